@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "asset_loader.h"
+#include "startup_timeline.h"
+#include "debug.h"
+#include <SDL2/SDL_image.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ÉTAT DU CHARGEUR
+// ═══════════════════════════════════════════════════════════════════════════
+// - Chaque thread prend l'image suivante (compteur atomique) jusqu'à épuisement
+// - Un sémaphore par image : posté une fois le décodage terminé (réussi ou non)
+// - Le thread principal est le seul à lire/modifier "taken"
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+    char path[256];
+    SDL_Surface* surface;       // Écrit par le thread, lu après SDL_SemWait
+    SDL_sem* done;
+    bool taken;                 // Déjà remise à l'appelant
+} PreloadedAsset;
+
+static struct {
+    PreloadedAsset assets[ASSET_LOADER_MAX];
+    int count;
+    atomic_int next;
+    SDL_Thread* threads[ASSET_LOADER_THREADS];
+    int thread_count;
+} loader;
+
+static const char* asset_basename(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+static int asset_worker(void* data) {
+    (void)data;
+
+    for (;;) {
+        int index = atomic_fetch_add(&loader.next, 1);
+        if (index >= loader.count) break;
+
+        PreloadedAsset* asset = &loader.assets[index];
+        asset->surface = IMG_Load(asset->path);
+        if (asset->surface) {
+            startup_mark("image décodée : %s", asset_basename(asset->path));
+        } else {
+            startup_mark("échec décodage : %s", asset_basename(asset->path));
+        }
+        SDL_SemPost(asset->done);
+    }
+    return 0;
+}
+
+bool asset_loader_start(const char* const* paths, int count) {
+    if (loader.count > 0 || !paths || count <= 0) return false;
+    if (count > ASSET_LOADER_MAX) {
+        debug_printf("⚠️ ASSETS: %d images demandées, seules %d préchargées\n",
+                     count, ASSET_LOADER_MAX);
+        count = ASSET_LOADER_MAX;
+    }
+
+    // Initialisation des décodeurs sur ce thread : IMG_Load l'appellerait
+    // sinon à la demande, depuis plusieurs threads à la fois
+    IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG);
+
+    for (int i = 0; i < count; i++) {
+        PreloadedAsset* asset = &loader.assets[loader.count];
+        snprintf(asset->path, sizeof(asset->path), "%s", paths[i]);
+        asset->surface = NULL;
+        asset->taken = false;
+        asset->done = SDL_CreateSemaphore(0);
+        if (!asset->done) {
+            debug_printf("⚠️ ASSETS: sémaphore non créé (%s)\n", SDL_GetError());
+            break;
+        }
+        loader.count++;
+    }
+    atomic_store(&loader.next, 0);
+
+    int wanted = loader.count < ASSET_LOADER_THREADS ? loader.count : ASSET_LOADER_THREADS;
+    for (int i = 0; i < wanted; i++) {
+        SDL_Thread* thread = SDL_CreateThread(asset_worker, "asset_loader", NULL);
+        if (!thread) {
+            debug_printf("⚠️ ASSETS: thread non créé (%s)\n", SDL_GetError());
+            break;
+        }
+        loader.threads[loader.thread_count++] = thread;
+    }
+
+    if (loader.thread_count == 0) {
+        // Pas de thread : les images seront chargées à la demande
+        asset_loader_stop();
+        return false;
+    }
+
+    debug_printf("🖼️ ASSETS: %d image(s) en décodage sur %d thread(s)\n",
+                 loader.count, loader.thread_count);
+    return true;
+}
+
+SDL_Surface* asset_load_surface(const char* path) {
+    if (!path) return NULL;
+
+    for (int i = 0; i < loader.count; i++) {
+        PreloadedAsset* asset = &loader.assets[i];
+        if (asset->taken || strcmp(asset->path, path) != 0) continue;
+
+        SDL_SemWait(asset->done);
+        asset->taken = true;
+
+        SDL_Surface* surface = asset->surface;
+        asset->surface = NULL;
+        if (surface) return surface;
+        break;      // Échec dans le thread : réessayer pour avoir IMG_GetError()
+    }
+
+    return IMG_Load(path);
+}
+
+SDL_Texture* asset_load_texture(SDL_Renderer* renderer, const char* path) {
+    SDL_Surface* surface = asset_load_surface(path);
+    if (!surface) return NULL;
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    return texture;
+}
+
+void asset_loader_stop(void) {
+    for (int i = 0; i < loader.thread_count; i++) {
+        SDL_WaitThread(loader.threads[i], NULL);
+    }
+    loader.thread_count = 0;
+
+    int unused = 0;
+    for (int i = 0; i < loader.count; i++) {
+        PreloadedAsset* asset = &loader.assets[i];
+        if (asset->surface) {
+            SDL_FreeSurface(asset->surface);
+            asset->surface = NULL;
+            unused++;
+        }
+        SDL_DestroySemaphore(asset->done);
+        asset->done = NULL;
+    }
+    if (unused > 0) {
+        debug_printf("⚠️ ASSETS: %d image(s) préchargée(s) jamais utilisée(s)\n", unused);
+    }
+    loader.count = 0;
+}
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PRÉCHARGEMENT DES IMAGES AU DÉMARRAGE
+// ═══════════════════════════════════════════════════════════════════════════
+// Les images sont décodées (IMG_Load) par des threads pendant que le thread
+// principal initialise SDL, les polices, la fenêtre et le renderer. La
+// création des textures reste sur le thread principal (seul autorisé à
+// utiliser le renderer) : asset_load_surface() attend uniquement l'image
+// demandée si son décodage n'est pas encore terminé.
+//
+// Un chemin non préchargé (ou déjà récupéré) est chargé directement :
+// remplacer IMG_Load() par asset_load_surface() ne change pas le résultat.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define ASSET_LOADER_MAX 8
+#define ASSET_LOADER_THREADS 4
+
+// Lance le décodage des images en arrière-plan (chemins copiés)
+bool asset_loader_start(const char* const* paths, int count);
+
+// Surface décodée (à libérer avec SDL_FreeSurface), NULL si erreur
+SDL_Surface* asset_load_surface(const char* path);
+
+// Surface → texture sur le renderer, NULL si erreur
+SDL_Texture* asset_load_texture(SDL_Renderer* renderer, const char* path);
+
+// Attend les threads et libère les images jamais récupérées
+void asset_loader_stop(void);
+
+#endif
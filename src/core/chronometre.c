@@ -4,6 +4,7 @@
 #include <string.h>
 #include "chronometre.h"
 #include "debug.h"
+#include "geometry.h"
 #include <SDL2/SDL2_gfxPrimitives.h>
 #include <cairo/cairo.h>
 #include <cairo/cairo-ft.h>
@@ -166,7 +167,7 @@ void stopwatch_render(StopwatchState* stopwatch, SDL_Renderer* renderer,
     int surface_height = adaptive_font_size * 2;  // Hauteur suffisante pour le texte
 
     cairo_font_face_t* cairo_face = cairo_ft_font_face_create_for_ft_face(ft_face, 0);
-    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, surface_width, surface_height);
+    cairo_surface_t* surface = create_frame_cairo_surface(surface_width, surface_height);
     cairo_t* cr = cairo_create(surface);
 
     // Configurer la police
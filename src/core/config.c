@@ -109,6 +109,39 @@ void save_config(const AppConfig* config) {
     }
 }
 
+//  HANDLES DES WIDGETS DE LA TABLE
+// Chaque entrée de CONFIG_PARAM_TABLE est résolue une fois en nœud de la
+// liste : les synchronisations sont ensuite un simple parcours de pointeurs.
+// La génération de la liste détecte un rechargement (nouvelle liste, même
+// adresse possible) ou un ajout de widget depuis la résolution.
+
+static struct {
+    const WidgetList* list;
+    uint32_t generation;
+    WidgetNode* nodes[sizeof(CONFIG_PARAM_TABLE) / sizeof(CONFIG_PARAM_TABLE[0])];
+} config_handles;
+
+void resolve_config_widgets(WidgetList* list) {
+    config_handles.list = list;
+    config_handles.generation = list ? list->generation : 0;
+
+    int resolved = 0;
+    for (int i = 0; i < CONFIG_PARAMS_COUNT; i++) {
+        config_handles.nodes[i] = list ? find_widget_by_id(list, CONFIG_PARAM_TABLE[i].widget_id) : NULL;
+        if (config_handles.nodes[i]) resolved++;
+    }
+
+    debug_printf("🔗 %d/%d paramètre(s) reliés à leur widget\n", resolved, CONFIG_PARAMS_COUNT);
+}
+
+// Handles à jour pour cette liste (re-résolus si la liste a changé)
+static WidgetNode* const* config_widget_handles(WidgetList* list) {
+    if (config_handles.list != list || config_handles.generation != list->generation) {
+        resolve_config_widgets(list);
+    }
+    return config_handles.nodes;
+}
+
 //  SYNCHRONISATION CONFIG → WIDGETS (GÉNÉRIQUE)
 // Parcourt la table CONFIG_PARAM_TABLE et synchronise automatiquement
 // Pour ajouter un nouveau paramètre : ajouter 1 ligne dans config_registry.h
@@ -116,6 +149,8 @@ void save_config(const AppConfig* config) {
 void sync_config_to_widgets(AppConfig* config, WidgetList* list) {
     if (!config || !list) return;
 
+    WidgetNode* const* nodes = config_widget_handles(list);
+
     debug_section("SYNC CONFIG → WIDGETS");
     int count = 0;
 
@@ -128,7 +163,7 @@ void sync_config_to_widgets(AppConfig* config, WidgetList* list) {
         bool success = false;
         switch (entry->type) {
             case CONFIG_TYPE_INT:
-                success = set_widget_int_value(list, entry->widget_id, *(const int*)field);
+                success = set_widget_node_int_value(nodes[i], *(const int*)field);
                 if (success) {
                     debug_printf("  🔄 %s = %d\n", entry->widget_id, *(const int*)field);
                     count++;
@@ -137,7 +172,7 @@ void sync_config_to_widgets(AppConfig* config, WidgetList* list) {
 
             case CONFIG_TYPE_FLOAT:
                 // Convertir float en int pour le widget (si nécessaire)
-                success = set_widget_int_value(list, entry->widget_id, (int)(*(const float*)field));
+                success = set_widget_node_int_value(nodes[i], (int)(*(const float*)field));
                 if (success) {
                     debug_printf("  🔄 %s = %.1f\n", entry->widget_id, *(const float*)field);
                     count++;
@@ -145,7 +180,7 @@ void sync_config_to_widgets(AppConfig* config, WidgetList* list) {
                 break;
 
             case CONFIG_TYPE_BOOL:
-                success = set_widget_bool_value(list, entry->widget_id, *(const bool*)field);
+                success = set_widget_node_bool_value(nodes[i], *(const bool*)field);
                 if (success) {
                     debug_printf("  🔄 %s = %s\n", entry->widget_id, *(const bool*)field ? "ON" : "OFF");
                     count++;
@@ -165,6 +200,8 @@ void sync_config_to_widgets(AppConfig* config, WidgetList* list) {
 void sync_widgets_to_config(WidgetList* list, AppConfig* config) {
     if (!list || !config) return;
 
+    WidgetNode* const* nodes = config_widget_handles(list);
+
     debug_section("SYNC WIDGETS → CONFIG");
     int count = 0;
 
@@ -177,7 +214,7 @@ void sync_widgets_to_config(WidgetList* list, AppConfig* config) {
         switch (entry->type) {
             case CONFIG_TYPE_INT: {
                 int int_val;
-                if (get_widget_int_value(list, entry->widget_id, &int_val)) {
+                if (get_widget_node_int_value(nodes[i], &int_val)) {
                     *(int*)field = int_val;
                     debug_printf("  💾 %s = %d\n", entry->widget_id, int_val);
                     count++;
@@ -187,7 +224,7 @@ void sync_widgets_to_config(WidgetList* list, AppConfig* config) {
 
             case CONFIG_TYPE_FLOAT: {
                 int int_val;
-                if (get_widget_int_value(list, entry->widget_id, &int_val)) {
+                if (get_widget_node_int_value(nodes[i], &int_val)) {
                     *(float*)field = (float)int_val;
                     debug_printf("  💾 %s = %.1f\n", entry->widget_id, (float)int_val);
                     count++;
@@ -197,7 +234,7 @@ void sync_widgets_to_config(WidgetList* list, AppConfig* config) {
 
             case CONFIG_TYPE_BOOL: {
                 bool bool_val;
-                if (get_widget_bool_value(list, entry->widget_id, &bool_val)) {
+                if (get_widget_node_bool_value(nodes[i], &bool_val)) {
                     *(bool*)field = bool_val;
                     debug_printf("  💾 %s = %s\n", entry->widget_id, bool_val ? "ON" : "OFF");
                     count++;
@@ -95,4 +95,12 @@ void sync_config_to_widgets(AppConfig* config, WidgetList* list);
  */
 void sync_widgets_to_config(WidgetList* list, AppConfig* config);
 
+/**
+ * Résout une fois les widgets de CONFIG_PARAM_TABLE dans la liste
+ * À appeler après chaque chargement des widgets ; les synchronisations
+ * re-résolvent d'elles-mêmes si la liste a changé depuis
+ * @param list Liste des widgets chargée
+ */
+void resolve_config_widgets(WidgetList* list);
+
 #endif
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "config_deps.h"
+#include "config_registry.h"
+#include "debug.h"
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TABLE DES DÉPENDANCES
+// ═══════════════════════════════════════════════════════════════════════════
+// - Les dépendances sont des clés de CONFIG_PARAM_TABLE (file_key) :
+//   ajouter un paramètre qui influence une donnée = ajouter sa clé ici
+// - Ce qui ne vient pas de la config (taille d'écran, police, renderer)
+//   passe par la clé de contexte fournie par l'appelant
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DERIVED_MAX_DEPS 8
+
+typedef struct {
+    const char* name;
+    const char* deps[DERIVED_MAX_DEPS];     // Terminé par NULL
+} DerivedDescriptor;
+
+static const DerivedDescriptor DERIVED_TABLE[DERIVED_ARTEFACT_COUNT] = {
+    [DERIVED_HEXAGON_TABLES] = { "tables hexagones", { "breath_duration", NULL } },
+    [DERIVED_COUNTER_CACHE]  = { "cache compteur",   { "Nb_respiration", "breath_duration", NULL } },
+    [DERIVED_SESSION_CARD]   = { "carte de session", { NULL } },
+    [DERIVED_SESSION_TIMER]  = { "timer de session", { "start_duration", NULL } },
+};
+
+typedef struct {
+    bool built;
+    AppConfig config;                       // Config au moment de la construction
+    uint64_t context_key;
+    const ConfigParamEntry* params[DERIVED_MAX_DEPS];
+    int param_count;
+    bool resolved;
+    int reused;
+    int rebuilt;
+} DerivedState;
+
+static DerivedState derived_states[DERIVED_ARTEFACT_COUNT];
+
+// Résout les clés en entrées de CONFIG_PARAM_TABLE (une seule fois)
+static void derived_resolve(DerivedArtefact artefact) {
+    DerivedState* state = &derived_states[artefact];
+    if (state->resolved) return;
+
+    const DerivedDescriptor* desc = &DERIVED_TABLE[artefact];
+    for (int i = 0; i < DERIVED_MAX_DEPS && desc->deps[i]; i++) {
+        const ConfigParamEntry* param = find_param_by_file_key(desc->deps[i]);
+        if (!param) {
+            debug_printf("⚠️ [DEPS] %s: clé '%s' absente de CONFIG_PARAM_TABLE\n",
+                         desc->name, desc->deps[i]);
+            continue;
+        }
+        state->params[state->param_count++] = param;
+    }
+    state->resolved = true;
+}
+
+static size_t param_size(const ConfigParamEntry* param) {
+    switch (param->type) {
+        case CONFIG_TYPE_INT:   return sizeof(int);
+        case CONFIG_TYPE_FLOAT: return sizeof(float);
+        case CONFIG_TYPE_BOOL:  return sizeof(bool);
+    }
+    return 0;
+}
+
+static bool param_changed(const ConfigParamEntry* param,
+                          const AppConfig* before, const AppConfig* after) {
+    return memcmp((const char*)before + param->offset,
+                  (const char*)after + param->offset,
+                  param_size(param)) != 0;
+}
+
+bool derived_is_current(DerivedArtefact artefact, const AppConfig* config,
+                        uint64_t context_key) {
+    if (artefact >= DERIVED_ARTEFACT_COUNT || !config) return false;
+
+    derived_resolve(artefact);
+    DerivedState* state = &derived_states[artefact];
+    const char* name = DERIVED_TABLE[artefact].name;
+
+    if (!state->built) {
+        debug_printf("🔨 [DEPS] %s: pas encore construit\n", name);
+        state->rebuilt++;
+        return false;
+    }
+
+    char changed[256] = "";
+    size_t length = 0;
+    for (int i = 0; i < state->param_count; i++) {
+        if (param_changed(state->params[i], &state->config, config)) {
+            int written = snprintf(changed + length, sizeof(changed) - length, "%s%s",
+                                   length ? ", " : "", state->params[i]->file_key);
+            if (written > 0 && (size_t)written < sizeof(changed) - length) {
+                length += (size_t)written;
+            }
+        }
+    }
+
+    if (length == 0 && state->context_key == context_key) {
+        debug_printf("♻️  [DEPS] %s: réutilisé (dépendances inchangées)\n", name);
+        state->reused++;
+        return true;
+    }
+
+    if (length > 0) {
+        debug_printf("🔁 [DEPS] %s: reconstruction (%s modifié)\n", name, changed);
+    } else {
+        debug_printf("🔁 [DEPS] %s: reconstruction (écran/police/renderer modifié)\n", name);
+    }
+    state->rebuilt++;
+    return false;
+}
+
+void derived_mark_built(DerivedArtefact artefact, const AppConfig* config,
+                        uint64_t context_key) {
+    if (artefact >= DERIVED_ARTEFACT_COUNT || !config) return;
+
+    DerivedState* state = &derived_states[artefact];
+    state->config = *config;
+    state->context_key = context_key;
+    state->built = true;
+}
+
+void derived_invalidate(DerivedArtefact artefact) {
+    if (artefact >= DERIVED_ARTEFACT_COUNT) return;
+    derived_states[artefact].built = false;
+}
+
+uint64_t derived_context_key(const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void derived_report(void) {
+    debug_subsection("DONNÉES DÉRIVÉES DE LA CONFIG");
+    for (int i = 0; i < DERIVED_ARTEFACT_COUNT; i++) {
+        debug_printf("  %-18s %3d réutilisation(s), %3d construction(s)\n",
+                     DERIVED_TABLE[i].name, derived_states[i].reused,
+                     derived_states[i].rebuilt);
+    }
+}
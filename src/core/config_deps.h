@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// config_deps.h
+// DÉPENDANCES CONFIG → DONNÉES DÉRIVÉES
+// Chaque donnée coûteuse à construire (tables d'hexagones, cache du compteur...)
+// déclare les paramètres de CONFIG_PARAM_TABLE dont elle dépend. Au clic sur
+// Wim, seules les données dont une entrée a changé sont reconstruites.
+
+#ifndef __CONFIG_DEPS_H__
+#define __CONFIG_DEPS_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+
+// DONNÉES DÉRIVÉES SUIVIES
+typedef enum {
+    DERIVED_HEXAGON_TABLES,     // precompute_all_cycles + precompute_counter_frames
+    DERIVED_COUNTER_CACHE,      // Textures du compteur (counter_cache_create)
+    DERIVED_SESSION_CARD,       // Carte "Session N" (texture rendue par Cairo)
+    DERIVED_SESSION_TIMER,      // Timer de départ (police TTF + durée)
+    DERIVED_ARTEFACT_COUNT
+} DerivedArtefact;
+
+// Vrai si la donnée a été construite et qu'aucune de ses dépendances
+// (paramètres de config + clé de contexte) n'a changé depuis.
+// Logge les champs modifiés ou la réutilisation.
+bool derived_is_current(DerivedArtefact artefact, const AppConfig* config,
+                        uint64_t context_key);
+
+// Enregistre la config et le contexte avec lesquels la donnée vient d'être construite
+void derived_mark_built(DerivedArtefact artefact, const AppConfig* config,
+                        uint64_t context_key);
+
+// Oublie la donnée (libérée ailleurs) : la prochaine vérification reconstruira
+void derived_invalidate(DerivedArtefact artefact);
+
+// Hash FNV-1a des paramètres hors config (taille écran, police, renderer...)
+uint64_t derived_context_key(const void* data, size_t size);
+
+// Bilan réutilisations / reconstructions dans debug.txt
+void derived_report(void);
+
+#endif
@@ -65,6 +65,21 @@ CounterState* counter_create(SDL_Renderer* renderer, int total_breaths, int rete
     return counter;
 }
 
+// RÉINITIALISATION DU COMPTEUR (le cache est conservé)
+void counter_reset(CounterState* counter, int total_breaths, int retention_type) {
+    if (!counter) return;
+
+    counter->total_breaths = total_breaths;
+    counter->retention_type = retention_type;
+    counter->is_active = false;
+    counter->current_breath = 0;
+    counter->was_at_min_last_frame = false;
+    counter->waiting_for_scale_min = false;
+    counter->was_at_max_last_frame = false;
+
+    debug_printf("🔄 Compteur réinitialisé: 0/%d respirations (cache conservé)\n", total_breaths);
+}
+
 
 
 // RENDU DU COMPTEUR AVEC CACHE DE TEXTURES (ULTRA-LIGHT)
@@ -73,6 +73,15 @@ void counter_render(CounterState* counter, SDL_Renderer* renderer,
                     int center_x, int center_y, int hex_radius, HexagoneNode* hex_node,
                     float scale_factor);
 
+/**
+ * Remettre le compteur à 0 sans toucher au cache de textures
+ * (réutilisation d'un compteur dont les dépendances n'ont pas changé)
+ * @param counter Pointeur vers le compteur
+ * @param total_breaths Nombre de respirations (≤ respirations du cache)
+ * @param retention_type Type de rétention: 0=poumons pleins, 1=poumons vides
+ */
+void counter_reset(CounterState* counter, int total_breaths, int retention_type);
+
 /**
  * Libérer la mémoire du compteur
  * @param counter Pointeur vers le compteur à détruire
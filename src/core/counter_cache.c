@@ -11,6 +11,7 @@
 #include "counter_cache.h"
 #include "precompute_list.h"  // Pour sinusoidal_movement
 #include "debug.h"
+#include "trace.h"
 #include "core/memory/memory.h"
 
 // UTILITAIRE : Convertir surface Cairo vers texture SDL
@@ -153,10 +154,13 @@ CounterTextureCache* counter_cache_create(SDL_Renderer* renderer,
         return NULL;
     }
 
+    TRACE_BEGIN("counter_cache_create");
+
     // Allouer la structure
     CounterTextureCache* cache = SAFE_MALLOC(sizeof(CounterTextureCache));
     if (!cache) {
         fprintf(stderr, "❌ Erreur allocation CounterTextureCache\n");
+        TRACE_END("counter_cache_create");
         return NULL;
     }
 
@@ -184,6 +188,7 @@ CounterTextureCache* counter_cache_create(SDL_Renderer* renderer,
     if (!cache->textures) {
         fprintf(stderr, "❌ Erreur allocation tableau de textures\n");
         SAFE_FREE(cache);
+        TRACE_END("counter_cache_create");
         return NULL;
     }
 
@@ -197,6 +202,7 @@ CounterTextureCache* counter_cache_create(SDL_Renderer* renderer,
             }
             SAFE_FREE(cache->textures);
             SAFE_FREE(cache);
+            TRACE_END("counter_cache_create");
             return NULL;
         }
     }
@@ -245,6 +251,7 @@ CounterTextureCache* counter_cache_create(SDL_Renderer* renderer,
     debug_printf("✅ Cache créé: %d textures précalculées (%.1f MB estimé)\n",
                  total_textures, memory_mb);
 
+    TRACE_END("counter_cache_create");
     return cache;
 }
 
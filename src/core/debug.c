@@ -1,18 +1,295 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include "debug.h"
+#include "core/memory/memory.h"
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 
 FILE *debug_file = NULL;
 int verbose_mode = 0;  // 0 = normal, 1 = verbose
+int debug_log_level = LOG_LEVEL_INFO;
 
-void debug_printf(const char *format, ...) {
-    if (debug_file) {
-        va_list args;
-        va_start(args, format);
-        vfprintf(debug_file, format, args);
-        va_end(args);
-        fflush(debug_file);  // ✅ Forcer l'écriture
+// ═══════════════════════════════════════════════════════════════════════════
+// BUFFER CIRCULAIRE MPSC (file bornée de Vyukov)
+// ═══════════════════════════════════════════════════════════════════════════
+// - Producteurs : réservent une case par CAS sur enqueue_pos, formatent le
+//   message directement dedans puis la publient via son numéro de séquence
+// - Consommateur unique (thread d'écriture) : lit dans l'ordre, fwrite, puis
+//   un seul fflush par lot
+// - Arrêt : on ferme l'entrée (accepting), on attend les producteurs en
+//   cours (producers) puis le dernier vidage avant de libérer le buffer. Les
+//   écritures synchrones attendent la fin de l'arrêt (sync_lock) pour ne pas
+//   passer devant des messages encore dans le buffer
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define LOG_RING_CAPACITY 4096          // Puissance de 2
+#define LOG_MESSAGE_MAX 512             // Au-delà, le message est tronqué
+#define LOG_WRITER_IDLE_MS 100          // Réveil périodique du thread d'écriture
+
+typedef struct {
+    atomic_size_t sequence;
+    size_t length;
+    char text[LOG_MESSAGE_MAX];
+} LogCell;
+
+static struct {
+    LogCell* ring;
+    atomic_size_t enqueue_pos;
+    size_t dequeue_pos;                 // Consommateur uniquement
+
+    SDL_Thread* writer;
+    SDL_sem* wakeup;
+    SDL_mutex* sync_lock;               // Jamais détruit : un producteur peut l'attendre
+    atomic_bool accepting;              // Les producteurs peuvent écrire dans le buffer
+    atomic_int producers;               // Producteurs entre le test d'accepting et la publication
+    atomic_bool running;
+    atomic_bool writer_idle;            // Le writer dort : un producteur doit le réveiller
+
+    atomic_size_t written;
+    atomic_size_t dropped;              // Buffer plein
+    atomic_size_t rate_limited;         // Supprimés par la limitation de débit
+    atomic_size_t truncated;
+} logger;
+
+// Écriture synchrone (avant démarrage / pendant et après l'arrêt du thread)
+static void log_write_sync(const char *format, va_list args) {
+    if (logger.sync_lock) SDL_LockMutex(logger.sync_lock);
+    vfprintf(debug_file, format, args);
+    fflush(debug_file);
+    if (logger.sync_lock) SDL_UnlockMutex(logger.sync_lock);
+}
+
+static void log_enqueue_ring(const char *format, va_list args);
+
+static void log_enqueue(const char *format, va_list args) {
+    // Compté avant de tester accepting : l'arrêt (qui fait l'inverse) voit
+    // soit ce producteur, soit le producteur voit l'entrée fermée
+    atomic_fetch_add(&logger.producers, 1);
+    if (!atomic_load(&logger.accepting)) {
+        atomic_fetch_sub(&logger.producers, 1);
+        log_write_sync(format, args);
+        return;
+    }
+
+    log_enqueue_ring(format, args);
+    atomic_fetch_sub(&logger.producers, 1);
+}
+
+static void log_enqueue_ring(const char *format, va_list args) {
+
+    LogCell* cell;
+    size_t pos = atomic_load_explicit(&logger.enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        cell = &logger.ring[pos & (LOG_RING_CAPACITY - 1)];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&logger.enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Buffer plein : perdre le message plutôt que bloquer le rendu
+            atomic_fetch_add_explicit(&logger.dropped, 1, memory_order_relaxed);
+            return;
+        } else {
+            pos = atomic_load_explicit(&logger.enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    int length = vsnprintf(cell->text, LOG_MESSAGE_MAX, format, args);
+    if (length < 0) {
+        length = 0;
+    } else if (length >= LOG_MESSAGE_MAX) {
+        // Garder la fin de ligne pour ne pas coller le message suivant
+        length = LOG_MESSAGE_MAX - 1;
+        cell->text[length - 1] = '\n';
+        atomic_fetch_add_explicit(&logger.truncated, 1, memory_order_relaxed);
+    }
+    cell->length = (size_t)length;
+
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+
+    if (atomic_exchange_explicit(&logger.writer_idle, false, memory_order_acq_rel)) {
+        SDL_SemPost(logger.wakeup);
+    }
+}
+
+static void log_enqueue_fmt(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    log_enqueue(format, args);
+    va_end(args);
+}
+
+static bool log_has_pending(void) {
+    LogCell* cell = &logger.ring[logger.dequeue_pos & (LOG_RING_CAPACITY - 1)];
+    size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    return sequence == logger.dequeue_pos + 1;
+}
+
+// Vide le buffer dans debug.txt (thread d'écriture uniquement)
+static void log_drain(void) {
+    size_t count = 0;
+
+    while (log_has_pending()) {
+        LogCell* cell = &logger.ring[logger.dequeue_pos & (LOG_RING_CAPACITY - 1)];
+        fwrite(cell->text, 1, cell->length, debug_file);
+
+        atomic_store_explicit(&cell->sequence, logger.dequeue_pos + LOG_RING_CAPACITY,
+                              memory_order_release);
+        logger.dequeue_pos++;
+        count++;
+    }
+
+    if (count > 0) {
+        fflush(debug_file);
+        atomic_fetch_add_explicit(&logger.written, count, memory_order_relaxed);
+    }
+}
+
+static int log_writer_thread(void* data) {
+    (void)data;
+
+    while (atomic_load_explicit(&logger.running, memory_order_acquire)) {
+        atomic_store_explicit(&logger.writer_idle, true, memory_order_release);
+        if (!log_has_pending()) {
+            SDL_SemWaitTimeout(logger.wakeup, LOG_WRITER_IDLE_MS);
+        }
+        atomic_store_explicit(&logger.writer_idle, false, memory_order_release);
+
+        log_drain();
+    }
+
+    // Derniers messages publiés avant l'arrêt
+    log_drain();
+    return 0;
+}
+
+void debug_logger_start(void) {
+    if (!debug_file || logger.ring) return;
+
+    if (!logger.sync_lock) logger.sync_lock = SDL_CreateMutex();
+    logger.ring = SAFE_MALLOC(LOG_RING_CAPACITY * sizeof(LogCell));
+    logger.wakeup = SDL_CreateSemaphore(0);
+    if (!logger.ring || !logger.wakeup) {
+        if (logger.ring) SAFE_FREE(logger.ring);
+        if (logger.wakeup) SDL_DestroySemaphore(logger.wakeup);
+        logger.wakeup = NULL;
+        fprintf(debug_file, "⚠️ Logger asynchrone indisponible, écriture synchrone\n");
+        return;
+    }
+
+    memset(logger.ring, 0, LOG_RING_CAPACITY * sizeof(LogCell));
+    for (size_t i = 0; i < LOG_RING_CAPACITY; i++) {
+        atomic_init(&logger.ring[i].sequence, i);
+    }
+    atomic_init(&logger.enqueue_pos, 0);
+    logger.dequeue_pos = 0;
+
+    atomic_store(&logger.running, true);
+    logger.writer = SDL_CreateThread(log_writer_thread, "debug_log_writer", NULL);
+    if (!logger.writer) {
+        atomic_store(&logger.running, false);
+        SAFE_FREE(logger.ring);
+        SDL_DestroySemaphore(logger.wakeup);
+        logger.wakeup = NULL;
+        fprintf(debug_file, "⚠️ Thread de log non créé (%s), écriture synchrone\n", SDL_GetError());
+        return;
+    }
+    atomic_store(&logger.accepting, true);
+}
+
+void debug_logger_stop(void) {
+    if (!logger.ring) return;
+
+    // Les écritures synchrones attendent le dernier vidage (mutex récursif :
+    // ce thread peut encore logger pendant l'arrêt)
+    SDL_LockMutex(logger.sync_lock);
+
+    // Fermer l'entrée puis attendre les producteurs déjà engagés
+    atomic_store(&logger.accepting, false);
+    while (atomic_load(&logger.producers) > 0) {
+        SDL_Delay(1);
+    }
+
+    // Plus personne n'écrit dans le buffer : dernier vidage par le writer
+    atomic_store_explicit(&logger.running, false, memory_order_release);
+    SDL_SemPost(logger.wakeup);
+    SDL_WaitThread(logger.writer, NULL);
+
+    SAFE_FREE(logger.ring);
+    logger.writer = NULL;
+    SDL_DestroySemaphore(logger.wakeup);
+    logger.wakeup = NULL;
+
+    SDL_UnlockMutex(logger.sync_lock);
+}
+
+void debug_logger_report(void) {
+    if (!debug_file) return;
+
+    size_t dropped = atomic_load(&logger.dropped);
+    size_t rate_limited = atomic_load(&logger.rate_limited);
+    size_t truncated = atomic_load(&logger.truncated);
+
+    log_enqueue_fmt("📝 Logger: %zu messages écrits, %zu perdus (buffer plein), "
+                    "%zu limités, %zu tronqués\n",
+                    atomic_load(&logger.written), dropped, rate_limited, truncated);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LIMITATION DE DÉBIT PAR POINT D'APPEL
+// ═══════════════════════════════════════════════════════════════════════════
+
+static unsigned int current_second(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned int)now.tv_sec;
+}
+
+// Retourne false si le message doit être supprimé
+static bool log_rate_allow(LogSite* site, const char* file, int line) {
+    unsigned int second = current_second();
+    unsigned int window = atomic_load_explicit(&site->window, memory_order_relaxed);
+
+    if (window != second &&
+        atomic_compare_exchange_strong(&site->window, &window, second)) {
+        // Nouvelle seconde : résumer ce qui a été supprimé dans la précédente
+        unsigned int suppressed = atomic_exchange(&site->suppressed, 0);
+        atomic_store(&site->count, 0);
+        if (suppressed > 0) {
+            log_enqueue_fmt("🔇 %u message(s) supprimé(s) depuis %s:%d (> %d/s)\n",
+                            suppressed, file, line, LOG_RATE_LIMIT_PER_SECOND);
+        }
     }
+
+    if (atomic_fetch_add_explicit(&site->count, 1, memory_order_relaxed)
+            >= LOG_RATE_LIMIT_PER_SECOND) {
+        atomic_fetch_add_explicit(&site->suppressed, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&logger.rate_limited, 1, memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void debug_log_impl(LogSite* site, int level, const char* file, int line,
+                    const char *format, ...) {
+    if (!debug_file) return;
+    if (level > debug_log_level) return;
+    if (site && !log_rate_allow(site, file, line)) return;
+
+    va_list args;
+    va_start(args, format);
+    log_enqueue(format, args);
+    va_end(args);
     /*// ✅ OPTIONNEL : Afficher aussi dans la console
     va_list args2;
     va_start(args2, format);
@@ -20,46 +297,32 @@ void debug_printf(const char *format, ...) {
     va_end(args2);*/
 }
 
-void debug_verbose(const char *format, ...) {
-    if (debug_file && verbose_mode) {
-        va_list args;
-        va_start(args, format);
-        vfprintf(debug_file, format, args);
-        va_end(args);
-        fflush(debug_file);
-    }
-}
-
 //  FONCTIONS D'AMÉLIORATION VISUELLE DU DEBUG
 
 void debug_blank_line() {
     if (debug_file) {
-        fprintf(debug_file, "\n");
-        fflush(debug_file);
+        log_enqueue_fmt("\n");
     }
 }
 
 void debug_separator() {
     if (debug_file) {
-        fprintf(debug_file, "────────────────────────────────────────────────────────────────────────────────\n");
-        fflush(debug_file);
+        log_enqueue_fmt("────────────────────────────────────────────────────────────────────────────────\n");
     }
 }
 
 void debug_section(const char* title) {
     if (debug_file) {
-        fprintf(debug_file, "\n");
-        fprintf(debug_file, "════════════════════════════════════════════════════════════════════════════════\n");
-        fprintf(debug_file, "  %s\n", title);
-        fprintf(debug_file, "════════════════════════════════════════════════════════════════════════════════\n");
-        fflush(debug_file);
+        log_enqueue_fmt("\n");
+        log_enqueue_fmt("════════════════════════════════════════════════════════════════════════════════\n");
+        log_enqueue_fmt("  %s\n", title);
+        log_enqueue_fmt("════════════════════════════════════════════════════════════════════════════════\n");
     }
 }
 
 void debug_subsection(const char* title) {
     if (debug_file) {
-        fprintf(debug_file, "\n");
-        fprintf(debug_file, "─── %s ───\n", title);
-        fflush(debug_file);
+        log_enqueue_fmt("\n");
+        log_enqueue_fmt("─── %s ───\n", title);
     }
 }
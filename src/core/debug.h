@@ -4,15 +4,96 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdatomic.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOGGER ASYNCHRONE
+// ═══════════════════════════════════════════════════════════════════════════
+// debug_printf() ne fait plus d'I/O : le message est formaté dans un buffer
+// circulaire lock-free (multi-producteurs) et un thread dédié l'écrit dans
+// debug.txt. Buffer plein → message perdu et compté (jamais de blocage).
+// Chaque point d'appel est limité à LOG_RATE_LIMIT_PER_SECOND messages/s ;
+// les messages en trop sont comptés et résumés en une ligne.
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Niveaux de log (du plus au moins important)
+#define LOG_LEVEL_ERROR   0
+#define LOG_LEVEL_WARN    1
+#define LOG_LEVEL_INFO    2
+#define LOG_LEVEL_VERBOSE 3
+
+// Niveau maximal compilé : au-dessus, les appels disparaissent du binaire
+// (ex: make LOG_LEVEL=INFO retire tous les debug_verbose)
+#ifndef DEBUG_LOG_COMPILE_LEVEL
+    #define DEBUG_LOG_COMPILE_LEVEL LOG_LEVEL_VERBOSE
+#endif
+
+#ifndef LOG_RATE_LIMIT_PER_SECOND
+    #define LOG_RATE_LIMIT_PER_SECOND 100
+#endif
+
+// État de limitation de débit d'un point d'appel (une instance static par appel)
+typedef struct LogSite {
+    atomic_uint window;         // Seconde en cours de comptage
+    atomic_uint count;          // Messages émis dans cette seconde
+    atomic_uint suppressed;     // Messages supprimés dans cette seconde
+} LogSite;
 
 // Fonctions de debug
 void init_debug_mode(int argc, char **argv);
 void cleanup_debug_mode();
-void debug_printf(const char *format, ...);
-void debug_verbose(const char *format, ...);  // Pour les messages verbose uniquement
+
+// Point d'entrée des macros ci-dessous (ne pas appeler directement)
+void debug_log_impl(LogSite* site, int level, const char* file, int line,
+                    const char *format, ...);
+
+// Démarre / arrête le thread d'écriture (debug_file doit être ouvert).
+// Sans thread, les messages sont écrits de façon synchrone.
+void debug_logger_start(void);
+void debug_logger_stop(void);
+
+// Compteurs du logger (écrits, perdus, limités, tronqués) dans debug.txt
+void debug_logger_report(void);
 
 extern FILE *debug_file;
-extern int verbose_mode;  // 0 = normal, 1 = verbose
+extern int verbose_mode;     // 0 = normal, 1 = verbose
+extern int debug_log_level;  // Niveau maximal affiché à l'exécution
+
+#define DEBUG_LOG_AT(level, ...) \
+    do { \
+        static LogSite debug_log_site_; \
+        debug_log_impl(&debug_log_site_, (level), __FILE__, __LINE__, __VA_ARGS__); \
+    } while (0)
+
+// Appel retiré à la compilation : les arguments restent "utilisés"
+// (pas de warnings) mais aucun code n'est généré
+static inline void debug_log_discard(const char *format, ...) { (void)format; }
+#define DEBUG_LOG_DISCARD(...) do { if (0) debug_log_discard(__VA_ARGS__); } while (0)
+
+#if DEBUG_LOG_COMPILE_LEVEL >= LOG_LEVEL_ERROR
+    #define debug_error(...) DEBUG_LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+    #define debug_error(...) DEBUG_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if DEBUG_LOG_COMPILE_LEVEL >= LOG_LEVEL_WARN
+    #define debug_warn(...) DEBUG_LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+    #define debug_warn(...) DEBUG_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if DEBUG_LOG_COMPILE_LEVEL >= LOG_LEVEL_INFO
+    #define debug_printf(...) DEBUG_LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+    #define debug_printf(...) DEBUG_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+// Pour les messages verbose uniquement (--verbose)
+#if DEBUG_LOG_COMPILE_LEVEL >= LOG_LEVEL_VERBOSE
+    #define debug_verbose(...) DEBUG_LOG_AT(LOG_LEVEL_VERBOSE, __VA_ARGS__)
+#else
+    #define debug_verbose(...) DEBUG_LOG_DISCARD(__VA_ARGS__)
+#endif
 
 // Fonctions d'amélioration visuelle du debug
 void debug_separator();              // Ligne de séparation fine
@@ -21,16 +102,9 @@ void debug_blank_line();              // Ligne vide pour aérer
 void debug_subsection(const char* title); // Sous-section
 
 // Macros pratiques pour différents niveaux de log
-#ifdef DEBUG_MODE
-    #define DEBUG_INFO(...) debug_printf("ℹ️ [INFO] " __VA_ARGS__)
-    #define DEBUG_WARN(...) debug_printf("⚠️ [WARN] " __VA_ARGS__)
-    #define DEBUG_ERROR(...) debug_printf("❌ [ERROR] " __VA_ARGS__)
-    #define DEBUG_TRACE(...) debug_printf("🔍 [TRACE] " __VA_ARGS__)
-#else
-    #define LOG_INFO(...)
-    #define LOG_WARN(...)
-    #define LOG_ERROR(...)
-    #define LOG_TRACE(...)
-#endif
+#define DEBUG_INFO(...) debug_printf("ℹ️ [INFO] " __VA_ARGS__)
+#define DEBUG_WARN(...) debug_warn("⚠️ [WARN] " __VA_ARGS__)
+#define DEBUG_ERROR(...) debug_error("❌ [ERROR] " __VA_ARGS__)
+#define DEBUG_TRACE(...) debug_verbose("🔍 [TRACE] " __VA_ARGS__)
 
 #endif
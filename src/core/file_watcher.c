@@ -0,0 +1,376 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "file_watcher.h"
+#include "debug.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ÉTAT DU SURVEILLANT
+// ═══════════════════════════════════════════════════════════════════════════
+// - inotify : une surveillance par répertoire parent (le noyau renvoie le
+//   même descripteur pour un répertoire déjà surveillé), filtrage par nom
+// - Le thread dort dans poll() sur le descripteur inotify et sur un pipe
+//   de réveil utilisé uniquement pour l'arrêt
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+    char path[256];
+    char dir[256];
+    char name[128];             // Vide : tout le répertoire est surveillé
+    bool is_directory;
+    int wd;                     // Descripteur inotify (-1 en mode stat)
+    bool pending;               // Changement vu, notification en attente
+
+    // Mode de repli
+    struct timespec mtime;
+    off_t size;
+    bool exists;
+} FileWatch;
+
+Uint32 file_watcher_event_type = (Uint32)-1;
+
+static struct {
+    FileWatch watches[FILE_WATCH_MAX];
+    int count;
+    int inotify_fd;             // -1 : mode stat() périodique
+    int wake_pipe[2];
+    SDL_Thread* thread;
+    atomic_bool running;
+    atomic_size_t notified;
+} watcher = { .inotify_fd = -1, .wake_pipe = { -1, -1 } };
+
+int file_watcher_add(const char* path, bool is_directory) {
+    if (!path || watcher.thread) return -1;
+    if (watcher.count >= FILE_WATCH_MAX) {
+        debug_printf("⚠️ WATCH: plus de %d fichiers surveillés, '%s' ignoré\n",
+                     FILE_WATCH_MAX, path);
+        return -1;
+    }
+
+    FileWatch* watch = &watcher.watches[watcher.count];
+    memset(watch, 0, sizeof(*watch));
+    snprintf(watch->path, sizeof(watch->path), "%s", path);
+    watch->is_directory = is_directory;
+    watch->wd = -1;
+
+    if (is_directory) {
+        snprintf(watch->dir, sizeof(watch->dir), "%s", path);
+    } else {
+        const char* slash = strrchr(path, '/');
+        if (slash) {
+            snprintf(watch->dir, sizeof(watch->dir), "%.*s", (int)(slash - path), path);
+            snprintf(watch->name, sizeof(watch->name), "%s", slash + 1);
+        } else {
+            snprintf(watch->dir, sizeof(watch->dir), ".");
+            snprintf(watch->name, sizeof(watch->name), "%s", path);
+        }
+    }
+
+    return watcher.count++;
+}
+
+const char* file_watcher_path(int id) {
+    if (id < 0 || id >= watcher.count) return NULL;
+    return watcher.watches[id].path;
+}
+
+static void watch_push_event(int id) {
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = file_watcher_event_type;
+    event.user.code = id;
+
+    if (SDL_PushEvent(&event) < 0) {
+        debug_printf("⚠️ WATCH: événement perdu pour %s (%s)\n",
+                     watcher.watches[id].path, SDL_GetError());
+        return;
+    }
+    atomic_fetch_add(&watcher.notified, 1);
+    debug_verbose("👀 WATCH: %s modifié\n", watcher.watches[id].path);
+}
+
+// Notifie les surveillances marquées (fin de la fenêtre d'anti-rebond)
+static void watch_flush_pending(void) {
+    for (int i = 0; i < watcher.count; i++) {
+        if (watcher.watches[i].pending) {
+            watcher.watches[i].pending = false;
+            watch_push_event(i);
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// MODE INOTIFY
+// ─────────────────────────────────────────────────────────────────────────────
+#ifdef __linux__
+#define WATCH_INOTIFY_MASK (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MODIFY | \
+                            IN_DELETE_SELF | IN_MOVE_SELF)
+
+static bool watch_stat(FileWatch* watch);
+
+// Surveillances sans descripteur (répertoire absent, supprimé ou déplacé)
+static bool watch_inotify_missing(void) {
+    for (int i = 0; i < watcher.count; i++) {
+        if (watcher.watches[i].wd < 0) return true;
+    }
+    return false;
+}
+
+// (Re)pose les surveillances manquantes. Tant qu'un répertoire manque, sa
+// surveillance retombe sur le stat() du mode de repli : un changement vu
+// ainsi, ou la réapparition du répertoire, est notifié
+static void watch_inotify_attach(bool startup) {
+    for (int i = 0; i < watcher.count; i++) {
+        FileWatch* watch = &watcher.watches[i];
+        if (watch->wd >= 0) continue;
+
+        bool changed = watch_stat(watch);
+        watch->wd = inotify_add_watch(watcher.inotify_fd, watch->dir, WATCH_INOTIFY_MASK);
+        if (startup) {
+            if (watch->wd < 0) {
+                // Répertoire absent (ex: stats pas encore créé) : nouvel essai à chaque
+                // intervalle du mode de repli
+                debug_printf("⚠️ WATCH: impossible de surveiller %s (%s), nouvel essai toutes les %d ms\n",
+                             watch->dir, strerror(errno), FILE_WATCH_POLL_MS);
+            }
+            continue;
+        }
+
+        if (watch->wd >= 0) {
+            debug_verbose("👀 WATCH: %s de nouveau surveillé\n", watch->dir);
+            watch->pending = true;
+        } else if (changed) {
+            watch->pending = true;
+        }
+    }
+}
+
+// Le noyau a retiré la surveillance d'un répertoire (IN_IGNORED après une
+// suppression ou un démontage) ou le répertoire a été déplacé (la surveillance
+// suivrait l'inode ailleurs) : on l'abandonne pour la reposer sur le chemin
+static void watch_inotify_detach(int wd, bool remove) {
+    if (remove) inotify_rm_watch(watcher.inotify_fd, wd);
+
+    for (int i = 0; i < watcher.count; i++) {
+        FileWatch* watch = &watcher.watches[i];
+        if (watch->wd != wd) continue;
+        watch->wd = -1;
+        watch->pending = true;
+        watch_stat(watch);
+        debug_verbose("👀 WATCH: %s n'est plus surveillé, nouvel essai\n", watch->dir);
+    }
+}
+
+static bool watch_inotify_setup(void) {
+    watcher.inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watcher.inotify_fd < 0) {
+        debug_printf("⚠️ WATCH: inotify indisponible (%s)\n", strerror(errno));
+        return false;
+    }
+
+    for (int i = 0; i < watcher.count; i++) {
+        watcher.watches[i].wd = -1;
+    }
+    watch_inotify_attach(true);
+    return true;
+}
+
+// Lit les notifications disponibles ; retourne true si une surveillance est concernée
+static bool watch_inotify_read(void) {
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool matched = false;
+
+    for (;;) {
+        ssize_t length = read(watcher.inotify_fd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+
+        for (char* ptr = buffer; ptr < buffer + length; ) {
+            const struct inotify_event* event = (const struct inotify_event*)ptr;
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            // File du noyau débordée : des changements ont pu être perdus
+            if (event->wd < 0) {
+                for (int i = 0; i < watcher.count; i++) watcher.watches[i].pending = true;
+                matched = true;
+                continue;
+            }
+            if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) {
+                watch_inotify_detach(event->wd, !(event->mask & IN_IGNORED));
+                matched = true;
+                continue;
+            }
+
+            for (int i = 0; i < watcher.count; i++) {
+                FileWatch* watch = &watcher.watches[i];
+                if (watch->wd != event->wd) continue;
+                if (!watch->is_directory &&
+                    (event->len == 0 || strcmp(event->name, watch->name) != 0)) {
+                    continue;
+                }
+                watch->pending = true;
+                matched = true;
+            }
+        }
+    }
+    return matched;
+}
+#endif
+
+// ─────────────────────────────────────────────────────────────────────────────
+// MODE DE REPLI : stat() PÉRIODIQUE
+// ─────────────────────────────────────────────────────────────────────────────
+static bool watch_stat(FileWatch* watch) {
+    struct stat st;
+    bool exists = stat(watch->path, &st) == 0;
+    bool changed = exists != watch->exists;
+
+    if (exists) {
+        changed = changed ||
+                  st.st_mtim.tv_sec != watch->mtime.tv_sec ||
+                  st.st_mtim.tv_nsec != watch->mtime.tv_nsec ||
+                  st.st_size != watch->size;
+        watch->mtime = st.st_mtim;
+        watch->size = st.st_size;
+    }
+    watch->exists = exists;
+    return changed;
+}
+
+static void watch_poll_all(void) {
+    for (int i = 0; i < watcher.count; i++) {
+        if (watch_stat(&watcher.watches[i])) {
+            watcher.watches[i].pending = true;
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// THREAD
+// ─────────────────────────────────────────────────────────────────────────────
+static int watch_thread(void* data) {
+    (void)data;
+    bool use_inotify = watcher.inotify_fd >= 0;
+    bool any_pending = false;
+
+    while (atomic_load(&watcher.running)) {
+        struct pollfd fds[2] = {
+            { .fd = watcher.wake_pipe[0], .events = POLLIN },
+            { .fd = watcher.inotify_fd, .events = POLLIN },
+        };
+        int timeout = FILE_WATCH_POLL_MS;
+#ifdef __linux__
+        if (use_inotify && !watch_inotify_missing()) timeout = -1;
+#endif
+        if (use_inotify && any_pending) timeout = FILE_WATCH_DEBOUNCE_MS;
+
+        int ready = poll(fds, use_inotify ? 2 : 1, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            debug_printf("❌ WATCH: poll() a échoué (%s)\n", strerror(errno));
+            break;
+        }
+
+        if (fds[0].revents) break;      // Arrêt demandé
+
+        if (ready == 0) {
+            if (!use_inotify) watch_poll_all();
+            watch_flush_pending();
+            any_pending = false;
+#ifdef __linux__
+            if (use_inotify && watch_inotify_missing()) {
+                watch_inotify_attach(false);
+                for (int i = 0; i < watcher.count; i++) {
+                    any_pending = any_pending || watcher.watches[i].pending;
+                }
+            }
+#endif
+            continue;
+        }
+
+#ifdef __linux__
+        if (use_inotify && (fds[1].revents & POLLIN) && watch_inotify_read()) {
+            any_pending = true;         // Relance la fenêtre d'anti-rebond
+        }
+#endif
+    }
+    return 0;
+}
+
+bool file_watcher_start(void) {
+    if (watcher.thread || watcher.count == 0) return false;
+
+    file_watcher_event_type = SDL_RegisterEvents(1);
+    if (file_watcher_event_type == (Uint32)-1) {
+        debug_printf("❌ WATCH: plus de types d'événements SDL disponibles\n");
+        return false;
+    }
+
+    if (pipe(watcher.wake_pipe) != 0) {
+        debug_printf("❌ WATCH: pipe() a échoué (%s)\n", strerror(errno));
+        return false;
+    }
+    fcntl(watcher.wake_pipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(watcher.wake_pipe[1], F_SETFD, FD_CLOEXEC);
+
+    bool use_inotify = false;
+#ifdef __linux__
+    use_inotify = watch_inotify_setup();
+#endif
+    if (!use_inotify) {
+        // État initial pour ne pas signaler tous les fichiers au premier passage
+        for (int i = 0; i < watcher.count; i++) {
+            watch_stat(&watcher.watches[i]);
+        }
+    }
+
+    atomic_store(&watcher.running, true);
+    watcher.thread = SDL_CreateThread(watch_thread, "file_watcher", NULL);
+    if (!watcher.thread) {
+        debug_printf("❌ WATCH: thread non créé (%s)\n", SDL_GetError());
+        atomic_store(&watcher.running, false);
+        file_watcher_stop();
+        return false;
+    }
+
+    debug_printf("👀 WATCH: %d chemin(s) surveillé(s) en mode %s\n", watcher.count,
+                 use_inotify ? "inotify" : "stat() périodique");
+    for (int i = 0; i < watcher.count; i++) {
+        debug_verbose("   - %s\n", watcher.watches[i].path);
+    }
+    return true;
+}
+
+void file_watcher_stop(void) {
+    if (watcher.thread) {
+        atomic_store(&watcher.running, false);
+        char byte = 0;
+        if (write(watcher.wake_pipe[1], &byte, 1) < 0) {
+            debug_printf("⚠️ WATCH: réveil du thread impossible (%s)\n", strerror(errno));
+        }
+        SDL_WaitThread(watcher.thread, NULL);
+        watcher.thread = NULL;
+
+        debug_printf("👀 WATCH: arrêté (%zu notification(s))\n", atomic_load(&watcher.notified));
+    }
+
+    if (watcher.inotify_fd >= 0) {
+        close(watcher.inotify_fd);
+        watcher.inotify_fd = -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        if (watcher.wake_pipe[i] >= 0) {
+            close(watcher.wake_pipe[i]);
+            watcher.wake_pipe[i] = -1;
+        }
+    }
+    watcher.count = 0;
+}
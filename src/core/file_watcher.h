@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SURVEILLANCE DES FICHIERS (HOT RELOAD)
+// ═══════════════════════════════════════════════════════════════════════════
+// Un thread attend les notifications inotify (Linux) et pousse un événement
+// SDL (type file_watcher_event_type, user.code = id de la surveillance) quand
+// un fichier surveillé change. Aucun appel système tant que rien ne bouge.
+//
+// - Anti-rebond : les écritures successives rapprochées (éditeur qui écrit
+//   puis renomme, sauvegarde automatique...) ne produisent qu'un événement
+// - Les répertoires parents sont surveillés : un fichier remplacé par
+//   renommage reste suivi ; un répertoire absent au démarrage, supprimé ou
+//   déplacé est surveillé par stat() et de nouveau par inotify dès qu'il
+//   réapparaît (essai toutes les FILE_WATCH_POLL_MS)
+// - Sans inotify : repli sur un stat() périodique dans le même thread
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define FILE_WATCH_MAX 8
+#define FILE_WATCH_DEBOUNCE_MS 50       // Silence requis avant de notifier
+#define FILE_WATCH_POLL_MS 500          // Intervalle du mode de repli
+
+// Type d'événement SDL des changements ((Uint32)-1 avant file_watcher_start)
+extern Uint32 file_watcher_event_type;
+
+// Ajoute un fichier (ou un répertoire entier) à surveiller, avant le démarrage.
+// Retourne l'id de la surveillance, -1 si erreur
+int file_watcher_add(const char* path, bool is_directory);
+
+// Démarre le thread de surveillance
+bool file_watcher_start(void);
+
+// Arrête le thread et oublie les surveillances
+void file_watcher_stop(void);
+
+// Chemin associé à un id (celui passé à file_watcher_add)
+const char* file_watcher_path(int id);
+
+#endif
@@ -21,22 +21,38 @@
 /* FONCTIONS UTILITAIRES CAIRO */
 /*----------------------------------------------------*/
 
+// Crée une surface Cairo dont les pixels vivent dans l'arène de frame
+// (aucun malloc : les dessins Cairo sont refaits à chaque frame)
+cairo_surface_t* create_frame_cairo_surface(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    }
+
+    int stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, width);
+    unsigned char* pixels = (stride > 0) ? FRAME_CALLOC((size_t)stride * height) : NULL;
+
+    // Fallback sur le tas si l'arène n'a pas pu s'étendre
+    if (!pixels) {
+        return cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    }
+
+    return cairo_image_surface_create_for_data(pixels, CAIRO_FORMAT_ARGB32,
+                                               width, height, stride);
+}
+
 // Crée une texture SDL depuis une surface Cairo
+// La surface SDL pointe directement sur les pixels Cairo (pas de copie)
 static SDL_Texture* texture_from_cairo(SDL_Renderer* renderer, cairo_surface_t* surface) {
     int width = cairo_image_surface_get_width(surface);
     int height = cairo_image_surface_get_height(surface);
 
-    SDL_Surface* sdl_surface = SDL_CreateRGBSurfaceWithFormat(
-        0, width, height, 32, SDL_PIXELFORMAT_ARGB8888
+    SDL_Surface* sdl_surface = SDL_CreateRGBSurfaceWithFormatFrom(
+        cairo_image_surface_get_data(surface), width, height, 32,
+        cairo_image_surface_get_stride(surface), SDL_PIXELFORMAT_ARGB8888
     );
 
     if (!sdl_surface) return NULL;
 
-    // Copier les données
-    memcpy(sdl_surface->pixels,
-           cairo_image_surface_get_data(surface),
-           height * cairo_image_surface_get_stride(surface));
-
     SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, sdl_surface);
     SDL_FreeSurface(sdl_surface);
 
@@ -66,7 +82,7 @@ void make_hexagone(SDL_Renderer *renderer, Hexagon* hex) {
     if (width <= 0 || height <= 0) return;
 
     // Créer une surface Cairo
-    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    cairo_surface_t* surface = create_frame_cairo_surface(width, height);
     cairo_t* cr = cairo_create(surface);
 
     // Activer l'antialiasing de haute qualité
@@ -362,7 +378,7 @@ void draw_triangle(SDL_Renderer *renderer, Triangle* tri) {
     if (width <= 0 || height <= 0) return;
 
     // Créer surface Cairo
-    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    cairo_surface_t* surface = create_frame_cairo_surface(width, height);
     cairo_t* cr = cairo_create(surface);
 
     cairo_set_antialias(cr, CAIRO_ANTIALIAS_BEST);
@@ -524,7 +540,7 @@ void draw_frame_rect(SDL_Renderer* renderer, int x, int y, int width, int height
     if (!renderer) return;
 
     // Créer surface Cairo
-    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    cairo_surface_t* surface = create_frame_cairo_surface(width, height);
     cairo_t* cr = cairo_create(surface);
 
     cairo_set_antialias(cr, CAIRO_ANTIALIAS_BEST);
@@ -558,7 +574,7 @@ void draw_rounded_rect(SDL_Renderer* renderer, int x, int y, int width, int heig
                        int radius, SDL_Color bg_color, SDL_Color border_color) {
     if (!renderer) return;
 
-    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    cairo_surface_t* surface = create_frame_cairo_surface(width, height);
     cairo_t* cr = cairo_create(surface);
 
     cairo_set_antialias(cr, CAIRO_ANTIALIAS_BEST);
@@ -627,7 +643,7 @@ void draw_toggle_circle(SDL_Renderer* renderer, int center_x, int center_y,
 
     int size = radius * 2 + 4;
 
-    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, size, size);
+    cairo_surface_t* surface = create_frame_cairo_surface(size, size);
     cairo_t* cr = cairo_create(surface);
 
     cairo_set_antialias(cr, CAIRO_ANTIALIAS_BEST);
@@ -5,6 +5,7 @@
 
 #include <SDL2/SDL.h>
 #include <stdbool.h>
+#include <cairo/cairo.h>
 
 // Déclaration anticipée
 typedef struct HexagoneList HexagoneList;
@@ -20,6 +21,8 @@ typedef struct Hexagon {
 } Hexagon;
 
 // Prototypes
+// Surface Cairo ARGB32 allouée dans l'arène de frame (à détruire avant la fin de la frame)
+cairo_surface_t* create_frame_cairo_surface(int width, int height);
 void make_hexagone(SDL_Renderer *renderer, Hexagon* hex);
 Hexagon* create_single_hexagon(int center_x, int center_y, int container_size, float size_ratio, unsigned char element_id);
 void recalculer_sommets(Hexagon* hex, int container_size);
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "input_coalesce.h"
+#include <stdbool.h>
+
+static size_t total_received = 0;
+static size_t total_dispatched = 0;
+
+static int sign(Sint32 value) {
+    return (value > 0) - (value < 0);
+}
+
+// Fusionne event dans last si les deux sont regroupables ; retourne true si fait
+static bool try_coalesce(SDL_Event* last, const SDL_Event* event) {
+    if (last->type != event->type) return false;
+
+    if (event->type == SDL_MOUSEMOTION) {
+        const SDL_MouseMotionEvent* motion = &event->motion;
+        if (last->motion.windowID != motion->windowID ||
+            last->motion.which != motion->which ||
+            last->motion.state != motion->state) {
+            return false;
+        }
+
+        last->motion.timestamp = motion->timestamp;
+        last->motion.x = motion->x;
+        last->motion.y = motion->y;
+        last->motion.xrel += motion->xrel;
+        last->motion.yrel += motion->yrel;
+        return true;
+    }
+
+    if (event->type == SDL_MOUSEWHEEL) {
+        const SDL_MouseWheelEvent* wheel = &event->wheel;
+        // Même sens uniquement : des crans opposés ne s'annulent pas
+        if (last->wheel.windowID != wheel->windowID ||
+            last->wheel.which != wheel->which ||
+            last->wheel.direction != wheel->direction ||
+            sign(last->wheel.x) != sign(wheel->x) ||
+            sign(last->wheel.y) != sign(wheel->y)) {
+            return false;
+        }
+
+        last->wheel.timestamp = wheel->timestamp;
+        last->wheel.x += wheel->x;
+        last->wheel.y += wheel->y;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        last->wheel.preciseX += wheel->preciseX;
+        last->wheel.preciseY += wheel->preciseY;
+#endif
+        return true;
+    }
+
+    return false;
+}
+
+int input_poll_coalesced(SDL_Event* events, int capacity) {
+    int count = 0;
+    SDL_Event event;
+
+    // Lot plein : les événements restants attendent la frame suivante
+    while (count < capacity && SDL_PollEvent(&event)) {
+        total_received++;
+
+        if (count > 0 && try_coalesce(&events[count - 1], &event)) {
+            continue;
+        }
+        events[count++] = event;
+    }
+
+    total_dispatched += (size_t)count;
+    return count;
+}
+
+void input_coalesce_stats(size_t* received, size_t* dispatched) {
+    if (received) *received = total_received;
+    if (dispatched) *dispatched = total_dispatched;
+}
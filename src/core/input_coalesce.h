@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef INPUT_COALESCE_H
+#define INPUT_COALESCE_H
+
+#include <SDL2/SDL.h>
+#include <stddef.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REGROUPEMENT DES ÉVÉNEMENTS SOURIS (PRÉ-PASSE PAR FRAME)
+// ═══════════════════════════════════════════════════════════════════════════
+// Une souris à haute fréquence d'échantillonnage remplit la file de centaines
+// de SDL_MOUSEMOTION par frame. Avant le dispatch, la file est vidée dans un
+// lot où :
+//   - les mouvements consécutifs (même fenêtre, mêmes boutons) ne gardent que
+//     la dernière position, les déplacements relatifs étant cumulés
+//   - les crans de molette consécutifs de même sens sont additionnés
+//   - clics, clavier et tout le reste gardent leur place et leur ordre
+//
+// Les consommateurs de la molette appliquent wheel.y cran par cran.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define INPUT_BATCH_MAX 256     // Au-delà, le reste attend la frame suivante
+
+// Vide la file SDL dans events ; retourne le nombre d'événements à traiter
+int input_poll_coalesced(SDL_Event* events, int capacity);
+
+// Totaux depuis le démarrage (reçus de SDL / transmis après regroupement)
+void input_coalesce_stats(size_t* received, size_t* dispatched);
+
+#endif
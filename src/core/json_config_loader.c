@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // json_config_loader.c
 #include "json_config_loader.h"
+#include "widget_layout_cache.h"
 //#include "settings_panel.h"
 #include "debug.h"
 #include <cjson/cJSON.h>
@@ -95,8 +96,35 @@ static void (*obtenir_callback_void(const char* nom))(void) {
     return NULL;
 }
 
-//  PARSING D'UN WIDGET INCREMENT
-bool parser_widget_increment(cJSON* json_obj, LoaderContext* ctx, WidgetList* list) {
+// ═══════════════════════════════════════════════════════════════════════════
+// ÉTAPE 1 : JSON → DESCRIPTIONS (WidgetSpec)
+// ═══════════════════════════════════════════════════════════════════════════
+// Validation et valeurs par défaut faites ici, une seule fois : le résultat
+// est mis en cache et la construction ne relit plus le JSON.
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Lit une couleur {r,g,b,a} optionnelle (les champs absents gardent le défaut)
+static SDL_Color lire_couleur(cJSON* couleur, SDL_Color defaut) {
+    SDL_Color color = defaut;
+    if (cJSON_IsObject(couleur)) {
+        cJSON* r = cJSON_GetObjectItem(couleur, "r");
+        cJSON* g = cJSON_GetObjectItem(couleur, "g");
+        cJSON* b = cJSON_GetObjectItem(couleur, "b");
+        cJSON* a = cJSON_GetObjectItem(couleur, "a");
+        if (cJSON_IsNumber(r)) color.r = r->valueint;
+        if (cJSON_IsNumber(g)) color.g = g->valueint;
+        if (cJSON_IsNumber(b)) color.b = b->valueint;
+        if (cJSON_IsNumber(a)) color.a = a->valueint;
+    }
+    return color;
+}
+
+static uint32_t lire_chaine(WidgetLayout* layout, cJSON* item) {
+    return cJSON_IsString(item) ? widget_layout_intern(layout, item->valuestring) : 0;
+}
+
+//  DESCRIPTION D'UN WIDGET INCREMENT
+static bool lire_spec_increment(cJSON* json_obj, WidgetLayout* layout) {
     // Récupération des champs obligatoires
     cJSON* id = cJSON_GetObjectItem(json_obj, "id");
     cJSON* nom_affichage = cJSON_GetObjectItem(json_obj, "nom_affichage");
@@ -121,46 +149,27 @@ bool parser_widget_increment(cJSON* json_obj, LoaderContext* ctx, WidgetList* li
         return false;
     }
 
-    // Récupération du callback
-    void (*callback_func)(int) = NULL;
-    if (cJSON_IsString(callback)) {
-        callback_func = obtenir_callback_int(callback->valuestring);
-    }
-
-    // Récupération du type d'affichage (par défaut "numeric")
-    const char* display_type = NULL;
-    if (cJSON_IsString(widget_display_type)) {
-        display_type = widget_display_type->valuestring;
-    }
-
-    // Création du widget
-    bool success = add_increment_widget(
-        list,
-        id->valuestring,
-        nom_affichage->valuestring,
-        x->valueint,
-        y->valueint,
-        valeur_min->valueint,
-        valeur_max->valueint,
-        valeur_depart->valueint,
-        cJSON_IsNumber(increment) ? increment->valueint : 1,
-        cJSON_IsNumber(taille_texte) ? taille_texte->valueint : 18,
-        ctx->font_normal,
-        callback_func,
-        display_type
-    );
-
-    if (success) {
-        debug_printf("✅ Widget increment '%s' chargé depuis JSON\n", id->valuestring);
-    }
-
-    return success;
+    WidgetSpec* spec = widget_layout_add(layout, WIDGET_SPEC_INCREMENT);
+    if (!spec) return false;
+
+    spec->x = x->valueint;
+    spec->y = y->valueint;
+    spec->u.increment.min = valeur_min->valueint;
+    spec->u.increment.max = valeur_max->valueint;
+    spec->u.increment.start = valeur_depart->valueint;
+    spec->u.increment.step = cJSON_IsNumber(increment) ? increment->valueint : 1;
+    spec->u.increment.text_size = cJSON_IsNumber(taille_texte) ? taille_texte->valueint : 18;
+
+    // widget_layout_intern() ne déplace que layout->strings : spec reste valide
+    spec->id = lire_chaine(layout, id);
+    spec->label = lire_chaine(layout, nom_affichage);
+    spec->callback = lire_chaine(layout, callback);
+    spec->u.increment.display_type = lire_chaine(layout, widget_display_type);
+    return true;
 }
 
-//  PARSING D'UN WIDGET TOGGLE
-bool parser_widget_toggle(cJSON* json_obj, LoaderContext* ctx, WidgetList* list) {
-    (void)ctx;  // Paramètre non utilisé
-
+//  DESCRIPTION D'UN WIDGET TOGGLE
+static bool lire_spec_toggle(cJSON* json_obj, WidgetLayout* layout) {
     // Récupération des champs
     cJSON* id = cJSON_GetObjectItem(json_obj, "id");
     cJSON* nom_affichage = cJSON_GetObjectItem(json_obj, "nom_affichage");
@@ -180,40 +189,25 @@ bool parser_widget_toggle(cJSON* json_obj, LoaderContext* ctx, WidgetList* list)
         return false;
     }
 
-    // Récupération du callback
-    void (*callback_func)(bool) = NULL;
-    if (cJSON_IsString(callback)) {
-        callback_func = obtenir_callback_bool(callback->valuestring);
-    }
-
-    // Création du widget
-    bool success = add_toggle_widget(
-        list,
-        id->valuestring,
-        nom_affichage->valuestring,
-        x->valueint,
-        y->valueint,
-        cJSON_IsBool(etat_depart) ? cJSON_IsTrue(etat_depart) : false,
-        cJSON_IsNumber(largeur_toggle) ? largeur_toggle->valueint : 40,
-        cJSON_IsNumber(hauteur_toggle) ? hauteur_toggle->valueint : 18,
-        cJSON_IsNumber(taille_curseur) ? taille_curseur->valueint : 18,
-        cJSON_IsNumber(taille_texte) ? taille_texte->valueint : 18,
-        callback_func
-    );
+    WidgetSpec* spec = widget_layout_add(layout, WIDGET_SPEC_TOGGLE);
+    if (!spec) return false;
 
-    if (success) {
-        debug_printf("✅ Widget toggle '%s' chargé depuis JSON\n", id->valuestring);
-    }
+    spec->x = x->valueint;
+    spec->y = y->valueint;
+    spec->u.toggle.start_state = cJSON_IsBool(etat_depart) ? cJSON_IsTrue(etat_depart) : false;
+    spec->u.toggle.width = cJSON_IsNumber(largeur_toggle) ? largeur_toggle->valueint : 40;
+    spec->u.toggle.height = cJSON_IsNumber(hauteur_toggle) ? hauteur_toggle->valueint : 18;
+    spec->u.toggle.thumb_size = cJSON_IsNumber(taille_curseur) ? taille_curseur->valueint : 18;
+    spec->u.toggle.text_size = cJSON_IsNumber(taille_texte) ? taille_texte->valueint : 18;
 
-    return success;
+    spec->id = lire_chaine(layout, id);
+    spec->label = lire_chaine(layout, nom_affichage);
+    spec->callback = lire_chaine(layout, callback);
+    return true;
 }
-//  PARSING D'UN TITRE (éléments statiques)
-bool parser_titre(void* json_obj, LoaderContext* ctx, WidgetList* list) {
-    if (!json_obj || !ctx || !list) return false;
-
-    // Cast du void* vers cJSON*
-    cJSON* obj = (cJSON*)json_obj;
 
+//  DESCRIPTION D'UN TITRE (éléments statiques)
+static bool lire_spec_titre(cJSON* obj, WidgetLayout* layout) {
     // Récupération des champs
     cJSON* texte = cJSON_GetObjectItem(obj, "texte");
     cJSON* x = cJSON_GetObjectItem(obj, "x");
@@ -228,11 +222,6 @@ bool parser_titre(void* json_obj, LoaderContext* ctx, WidgetList* list) {
         return false;
     }
 
-    // Paramètres
-    int text_size = cJSON_IsNumber(taille) ? taille->valueint : 24;
-    bool underlined = (cJSON_IsBool(souligne) && cJSON_IsTrue(souligne));
-    SDL_Color color = {0, 0, 0, 255};  // Noir par défaut
-
     // Parser l'alignement
     LabelAlignment alignment = LABEL_ALIGN_CENTER;  // Par défaut centré
     if (cJSON_IsString(alignement)) {
@@ -246,70 +235,21 @@ bool parser_titre(void* json_obj, LoaderContext* ctx, WidgetList* list) {
         }
     }
 
-    // ═══════════════════════════════════════════════════════════════════════
-    // CALCULER LA POSITION X FINALE SELON L'ALIGNEMENT
-    // ═══════════════════════════════════════════════════════════════════════
-    int x_final = x->valueint;  // Par défaut, utiliser la valeur du JSON
+    WidgetSpec* spec = widget_layout_add(layout, WIDGET_SPEC_TITRE);
+    if (!spec) return false;
 
-    if (alignment == LABEL_ALIGN_CENTER) {
-        // Pour CENTER, calculer la position pour centrer le texte dans la largeur du panneau
-        TTF_Font* font = ctx->font_titre;  // Police pour les titres
-        if (font) {
-            int text_width = 0;
-            if (TTF_SizeUTF8(font, texte->valuestring, &text_width, NULL) == 0) {
-                x_final = (ctx->panel_width - text_width) / 2;
-                debug_printf("📐 LABEL CENTER '%s': largeur=%d, x_calculé=%d (panel_width=%d)\n",
-                            texte->valuestring, text_width, x_final, ctx->panel_width);
-            } else {
-                debug_printf("⚠️ Impossible de mesurer '%s', x=%d par défaut\n",
-                            texte->valuestring, x_final);
-            }
-        }
-    } else if (alignment == LABEL_ALIGN_RIGHT) {
-        // Pour RIGHT, calculer depuis le bord droit
-        TTF_Font* font = ctx->font_titre;
-        if (font) {
-            int text_width = 0;
-            if (TTF_SizeUTF8(font, texte->valuestring, &text_width, NULL) == 0) {
-                x_final = ctx->panel_width - text_width - 20;  // 20px de marge
-                debug_printf("📐 LABEL RIGHT '%s': largeur=%d, x_calculé=%d (panel_width=%d)\n",
-                            texte->valuestring, text_width, x_final, ctx->panel_width);
-            }
-        }
-    }
-    // Pour LEFT, garder x_final = x->valueint (pas de calcul)
-
-    // ═══ AJOUTER À LA WIDGET LIST ═══
-    // Générer un id unique pour le titre
-    char id[50];
-    snprintf(id, sizeof(id), "titre_%d", list->count);
-
-    bool success = add_label_widget(
-        list,
-        id,
-        texte->valuestring,
-        x_final,  // ← Utiliser x_final calculé au lieu de x->valueint
-        y->valueint,
-        text_size,
-        color,
-        underlined,
-        alignment
-    );
-
-    if (success) {
-        debug_printf("✅ Titre '%s' ajouté à la liste\n", texte->valuestring);
-    }
+    spec->x = x->valueint;
+    spec->y = y->valueint;
+    spec->u.titre.text_size = cJSON_IsNumber(taille) ? taille->valueint : 24;
+    spec->u.titre.underlined = (cJSON_IsBool(souligne) && cJSON_IsTrue(souligne));
+    spec->u.titre.alignment = alignment;
 
-    return success;
+    spec->label = lire_chaine(layout, texte);
+    return true;
 }
 
-//  PARSING D'UN SÉPARATEUR (éléments statiques)
-bool parser_separateur(void* json_obj, LoaderContext* ctx, WidgetList* list) {
-    if (!json_obj || !ctx || !list) return false;
-
-    // Cast du void* vers cJSON*
-    cJSON* obj = (cJSON*)json_obj;
-
+//  DESCRIPTION D'UN SÉPARATEUR (éléments statiques)
+static bool lire_spec_separateur(cJSON* obj, WidgetLayout* layout) {
     // Récupération des champs
     cJSON* x = cJSON_GetObjectItem(obj, "x");
     cJSON* y = cJSON_GetObjectItem(obj, "y");
@@ -323,58 +263,21 @@ bool parser_separateur(void* json_obj, LoaderContext* ctx, WidgetList* list) {
         return false;
     }
 
-    // Paramètres
-    int x_val = x->valueint;
-    int y_val = y->valueint;
-    int width = cJSON_IsNumber(largeur) ? largeur->valueint : 460;
-    int thickness = cJSON_IsNumber(hauteur) ? hauteur->valueint : 1;
-
-    // Couleur par défaut : gris clair
-    SDL_Color color = {200, 200, 200, 255};
-    if (cJSON_IsObject(couleur)) {
-        cJSON* r = cJSON_GetObjectItem(couleur, "r");
-        cJSON* g = cJSON_GetObjectItem(couleur, "g");
-        cJSON* b = cJSON_GetObjectItem(couleur, "b");
-        cJSON* a = cJSON_GetObjectItem(couleur, "a");
-        if (cJSON_IsNumber(r)) color.r = r->valueint;
-        if (cJSON_IsNumber(g)) color.g = g->valueint;
-        if (cJSON_IsNumber(b)) color.b = b->valueint;
-        if (cJSON_IsNumber(a)) color.a = a->valueint;
-    }
-
-    // ═══ CONVERTIR x,largeur EN marges ═══
-    // add_separator_widget() attend start_margin et end_margin
-    // Avec PANEL_WIDTH = 500 (largeur de référence du panneau)
-    const int PANEL_WIDTH = 500;
-    int start_margin = x_val;
-    int end_margin = PANEL_WIDTH - (x_val + width);
+    WidgetSpec* spec = widget_layout_add(layout, WIDGET_SPEC_SEPARATEUR);
+    if (!spec) return false;
 
-    // Générer un id unique
-    char id[50];
-    snprintf(id, sizeof(id), "sep_%d", list->count);
+    spec->x = x->valueint;
+    spec->y = y->valueint;
+    spec->u.separateur.width = cJSON_IsNumber(largeur) ? largeur->valueint : 460;
+    spec->u.separateur.thickness = cJSON_IsNumber(hauteur) ? hauteur->valueint : 1;
 
-    // ═══ AJOUTER À LA WIDGET LIST ═══
-    bool success = add_separator_widget(
-        list,
-        id,
-        y_val,
-        start_margin,
-        end_margin,
-        thickness,
-        color
-    );
-
-    if (success) {
-        debug_printf("✅ Séparateur ajouté à la liste\n");
-    }
-
-    return success;
+    // Couleur par défaut : gris clair
+    spec->u.separateur.color = lire_couleur(couleur, (SDL_Color){200, 200, 200, 255});
+    return true;
 }
 
-//  PARSING D'UN WIDGET PREVIEW
-bool parser_widget_preview(cJSON* json_obj, LoaderContext* ctx, WidgetList* list) {
-    if (!json_obj || !ctx || !list) return false;
-
+//  DESCRIPTION D'UN WIDGET PREVIEW
+static bool lire_spec_preview(cJSON* json_obj, WidgetLayout* layout) {
     // Récupération des champs
     cJSON* id = cJSON_GetObjectItem(json_obj, "id");
     cJSON* x = cJSON_GetObjectItem(json_obj, "x");
@@ -389,33 +292,22 @@ bool parser_widget_preview(cJSON* json_obj, LoaderContext* ctx, WidgetList* list
         return false;
     }
 
-    // Valeurs par défaut
-    int size = cJSON_IsNumber(frame_size) ? frame_size->valueint : 100;
-    float ratio = cJSON_IsNumber(size_ratio) ? (float)size_ratio->valuedouble : 0.90f;
-    float duration = cJSON_IsNumber(breath_duration) ? (float)breath_duration->valuedouble : 3.0f;
-
-    // Création du widget
-    bool success = add_preview_widget(
-        list,
-        id->valuestring,
-        x->valueint,
-        y->valueint,
-        size,
-        ratio,
-        duration
-    );
+    WidgetSpec* spec = widget_layout_add(layout, WIDGET_SPEC_PREVIEW);
+    if (!spec) return false;
 
-    if (success) {
-        debug_printf("✅ Widget preview '%s' chargé depuis JSON\n", id->valuestring);
-    }
+    // Valeurs par défaut
+    spec->x = x->valueint;
+    spec->y = y->valueint;
+    spec->u.preview.frame_size = cJSON_IsNumber(frame_size) ? frame_size->valueint : 100;
+    spec->u.preview.size_ratio = cJSON_IsNumber(size_ratio) ? (float)size_ratio->valuedouble : 0.90f;
+    spec->u.preview.breath_duration = cJSON_IsNumber(breath_duration) ? (float)breath_duration->valuedouble : 3.0f;
 
-    return success;
+    spec->id = lire_chaine(layout, id);
+    return true;
 }
 
-//  PARSING D'UN WIDGET BUTTON
-bool parser_widget_button(cJSON* json_obj, LoaderContext* ctx, WidgetList* list) {
-    if (!json_obj || !ctx || !list) return false;
-
+//  DESCRIPTION D'UN WIDGET BUTTON
+static bool lire_spec_button(cJSON* json_obj, WidgetLayout* layout) {
     // Récupération des champs
     cJSON* id = cJSON_GetObjectItem(json_obj, "id");
     cJSON* texte = cJSON_GetObjectItem(json_obj, "texte");
@@ -436,62 +328,34 @@ bool parser_widget_button(cJSON* json_obj, LoaderContext* ctx, WidgetList* list)
         return false;
     }
 
+    WidgetSpec* spec = widget_layout_add(layout, WIDGET_SPEC_BUTTON);
+    if (!spec) return false;
+
+    spec->x = x->valueint;
+    spec->y = y->valueint;
+    spec->u.button.width = largeur->valueint;
+    spec->u.button.height = hauteur->valueint;
+
     // Taille de texte par défaut
-    int text_size = cJSON_IsNumber(taille_texte) ? taille_texte->valueint : 16;
+    spec->u.button.text_size = cJSON_IsNumber(taille_texte) ? taille_texte->valueint : 16;
 
     // Couleur de fond par défaut : bleu
-    SDL_Color bg_color = {70, 130, 180, 255};
-    if (cJSON_IsObject(couleur)) {
-        cJSON* r = cJSON_GetObjectItem(couleur, "r");
-        cJSON* g = cJSON_GetObjectItem(couleur, "g");
-        cJSON* b = cJSON_GetObjectItem(couleur, "b");
-        cJSON* a = cJSON_GetObjectItem(couleur, "a");
-        if (cJSON_IsNumber(r)) bg_color.r = r->valueint;
-        if (cJSON_IsNumber(g)) bg_color.g = g->valueint;
-        if (cJSON_IsNumber(b)) bg_color.b = b->valueint;
-        if (cJSON_IsNumber(a)) bg_color.a = a->valueint;
-    }
+    spec->u.button.color = lire_couleur(couleur, (SDL_Color){70, 130, 180, 255});
 
     // Ancrage Y (par défaut TOP)
-    ButtonYAnchor y_anchor = BUTTON_ANCHOR_TOP;
-    if (cJSON_IsString(y_anchor_json)) {
-        if (strcmp(y_anchor_json->valuestring, "bottom") == 0) {
-            y_anchor = BUTTON_ANCHOR_BOTTOM;
-        }
-    }
-
-    // Récupération du callback
-    void (*callback_func)(void) = NULL;
-    if (cJSON_IsString(callback)) {
-        callback_func = obtenir_callback_void(callback->valuestring);
-    }
-
-    // Création du widget
-    bool success = add_button_widget(
-        list,
-        id->valuestring,
-        texte->valuestring,
-        x->valueint,
-        y->valueint,
-        largeur->valueint,
-        hauteur->valueint,
-        text_size,
-        bg_color,
-        y_anchor,
-        callback_func
-    );
-
-    if (success) {
-        debug_printf("✅ Widget button '%s' chargé depuis JSON\n", id->valuestring);
+    spec->u.button.y_anchor = BUTTON_ANCHOR_TOP;
+    if (cJSON_IsString(y_anchor_json) && strcmp(y_anchor_json->valuestring, "bottom") == 0) {
+        spec->u.button.y_anchor = BUTTON_ANCHOR_BOTTOM;
     }
 
-    return success;
+    spec->id = lire_chaine(layout, id);
+    spec->label = lire_chaine(layout, texte);
+    spec->callback = lire_chaine(layout, callback);
+    return true;
 }
 
-//  PARSING D'UN WIDGET SELECTOR
-bool parser_widget_selector(cJSON* json_obj, LoaderContext* ctx, WidgetList* list) {
-    (void)ctx;  // Paramètre non utilisé
-
+//  DESCRIPTION D'UN WIDGET SELECTOR
+static bool lire_spec_selector(cJSON* json_obj, WidgetLayout* layout) {
     // Récupération des champs obligatoires
     cJSON* id = cJSON_GetObjectItem(json_obj, "id");
     cJSON* nom_affichage = cJSON_GetObjectItem(json_obj, "nom_affichage");
@@ -515,108 +379,39 @@ bool parser_widget_selector(cJSON* json_obj, LoaderContext* ctx, WidgetList* lis
     if (!is_roller_mode && !cJSON_IsArray(options_array)) {
         debug_printf("❌ Widget selector invalide : options manquantes (mode classique)\n");
         return false;
-        }
-
-        // Valeurs par défaut
-        int default_index = cJSON_IsNumber(index_depart) ? index_depart->valueint : 0;
-        int arrow_size = 6;  // Taille fixe des flèches
-        int text_size = cJSON_IsNumber(taille_texte) ? taille_texte->valueint : 14;
-
-        // ─────────────────────────────────────────────────────────────────────────
-        // CRÉATION DU WIDGET SELECTOR
-        // ─────────────────────────────────────────────────────────────────────────
-        bool success = add_selector_widget(
-            list,
-            id->valuestring,
-            nom_affichage->valuestring,
-            x->valueint,
-            y->valueint,
-            default_index,
-            arrow_size,
-            text_size,
-            ctx->font_normal  // ← Police pour le rendu du texte
-        );
-
-        if (!success) {
-            debug_printf("❌ Échec création SelectorWidget '%s'\n", id->valuestring);
-            return false;
-        }
-
-        // ─────────────────────────────────────────────────────────────────────────
-        // RÉCUPÉRATION DU WIDGET POUR AJOUTER LES OPTIONS
-        // ─────────────────────────────────────────────────────────────────────────
-        WidgetNode* node = find_widget_by_id(list, id->valuestring);
-        if (!node || !node->widget.selector_widget) {
-            debug_printf("❌ Widget selector '%s' introuvable après création\n", id->valuestring);
-            return false;
-        }
-
-        SelectorWidget* selector = node->widget.selector_widget;
-
-        // ─────────────────────────────────────────────────────────────────────────
-        // CHARGER LES DONNÉES ROLLER (TOUJOURS, même en mode classique)
-        // ─────────────────────────────────────────────────────────────────────────
-        // Ces données sont nécessaires pour activer dynamiquement le submenu
-        // lorsque l'utilisateur sélectionne l'option "Alterné"
-        cJSON* seq1_type = cJSON_GetObjectItem(json_obj, "roller_seq1_type_default");
-        cJSON* seq1_count = cJSON_GetObjectItem(json_obj, "roller_seq1_count_default");
-        cJSON* seq2_type = cJSON_GetObjectItem(json_obj, "roller_seq2_type_default");
-        cJSON* seq2_count = cJSON_GetObjectItem(json_obj, "roller_seq2_count_default");
-
-        selector->seq1_type = (seq1_type && cJSON_IsNumber(seq1_type)) ? seq1_type->valueint : 1;
-        selector->seq1_count = (seq1_count && cJSON_IsNumber(seq1_count)) ? seq1_count->valueint : 1;
-        selector->seq2_type = (seq2_type && cJSON_IsNumber(seq2_type)) ? seq2_type->valueint : 0;
-        selector->seq2_count = (seq2_count && cJSON_IsNumber(seq2_count)) ? seq2_count->valueint : 2;
-
-        // Charger le callback roller (avec 4 paramètres)
-        cJSON* roller_callback_name = cJSON_GetObjectItem(json_obj, "roller_callback");
-        if (roller_callback_name && cJSON_IsString(roller_callback_name)) {
-            // Mapper le nom vers la fonction
-            if (strcmp(roller_callback_name->valuestring, "retention_roller_changed") == 0) {
-                // Déclaration externe du callback
-                extern void retention_roller_changed(int, int, int, int);
-                selector->roller_callback = retention_roller_changed;
-                debug_printf("✅ Callback roller '%s' défini\n", roller_callback_name->valuestring);
-            }
-        }
-
-        debug_printf("🔧 Données roller chargées: seq1=%d×%d, seq2=%d×%d, callback=%s\n",
-                     selector->seq1_count, selector->seq1_type,
-                     selector->seq2_count, selector->seq2_type,
-                     selector->roller_callback ? "OUI" : "NON");
-
-        // ─────────────────────────────────────────────────────────────────────────
-        // VÉRIFIER LE MODE ROLLER (sous-menu personnalisé)
-        // ─────────────────────────────────────────────────────────────────────────
-        // submenu_enabled déjà déclaré ligne 503
-        if (submenu_enabled && cJSON_IsTrue(submenu_enabled)) {
-            // Mode roller-only activé (ancien comportement, obsolète)
-            selector->submenu_enabled = true;
-
-            debug_printf("✅ Selector '%s' en mode roller-only (layout initialisé)\n",
-                         id->valuestring);
-
-            // ─────────────────────────────────────────────────────────────────────────
-            // INITIALISATION DU LAYOUT (créer flèches et zones cliquables)
-            // IMPORTANT: Doit être fait même en mode roller pour initialiser les flèches
-            // ─────────────────────────────────────────────────────────────────────────
-            rescale_selector_widget(selector, 1.0f);
-
-            // Skip le parsing des options en mode roller-only
-            return true;
-        }
-
-        // ─────────────────────────────────────────────────────────────────────────
-        // MODE CLASSIQUE : submenu désactivé par défaut, sera activé dynamiquement
-        // ─────────────────────────────────────────────────────────────────────────
-        selector->submenu_enabled = false;
+    }
 
-        // ─────────────────────────────────────────────────────────────────────────
-        // PARSING DU TABLEAU D'OPTIONS (mode classique uniquement)
-        // ─────────────────────────────────────────────────────────────────────────
+    // Données roller (TOUJOURS, même en mode classique) : nécessaires pour
+    // activer dynamiquement le submenu quand l'utilisateur choisit "Alterné"
+    cJSON* seq1_type = cJSON_GetObjectItem(json_obj, "roller_seq1_type_default");
+    cJSON* seq1_count = cJSON_GetObjectItem(json_obj, "roller_seq1_count_default");
+    cJSON* seq2_type = cJSON_GetObjectItem(json_obj, "roller_seq2_type_default");
+    cJSON* seq2_count = cJSON_GetObjectItem(json_obj, "roller_seq2_count_default");
+    cJSON* roller_callback_name = cJSON_GetObjectItem(json_obj, "roller_callback");
+
+    // Les options ajoutées ensuite n'agrandissent que layout->options et
+    // layout->strings : le pointeur spec reste valide
+    WidgetSpec* spec = widget_layout_add(layout, WIDGET_SPEC_SELECTOR);
+    if (!spec) return false;
+
+    spec->x = x->valueint;
+    spec->y = y->valueint;
+    spec->u.selector.default_index = cJSON_IsNumber(index_depart) ? index_depart->valueint : 0;
+    spec->u.selector.text_size = cJSON_IsNumber(taille_texte) ? taille_texte->valueint : 14;
+    spec->u.selector.submenu_enabled = is_roller_mode;
+    spec->u.selector.seq1_type = cJSON_IsNumber(seq1_type) ? seq1_type->valueint : 1;
+    spec->u.selector.seq1_count = cJSON_IsNumber(seq1_count) ? seq1_count->valueint : 1;
+    spec->u.selector.seq2_type = cJSON_IsNumber(seq2_type) ? seq2_type->valueint : 0;
+    spec->u.selector.seq2_count = cJSON_IsNumber(seq2_count) ? seq2_count->valueint : 2;
+
+    spec->id = lire_chaine(layout, id);
+    spec->label = lire_chaine(layout, nom_affichage);
+    spec->u.selector.roller_callback = lire_chaine(layout, roller_callback_name);
+    spec->u.selector.first_option = layout->option_count;
+
+    // Options (mode classique uniquement)
+    if (!is_roller_mode) {
         int num_options = cJSON_GetArraySize(options_array);
-        debug_printf("📋 Parsing de %d options pour selector '%s'\n", num_options, id->valuestring);
-
         for (int i = 0; i < num_options; i++) {
             cJSON* option = cJSON_GetArrayItem(options_array, i);
             if (!cJSON_IsObject(option)) {
@@ -633,47 +428,462 @@ bool parser_widget_selector(cJSON* json_obj, LoaderContext* ctx, WidgetList* lis
                 continue;
             }
 
-            // Ajouter l'option au widget
-            bool added = add_selector_option(selector, texte->valuestring, callback_name->valuestring);
-            if (!added) {
-                debug_printf("⚠️ Impossible d'ajouter option '%s'\n", texte->valuestring);
-                continue;
+            if (!widget_layout_add_option(layout, texte->valuestring, callback_name->valuestring)) {
+                return false;
             }
+        }
+    }
+
+    spec->u.selector.option_count = layout->option_count - spec->u.selector.first_option;
+    return true;
+}
+
+// Ajoute la description d'un élément du tableau "widgets"
+static bool lire_spec_widget(cJSON* widget, int index, WidgetLayout* layout) {
+    // Récupérer le type
+    cJSON* type = cJSON_GetObjectItem(widget, "type");
+    if (!cJSON_IsString(type)) {
+        debug_printf("⚠️ Widget %d sans type valide\n", index);
+        return false;
+    }
+
+    const char* type_str = type->valuestring;
+    debug_printf("🔍 Traitement widget %d de type '%s'\n", index, type_str);
+
+    if (strcmp(type_str, "increment") == 0) return lire_spec_increment(widget, layout);
+    if (strcmp(type_str, "toggle") == 0) return lire_spec_toggle(widget, layout);
+    if (strcmp(type_str, "titre") == 0) return lire_spec_titre(widget, layout);
+    if (strcmp(type_str, "separateur") == 0) return lire_spec_separateur(widget, layout);
+    if (strcmp(type_str, "preview") == 0) return lire_spec_preview(widget, layout);
+    if (strcmp(type_str, "button") == 0) return lire_spec_button(widget, layout);
+    if (strcmp(type_str, "selector") == 0) return lire_spec_selector(widget, layout);
+
+    debug_printf("⚠️ Type de widget inconnu: '%s'\n", type_str);
+    return false;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ÉTAPE 2 : DESCRIPTIONS → WIDGETS
+// ═══════════════════════════════════════════════════════════════════════════
+// Ce qui dépend du contexte (polices, largeur du panneau, callbacks) est
+// résolu ici, à chaque construction : le cache reste valable quel que soit
+// l'écran.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define SPEC_STR(field) widget_layout_string(layout, spec->field)
+
+static bool construire_increment(const WidgetLayout* layout, const WidgetSpec* spec,
+                                 LoaderContext* ctx, WidgetList* list) {
+    bool success = add_increment_widget(
+        list,
+        SPEC_STR(id),
+        SPEC_STR(label),
+        spec->x,
+        spec->y,
+        spec->u.increment.min,
+        spec->u.increment.max,
+        spec->u.increment.start,
+        spec->u.increment.step,
+        spec->u.increment.text_size,
+        ctx->font_normal,
+        obtenir_callback_int(SPEC_STR(callback)),
+        SPEC_STR(u.increment.display_type)
+    );
+
+    if (success) {
+        debug_printf("✅ Widget increment '%s' chargé\n", SPEC_STR(id));
+    }
+    return success;
+}
+
+static bool construire_toggle(const WidgetLayout* layout, const WidgetSpec* spec,
+                              LoaderContext* ctx, WidgetList* list) {
+    (void)ctx;  // Paramètre non utilisé
+
+    bool success = add_toggle_widget(
+        list,
+        SPEC_STR(id),
+        SPEC_STR(label),
+        spec->x,
+        spec->y,
+        spec->u.toggle.start_state != 0,
+        spec->u.toggle.width,
+        spec->u.toggle.height,
+        spec->u.toggle.thumb_size,
+        spec->u.toggle.text_size,
+        obtenir_callback_bool(SPEC_STR(callback))
+    );
+
+    if (success) {
+        debug_printf("✅ Widget toggle '%s' chargé\n", SPEC_STR(id));
+    }
+    return success;
+}
+
+static bool construire_titre(const WidgetLayout* layout, const WidgetSpec* spec,
+                             LoaderContext* ctx, WidgetList* list) {
+    const char* texte = SPEC_STR(label);
+    LabelAlignment alignment = (LabelAlignment)spec->u.titre.alignment;
+    SDL_Color color = {0, 0, 0, 255};  // Noir par défaut
 
-            // Récupérer le callback VOID associé
-            void (*callback_func)(void) = obtenir_callback_void(callback_name->valuestring);
-            if (callback_func) {
-                set_selector_option_callback(selector, i, callback_func);
-                debug_printf("✅ Option '%s' → callback '%s' défini\n",
-                             texte->valuestring, callback_name->valuestring);
+    // ═══════════════════════════════════════════════════════════════════════
+    // CALCULER LA POSITION X FINALE SELON L'ALIGNEMENT
+    // ═══════════════════════════════════════════════════════════════════════
+    int x_final = spec->x;  // Par défaut, utiliser la valeur du JSON
+
+    if (alignment == LABEL_ALIGN_CENTER) {
+        // Pour CENTER, calculer la position pour centrer le texte dans la largeur du panneau
+        TTF_Font* font = ctx->font_titre;  // Police pour les titres
+        if (font) {
+            int text_width = 0;
+            if (TTF_SizeUTF8(font, texte, &text_width, NULL) == 0) {
+                x_final = (ctx->panel_width - text_width) / 2;
+                debug_printf("📐 LABEL CENTER '%s': largeur=%d, x_calculé=%d (panel_width=%d)\n",
+                            texte, text_width, x_final, ctx->panel_width);
             } else {
-                debug_printf("⚠️ Callback '%s' introuvable pour option '%s'\n",
-                             callback_name->valuestring, texte->valuestring);
+                debug_printf("⚠️ Impossible de mesurer '%s', x=%d par défaut\n",
+                            texte, x_final);
+            }
+        }
+    } else if (alignment == LABEL_ALIGN_RIGHT) {
+        // Pour RIGHT, calculer depuis le bord droit
+        TTF_Font* font = ctx->font_titre;
+        if (font) {
+            int text_width = 0;
+            if (TTF_SizeUTF8(font, texte, &text_width, NULL) == 0) {
+                x_final = ctx->panel_width - text_width - 20;  // 20px de marge
+                debug_printf("📐 LABEL RIGHT '%s': largeur=%d, x_calculé=%d (panel_width=%d)\n",
+                            texte, text_width, x_final, ctx->panel_width);
             }
         }
+    }
+    // Pour LEFT, garder x_final = spec->x (pas de calcul)
+
+    // ═══ AJOUTER À LA WIDGET LIST ═══
+    // Générer un id unique pour le titre
+    char id[50];
+    snprintf(id, sizeof(id), "titre_%d", list->count);
+
+    bool success = add_label_widget(
+        list,
+        id,
+        texte,
+        x_final,
+        spec->y,
+        spec->u.titre.text_size,
+        color,
+        spec->u.titre.underlined != 0,
+        alignment
+    );
+
+    if (success) {
+        debug_printf("✅ Titre '%s' ajouté à la liste\n", texte);
+    }
+    return success;
+}
+
+static bool construire_separateur(const WidgetLayout* layout, const WidgetSpec* spec,
+                                  LoaderContext* ctx, WidgetList* list) {
+    (void)layout;
+    (void)ctx;
+
+    // ═══ CONVERTIR x,largeur EN marges ═══
+    // add_separator_widget() attend start_margin et end_margin
+    // Avec PANEL_WIDTH = 500 (largeur de référence du panneau)
+    const int PANEL_WIDTH = 500;
+    int start_margin = spec->x;
+    int end_margin = PANEL_WIDTH - (spec->x + spec->u.separateur.width);
+
+    // Générer un id unique
+    char id[50];
+    snprintf(id, sizeof(id), "sep_%d", list->count);
+
+    // ═══ AJOUTER À LA WIDGET LIST ═══
+    bool success = add_separator_widget(
+        list,
+        id,
+        spec->y,
+        start_margin,
+        end_margin,
+        spec->u.separateur.thickness,
+        spec->u.separateur.color
+    );
+
+    if (success) {
+        debug_printf("✅ Séparateur ajouté à la liste\n");
+    }
+    return success;
+}
 
-        // ─────────────────────────────────────────────────────────────────────────
-        // INITIALISER LA VALEUR PAR DÉFAUT (appelle le bon callback)
-        // ─────────────────────────────────────────────────────────────────────────
-        // Utiliser set_selector_value() qui va :
-        // - Définir current_index
-        // - Activer le submenu si index == 2 (Alterné)
-        // - Appeler le callback approprié (classique OU roller)
-        if (default_index >= 0 && default_index < selector->num_options) {
-            set_selector_value(selector, default_index);
-            debug_printf("✅ Valeur par défaut initialisée: index=%d\n", default_index);
+static bool construire_preview(const WidgetLayout* layout, const WidgetSpec* spec,
+                               LoaderContext* ctx, WidgetList* list) {
+    (void)ctx;
+
+    bool success = add_preview_widget(
+        list,
+        SPEC_STR(id),
+        spec->x,
+        spec->y,
+        spec->u.preview.frame_size,
+        spec->u.preview.size_ratio,
+        spec->u.preview.breath_duration
+    );
+
+    if (success) {
+        debug_printf("✅ Widget preview '%s' chargé\n", SPEC_STR(id));
+    }
+    return success;
+}
+
+static bool construire_button(const WidgetLayout* layout, const WidgetSpec* spec,
+                              LoaderContext* ctx, WidgetList* list) {
+    (void)ctx;
+
+    bool success = add_button_widget(
+        list,
+        SPEC_STR(id),
+        SPEC_STR(label),
+        spec->x,
+        spec->y,
+        spec->u.button.width,
+        spec->u.button.height,
+        spec->u.button.text_size,
+        spec->u.button.color,
+        (ButtonYAnchor)spec->u.button.y_anchor,
+        obtenir_callback_void(SPEC_STR(callback))
+    );
+
+    if (success) {
+        debug_printf("✅ Widget button '%s' chargé\n", SPEC_STR(id));
+    }
+    return success;
+}
+
+static bool construire_selector(const WidgetLayout* layout, const WidgetSpec* spec,
+                                LoaderContext* ctx, WidgetList* list) {
+    const char* id = SPEC_STR(id);
+    int default_index = spec->u.selector.default_index;
+    int arrow_size = 6;  // Taille fixe des flèches
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // CRÉATION DU WIDGET SELECTOR
+    // ─────────────────────────────────────────────────────────────────────────
+    bool success = add_selector_widget(
+        list,
+        id,
+        SPEC_STR(label),
+        spec->x,
+        spec->y,
+        default_index,
+        arrow_size,
+        spec->u.selector.text_size,
+        ctx->font_normal  // ← Police pour le rendu du texte
+    );
+
+    if (!success) {
+        debug_printf("❌ Échec création SelectorWidget '%s'\n", id);
+        return false;
+    }
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // RÉCUPÉRATION DU WIDGET POUR AJOUTER LES OPTIONS
+    // ─────────────────────────────────────────────────────────────────────────
+    WidgetNode* node = find_widget_by_id(list, id);
+    if (!node || !node->widget.selector_widget) {
+        debug_printf("❌ Widget selector '%s' introuvable après création\n", id);
+        return false;
+    }
+
+    SelectorWidget* selector = node->widget.selector_widget;
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // DONNÉES ROLLER (TOUJOURS, même en mode classique)
+    // ─────────────────────────────────────────────────────────────────────────
+    selector->seq1_type = spec->u.selector.seq1_type;
+    selector->seq1_count = spec->u.selector.seq1_count;
+    selector->seq2_type = spec->u.selector.seq2_type;
+    selector->seq2_count = spec->u.selector.seq2_count;
+
+    // Callback roller (avec 4 paramètres)
+    const char* roller_callback_name = SPEC_STR(u.selector.roller_callback);
+    if (roller_callback_name) {
+        // Mapper le nom vers la fonction
+        if (strcmp(roller_callback_name, "retention_roller_changed") == 0) {
+            // Déclaration externe du callback
+            extern void retention_roller_changed(int, int, int, int);
+            selector->roller_callback = retention_roller_changed;
+            debug_printf("✅ Callback roller '%s' défini\n", roller_callback_name);
         }
+    }
 
-        // ─────────────────────────────────────────────────────────────────────────
-        // INITIALISATION DU LAYOUT (créer flèches et zones cliquables)
-        // IMPORTANT: Doit être fait APRÈS l'ajout de toutes les options pour
-        // calculer correctement la largeur maximale des choix
-        // ─────────────────────────────────────────────────────────────────────────
-        rescale_selector_widget(selector, 1.0f);
-        debug_printf("✅ Widget selector '%s' chargé avec %d options (layout initialisé)\n",
-                     id->valuestring, selector->num_options);
+    debug_printf("🔧 Données roller chargées: seq1=%d×%d, seq2=%d×%d, callback=%s\n",
+                 selector->seq1_count, selector->seq1_type,
+                 selector->seq2_count, selector->seq2_type,
+                 selector->roller_callback ? "OUI" : "NON");
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // MODE ROLLER (sous-menu personnalisé)
+    // ─────────────────────────────────────────────────────────────────────────
+    if (spec->u.selector.submenu_enabled) {
+        // Mode roller-only activé (ancien comportement, obsolète)
+        selector->submenu_enabled = true;
+
+        debug_printf("✅ Selector '%s' en mode roller-only (layout initialisé)\n", id);
 
+        // IMPORTANT: Doit être fait même en mode roller pour initialiser les flèches
+        rescale_selector_widget(selector, 1.0f);
         return true;
+    }
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // MODE CLASSIQUE : submenu désactivé par défaut, sera activé dynamiquement
+    // ─────────────────────────────────────────────────────────────────────────
+    selector->submenu_enabled = false;
+
+    uint32_t num_options = spec->u.selector.option_count;
+    debug_printf("📋 Ajout de %u options pour selector '%s'\n", num_options, id);
+
+    for (uint32_t i = 0; i < num_options; i++) {
+        const SelectorOptionSpec* option = &layout->options[spec->u.selector.first_option + i];
+        const char* texte = widget_layout_string(layout, option->texte);
+        const char* callback_name = widget_layout_string(layout, option->callback);
+
+        // Ajouter l'option au widget
+        if (!add_selector_option(selector, texte, callback_name)) {
+            debug_printf("⚠️ Impossible d'ajouter option '%s'\n", texte);
+            continue;
+        }
+
+        // Récupérer le callback VOID associé
+        void (*callback_func)(void) = obtenir_callback_void(callback_name);
+        if (callback_func) {
+            set_selector_option_callback(selector, selector->num_options - 1, callback_func);
+            debug_printf("✅ Option '%s' → callback '%s' défini\n", texte, callback_name);
+        } else {
+            debug_printf("⚠️ Callback '%s' introuvable pour option '%s'\n",
+                         callback_name, texte);
+        }
+    }
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // INITIALISER LA VALEUR PAR DÉFAUT (appelle le bon callback)
+    // ─────────────────────────────────────────────────────────────────────────
+    // Utiliser set_selector_value() qui va :
+    // - Définir current_index
+    // - Activer le submenu si index == 2 (Alterné)
+    // - Appeler le callback approprié (classique OU roller)
+    if (default_index >= 0 && default_index < selector->num_options) {
+        set_selector_value(selector, default_index);
+        debug_printf("✅ Valeur par défaut initialisée: index=%d\n", default_index);
+    }
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // INITIALISATION DU LAYOUT (créer flèches et zones cliquables)
+    // IMPORTANT: Doit être fait APRÈS l'ajout de toutes les options pour
+    // calculer correctement la largeur maximale des choix
+    // ─────────────────────────────────────────────────────────────────────────
+    rescale_selector_widget(selector, 1.0f);
+    debug_printf("✅ Widget selector '%s' chargé avec %d options (layout initialisé)\n",
+                 id, selector->num_options);
+
+    return true;
+}
+
+#undef SPEC_STR
+
+static bool construire_widget(const WidgetLayout* layout, const WidgetSpec* spec,
+                              LoaderContext* ctx, WidgetList* list) {
+    switch ((WidgetSpecType)spec->type) {
+        case WIDGET_SPEC_INCREMENT:  return construire_increment(layout, spec, ctx, list);
+        case WIDGET_SPEC_TOGGLE:     return construire_toggle(layout, spec, ctx, list);
+        case WIDGET_SPEC_TITRE:      return construire_titre(layout, spec, ctx, list);
+        case WIDGET_SPEC_SEPARATEUR: return construire_separateur(layout, spec, ctx, list);
+        case WIDGET_SPEC_PREVIEW:    return construire_preview(layout, spec, ctx, list);
+        case WIDGET_SPEC_BUTTON:     return construire_button(layout, spec, ctx, list);
+        case WIDGET_SPEC_SELECTOR:   return construire_selector(layout, spec, ctx, list);
+    }
+    return false;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PARSING D'UN WIDGET ISOLÉ (description puis construction immédiate)
+// ═══════════════════════════════════════════════════════════════════════════
+
+static bool parser_un_widget(cJSON* json_obj, bool (*lire)(cJSON*, WidgetLayout*),
+                             LoaderContext* ctx, WidgetList* list) {
+    if (!json_obj || !ctx || !list) return false;
+
+    WidgetLayout layout;
+    widget_layout_init(&layout);
+
+    bool success = lire(json_obj, &layout) && layout.count == 1 &&
+                   construire_widget(&layout, &layout.specs[0], ctx, list);
+
+    widget_layout_free(&layout);
+    return success;
+}
+
+bool parser_widget_increment(cJSON* json_obj, LoaderContext* ctx, WidgetList* list) {
+    return parser_un_widget(json_obj, lire_spec_increment, ctx, list);
+}
+
+bool parser_widget_toggle(cJSON* json_obj, LoaderContext* ctx, WidgetList* list) {
+    return parser_un_widget(json_obj, lire_spec_toggle, ctx, list);
+}
+
+bool parser_titre(void* json_obj, LoaderContext* ctx, WidgetList* list) {
+    return parser_un_widget((cJSON*)json_obj, lire_spec_titre, ctx, list);
+}
+
+bool parser_separateur(void* json_obj, LoaderContext* ctx, WidgetList* list) {
+    return parser_un_widget((cJSON*)json_obj, lire_spec_separateur, ctx, list);
+}
+
+bool parser_widget_preview(cJSON* json_obj, LoaderContext* ctx, WidgetList* list) {
+    return parser_un_widget(json_obj, lire_spec_preview, ctx, list);
+}
+
+bool parser_widget_button(cJSON* json_obj, LoaderContext* ctx, WidgetList* list) {
+    return parser_un_widget(json_obj, lire_spec_button, ctx, list);
+}
+
+bool parser_widget_selector(cJSON* json_obj, LoaderContext* ctx, WidgetList* list) {
+    return parser_un_widget(json_obj, lire_spec_selector, ctx, list);
+}
+
+// Traduit tout le tableau "widgets" du JSON en descriptions
+static bool compiler_layout_json(const char* json_string, WidgetLayout* layout) {
+    cJSON* root = cJSON_Parse(json_string);
+    if (!root) {
+        const char* error_ptr = cJSON_GetErrorPtr();
+        if (error_ptr) {
+            debug_printf("❌ Erreur parsing JSON avant: %s\n", error_ptr);
+        }
+        return false;
+    }
+
+    // Récupération du tableau "widgets"
+    cJSON* widgets_array = cJSON_GetObjectItem(root, "widgets");
+    if (!cJSON_IsArray(widgets_array)) {
+        debug_printf("❌ Pas de tableau 'widgets' trouvé dans le JSON\n");
+        cJSON_Delete(root);
+        return false;
+    }
+
+    int nb_widgets = cJSON_GetArraySize(widgets_array);
+    debug_printf("📋 Nombre d'éléments à charger: %d\n", nb_widgets);
+
+    int index = 0;
+    cJSON* widget;
+    cJSON_ArrayForEach(widget, widgets_array) {
+        if (cJSON_IsObject(widget)) {
+            lire_spec_widget(widget, index, layout);
+        }
+        index++;
+    }
+
+    cJSON_Delete(root);
+    return true;
 }
 
 //  FONCTION PRINCIPALE : CHARGER TOUS LES WIDGETS
@@ -710,99 +920,48 @@ bool charger_widgets_depuis_json(const char* filename,
     }
 
     // Lire le fichier
-    fread(json_string, 1, file_size, file);
-    json_string[file_size] = '\0';
+    size_t bytes_read = fread(json_string, 1, file_size, file);
+    json_string[bytes_read] = '\0';
     fclose(file);
 
-    debug_printf("✅ Fichier JSON lu (%ld octets)\n", file_size);
+    debug_printf("✅ Fichier JSON lu (%zu octets)\n", bytes_read);
 
     // ─────────────────────────────────────────────────────────────────────────
-    // 2. PARSING DU JSON
+    // 2. DESCRIPTIONS : CACHE BINAIRE SI LE CONTENU N'A PAS CHANGÉ
     // ─────────────────────────────────────────────────────────────────────────
-    cJSON* root = cJSON_Parse(json_string);
-    SAFE_FREE(json_string);
+    uint64_t json_hash = widget_layout_hash(json_string, bytes_read);
 
-    if (!root) {
-        const char* error_ptr = cJSON_GetErrorPtr();
-        if (error_ptr) {
-            debug_printf("❌ Erreur parsing JSON avant: %s\n", error_ptr);
-        }
-        return false;
-    }
+    char cache_path[512];
+    snprintf(cache_path, sizeof(cache_path), "%s.bin", filename);
 
-    // ─────────────────────────────────────────────────────────────────────────
-    // 3. RÉCUPÉRATION DU TABLEAU "widgets"
-    // ─────────────────────────────────────────────────────────────────────────
-    cJSON* widgets_array = cJSON_GetObjectItem(root, "widgets");
-    if (!cJSON_IsArray(widgets_array)) {
-        debug_printf("❌ Pas de tableau 'widgets' trouvé dans le JSON\n");
-        cJSON_Delete(root);
-        return false;
-    }
+    WidgetLayout layout;
+    widget_layout_init(&layout);
 
-    int nb_widgets = cJSON_GetArraySize(widgets_array);
-    debug_printf("📋 Nombre d'éléments à charger: %d\n", nb_widgets);
+    if (!widget_layout_cache_load(cache_path, json_hash, &layout)) {
+        if (!compiler_layout_json(json_string, &layout)) {
+            SAFE_FREE(json_string);
+            widget_layout_free(&layout);
+            return false;
+        }
+        widget_layout_cache_save(cache_path, json_hash, &layout);
+    }
+    SAFE_FREE(json_string);
 
     // ─────────────────────────────────────────────────────────────────────────
-    // 4. BOUCLE SUR TOUS LES WIDGETS
+    // 3. CONSTRUCTION DES WIDGETS
     // ─────────────────────────────────────────────────────────────────────────
     int compteur_success = 0;
 
-    for (int i = 0; i < nb_widgets; i++) {
-        cJSON* widget = cJSON_GetArrayItem(widgets_array, i);
-        if (!cJSON_IsObject(widget)) continue;
-
-        // Récupérer le type
-        cJSON* type = cJSON_GetObjectItem(widget, "type");
-        if (!cJSON_IsString(type)) {
-            debug_printf("⚠️ Widget %d sans type valide\n", i);
-            continue;
-        }
-
-        const char* type_str = type->valuestring;
-        debug_printf("🔍 Traitement widget %d de type '%s'\n", i, type_str);
-
-        // ─────────────────────────────────────────────────────────────────────
-        // DISPATCH selon le type
-        // ─────────────────────────────────────────────────────────────────────
-        bool success = false;
-
-        if (strcmp(type_str, "increment") == 0) {
-            success = parser_widget_increment(widget, context, widget_list);
-        }
-        else if (strcmp(type_str, "toggle") == 0) {
-            success = parser_widget_toggle(widget, context, widget_list);
-        }
-        else if (strcmp(type_str, "titre") == 0) {
-            success = parser_titre(widget, context, widget_list);
-        }
-        else if (strcmp(type_str, "separateur") == 0) {
-            success = parser_separateur(widget, context, widget_list);
-        }
-        else if (strcmp(type_str, "preview") == 0) {
-            success = parser_widget_preview(widget, context, widget_list);
-        }
-        else if (strcmp(type_str, "button") == 0) {
-            success = parser_widget_button(widget, context, widget_list);
+    for (uint32_t i = 0; i < layout.count; i++) {
+        if (construire_widget(&layout, &layout.specs[i], context, widget_list)) {
+            compteur_success++;
         }
-        else if (strcmp(type_str, "selector") == 0) {
-            success = parser_widget_selector(widget, context, widget_list);
-        }
-        else {
-            debug_printf("⚠️ Type de widget inconnu: '%s'\n", type_str);
-        }
-
-        if (success) compteur_success++;
     }
 
-    // ─────────────────────────────────────────────────────────────────────────
-    // 5. NETTOYAGE ET RÉSULTAT
-    // ─────────────────────────────────────────────────────────────────────────
-    cJSON_Delete(root);
-
-    debug_printf("✅ Chargement terminé : %d/%d éléments créés avec succès\n",
-                 compteur_success, nb_widgets);
+    debug_printf("✅ Chargement terminé : %d/%u éléments créés avec succès\n",
+                 compteur_success, layout.count);
 
+    widget_layout_free(&layout);
     return (compteur_success > 0);
 }
 
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "memory.h"
+#include "core/debug.h"
+#include <stdint.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ARÈNE DE FRAME (allocateur linéaire "bump")
+// ═══════════════════════════════════════════════════════════════════════════
+// - Allocation = avancer un index dans un bloc, aucun appel à malloc
+// - Pas de libération individuelle : tout est rendu d'un coup par
+//   frame_arena_reset() en tête de boucle principale
+// - Débordement : un nouveau bloc (2× plus grand) est chaîné au précédent.
+//   Au reset, la chaîne est fusionnée en un seul bloc de la taille totale,
+//   donc après quelques frames l'arène ne touche plus jamais au tas
+// - Réduction : après FRAME_ARENA_SHRINK_FRAMES frames consécutives sous le
+//   quart de la capacité, le bloc (dimensionné pour un pic passé, ex: le
+//   démarrage) est remplacé par un bloc de 2× le pic récent
+// - Thread principal uniquement (pas de verrou)
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define FRAME_ARENA_INITIAL_CAPACITY (256 * 1024)
+#define FRAME_ARENA_ALIGN 16
+#define FRAME_ARENA_SHRINK_FRAMES 600     // ~10 s à 60 FPS
+#define FRAME_ARENA_SHRINK_RATIO 4        // "Bien en dessous" = sous capacité / 4
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* prev;    // Bloc précédent de la chaîne (débordement)
+    size_t capacity;            // Octets utilisables dans data
+    size_t used;                // Octets consommés dans data
+    unsigned char data[];
+} ArenaBlock;
+
+static struct {
+    ArenaBlock* current;        // Bloc actif (tête de chaîne)
+    size_t frame_bytes;         // Octets servis depuis le dernier reset
+    size_t high_water_mark;     // Maximum de frame_bytes sur une frame
+    size_t overflow_count;      // Nombre de blocs chaînés depuis le début
+    size_t frame_count;         // Nombre de resets
+    size_t quiet_frames;        // Frames consécutives sous le seuil de réduction
+    size_t quiet_peak;          // Maximum de frame_bytes sur ces frames
+    size_t shrink_count;        // Nombre de réductions du bloc
+} frame_arena = {0};
+
+static ArenaBlock* arena_block_create(size_t capacity, ArenaBlock* prev) {
+    ArenaBlock* block = SAFE_MALLOC(sizeof(ArenaBlock) + capacity);
+    if (!block) return NULL;
+
+    block->prev = prev;
+    block->capacity = capacity;
+    block->used = 0;
+    return block;
+}
+
+// Décalage à ajouter à "used" pour que l'adresse retournée soit alignée
+static inline size_t arena_padding(const ArenaBlock* block) {
+    uintptr_t address = (uintptr_t)(block->data + block->used);
+    return (FRAME_ARENA_ALIGN - (address & (FRAME_ARENA_ALIGN - 1))) & (FRAME_ARENA_ALIGN - 1);
+}
+
+void* frame_alloc_impl(size_t size, const char* file, int line) {
+    if (size == 0) {
+        debug_printf("⚠️ frame_alloc(0) appelé depuis %s:%d\n", file, line);
+        return NULL;
+    }
+
+    ArenaBlock* block = frame_arena.current;
+    size_t padding = block ? arena_padding(block) : 0;
+
+    if (!block || block->used + padding + size > block->capacity) {
+        // Débordement : chaîner un bloc au moins 2× plus grand
+        size_t capacity = block ? block->capacity * 2 : FRAME_ARENA_INITIAL_CAPACITY;
+        if (capacity < size + FRAME_ARENA_ALIGN) {
+            capacity = size + FRAME_ARENA_ALIGN;
+        }
+
+        ArenaBlock* new_block = arena_block_create(capacity, block);
+        if (!new_block) {
+            debug_printf("❌ ARÈNE DE FRAME: échec extension (%zu octets) depuis %s:%d\n",
+                         size, file, line);
+            return NULL;
+        }
+
+        if (block) {
+            frame_arena.overflow_count++;
+            debug_verbose("📦 Arène de frame: débordement → bloc chaîné de %zu Ko\n",
+                          capacity / 1024);
+        }
+
+        frame_arena.current = new_block;
+        block = new_block;
+        padding = arena_padding(block);
+    }
+
+    void* ptr = block->data + block->used + padding;
+    block->used += padding + size;
+    frame_arena.frame_bytes += padding + size;
+
+    return ptr;
+}
+
+void* frame_calloc_impl(size_t size, const char* file, int line) {
+    void* ptr = frame_alloc_impl(size, file, line);
+    if (ptr) {
+        memset(ptr, 0, size);
+    }
+    return ptr;
+}
+
+// Bloc unique resté surdimensionné après un pic : compte les frames bien
+// en dessous de la capacité et le remplace par un bloc à la mesure du pic
+// récent quand elles durent
+static void arena_maybe_shrink(ArenaBlock* block, size_t frame_bytes) {
+    if (block->capacity <= FRAME_ARENA_INITIAL_CAPACITY ||
+        frame_bytes > block->capacity / FRAME_ARENA_SHRINK_RATIO) {
+        frame_arena.quiet_frames = 0;
+        frame_arena.quiet_peak = 0;
+        return;
+    }
+
+    if (frame_bytes > frame_arena.quiet_peak) frame_arena.quiet_peak = frame_bytes;
+    if (++frame_arena.quiet_frames < FRAME_ARENA_SHRINK_FRAMES) return;
+
+    size_t capacity = FRAME_ARENA_INITIAL_CAPACITY;
+    while (capacity < frame_arena.quiet_peak * 2) capacity *= 2;
+    frame_arena.quiet_frames = 0;
+    frame_arena.quiet_peak = 0;
+    if (capacity >= block->capacity) return;
+
+    debug_verbose("📦 Arène de frame: bloc réduit de %zu Ko à %zu Ko\n",
+                  block->capacity / 1024, capacity / 1024);
+    SAFE_FREE(block);
+    // Échec : current NULL, le prochain FRAME_ALLOC recrée un bloc initial
+    frame_arena.current = arena_block_create(capacity, NULL);
+    frame_arena.shrink_count++;
+}
+
+void frame_arena_reset(void) {
+    ArenaBlock* block = frame_arena.current;
+    if (!block) return;
+
+    size_t frame_bytes = frame_arena.frame_bytes;
+    if (frame_bytes > frame_arena.high_water_mark) {
+        frame_arena.high_water_mark = frame_bytes;
+    }
+    frame_arena.frame_bytes = 0;
+    frame_arena.frame_count++;
+
+    // Cas courant : un seul bloc → simple remise à zéro de l'index
+    if (!block->prev) {
+        block->used = 0;
+        arena_maybe_shrink(block, frame_bytes);
+        return;
+    }
+
+    // La frame a débordé : fusionner la chaîne en un bloc unique assez
+    // grand pour la prochaine frame équivalente
+    size_t total_capacity = 0;
+    while (block) {
+        ArenaBlock* prev = block->prev;
+        total_capacity += block->capacity;
+        SAFE_FREE(block);
+        block = prev;
+    }
+
+    frame_arena.quiet_frames = 0;
+    frame_arena.quiet_peak = 0;
+    frame_arena.current = arena_block_create(total_capacity, NULL);
+    debug_verbose("📦 Arène de frame: chaîne fusionnée en un bloc de %zu Ko\n",
+                  total_capacity / 1024);
+}
+
+size_t frame_arena_get_high_water_mark(void) {
+    if (frame_arena.frame_bytes > frame_arena.high_water_mark) {
+        return frame_arena.frame_bytes;
+    }
+    return frame_arena.high_water_mark;
+}
+
+void frame_arena_report(void) {
+    size_t capacity = 0;
+    size_t blocks = 0;
+    for (ArenaBlock* block = frame_arena.current; block; block = block->prev) {
+        capacity += block->capacity;
+        blocks++;
+    }
+
+    debug_subsection("ARÈNE DE FRAME");
+    debug_printf("  Frames       : %zu\n", frame_arena.frame_count);
+    debug_printf("  Capacité     : %zu Ko (%zu bloc%s)\n",
+                 capacity / 1024, blocks, blocks > 1 ? "s" : "");
+    debug_printf("  High-water   : %zu Ko\n", frame_arena_get_high_water_mark() / 1024);
+    debug_printf("  Débordements : %zu\n", frame_arena.overflow_count);
+    debug_printf("  Réductions   : %zu\n", frame_arena.shrink_count);
+}
+
+void frame_arena_cleanup(void) {
+    ArenaBlock* block = frame_arena.current;
+    while (block) {
+        ArenaBlock* prev = block->prev;
+        SAFE_FREE(block);
+        block = prev;
+    }
+
+    frame_arena.current = NULL;
+    frame_arena.frame_bytes = 0;
+    frame_arena.quiet_frames = 0;
+    frame_arena.quiet_peak = 0;
+}
@@ -4,56 +4,270 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
-
-// Structure pour tracker une allocation
-typedef struct AllocationRecord {
-    void* ptr;
-    size_t size;
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TRACKING PAR TABLE DE HACHAGE (adressage ouvert, sondage linéaire)
+// ═══════════════════════════════════════════════════════════════════════════
+// - Pointeurs vivants : table ptr → (taille, callsite), O(1) en alloc ET free
+// - Callsites : table (fichier, ligne) → agrégats (compte, octets, pic, churn)
+// - Aucun malloc supplémentaire par allocation : les tables grossissent par
+//   doublement, les enregistrements sont stockés en place
+// - Suppression par "backward shift" : pas de tombstones, la table ne se
+//   dégrade pas même après des millions d'alloc/free
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define LIVE_TABLE_INITIAL_CAPACITY 4096   // Puissance de 2
+#define SITE_TABLE_INITIAL_CAPACITY 256    // Puissance de 2
+#define NO_SITE UINT32_MAX
+
+// Agrégats d'un point d'appel (fichier:ligne)
+typedef struct {
     const char* file;
     int line;
-    struct AllocationRecord* next;
-} AllocationRecord;
+    size_t live_count;      // Blocs actuellement vivants
+    size_t live_bytes;      // Octets actuellement vivants
+    size_t peak_bytes;      // Pic d'octets vivants pour ce callsite
+    size_t total_allocs;    // Allocations cumulées (pour le churn)
+    size_t total_frees;     // Libérations cumulées
+    size_t total_bytes;     // Octets alloués cumulés
+} CallsiteStats;
+
+// Enregistrement d'un pointeur vivant (stocké directement dans la table)
+typedef struct {
+    void* ptr;              // NULL = case vide
+    size_t size;
+    uint32_t site;          // Index dans memory_state.sites
+} LiveRecord;
 
 // État global du système de tracking
 static struct {
     bool tracking_enabled;
-    AllocationRecord* allocations;
+
+    LiveRecord* live;               // Table des pointeurs vivants
+    size_t live_capacity;           // Toujours une puissance de 2
+
+    CallsiteStats* sites;           // Agrégats, dans l'ordre de découverte
+    size_t site_count;
+    size_t site_capacity;
+    uint32_t* site_index;           // Table (fichier, ligne) → index dans sites
+    size_t site_index_capacity;     // Toujours une puissance de 2
+
     size_t allocation_count;
     size_t total_allocated;
     size_t total_freed;
     size_t peak_memory;
+    size_t untracked_frees;         // free() de pointeurs non alloués par SAFE_MALLOC (strdup...)
+
+    struct timespec start_time;     // Début du tracking (base du churn/s)
+    atomic_flag lock;               // Spinlock : les workers allouent aussi
 } memory_state = {
     .tracking_enabled = false,
-    .allocations = NULL,
+    .live = NULL,
+    .live_capacity = 0,
+    .sites = NULL,
+    .site_count = 0,
+    .site_capacity = 0,
+    .site_index = NULL,
+    .site_index_capacity = 0,
     .allocation_count = 0,
     .total_allocated = 0,
     .total_freed = 0,
-    .peak_memory = 0
+    .peak_memory = 0,
+    .untracked_frees = 0,
+    .lock = ATOMIC_FLAG_INIT
 };
 
+static inline void tracker_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&memory_state.lock, memory_order_acquire)) {
+        // Attente active : les sections critiques ne font que quelques sondages
+    }
+}
+
+static inline void tracker_unlock(void) {
+    atomic_flag_clear_explicit(&memory_state.lock, memory_order_release);
+}
+
+// Mélangeur 64 bits (finaliseur de splitmix64) : les adresses malloc sont
+// alignées sur 16 octets, les bits de poids faible seuls seraient inutiles
+static inline size_t hash_pointer(const void* ptr) {
+    uint64_t x = (uint64_t)(uintptr_t)ptr;
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return (size_t)x;
+}
+
+// __FILE__ est un littéral : on hache l'adresse, pas le contenu (pas de strlen)
+static inline size_t hash_callsite(const char* file, int line) {
+    return hash_pointer(file) ^ ((size_t)line * 0x9e3779b97f4a7c15ULL);
+}
+
+static double elapsed_seconds_since_start(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double elapsed = (double)(now.tv_sec - memory_state.start_time.tv_sec) +
+                     (double)(now.tv_nsec - memory_state.start_time.tv_nsec) / 1e9;
+    return (elapsed > 0.0) ? elapsed : 0.0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────
+// TABLE DES CALLSITES
+// ─────────────────────────────────────────────────────────────────────────
+
+static bool site_index_rehash(size_t new_capacity) {
+    uint32_t* new_index = malloc(new_capacity * sizeof(uint32_t));
+    if (!new_index) return false;
+    for (size_t i = 0; i < new_capacity; i++) new_index[i] = NO_SITE;
+
+    size_t mask = new_capacity - 1;
+    for (size_t s = 0; s < memory_state.site_count; s++) {
+        size_t slot = hash_callsite(memory_state.sites[s].file, memory_state.sites[s].line) & mask;
+        while (new_index[slot] != NO_SITE) slot = (slot + 1) & mask;
+        new_index[slot] = (uint32_t)s;
+    }
+
+    free(memory_state.site_index);
+    memory_state.site_index = new_index;
+    memory_state.site_index_capacity = new_capacity;
+    return true;
+}
+
+// Retourne l'index du callsite (créé si nécessaire), NO_SITE si plus de mémoire
+static uint32_t find_or_add_callsite(const char* file, int line) {
+    if (!memory_state.site_index &&
+        !site_index_rehash(SITE_TABLE_INITIAL_CAPACITY)) {
+        return NO_SITE;
+    }
+
+    size_t mask = memory_state.site_index_capacity - 1;
+    size_t slot = hash_callsite(file, line) & mask;
+    while (memory_state.site_index[slot] != NO_SITE) {
+        CallsiteStats* site = &memory_state.sites[memory_state.site_index[slot]];
+        if (site->file == file && site->line == line) {
+            return memory_state.site_index[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // Nouveau callsite : agrandir le tableau dense si nécessaire
+    if (memory_state.site_count == memory_state.site_capacity) {
+        size_t new_capacity = memory_state.site_capacity ? memory_state.site_capacity * 2
+                                                         : SITE_TABLE_INITIAL_CAPACITY;
+        CallsiteStats* new_sites = realloc(memory_state.sites, new_capacity * sizeof(CallsiteStats));
+        if (!new_sites) return NO_SITE;
+        memory_state.sites = new_sites;
+        memory_state.site_capacity = new_capacity;
+    }
+
+    uint32_t index = (uint32_t)memory_state.site_count++;
+    memset(&memory_state.sites[index], 0, sizeof(CallsiteStats));
+    memory_state.sites[index].file = file;
+    memory_state.sites[index].line = line;
+    memory_state.site_index[slot] = index;
+
+    // Facteur de charge max 0.5
+    if (memory_state.site_count * 2 > memory_state.site_index_capacity) {
+        site_index_rehash(memory_state.site_index_capacity * 2);
+    }
+
+    return index;
+}
+
+// ─────────────────────────────────────────────────────────────────────────
+// TABLE DES POINTEURS VIVANTS
+// ─────────────────────────────────────────────────────────────────────────
+
+static bool live_table_rehash(size_t new_capacity) {
+    LiveRecord* new_table = calloc(new_capacity, sizeof(LiveRecord));
+    if (!new_table) return false;
+
+    size_t mask = new_capacity - 1;
+    for (size_t i = 0; i < memory_state.live_capacity; i++) {
+        LiveRecord* record = &memory_state.live[i];
+        if (!record->ptr) continue;
+        size_t slot = hash_pointer(record->ptr) & mask;
+        while (new_table[slot].ptr) slot = (slot + 1) & mask;
+        new_table[slot] = *record;
+    }
+
+    free(memory_state.live);
+    memory_state.live = new_table;
+    memory_state.live_capacity = new_capacity;
+    return true;
+}
+
+// Suppression sans tombstone : on recule les entrées suivantes du cluster
+// qui ne sont pas à leur place idéale
+static void live_table_remove_slot(size_t slot) {
+    size_t mask = memory_state.live_capacity - 1;
+    size_t hole = slot;
+    size_t next = (hole + 1) & mask;
+
+    while (memory_state.live[next].ptr) {
+        size_t ideal = hash_pointer(memory_state.live[next].ptr) & mask;
+        // L'entrée peut combler le trou si sa place idéale n'est pas dans ]hole, next]
+        if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+            memory_state.live[hole] = memory_state.live[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    memory_state.live[hole].ptr = NULL;
+}
+
 void memory_enable_tracking(bool enable) {
+    tracker_lock();
     memory_state.tracking_enabled = enable;
     if (enable) {
-        debug_printf("🔍 Memory tracking activé\n");
+        clock_gettime(CLOCK_MONOTONIC, &memory_state.start_time);
+    }
+    tracker_unlock();
+
+    if (enable) {
+        debug_printf("🔍 Memory tracking activé (table de hachage)\n");
     }
 }
 
+bool memory_is_tracking_enabled(void) {
+    return memory_state.tracking_enabled;
+}
+
 static void track_allocation(void* ptr, size_t size, const char* file, int line) {
-    if (!memory_state.tracking_enabled || !ptr) return;
+    if (!ptr) return;
 
-    AllocationRecord* record = malloc(sizeof(AllocationRecord));
-    if (!record) {
-        fprintf(stderr, "⚠️ Impossible de tracker l'allocation (out of memory)\n");
+    tracker_lock();
+    if (!memory_state.tracking_enabled) {
+        tracker_unlock();
         return;
     }
 
-    record->ptr = ptr;
-    record->size = size;
-    record->file = file;
-    record->line = line;
-    record->next = memory_state.allocations;
+    // Facteur de charge max 0.5 pour garder des clusters courts
+    if ((memory_state.allocation_count + 1) * 2 > memory_state.live_capacity) {
+        size_t new_capacity = memory_state.live_capacity ? memory_state.live_capacity * 2
+                                                         : LIVE_TABLE_INITIAL_CAPACITY;
+        if (!live_table_rehash(new_capacity)) {
+            tracker_unlock();
+            fprintf(stderr, "⚠️ Impossible de tracker l'allocation (out of memory)\n");
+            return;
+        }
+    }
+
+    uint32_t site_idx = find_or_add_callsite(file, line);
+
+    size_t mask = memory_state.live_capacity - 1;
+    size_t slot = hash_pointer(ptr) & mask;
+    while (memory_state.live[slot].ptr) slot = (slot + 1) & mask;
+
+    memory_state.live[slot].ptr = ptr;
+    memory_state.live[slot].size = size;
+    memory_state.live[slot].site = site_idx;
 
-    memory_state.allocations = record;
     memory_state.allocation_count++;
     memory_state.total_allocated += size;
 
@@ -61,27 +275,58 @@ static void track_allocation(void* ptr, size_t size, const char* file, int line)
     if (current_allocated > memory_state.peak_memory) {
         memory_state.peak_memory = current_allocated;
     }
+
+    if (site_idx != NO_SITE) {
+        CallsiteStats* site = &memory_state.sites[site_idx];
+        site->live_count++;
+        site->live_bytes += size;
+        site->total_allocs++;
+        site->total_bytes += size;
+        if (site->live_bytes > site->peak_bytes) {
+            site->peak_bytes = site->live_bytes;
+        }
+    }
+
+    tracker_unlock();
 }
 
 static void track_deallocation(void* ptr) {
-    if (!memory_state.tracking_enabled || !ptr) return;
+    if (!ptr) return;
 
-    AllocationRecord** current = &memory_state.allocations;
-    while (*current) {
-        if ((*current)->ptr == ptr) {
-            AllocationRecord* to_remove = *current;
-            *current = to_remove->next;
+    tracker_lock();
+    if (!memory_state.tracking_enabled || !memory_state.live) {
+        tracker_unlock();
+        return;
+    }
+
+    size_t mask = memory_state.live_capacity - 1;
+    size_t slot = hash_pointer(ptr) & mask;
+    while (memory_state.live[slot].ptr) {
+        if (memory_state.live[slot].ptr == ptr) {
+            LiveRecord* record = &memory_state.live[slot];
 
             memory_state.allocation_count--;
-            memory_state.total_freed += to_remove->size;
+            memory_state.total_freed += record->size;
 
-            free(to_remove);
+            if (record->site != NO_SITE) {
+                CallsiteStats* site = &memory_state.sites[record->site];
+                site->live_count--;
+                site->live_bytes -= record->size;
+                site->total_frees++;
+            }
+
+            live_table_remove_slot(slot);
+            tracker_unlock();
             return;
         }
-        current = &((*current)->next);
+        slot = (slot + 1) & mask;
     }
 
-    fprintf(stderr, "⚠️ Tentative de libération d'un pointeur non tracké: %p\n", ptr);
+    // Pointeur inconnu : strdup(), alloué avant l'activation du tracking...
+    // On compte au lieu de spammer stderr (le tracking doit rester silencieux en prod)
+    memory_state.untracked_frees++;
+    tracker_unlock();
+    debug_verbose("⚠️ Libération d'un pointeur non tracké: %p\n", ptr);
 }
 
 void* safe_malloc_impl(size_t size, const char* file, int line) {
@@ -121,6 +366,51 @@ void safe_free_impl(void** ptr, const char* file, int line) {
     *ptr = NULL;
 }
 
+// Tri des callsites : copie d'indices pour ne pas réordonner la table
+static const CallsiteStats* sort_sites_base;
+
+static int compare_sites_by_live_bytes(const void* a, const void* b) {
+    const CallsiteStats* sa = &sort_sites_base[*(const uint32_t*)a];
+    const CallsiteStats* sb = &sort_sites_base[*(const uint32_t*)b];
+    if (sa->live_bytes != sb->live_bytes) return (sa->live_bytes < sb->live_bytes) ? 1 : -1;
+    return 0;
+}
+
+static int compare_sites_by_allocs(const void* a, const void* b) {
+    const CallsiteStats* sa = &sort_sites_base[*(const uint32_t*)a];
+    const CallsiteStats* sb = &sort_sites_base[*(const uint32_t*)b];
+    if (sa->total_allocs != sb->total_allocs) return (sa->total_allocs < sb->total_allocs) ? 1 : -1;
+    return 0;
+}
+
+// Copie les callsites sous verrou puis trie hors verrou (le rapport appelle
+// debug_printf, qui ne doit pas tourner avec le spinlock tenu)
+static CallsiteStats* snapshot_sites(size_t* count, uint32_t** order,
+                                     int (*compare)(const void*, const void*)) {
+    tracker_lock();
+    size_t n = memory_state.site_count;
+    CallsiteStats* copy = n ? malloc(n * sizeof(CallsiteStats)) : NULL;
+    if (copy) memcpy(copy, memory_state.sites, n * sizeof(CallsiteStats));
+    tracker_unlock();
+
+    *count = copy ? n : 0;
+    *order = NULL;
+    if (!copy) return NULL;
+
+    *order = malloc(n * sizeof(uint32_t));
+    if (!*order) {
+        free(copy);
+        *count = 0;
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) (*order)[i] = (uint32_t)i;
+
+    sort_sites_base = copy;
+    qsort(*order, n, sizeof(uint32_t), compare);
+    sort_sites_base = NULL;
+    return copy;
+}
+
 void memory_report_leaks(void) {
     if (!memory_state.tracking_enabled) {
         debug_printf("⚠️ Tracking désactivé, impossible de détecter les fuites\n");
@@ -129,39 +419,95 @@ void memory_report_leaks(void) {
 
     debug_section("RAPPORT MÉMOIRE");
 
+    tracker_lock();
+    size_t total_allocated = memory_state.total_allocated;
+    size_t total_freed = memory_state.total_freed;
+    size_t peak_memory = memory_state.peak_memory;
+    size_t allocation_count = memory_state.allocation_count;
+    size_t untracked_frees = memory_state.untracked_frees;
+    tracker_unlock();
+
     debug_printf("📊 Statistiques globales:\n");
-    debug_printf("  Total alloué  : %zu octets\n", memory_state.total_allocated);
-    debug_printf("  Total libéré  : %zu octets\n", memory_state.total_freed);
-    debug_printf("  Pic mémoire   : %zu octets\n", memory_state.peak_memory);
-    debug_printf("  Allocations actives: %zu\n", memory_state.allocation_count);
+    debug_printf("  Total alloué  : %zu octets\n", total_allocated);
+    debug_printf("  Total libéré  : %zu octets\n", total_freed);
+    debug_printf("  Pic mémoire   : %zu octets\n", peak_memory);
+    debug_printf("  Allocations actives: %zu\n", allocation_count);
+    if (untracked_frees > 0) {
+        debug_printf("  Libérations non trackées: %zu (strdup, realloc...)\n", untracked_frees);
+    }
 
-    if (memory_state.allocation_count == 0) {
+    if (allocation_count == 0) {
         debug_printf("✅ Aucune fuite mémoire détectée!\n");
         return;
     }
 
-    debug_printf("\n❌ FUITES MÉMOIRE DÉTECTÉES (%zu blocs):\n",
-                memory_state.allocation_count);
+    debug_printf("\n❌ FUITES MÉMOIRE DÉTECTÉES (%zu blocs):\n", allocation_count);
     debug_blank_line();
 
-    AllocationRecord* current = memory_state.allocations;
-    size_t leak_number = 1;
+    // Les fuites sont regroupées par callsite : une boucle qui fuit 10 000 nœuds
+    // produit une seule ligne au lieu de 10 000
+    size_t count;
+    uint32_t* order;
+    CallsiteStats* sites = snapshot_sites(&count, &order, compare_sites_by_live_bytes);
     size_t total_leaked = 0;
+    size_t leak_number = 1;
 
-    while (current) {
-        debug_printf("  Fuite #%zu:\n", leak_number++);
-        debug_printf("    Adresse : %p\n", current->ptr);
-        debug_printf("    Taille  : %zu octets\n", current->size);
-        debug_printf("    Fichier : %s:%d\n", current->file, current->line);
-        debug_blank_line();
+    for (size_t i = 0; i < count; i++) {
+        const CallsiteStats* site = &sites[order[i]];
+        if (site->live_count == 0) continue;
 
-        total_leaked += current->size;
-        current = current->next;
+        debug_printf("  Fuite #%zu: %s:%d\n", leak_number++, site->file, site->line);
+        debug_printf("    Blocs   : %zu (pic %zu octets)\n", site->live_count, site->peak_bytes);
+        debug_printf("    Taille  : %zu octets\n", site->live_bytes);
+        total_leaked += site->live_bytes;
     }
+    debug_blank_line();
+
+    free(order);
+    free(sites);
 
     debug_printf("💧 Total fuites: %zu octets non libérés\n", total_leaked);
 }
 
+void memory_report_churn(size_t max_sites) {
+    if (!memory_state.tracking_enabled) {
+        debug_printf("⚠️ Tracking désactivé, pas de statistiques de churn\n");
+        return;
+    }
+
+    double elapsed = elapsed_seconds_since_start();
+    if (elapsed <= 0.0) elapsed = 1e-3;
+
+    size_t count;
+    uint32_t* order;
+    CallsiteStats* sites = snapshot_sites(&count, &order, compare_sites_by_allocs);
+
+    debug_section("CHURN MÉMOIRE PAR CALLSITE");
+    debug_printf("⏱️  Durée observée : %.1f s, %zu callsites\n", elapsed, count);
+    debug_printf("  %-44s %10s %9s %10s %10s %8s\n",
+                 "Callsite", "Allocs", "Allocs/s", "Octets", "Pic", "Vivants");
+
+    if (max_sites == 0 || max_sites > count) max_sites = count;
+    for (size_t i = 0; i < max_sites; i++) {
+        const CallsiteStats* site = &sites[order[i]];
+
+        // Garder la fin du chemin (la partie utile) si le nom est trop long
+        char location[64];
+        snprintf(location, sizeof(location), "%s:%d", site->file, site->line);
+        size_t len = strlen(location);
+        const char* shown = (len > 44) ? location + (len - 44) : location;
+
+        debug_printf("  %-44s %10zu %9.1f %10zu %10zu %8zu\n",
+                     shown, site->total_allocs, (double)site->total_allocs / elapsed,
+                     site->total_bytes, site->peak_bytes, site->live_count);
+    }
+
+    free(order);
+    free(sites);
+
+    memory_report_pools();
+}
+
 size_t memory_get_allocation_count(void) {
     return memory_state.allocation_count;
 }
@@ -173,15 +519,21 @@ size_t memory_get_allocated_bytes(void) {
 void memory_cleanup_tracking(void) {
     if (!memory_state.tracking_enabled) return;
 
-    AllocationRecord* current = memory_state.allocations;
-    while (current) {
-        AllocationRecord* next = current->next;
-        free(current);
-        current = next;
-    }
-
-    memory_state.allocations = NULL;
+    tracker_lock();
+    free(memory_state.live);
+    free(memory_state.sites);
+    free(memory_state.site_index);
+
+    memory_state.live = NULL;
+    memory_state.live_capacity = 0;
+    memory_state.sites = NULL;
+    memory_state.site_count = 0;
+    memory_state.site_capacity = 0;
+    memory_state.site_index = NULL;
+    memory_state.site_index_capacity = 0;
     memory_state.allocation_count = 0;
+    memory_state.tracking_enabled = false;
+    tracker_unlock();
 
     debug_printf("🧹 Système de tracking mémoire nettoyé\n");
 }
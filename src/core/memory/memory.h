@@ -14,9 +14,16 @@ extern "C" {
  *
  * En mode debug, toutes les allocations sont enregistrées avec
  * leur localisation (fichier:ligne) pour détecter les fuites.
+ * Le tracking repose sur une table de hachage (O(1) par malloc/free)
+ * et peut rester actif en production.
  */
 void memory_enable_tracking(bool enable);
 
+/**
+ * @brief Indique si le tracking des allocations est actif
+ */
+bool memory_is_tracking_enabled(void);
+
 /**
  * @brief Allocation mémoire sécurisée avec tracking optionnel
  *
@@ -45,10 +52,23 @@ void safe_free_impl(void** ptr, const char* file, int line);
  * @brief Affiche un rapport des allocations non libérées
  *
  * Utile en fin de programme pour détecter les fuites mémoire.
+ * Les fuites sont regroupées par point d'appel (fichier:ligne).
  * Nécessite que le tracking soit activé.
  */
 void memory_report_leaks(void);
 
+/**
+ * @brief Affiche le churn (allocations/seconde) par point d'appel
+ *
+ * Pour chaque fichier:ligne : nombre d'allocations, allocations par
+ * seconde depuis l'activation du tracking, octets cumulés, pic et blocs
+ * vivants. Trié du callsite le plus actif au moins actif.
+ * Suivi de l'occupation des pools d'objets (memory_report_pools).
+ *
+ * @param max_sites Nombre maximum de lignes affichées (0 = toutes)
+ */
+void memory_report_churn(size_t max_sites);
+
 /**
  * @brief Retourne le nombre d'allocations actives
  *
@@ -75,6 +95,121 @@ void memory_cleanup_tracking(void);
 #define SAFE_MALLOC(size) safe_malloc_impl((size), __FILE__, __LINE__)
 #define SAFE_FREE(ptr) safe_free_impl((void**)&(ptr), __FILE__, __LINE__)
 
+// ═══════════════════════════════════════════════════════════════════════════
+// ARÈNE DE FRAME (allocations temporaires, durée de vie = 1 frame)
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Alloue dans l'arène de frame (allocateur linéaire)
+ *
+ * La mémoire est valide jusqu'au prochain frame_arena_reset() (en tête
+ * de boucle principale). Ne JAMAIS la passer à SAFE_FREE ni la conserver
+ * d'une frame à l'autre. Thread principal uniquement.
+ *
+ * Note: Utiliser les macros FRAME_ALLOC / FRAME_CALLOC
+ */
+void* frame_alloc_impl(size_t size, const char* file, int line);
+
+/**
+ * @brief Comme frame_alloc_impl, mais mémoire remise à zéro
+ */
+void* frame_calloc_impl(size_t size, const char* file, int line);
+
+/**
+ * @brief Rend toute la mémoire de l'arène (début de frame)
+ *
+ * Si la frame précédente a débordé (blocs chaînés), la chaîne est
+ * fusionnée en un bloc unique pour que les frames suivantes tiennent
+ * dans un seul bloc sans allocation. Un bloc resté bien plus grand que
+ * les frames récentes (pic de démarrage) est réduit après quelques
+ * secondes.
+ */
+void frame_arena_reset(void);
+
+/**
+ * @brief Retourne le maximum d'octets consommés sur une seule frame
+ */
+size_t frame_arena_get_high_water_mark(void);
+
+/**
+ * @brief Affiche capacité, high-water mark et nombre de débordements
+ */
+void frame_arena_report(void);
+
+/**
+ * @brief Libère les blocs de l'arène (fin de programme)
+ */
+void frame_arena_cleanup(void);
+
+#define FRAME_ALLOC(size) frame_alloc_impl((size), __FILE__, __LINE__)
+#define FRAME_CALLOC(size) frame_calloc_impl((size), __FILE__, __LINE__)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// POOLS D'OBJETS (nœuds de taille fixe, alloués/libérés en masse)
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct PoolSlab PoolSlab;
+
+/**
+ * @brief Pool d'objets de taille fixe (slabs + free list)
+ *
+ * À déclarer en static dans le module propriétaire avec OBJECT_POOL_INIT.
+ * Le pool s'enregistre tout seul à la première allocation pour apparaître
+ * dans memory_report_pools(). Thread principal uniquement.
+ */
+typedef struct ObjectPool {
+    const char* name;           // Nom affiché dans les rapports
+    size_t object_size;         // sizeof(T) demandé
+    size_t slab_objects;        // Objets dans le prochain slab (doublé à chaque slab)
+    size_t stride;              // Taille réelle d'un emplacement (alignée)
+    PoolSlab* slabs;            // Slabs alloués (liste chaînée)
+    void* free_list;            // Emplacements libres (chaînés en place)
+    bool registered;            // Déjà présent dans le registre des pools
+    size_t slab_count;
+    size_t capacity;            // Emplacements totaux
+    size_t live;                // Emplacements occupés
+    size_t peak_live;
+    size_t total_allocs;
+    size_t total_frees;
+    size_t poison_errors;       // Écritures détectées après libération
+    size_t double_frees;        // Double libérations interceptées
+} ObjectPool;
+
+#define OBJECT_POOL_INIT(pool_name, type, first_slab_objects) \
+    { .name = (pool_name), .object_size = sizeof(type), .slab_objects = (first_slab_objects) }
+
+/**
+ * @brief Prend un emplacement dans le pool (mémoire remise à zéro)
+ *
+ * Note: Utiliser la macro POOL_ALLOC
+ */
+void* pool_alloc_impl(ObjectPool* pool, const char* file, int line);
+
+/**
+ * @brief Rend un emplacement au pool et met le pointeur à NULL
+ *
+ * En build debug (sans NDEBUG) l'emplacement est empoisonné : une écriture
+ * après libération ou une double libération est signalée.
+ *
+ * Note: Utiliser la macro POOL_FREE
+ */
+void pool_free_impl(ObjectPool* pool, void** ptr, const char* file, int line);
+
+/**
+ * @brief Affiche l'occupation de tous les pools (slabs, vivants, pic)
+ */
+void memory_report_pools(void);
+
+/**
+ * @brief Libère les slabs de tous les pools (fin de programme)
+ *
+ * Les objets encore vivants sont signalés comme fuites de pool.
+ */
+void memory_pools_cleanup(void);
+
+#define POOL_ALLOC(pool) pool_alloc_impl(&(pool), __FILE__, __LINE__)
+#define POOL_FREE(pool, ptr) pool_free_impl(&(pool), (void**)&(ptr), __FILE__, __LINE__)
+
 // Macro pour cleanup automatique en fin de scope (GCC/Clang)
 #if defined(__GNUC__) || defined(__clang__)
     #define AUTO_FREE __attribute__((cleanup(auto_free_cleanup)))
@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "memory.h"
+#include "core/debug.h"
+#include <stdint.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// POOLS D'OBJETS DE TAILLE FIXE
+// ═══════════════════════════════════════════════════════════════════════════
+// - Les objets sont découpés dans des slabs (un SAFE_MALLOC pour N objets),
+//   chaque nouveau slab est 2× plus grand que le précédent (plafonné)
+// - Free list chaînée en place dans les emplacements libres : alloc et free
+//   en O(1), sans passer par malloc une fois le pool chaud
+// - Les slabs ne sont rendus qu'en fin de programme (memory_pools_cleanup)
+// - Sans NDEBUG : empoisonnement des emplacements libérés pour détecter les
+//   écritures après libération et les doubles libérations
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define POOL_MAX_REGISTERED 16
+#define POOL_MAX_SLAB_BYTES (1024 * 1024)   // Plafond de la croissance des slabs
+#define POOL_ALIGN (_Alignof(max_align_t))
+
+#ifndef NDEBUG
+    #define POOL_DEBUG_POISON 1
+    #define POOL_POISON_BYTE 0xDD
+    #define POOL_POISON_CHECK_BYTES 256     // Vérification bornée (gros objets)
+#endif
+
+struct PoolSlab {
+    PoolSlab* next;
+    size_t object_count;
+    max_align_t data[];         // Emplacements (alignement garanti)
+};
+
+static ObjectPool* registered_pools[POOL_MAX_REGISTERED];
+static size_t registered_count = 0;
+
+static void pool_register(ObjectPool* pool) {
+    pool->registered = true;
+    if (registered_count < POOL_MAX_REGISTERED) {
+        registered_pools[registered_count++] = pool;
+    } else {
+        debug_printf("⚠️ POOL: registre plein, '%s' absent des rapports\n", pool->name);
+    }
+}
+
+// Premier champ d'un emplacement libre = lien vers le suivant
+static inline void* slot_next(void* slot) {
+    void* next;
+    memcpy(&next, slot, sizeof(next));
+    return next;
+}
+
+static inline void slot_set_next(void* slot, void* next) {
+    memcpy(slot, &next, sizeof(next));
+}
+
+static bool pool_grow(ObjectPool* pool, const char* file, int line) {
+    if (pool->stride == 0) {
+        size_t size = pool->object_size < sizeof(void*) ? sizeof(void*) : pool->object_size;
+        pool->stride = (size + POOL_ALIGN - 1) & ~(POOL_ALIGN - 1);
+    }
+
+    size_t max_objects = POOL_MAX_SLAB_BYTES / pool->stride;
+    if (max_objects == 0) max_objects = 1;
+
+    size_t object_count = pool->slab_objects ? pool->slab_objects : 16;
+    if (object_count > max_objects) object_count = max_objects;
+
+    PoolSlab* slab = SAFE_MALLOC(sizeof(PoolSlab) + object_count * pool->stride);
+    if (!slab) {
+        debug_printf("❌ POOL '%s': échec allocation slab (%zu objets) depuis %s:%d\n",
+                     pool->name, object_count, file, line);
+        return false;
+    }
+
+    slab->object_count = object_count;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->slab_count++;
+    pool->capacity += object_count;
+    pool->slab_objects = object_count * 2;
+
+    // Chaîner à l'envers pour que la free list serve les adresses croissantes
+    unsigned char* base = (unsigned char*)slab->data;
+    for (size_t i = object_count; i-- > 0; ) {
+        void* slot = base + i * pool->stride;
+#ifdef POOL_DEBUG_POISON
+        memset(slot, POOL_POISON_BYTE, pool->stride);
+#endif
+        slot_set_next(slot, pool->free_list);
+        pool->free_list = slot;
+    }
+
+    debug_verbose("🧱 POOL '%s': slab de %zu objets (%zu octets), capacité %zu\n",
+                  pool->name, object_count, object_count * pool->stride, pool->capacity);
+    return true;
+}
+
+#ifdef POOL_DEBUG_POISON
+// Vrai si l'emplacement porte encore le poison posé à la libération
+static bool slot_is_poisoned(const ObjectPool* pool, const void* slot) {
+    const unsigned char* bytes = (const unsigned char*)slot + sizeof(void*);
+    size_t check = pool->stride - sizeof(void*);
+    if (check > POOL_POISON_CHECK_BYTES) check = POOL_POISON_CHECK_BYTES;
+
+    for (size_t i = 0; i < check; i++) {
+        if (bytes[i] != POOL_POISON_BYTE) return false;
+    }
+    return true;
+}
+
+static bool pool_owns(const ObjectPool* pool, const void* ptr) {
+    for (const PoolSlab* slab = pool->slabs; slab; slab = slab->next) {
+        const unsigned char* base = (const unsigned char*)slab->data;
+        const unsigned char* p = (const unsigned char*)ptr;
+        if (p >= base && p < base + slab->object_count * pool->stride) {
+            return ((size_t)(p - base) % pool->stride) == 0;
+        }
+    }
+    return false;
+}
+#endif
+
+void* pool_alloc_impl(ObjectPool* pool, const char* file, int line) {
+    if (!pool) return NULL;
+
+    if (!pool->registered) {
+        pool_register(pool);
+    }
+
+    if (!pool->free_list && !pool_grow(pool, file, line)) {
+        return NULL;
+    }
+
+    void* slot = pool->free_list;
+    pool->free_list = slot_next(slot);
+
+#ifdef POOL_DEBUG_POISON
+    if (!slot_is_poisoned(pool, slot)) {
+        pool->poison_errors++;
+        debug_printf("❌ POOL '%s': emplacement %p modifié après libération (détecté depuis %s:%d)\n",
+                     pool->name, slot, file, line);
+    }
+#endif
+
+    memset(slot, 0, pool->object_size);
+
+    pool->live++;
+    pool->total_allocs++;
+    if (pool->live > pool->peak_live) {
+        pool->peak_live = pool->live;
+    }
+
+    return slot;
+}
+
+void pool_free_impl(ObjectPool* pool, void** ptr, const char* file, int line) {
+    if (!pool || !ptr || !*ptr) return;
+
+    void* slot = *ptr;
+
+#ifdef POOL_DEBUG_POISON
+    if (!pool_owns(pool, slot)) {
+        debug_printf("❌ POOL '%s': %p n'appartient pas au pool (depuis %s:%d)\n",
+                     pool->name, slot, file, line);
+        *ptr = NULL;
+        return;
+    }
+
+    if (slot_is_poisoned(pool, slot)) {
+        pool->double_frees++;
+        debug_printf("❌ POOL '%s': double libération de %p depuis %s:%d\n",
+                     pool->name, slot, file, line);
+        *ptr = NULL;
+        return;
+    }
+
+    memset(slot, POOL_POISON_BYTE, pool->stride);
+#else
+    (void)file;
+    (void)line;
+#endif
+
+    slot_set_next(slot, pool->free_list);
+    pool->free_list = slot;
+
+    pool->live--;
+    pool->total_frees++;
+    *ptr = NULL;
+}
+
+void memory_report_pools(void) {
+    if (registered_count == 0) return;
+
+    debug_subsection("POOLS D'OBJETS");
+    debug_printf("  %-16s %7s %6s %9s %8s %8s %10s %10s\n",
+                 "Pool", "Taille", "Slabs", "Capacité", "Vivants", "Pic", "Allocs", "Frees");
+
+    for (size_t i = 0; i < registered_count; i++) {
+        const ObjectPool* pool = registered_pools[i];
+        debug_printf("  %-16s %7zu %6zu %9zu %8zu %8zu %10zu %10zu\n",
+                     pool->name, pool->object_size, pool->slab_count, pool->capacity,
+                     pool->live, pool->peak_live, pool->total_allocs, pool->total_frees);
+
+        if (pool->poison_errors || pool->double_frees) {
+            debug_printf("    ⚠️ %zu écriture(s) après libération, %zu double(s) libération(s)\n",
+                         pool->poison_errors, pool->double_frees);
+        }
+    }
+}
+
+void memory_pools_cleanup(void) {
+    for (size_t i = 0; i < registered_count; i++) {
+        ObjectPool* pool = registered_pools[i];
+
+        if (pool->live > 0) {
+            debug_printf("💧 POOL '%s': %zu objet(s) jamais rendu(s)\n", pool->name, pool->live);
+        }
+
+        PoolSlab* slab = pool->slabs;
+        while (slab) {
+            PoolSlab* next = slab->next;
+            SAFE_FREE(slab);
+            slab = next;
+        }
+
+        pool->slabs = NULL;
+        pool->free_list = NULL;
+        pool->slab_count = 0;
+        pool->capacity = 0;
+        pool->live = 0;
+        pool->registered = false;
+    }
+
+    registered_count = 0;
+}
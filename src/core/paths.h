@@ -33,6 +33,10 @@
 #define CONFIG_FILE             "../config/respiration.conf"
 #define CONFIG_WIDGETS          "../config/widgets_config.json"
 #define CONFIG_STATS_DIR        "../config/stats"
+#define CONFIG_STATS_LOG        CONFIG_STATS_DIR "/exercises.log"
+#define CONFIG_STATS_INDEX      CONFIG_STATS_DIR "/exercises.idx"
+#define CONFIG_STATS_ROLLUP     CONFIG_STATS_DIR "/exercises.rollup"
+#define CONFIG_STATS_EXCHANGE   CONFIG_STATS_DIR "/exercises.csv"   // Export/import du panneau
 
 /* ═══════════════════════════════════════════════════════════════════════════
  * FICHIERS GÉNÉRÉS (pour l'éditeur JSON)
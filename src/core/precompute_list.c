@@ -6,10 +6,13 @@
 #include "precompute_list.h"
 #include "config.h"
 #include "debug.h"
+#include "trace.h"
 #include "constants.h"
 #include "core/error/error.h"
 #include "core/memory/memory.h"
 
+// Pool des nœuds d'hexagones (recréés à chaque rechargement de config)
+static ObjectPool hexagone_node_pool = OBJECT_POOL_INIT("HexagoneNode", HexagoneNode, 8);
 
 /*------------------------------ Nouvelle Liste ------------------------------------*/
 
@@ -41,7 +44,7 @@ int hexagone_list_count(HexagoneList *li){
 void add_hexagone(HexagoneList* list, Hexagon* hex, Animation* anim) {
     if (!list || !hex) return;
 
-    HexagoneNode* new_node = SAFE_MALLOC(sizeof(HexagoneNode));
+    HexagoneNode* new_node = POOL_ALLOC(hexagone_node_pool);
     if (!new_node) return;
 
     new_node->data = hex;
@@ -112,6 +115,8 @@ void sinusoidal_movement(double frame_time, const SinusoidalConfig* config, Sinu
 void precompute_all_cycles(HexagoneList* list, int fps, float breath_duration) {
     if (!list) return;
 
+    TRACE_BEGIN("precompute_all_cycles");
+
     // CALCUL UNIQUE avant la boucle
     int cycles_for_alignment = calculate_alignment_cycles();
     int total_frames = (int)(cycles_for_alignment * fps * breath_duration);
@@ -227,6 +232,8 @@ next_node:
         }
         node = node->next;
     }
+
+    TRACE_END("precompute_all_cycles");
 }
 
 /*------------------------- Copie liste de points -----------------------------*/
@@ -295,7 +302,7 @@ void free_hexagone_list(HexagoneList* list) {
             free_animation(current->animation);
         }
         free_hexagon(current->data);
-        SAFE_FREE(current);
+        POOL_FREE(hexagone_node_pool, current);
         current = next;
     }
     SAFE_FREE(list);
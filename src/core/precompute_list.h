@@ -95,6 +95,10 @@ void precompute_counter_frames(HexagoneNode* node, int total_frames, int fps,
 // À appeler à la fin de l'animation pour économiser la mémoire
 void free_precomputed_data(HexagoneList* list);
 
+// Délai sur l'écran d'accueil (aucune technique active) au-delà duquel les
+// tables gardées pour un nouveau clic sur Wim sont libérées
+#define PRECOMPUTE_IDLE_MS 60000
+
 // 🆕 HELPERS POUR ÉLIMINER DUPLICATION DES BOUCLES while(node)
 // Freeze tous les hexagones (is_frozen = true)
 void freeze_all_hexagones(HexagoneList* list);
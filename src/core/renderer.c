@@ -5,8 +5,14 @@
 #include "json_config_loader.h"
 #include "session_card.h"
 #include "debug.h"
+#include "trace.h"
+#include "config_deps.h"
+#include "file_watcher.h"
+#include "asset_loader.h"
+#include "startup_timeline.h"
 #include "constants.h"
 #include "paths.h"
+#include "core/memory/memory.h"
 #include "instances/technique_instance.h"
 #include "instances/whm/whm.h"
 #include <SDL2/SDL_image.h>
@@ -327,8 +333,8 @@ static void setup_welcome_screen(AppState* app) {
 
     app->waiting_to_start = true;  // Commence sur l'écran d'accueil
 
-    // Charger l'image wim.png
-    SDL_Surface* wim_surface = IMG_Load(IMG_WIM);
+    // Charger l'image wim.png (décodée en arrière-plan par asset_loader)
+    SDL_Surface* wim_surface = asset_load_surface(IMG_WIM);
     if (!wim_surface) {
         debug_printf("⚠️  Impossible de charger wim.png: %s\n", IMG_GetError());
         app->wim_image = NULL;
@@ -340,22 +346,36 @@ static void setup_welcome_screen(AppState* app) {
             debug_printf("⚠️  Impossible de créer texture wim.png\n");
         }
     }
+    startup_mark("texture wim.png");
 
     // Créer le titre "Technique\nWim Hof" en Cairo
     app->wim_title = create_wim_title_texture(app->renderer, FONT_ARIAL_REGULAR);
     if (!app->wim_title) {
         debug_printf("⚠️  Impossible de créer titre Wim Hof\n");
     }
+    startup_mark("titre Cairo");
 
     debug_printf("✅ Écran d'accueil Wim Hof créé\n");
 }
 
 // Initialise toute la partie SDL et graphique
+// Seul ce qui apparaît sur la première frame (écran d'accueil) est créé ici ;
+// le reste l'est par finish_deferred_startup() juste après son affichage.
 bool initialize_app(AppState* app, const char* title, const char* image_path) {
+    startup_mark("initialize_app");
+
+    // 0. Décodage des images en parallèle de l'initialisation SDL/fenêtre
+    const char* const preload[] = {
+        image_path, IMG_WIM, IMG_SETTINGS_ICON, IMG_SETTINGS_BG, IMG_VERT
+    };
+    asset_loader_start(preload, (int)(sizeof(preload) / sizeof(preload[0])));
+
     // 1. Initialisation SDL, TTF et polices
     if (!init_sdl_and_fonts()) {
+        asset_loader_stop();
         return false;
     }
+    startup_mark("SDL, TTF et polices");
 
     // 2. Création fenêtre plein écran
     app->window = SDL_CreateWindow(title,
@@ -364,8 +384,10 @@ bool initialize_app(AppState* app, const char* title, const char* image_path) {
                                    SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
     if (!app->window) {
         SDL_Log("ERREUR Fenêtre: %s", SDL_GetError());
+        asset_loader_stop();
         return false;
     }
+    startup_mark("fenêtre");
 
     // 3. Création renderer
     app->renderer = SDL_CreateRenderer(
@@ -375,13 +397,16 @@ bool initialize_app(AppState* app, const char* title, const char* image_path) {
 
     if (!app->renderer) {
         SDL_Log("ERREUR Renderer: %s", SDL_GetError());
+        asset_loader_stop();
         return false;
     }
+    startup_mark("renderer");
 
-    // 4. Chargement image de fond
-    SDL_Surface* surface = IMG_Load(image_path);
+    // 4. Texture de l'image de fond (décodage probablement déjà terminé)
+    SDL_Surface* surface = asset_load_surface(image_path);
     if (!surface) {
         SDL_Log("ERREUR Chargement image %s: %s", image_path, SDL_GetError());
+        asset_loader_stop();
         return false;
     }
 
@@ -389,8 +414,10 @@ bool initialize_app(AppState* app, const char* title, const char* image_path) {
     SDL_FreeSurface(surface);
     if (!app->background) {
         SDL_Log("ERREUR Texture: %s", SDL_GetError());
+        asset_loader_stop();
         return false;
     }
+    startup_mark("texture de fond");
 
     // 5. Récupération taille FENÊTRE (pas écran) pour usage futur
     // ════════════════════════════════════════════════════════════════════════
@@ -407,6 +434,42 @@ bool initialize_app(AppState* app, const char* title, const char* image_path) {
     // 6. Initialisation des autres champs
     app->hexagones = NULL;
     app->is_running = true;
+    app->settings_panel = NULL;     // Créé après la première frame
+    app->json_editor = NULL;        // Idem
+    app->startup_complete = false;
+    app->resize_pending = false;
+    app->resize_snapshot = NULL;
+
+    // Chargement de la configuration
+    load_config(&app->config);
+
+    // Initialisation FPS adaptatif
+    app->last_interaction_time = SDL_GetTicks();
+    app->editor_has_focus = false;
+    app->last_editor_event = 0;
+
+    // Configuration de l'écran d'accueil Wim Hof
+    setup_welcome_screen(app);
+
+    debug_printf("Application initialisée: %dx%d\n", app->screen_width, app->screen_height);
+    startup_mark("initialize_app terminé");
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DÉMARRAGE DIFFÉRÉ (après la première frame)
+// ═══════════════════════════════════════════════════════════════════════════
+// Rien de ceci n'est nécessaire pour afficher l'écran d'accueil : le panneau
+// (fermé, seule l'icône d'engrenage est visible), l'éditeur JSON, les
+// templates et la surveillance des fichiers. Appelé une seule fois, depuis
+// render_app(), une fois la première frame présentée.
+static void finish_deferred_startup(AppState* app) {
+    app->startup_complete = true;
+    startup_first_frame();
+
+    TRACE_BEGIN("deferred_startup");
+
+    // Panneau de réglages
     app->settings_panel = create_settings_panel(
         app->renderer,
         app->window,       // ← Passer la fenêtre pour gérer la taille minimale
@@ -414,9 +477,10 @@ bool initialize_app(AppState* app, const char* title, const char* image_path) {
         app->screen_height,
         app->scale_factor
     );
+    startup_mark("panneau de réglages");
 
     // ════════════════════════════════════════════════════════════════════════
-    // 6a. INITIALISER LE CALLBACK CONTEXT DU PANNEAU
+    // INITIALISER LE CALLBACK CONTEXT DU PANNEAU
     // ════════════════════════════════════════════════════════════════════════
     // Remplace les 10 variables globales statiques par un contexte unifié
     if (app->settings_panel) {
@@ -428,7 +492,7 @@ bool initialize_app(AppState* app, const char* title, const char* image_path) {
     }
 
     // ════════════════════════════════════════════════════════════════════════
-    // 6b. SYNCHRONISER CONFIG → WIDGETS
+    // SYNCHRONISER CONFIG → WIDGETS
     // ════════════════════════════════════════════════════════════════════════
     // Les widgets sont créés avec les valeurs du JSON (valeur_depart)
     // Mais on doit les mettre à jour avec les valeurs de respiration.conf
@@ -437,7 +501,7 @@ bool initialize_app(AppState* app, const char* title, const char* image_path) {
     }
 
     // ════════════════════════════════════════════════════════════════════════
-    // 6c. DÉFINIR LA LARGEUR MINIMALE DE FENÊTRE
+    // DÉFINIR LA LARGEUR MINIMALE DE FENÊTRE
     // ════════════════════════════════════════════════════════════════════════
     // Empêcher que les widgets ne sortent de la fenêtre par la droite
     // en définissant une largeur minimale basée sur le plus grand widget
@@ -449,29 +513,239 @@ bool initialize_app(AppState* app, const char* title, const char* image_path) {
     if (!generer_templates_json(CONFIG_WIDGETS, GENERATED_TEMPLATES_JSON)) {
         debug_printf("⚠️ Impossible de générer templates.json (non bloquant)\n");
     }
+    startup_mark("templates JSON");
 
     // Création de la fenêtre éditeur JSON avec positionnement responsive
     create_json_editor_window(app);
+    startup_mark("éditeur JSON");
+
+    // Surveillance des fichiers (hot reload) : config, templates, historique
+    file_watcher_add(CONFIG_WIDGETS, false);
+    file_watcher_add(CONFIG_FILE, false);
+    file_watcher_add(GENERATED_TEMPLATES_JSON, false);
+    file_watcher_add(CONFIG_STATS_DIR, true);
+    if (!file_watcher_start()) {
+        debug_printf("⚠️ Hot reload désactivé (surveillance des fichiers indisponible)\n");
+    }
 
-    // Chargement de la configuration
-    load_config(&app->config);
+    // Toutes les images préchargées ont été récupérées (ou ne le seront plus)
+    asset_loader_stop();
+    startup_mark("démarrage différé terminé");
 
-    // Initialisation FPS adaptatif
-    app->last_interaction_time = SDL_GetTicks();
-    app->editor_has_focus = false;
-    app->last_editor_event = 0;
+    TRACE_END("deferred_startup");
+    startup_report();
+}
 
-    // Configuration de l'écran d'accueil Wim Hof
-    setup_welcome_screen(app);
+// ═══════════════════════════════════════════════════════════════════════════
+// REDIMENSIONNEMENT DIFFÉRÉ
+// ═══════════════════════════════════════════════════════════════════════════
+// handle_app_events() ne fait que noter qu'un redimensionnement est en cours.
+// Tant que la taille bouge, render_app() affiche une copie étirée de la
+// dernière frame (resize_snapshot) ; le recalcul des hexagones, du panneau
+// (dont les frames du preview) et de la carte de session n'est fait qu'une
+// fois, RESIZE_SETTLE_MS après le dernier événement.
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void render_scene(AppState* app);
+
+// Capture la scène à l'ancienne taille dans une texture cible
+static void resize_capture_snapshot(AppState* app) {
+    if (app->resize_snapshot || !SDL_RenderTargetSupported(app->renderer)) return;
+
+    SDL_Texture* snapshot = SDL_CreateTexture(app->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                              SDL_TEXTUREACCESS_TARGET,
+                                              app->screen_width, app->screen_height);
+    if (!snapshot) {
+        debug_printf("⚠️ Capture avant redimensionnement impossible : %s\n", SDL_GetError());
+        return;
+    }
 
-    debug_printf("Application initialisée: %dx%d\n", app->screen_width, app->screen_height);
-    return true;
+    if (SDL_SetRenderTarget(app->renderer, snapshot) != 0) {
+        SDL_DestroyTexture(snapshot);
+        return;
+    }
+    render_scene(app);
+    SDL_SetRenderTarget(app->renderer, NULL);
+
+    app->resize_snapshot = snapshot;
+}
+
+static void resize_release_snapshot(AppState* app) {
+    if (app->resize_snapshot) {
+        SDL_DestroyTexture(app->resize_snapshot);
+        app->resize_snapshot = NULL;
+    }
+}
+
+// Recalcul complet pour la taille actuelle de la fenêtre
+static void apply_window_resize(AppState* app) {
+    TRACE_BEGIN("apply_window_resize");
+
+    // Sauvegarder l'ancienne taille AVANT de la mettre à jour
+    int old_width = app->screen_width;
+    int old_height = app->screen_height;
+
+    // Récupérer la nouvelle taille
+    SDL_GetWindowSize(app->window, &app->screen_width, &app->screen_height);
+
+    debug_printf("🔄 Fenêtre redimensionnée : %dx%d → %dx%d\n",
+                 old_width, old_height,
+                 app->screen_width, app->screen_height);
+
+    // ═══════════════════════════════════════════════════════════════
+    // RECALCULER LE FACTEUR D'ÉCHELLE
+    // ═══════════════════════════════════════════════════════════════
+    app->scale_factor = calculate_scale_factor(app->screen_width, app->screen_height);
+
+    debug_printf("📏 Nouveau facteur d'échelle : %.2f\n", app->scale_factor);
+
+    // ═══════════════════════════════════════════════════════════════
+    // ÉTAPE 1 : RECENTRER L'HEXAGONE PRINCIPAL
+    // ═══════════════════════════════════════════════════════════════
+    if (app->hexagones && app->hexagones->first) {
+        // Calculer le nouveau centre de la fenêtre
+        int new_center_x = app->screen_width / 2;
+        int new_center_y = app->screen_height / 2;
+
+        // Calculer l'ancien centre (pour les offsets)
+        int old_center_x = old_width / 2;
+        int old_center_y = old_height / 2;
+
+        debug_printf("📐 Ancien centre: (%d,%d), Nouveau centre: (%d,%d)\n",
+                     old_center_x, old_center_y, new_center_x, new_center_y);
+
+        // IMPORTANT : Parcourir TOUS les hexagones
+        HexagoneNode* node = app->hexagones->first;
+        int hex_count = 0;
+
+        // ═══════════════════════════════════════════════════════════════
+        // UTILISER DIRECTEMENT LE SCALE_FACTOR
+        // ═══════════════════════════════════════════════════════════════
+        // Au lieu de calculer un ratio entre ancien/nouveau container,
+        // on utilise directement le scale_factor qui est déjà calculé
+        // par rapport à la résolution de référence (1280x720).
+        // Cela permet de scaler correctement même si on change juste
+        // la largeur ou la hauteur.
+        // ═══════════════════════════════════════════════════════════════
+        debug_printf("📏 Application du scale_factor : %.3f\n", app->scale_factor);
+
+        while (node && node->data) {
+            Hexagon* hex = node->data;
+
+            // ─────────────────────────────────────────────────────────────
+            // ÉTAPE 1 : REPOSITIONNER LE CENTRE
+            // ─────────────────────────────────────────────────────────────
+            // Calculer l'offset de CET hexagone par rapport à l'ANCIEN centre
+            int offset_x = hex->center_x - old_center_x;
+            int offset_y = hex->center_y - old_center_y;
+
+            // Appliquer le NOUVEAU centre + offset
+            hex->center_x = new_center_x + offset_x;
+            hex->center_y = new_center_y + offset_y;
+
+            // ─────────────────────────────────────────────────────────────
+            // ÉTAPE 2 : METTRE À JOUR L'ÉCHELLE
+            // ─────────────────────────────────────────────────────────────
+            // ⚠️ IMPORTANT : On ne recalcule PAS les sommets !
+            //
+            // Les hexagones utilisent un système de coordonnées RELATIVES :
+            // - vx[i], vy[i] = coordonnées relatives au centre (fixes)
+            // - current_scale = facteur d'échelle appliqué lors du rendu
+            //
+            // Dans make_hexagone() (geometry.c ligne 29) :
+            //   absolute_x = center_x + (vx[i] * current_scale)
+            //
+            // On applique directement le scale_factor calculé
+            // ─────────────────────────────────────────────────────────────
+            hex->current_scale = app->scale_factor;
+
+            debug_printf("  ✅ Hexagone %d - Centre:(%d,%d) Scale:%.3f\n",
+                         hex_count, hex->center_x, hex->center_y,
+                         hex->current_scale);
+
+            hex_count++;
+            node = node->next;
+        }
+
+        debug_printf("✅ %d hexagones redimensionnés (scale_factor: %.3f)\n",
+                     hex_count, app->scale_factor);
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // ÉTAPE 2 : REPOSITIONNER LE PANNEAU DE CONFIGURATION
+    // ═══════════════════════════════════════════════════════════════
+    if (app->settings_panel) {
+        // Mettre à jour le scale du panneau
+        update_panel_scale(app->settings_panel,
+                           app->screen_width,
+                           app->screen_height,
+                           app->scale_factor);
+
+        debug_printf("✅ Panneau mis à jour avec nouveau scale\n");
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // ÉTAPE 3 : REPOSITIONNER LA CARTE DE SESSION (si WHM actif)
+    // ═══════════════════════════════════════════════════════════════
+    if (app->active_technique) {
+        // Mettre à jour les infos d'écran dans WHM
+        whm_set_screen_info(app->active_technique, app->screen_width,
+                           app->screen_height, app->scale_factor);
+        debug_printf("✅ Infos d'écran mises à jour dans WHM\n");
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // ÉTAPE 4 : ZONE CLIQUABLE WIM HOF
+    // ═══════════════════════════════════════════════════════════════
+    // La zone cliquable sera automatiquement mise à jour lors du prochain
+    // rendu de l'écran d'accueil (ligne 940: app->wim_clickable_rect = img_rect)
+    // Pas besoin de la recalculer manuellement ici
+
+    TRACE_END("apply_window_resize");
 }
 
 // Gestion des événements de l'application
+// Réaction à un fichier modifié sur disque (événement du file_watcher)
+static void handle_watched_file_change(AppState* app, int watch_id) {
+    const char* path = file_watcher_path(watch_id);
+    if (!path) return;
+
+    if (strcmp(path, CONFIG_WIDGETS) == 0) {
+        if (app->settings_panel) {
+            handle_json_file_changed(app->settings_panel, app->screen_width, app->screen_height);
+        }
+        if (app->json_editor) {
+            recharger_json_si_modifie(app->json_editor);
+        }
+    } else if (strcmp(path, CONFIG_FILE) == 0) {
+        load_config(&app->config);
+        debug_printf("🔥 HOT RELOAD: %s rechargé\n", path);
+
+        // Ne pas écraser des réglages en cours d'édition dans le panneau
+        if (app->settings_panel && app->settings_panel->state == PANEL_CLOSED &&
+            app->settings_panel->widget_list) {
+            app->settings_panel->temp_config = app->config;
+            sync_config_to_widgets(&app->config, app->settings_panel->widget_list);
+        }
+    } else {
+        // Templates et historique sont relus à l'ouverture du menu / des stats
+        debug_printf("👀 %s modifié (pris en compte à la prochaine ouverture)\n", path);
+    }
+
+    app->last_interaction_time = SDL_GetTicks();
+}
+
 void handle_app_events(AppState* app, SDL_Event* event) {
     if (!app) return;
 
+    // ─────────────────────────────────────────────────────────────────────────
+    // PRIORITÉ 0 : Fichier surveillé modifié (hot reload)
+    // ─────────────────────────────────────────────────────────────────────────
+    if (event->type == file_watcher_event_type) {
+        handle_watched_file_change(app, event->user.code);
+        return;
+    }
+
     // ─────────────────────────────────────────────────────────────────────────
     // PRIORITÉ 1 : Éditeur JSON (si ouvert)
     // ─────────────────────────────────────────────────────────────────────────
@@ -545,36 +819,55 @@ void handle_app_events(AppState* app, SDL_Event* event) {
                 }
 
                 // ═════════════════════════════════════════════════════════════════
-                // ÉTAPE 3 : PRÉ-CALCULS (~100 MB) - PARTIE DU CORE
+                // ÉTAPE 3 : PRÉ-CALCULS - PARTIE DU CORE
                 // ═════════════════════════════════════════════════════════════════
-                // ⚠️  Libérer les anciennes données précompilées avant de réallouer
-                // (évite memory leak si on reclique plusieurs fois)
-                if (app->hexagones) {
-                    free_precomputed_data(app->hexagones);
-                    debug_printf("🗑️  Anciennes données précompilées libérées\n");
-                }
+                // Les tables ne dépendent que de breath_duration (et de la taille
+                // des hexagones) : on ne les refait que si l'un des deux a changé
+                int container_size = (app->screen_width < app->screen_height)
+                    ? app->screen_width : app->screen_height;
+                uint64_t tables_key = derived_context_key(&container_size, sizeof(container_size));
+                bool tables_present = app->hexagones && app->hexagones->first &&
+                                      app->hexagones->first->precomputed_vx;
+
+                if (!tables_present) derived_invalidate(DERIVED_HEXAGON_TABLES);
+
+                HexagoneNode* node;
+                if (tables_present &&
+                    derived_is_current(DERIVED_HEXAGON_TABLES, &app->config, tables_key)) {
+                    debug_printf("♻️  Pré-calculs conservés (breath_duration=%.1fs)\n",
+                                 app->config.breath_duration);
+                } else {
+                    // ⚠️  Libérer les anciennes données précompilées avant de réallouer
+                    // (évite memory leak si on reclique plusieurs fois)
+                    if (app->hexagones) {
+                        free_precomputed_data(app->hexagones);
+                        debug_printf("🗑️  Anciennes données précompilées libérées\n");
+                    }
 
-                debug_printf("🔢 Lancement des pré-calculs (breath_duration=%.1fs)...\n",
-                             app->config.breath_duration);
-                Uint32 precompute_start = SDL_GetTicks();
+                    debug_printf("🔢 Lancement des pré-calculs (breath_duration=%.1fs)...\n",
+                                 app->config.breath_duration);
+                    Uint32 precompute_start = SDL_GetTicks();
+
+                    precompute_all_cycles(app->hexagones, TARGET_FPS, app->config.breath_duration);
+
+                    node = app->hexagones->first;
+                    while (node) {
+                        precompute_counter_frames(
+                            node,
+                            node->total_cycles,
+                            TARGET_FPS,
+                            app->config.breath_duration,
+                            app->config.Nb_respiration
+                        );
+                        node = node->next;
+                    }
 
-                precompute_all_cycles(app->hexagones, TARGET_FPS, app->config.breath_duration);
+                    derived_mark_built(DERIVED_HEXAGON_TABLES, &app->config, tables_key);
 
-                HexagoneNode* node = app->hexagones->first;
-                while (node) {
-                    precompute_counter_frames(
-                        node,
-                        node->total_cycles,
-                        TARGET_FPS,
-                        app->config.breath_duration,
-                        app->config.Nb_respiration
-                    );
-                    node = node->next;
+                    Uint32 precompute_time = SDL_GetTicks() - precompute_start;
+                    debug_printf("✅ Pré-calculs terminés en %u ms\n", precompute_time);
                 }
 
-                Uint32 precompute_time = SDL_GetTicks() - precompute_start;
-                debug_printf("✅ Pré-calculs terminés en %u ms\n", precompute_time);
-
                 // ═════════════════════════════════════════════════════════════════
                 // ÉTAPE 4 : CRÉER L'INSTANCE DE LA TECHNIQUE WIM HOF
                 // ═════════════════════════════════════════════════════════════════
@@ -682,129 +975,16 @@ void handle_app_events(AppState* app, SDL_Event* event) {
                 event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
                 // 2. Redimensionnement de la fenêtre
                 // ─────────────────────────────────────────────────────────────
-                // Quand l'utilisateur redimensionne la fenêtre, on met à jour
-                // les dimensions et on repositionne TOUS les éléments
+                // Un glissement produit des dizaines d'événements par seconde :
+                // on ne retient que la dernière taille, le recalcul complet est
+                // fait par render_app() une fois la taille stabilisée
                 // ─────────────────────────────────────────────────────────────
-
-                // Sauvegarder l'ancienne taille AVANT de la mettre à jour
-                int old_width = app->screen_width;
-                int old_height = app->screen_height;
-
-                // Récupérer la nouvelle taille
-                SDL_GetWindowSize(app->window, &app->screen_width, &app->screen_height);
-
-                debug_printf("🔄 Fenêtre redimensionnée : %dx%d → %dx%d\n",
-                             old_width, old_height,
-                             app->screen_width, app->screen_height);
-
-                // ═══════════════════════════════════════════════════════════════
-                // RECALCULER LE FACTEUR D'ÉCHELLE
-                // ═══════════════════════════════════════════════════════════════
-                app->scale_factor = calculate_scale_factor(app->screen_width, app->screen_height);
-
-                debug_printf("📏 Nouveau facteur d'échelle : %.2f\n", app->scale_factor);
-
-                // ═══════════════════════════════════════════════════════════════
-                // ÉTAPE 1 : RECENTRER L'HEXAGONE PRINCIPAL
-                // ═══════════════════════════════════════════════════════════════
-                if (app->hexagones && app->hexagones->first) {
-                    // Calculer le nouveau centre de la fenêtre
-                    int new_center_x = app->screen_width / 2;
-                    int new_center_y = app->screen_height / 2;
-
-                    // Calculer l'ancien centre (pour les offsets)
-                    int old_center_x = old_width / 2;
-                    int old_center_y = old_height / 2;
-
-                    debug_printf("📐 Ancien centre: (%d,%d), Nouveau centre: (%d,%d)\n",
-                                 old_center_x, old_center_y, new_center_x, new_center_y);
-
-                    // IMPORTANT : Parcourir TOUS les hexagones
-                    HexagoneNode* node = app->hexagones->first;
-                    int hex_count = 0;
-
-                    // ═══════════════════════════════════════════════════════════════
-                    // UTILISER DIRECTEMENT LE SCALE_FACTOR
-                    // ═══════════════════════════════════════════════════════════════
-                    // Au lieu de calculer un ratio entre ancien/nouveau container,
-                    // on utilise directement le scale_factor qui est déjà calculé
-                    // par rapport à la résolution de référence (1280x720).
-                    // Cela permet de scaler correctement même si on change juste
-                    // la largeur ou la hauteur.
-                    // ═══════════════════════════════════════════════════════════════
-                    debug_printf("📏 Application du scale_factor : %.3f\n", app->scale_factor);
-
-                    while (node && node->data) {
-                        Hexagon* hex = node->data;
-
-                        // ─────────────────────────────────────────────────────────────
-                        // ÉTAPE 1 : REPOSITIONNER LE CENTRE
-                        // ─────────────────────────────────────────────────────────────
-                        // Calculer l'offset de CET hexagone par rapport à l'ANCIEN centre
-                        int offset_x = hex->center_x - old_center_x;
-                        int offset_y = hex->center_y - old_center_y;
-
-                        // Appliquer le NOUVEAU centre + offset
-                        hex->center_x = new_center_x + offset_x;
-                        hex->center_y = new_center_y + offset_y;
-
-                        // ─────────────────────────────────────────────────────────────
-                        // ÉTAPE 2 : METTRE À JOUR L'ÉCHELLE
-                        // ─────────────────────────────────────────────────────────────
-                        // ⚠️ IMPORTANT : On ne recalcule PAS les sommets !
-                        //
-                        // Les hexagones utilisent un système de coordonnées RELATIVES :
-                        // - vx[i], vy[i] = coordonnées relatives au centre (fixes)
-                        // - current_scale = facteur d'échelle appliqué lors du rendu
-                        //
-                        // Dans make_hexagone() (geometry.c ligne 29) :
-                        //   absolute_x = center_x + (vx[i] * current_scale)
-                        //
-                        // On applique directement le scale_factor calculé
-                        // ─────────────────────────────────────────────────────────────
-                        hex->current_scale = app->scale_factor;
-
-                        debug_printf("  ✅ Hexagone %d - Centre:(%d,%d) Scale:%.3f\n",
-                                     hex_count, hex->center_x, hex->center_y,
-                                     hex->current_scale);
-
-                        hex_count++;
-                        node = node->next;
-                    }
-
-                    debug_printf("✅ %d hexagones redimensionnés (scale_factor: %.3f)\n",
-                                 hex_count, app->scale_factor);
+                if (!app->resize_pending) {
+                    resize_capture_snapshot(app);
                 }
-
-                // ═══════════════════════════════════════════════════════════════
-                // ÉTAPE 2 : REPOSITIONNER LE PANNEAU DE CONFIGURATION
-                // ═══════════════════════════════════════════════════════════════
-                if (app->settings_panel) {
-                    // Mettre à jour le scale du panneau
-                    update_panel_scale(app->settings_panel,
-                                       app->screen_width,
-                                       app->screen_height,
-                                       app->scale_factor);
-
-                    debug_printf("✅ Panneau mis à jour avec nouveau scale\n");
-                }
-
-                // ═══════════════════════════════════════════════════════════════
-                // ÉTAPE 3 : REPOSITIONNER LA CARTE DE SESSION (si WHM actif)
-                // ═══════════════════════════════════════════════════════════════
-                if (app->active_technique) {
-                    // Mettre à jour les infos d'écran dans WHM
-                    whm_set_screen_info(app->active_technique, app->screen_width,
-                                       app->screen_height, app->scale_factor);
-                    debug_printf("✅ Infos d'écran mises à jour dans WHM\n");
-                }
-
-                // ═══════════════════════════════════════════════════════════════
-                // ÉTAPE 4 : ZONE CLIQUABLE WIM HOF
-                // ═══════════════════════════════════════════════════════════════
-                // La zone cliquable sera automatiquement mise à jour lors du prochain
-                // rendu de l'écran d'accueil (ligne 940: app->wim_clickable_rect = img_rect)
-                // Pas besoin de la recalculer manuellement ici
+                app->resize_pending = true;
+                app->resize_last_event = SDL_GetTicks();
+                app->last_interaction_time = app->resize_last_event;
             }
         }
         break;
@@ -817,6 +997,11 @@ void handle_app_events(AppState* app, SDL_Event* event) {
             else if (event->key.keysym.sym == SDLK_SPACE && app->chrono_phase && app->session_stopwatch) {
                 handle_chrono_stop(app, "ESPACE");
             }
+            // Rapport mémoire à la demande (F9, avec --track-memory)
+            else if (event->key.keysym.sym == SDLK_F9 && memory_is_tracking_enabled()) {
+                memory_report_churn(20);
+                memory_report_leaks();
+            }
             break;
 
             // ═════════════════════════════════════════════════════════════════
@@ -932,10 +1117,8 @@ static void render_welcome_screen(AppState* app) {
     }
 }
 
-// Rendu complet de l'application
-void render_app(AppState* app) {
-    if (!app || !app->renderer) return;
-
+// Dessine la fenêtre principale dans la cible courante (sans Present)
+static void render_scene(AppState* app) {
     // 1. Efface l'écran avec le fond
     SDL_RenderCopy(app->renderer, app->background, NULL, NULL);
 
@@ -947,7 +1130,9 @@ void render_app(AppState* app) {
 
         // Déléguer le rendu à l'instance
         if (instance->render) {
+            TRACE_BEGIN("technique_render");
             instance->render(instance, app->renderer);
+            TRACE_END("technique_render");
         }
 
         // Continuer pour rendre les panneaux (settings, JSON editor)
@@ -1088,22 +1273,56 @@ render_panels:
     if (!app->waiting_to_start && app->stats_panel) {
         render_stats_panel(app->renderer, app->stats_panel);
     }
+}
+
+// Rendu complet de l'application
+void render_app(AppState* app) {
+    if (!app || !app->renderer) return;
+
+    TRACE_BEGIN("render_app");
+
+    // Redimensionnement en cours : le recalcul attend que la taille se stabilise
+    if (app->resize_pending &&
+        SDL_GetTicks() - app->resize_last_event >= RESIZE_SETTLE_MS) {
+        app->resize_pending = false;
+        resize_release_snapshot(app);
+        apply_window_resize(app);
+    }
 
-    // 4. Présentation fenêtre principale
+    if (app->resize_pending && app->resize_snapshot) {
+        // Dernière frame étirée à la nouvelle taille
+        SDL_RenderClear(app->renderer);
+        SDL_RenderCopy(app->renderer, app->resize_snapshot, NULL, NULL);
+    } else {
+        render_scene(app);
+    }
+
+    // 4. Présentation fenêtre principale (bloque sur la vsync)
+    TRACE_BEGIN("SDL_RenderPresent");
     SDL_RenderPresent(app->renderer);
+    TRACE_END("SDL_RenderPresent");
+
+    // Première frame à l'écran : créer ce qui n'y figurait pas
+    if (!app->startup_complete) {
+        finish_deferred_startup(app);
+    }
 
     // ─────────────────────────────────────────────────────────────────────────
     // 5. RENDU DE LA FENÊTRE ÉDITEUR JSON (seulement si ouverte)
     // ─────────────────────────────────────────────────────────────────────────
     if (app->json_editor && app->json_editor->est_ouvert) {
+        TRACE_BEGIN("json_editor");
         verifier_auto_save(app->json_editor);  // Auto-save pour hot reload
         rendre_json_editor(app->json_editor);
+        TRACE_END("json_editor");
     } else if (app->json_editor && !app->json_editor->est_ouvert) {
         // ✅ Si la fenêtre est marquée comme fermée, la détruire
         detruire_json_editor(app->json_editor);
         app->json_editor = NULL;
         debug_printf("🗑️ Fenêtre JSON fermée\n");
     }
+
+    TRACE_END("render_app");
 }
 
 // Régulation FPS
@@ -1144,6 +1363,12 @@ void render_hexagones(AppState* app, HexagoneList* hex_list) {
 void cleanup_app(AppState* app) {
     if (!app) return;
 
+    // Plus d'événements de hot reload pendant la destruction
+    file_watcher_stop();
+
+    // Arrêt avant la première frame : threads de décodage encore actifs
+    asset_loader_stop();
+
     // Libère l'éditeur JSON
     if (app->json_editor) {
         detruire_json_editor(app->json_editor);
@@ -1155,6 +1380,8 @@ void cleanup_app(AppState* app) {
         free_settings_panel(app->settings_panel);
     }
 
+    resize_release_snapshot(app);
+
     // Libère les textures de l'écran d'accueil
     if (app->wim_image) {
         SDL_DestroyTexture(app->wim_image);
@@ -1208,6 +1435,7 @@ bool should_use_high_fps(AppState* app) {
     //
     // Note : L'écran d'accueil (waiting_to_start = true) reste à 15 FPS pour économiser le CPU
 
+    if (app->resize_pending) return true;        // Redimensionnement en cours
     if (app->timer_phase) return true;           // Timer avant session
     if (app->session_card_phase) return true;    // Carte de session animée
     if (app->counter_phase) return true;         // Compteur de respirations (hexagones respirent)
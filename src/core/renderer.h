@@ -16,6 +16,9 @@
 #include "session_card.h"
 #include "stats_panel.h"
 
+// Délai sans événement de resize avant de recalculer la disposition
+#define RESIZE_SETTLE_MS 150
+
 // Structure qui contient TOUT l'état de l'application graphique
 typedef struct {
     SDL_Window* window;           // Fenêtre principale
@@ -79,9 +82,16 @@ typedef struct {
 
     // 🆕 SYSTÈME D'INSTANCES DE TECHNIQUES
     void* active_technique;          // Instance de technique active (TechniqueInstance*)
+    Uint32 precompute_idle_since;    // Début de l'inactivité des tables (0 = en usage)
 
     AppConfig config;
     bool is_running;
+    bool startup_complete;           // Démarrage différé fait (après la 1ère frame)
+
+    // Redimensionnement différé (voir apply_window_resize dans renderer.c)
+    bool resize_pending;             // Taille changée, recalcul pas encore fait
+    Uint32 resize_last_event;        // Timestamp du dernier événement de resize
+    SDL_Texture* resize_snapshot;    // Dernière frame, étirée pendant le resize
 
     // ════════════════════════════════════════════════════════════════════════
     // SYSTÈME FPS ADAPTATIF
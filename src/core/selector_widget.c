@@ -412,11 +412,20 @@ void render_selector_widget(SDL_Renderer* renderer, SelectorWidget* widget,
         SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
         SDL_RenderDrawRect(renderer, &submenu_bg);
 
-        // Activer le clipping pour l'effet slide down
-        SDL_RenderSetClipRect(renderer, &submenu_bg);
+        // Activer le clipping pour l'effet slide down (sans sortir de celui
+        // du panneau, rétabli ensuite)
+        SDL_Rect previous_clip;
+        bool had_clip = SDL_RenderIsClipEnabled(renderer);
+        SDL_Rect submenu_clip = submenu_bg;
+        bool content_visible = true;
+        if (had_clip) {
+            SDL_RenderGetClipRect(renderer, &previous_clip);
+            content_visible = SDL_IntersectRect(&previous_clip, &submenu_bg, &submenu_clip);
+        }
+        SDL_RenderSetClipRect(renderer, &submenu_clip);
 
-        // Contenu du sous-menu (seulement si suffisamment ouvert)
-        if (widget->submenu_animation > 0.3f) {
+        // Contenu du sous-menu (seulement si suffisamment ouvert et visible)
+        if (widget->submenu_animation > 0.3f && content_visible) {
             int content_y = submenu_y + 5;
 
             // ─── SÉQUENCE 1 ───
@@ -522,8 +531,73 @@ void render_selector_widget(SDL_Renderer* renderer, SelectorWidget* widget,
             }
         }
 
-        // Désactiver le clipping
-        SDL_RenderSetClipRect(renderer, NULL);
+        // Rétablir le clipping précédent
+        SDL_RenderSetClipRect(renderer, had_clip ? &previous_clip : NULL);
+    }
+}
+
+// Un cran de molette (wheel_y > 0 : vers le haut)
+static void selector_wheel_step(SelectorWidget* widget, int wheel_y) {
+    // ═══════════════════════════════════════════════════════════════
+    // MOLETTE SUR LES ROLLERS
+    // ═══════════════════════════════════════════════════════════════
+    if (widget->submenu_enabled && widget->submenu_animation == 1.0f) {
+        bool value_changed = false;
+
+        // Roller texte 1 : toggle pleins/vides
+        if (widget->seq1_type_hovered) {
+            widget->seq1_type = (widget->seq1_type == 0) ? 1 : 0;
+            value_changed = true;
+        }
+
+        // Roller chiffre 1 : incrément/décrément
+        if (widget->seq1_count_hovered) {
+            if (wheel_y > 0) {
+                widget->seq1_count++;
+                if (widget->seq1_count > 10) widget->seq1_count = 10;
+            } else if (wheel_y < 0) {
+                widget->seq1_count--;
+                if (widget->seq1_count < 1) widget->seq1_count = 1;
+            }
+            value_changed = true;
+        }
+
+        // Roller texte 2 : toggle pleins/vides
+        if (widget->seq2_type_hovered) {
+            widget->seq2_type = (widget->seq2_type == 0) ? 1 : 0;
+            value_changed = true;
+        }
+
+        // Roller chiffre 2 : incrément/décrément
+        if (widget->seq2_count_hovered) {
+            if (wheel_y > 0) {
+                widget->seq2_count++;
+                if (widget->seq2_count > 10) widget->seq2_count = 10;
+            } else if (wheel_y < 0) {
+                widget->seq2_count--;
+                if (widget->seq2_count < 1) widget->seq2_count = 1;
+            }
+            value_changed = true;
+        }
+
+        // Appeler le callback si une valeur a changé
+        if (value_changed && widget->roller_callback) {
+            widget->roller_callback(widget->seq1_type, widget->seq1_count,
+                                  widget->seq2_type, widget->seq2_count);
+        }
+
+        return;
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // MODE CLASSIQUE (molette sur la valeur)
+    // ═══════════════════════════════════════════════════════════════
+    if (widget->value_hovered) {
+        if (wheel_y > 0) {
+            selector_previous_option(widget);  // Molette vers le haut
+        } else if (wheel_y < 0) {
+            selector_next_option(widget);  // Molette vers le bas
+        }
     }
 }
 
@@ -669,66 +743,10 @@ void handle_selector_widget_events(SelectorWidget* widget, SDL_Event* event,
         }
 
         case SDL_MOUSEWHEEL: {
-            // ═══════════════════════════════════════════════════════════════
-            // MOLETTE SUR LES ROLLERS
-            // ═══════════════════════════════════════════════════════════════
-            if (widget->submenu_enabled && widget->submenu_animation == 1.0f) {
-                bool value_changed = false;
-
-                // Roller texte 1 : toggle pleins/vides
-                if (widget->seq1_type_hovered) {
-                    widget->seq1_type = (widget->seq1_type == 0) ? 1 : 0;
-                    value_changed = true;
-                }
-
-                // Roller chiffre 1 : incrément/décrément
-                if (widget->seq1_count_hovered) {
-                    if (event->wheel.y > 0) {
-                        widget->seq1_count++;
-                        if (widget->seq1_count > 10) widget->seq1_count = 10;
-                    } else if (event->wheel.y < 0) {
-                        widget->seq1_count--;
-                        if (widget->seq1_count < 1) widget->seq1_count = 1;
-                    }
-                    value_changed = true;
-                }
-
-                // Roller texte 2 : toggle pleins/vides
-                if (widget->seq2_type_hovered) {
-                    widget->seq2_type = (widget->seq2_type == 0) ? 1 : 0;
-                    value_changed = true;
-                }
-
-                // Roller chiffre 2 : incrément/décrément
-                if (widget->seq2_count_hovered) {
-                    if (event->wheel.y > 0) {
-                        widget->seq2_count++;
-                        if (widget->seq2_count > 10) widget->seq2_count = 10;
-                    } else if (event->wheel.y < 0) {
-                        widget->seq2_count--;
-                        if (widget->seq2_count < 1) widget->seq2_count = 1;
-                    }
-                    value_changed = true;
-                }
-
-                // Appeler le callback si une valeur a changé
-                if (value_changed && widget->roller_callback) {
-                    widget->roller_callback(widget->seq1_type, widget->seq1_count,
-                                          widget->seq2_type, widget->seq2_count);
-                }
-
-                break;
-            }
-
-            // ═══════════════════════════════════════════════════════════════
-            // MODE CLASSIQUE (molette sur la valeur)
-            // ═══════════════════════════════════════════════════════════════
-            if (widget->value_hovered) {
-                if (event->wheel.y > 0) {
-                    selector_previous_option(widget);  // Molette vers le haut
-                } else if (event->wheel.y < 0) {
-                    selector_next_option(widget);  // Molette vers le bas
-                }
+            // Crans de molette regroupés (input_coalesce) : appliqués un par un
+            int steps = (event->wheel.y != 0) ? abs(event->wheel.y) : 1;
+            for (int step = 0; step < steps; step++) {
+                selector_wheel_step(widget, event->wheel.y);
             }
             break;
         }
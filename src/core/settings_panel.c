@@ -6,9 +6,11 @@
 #include "preview_widget.h"
 #include "button_widget.h"
 #include "debug.h"
+#include "trace.h"
 #include "constants.h"
 #include "paths.h"
 #include "json_config_loader.h"
+#include "asset_loader.h"
 #include "timer.h"
 #include "chronometre.h"
 #include "counter.h"
@@ -267,8 +269,8 @@ void apply_button_clicked(void) {
 
     // 🆕 Étape 2.6: Réinitialiser les hexagones principaux (comme après stats_panel)
     if (ctx->hexagones && *ctx->hexagones && ctx->screen_width && ctx->screen_height) {
-        // Libérer les données précompilées (seront recalculées au prochain clic Wim)
-        free_precomputed_data(*ctx->hexagones);
+        // Les données précompilées sont gardées : le clic sur Wim ne les
+        // recalcule que si breath_duration a changé (config_deps)
 
         // Réinitialiser chaque hexagone à son état d'origine
         HexagoneNode* node = (*ctx->hexagones)->first;
@@ -361,12 +363,14 @@ static bool load_panel_widgets(SettingsPanel* panel, SDL_Renderer* renderer, Err
     if (!charger_widgets_depuis_json(panel->json_config_path, &ctx, panel->widget_list)) {
         debug_printf("⚠️ Échec chargement JSON, utilisation config par défaut\n");
     }
+    resolve_config_widgets(panel->widget_list);
 
     // Initialiser le timestamp du fichier JSON
     struct stat file_stat;
     if (stat(panel->json_config_path, &file_stat) == 0) {
-        panel->last_json_mtime = file_stat.st_mtime;
-        debug_printf("📅 JSON timestamp initial: %ld\n", (long)panel->last_json_mtime);
+        panel->last_json_mtime = file_stat.st_mtim;
+        panel->last_json_size = file_stat.st_size;
+        debug_printf("📅 JSON timestamp initial: %ld\n", (long)panel->last_json_mtime.tv_sec);
     }
 
     debug_print_widget_list(panel->widget_list);
@@ -384,7 +388,7 @@ cleanup:
 static bool load_panel_textures(SettingsPanel* panel, SDL_Renderer* renderer,
                                 int screen_width, int screen_height, float scale_factor, Error* err) {
     // Fond du panneau
-    SDL_Surface* bg_surface = IMG_Load(IMG_SETTINGS_BG);
+    SDL_Surface* bg_surface = asset_load_surface(IMG_SETTINGS_BG);
     if (!bg_surface) {
         bg_surface = SDL_CreateRGBSurface(0, BASE_PANEL_WIDTH, screen_height, 32, 0, 0, 0, 0);
         SDL_FillRect(bg_surface, NULL, SDL_MapRGBA(bg_surface->format, 240, 240, 240, 255));
@@ -394,7 +398,7 @@ static bool load_panel_textures(SettingsPanel* panel, SDL_Renderer* renderer,
     CHECK_PTR(panel->background, err, "Échec création texture background");
 
     // Icône d'engrenage
-    SDL_Surface* gear_surface = IMG_Load(IMG_SETTINGS_ICON);
+    SDL_Surface* gear_surface = asset_load_surface(IMG_SETTINGS_ICON);
     if (!gear_surface) {
         gear_surface = SDL_CreateRGBSurface(0, 40, 40, 32, 0, 0, 0, 0);
         SDL_FillRect(gear_surface, NULL, SDL_MapRGBA(gear_surface->format, 128, 128, 128, 255));
@@ -446,9 +450,8 @@ SettingsPanel* create_settings_panel(SDL_Renderer* renderer, SDL_Window* window,
 
     // Initialisation du hot reload
     panel->json_config_path = CONFIG_WIDGETS;
-    panel->json_check_interval = 0.5f;  // Vérifier toutes les 0.5 secondes
-    panel->time_since_last_check = 0.0f;
-    panel->last_json_mtime = 0;
+    panel->last_json_mtime = (struct timespec){0, 0};
+    panel->last_json_size = 0;
 
     // Initialisation du scroll et layout responsive
     panel->scroll_offset = 0;
@@ -562,11 +565,6 @@ void update_settings_panel(SettingsPanel* panel, float delta_time) {
     if (panel->state == PANEL_OPEN) {
         update_widget_list_animations(panel->widget_list, delta_time);
     }
-
-    // Vérification du hot reload du JSON (seulement si le panneau est ouvert)
-    if (panel->state == PANEL_OPEN) {
-        check_json_hot_reload(panel, delta_time, panel->screen_width, panel->screen_height);
-    }
 }
 
 //  RENDU DU PANNEAU
@@ -586,8 +584,15 @@ void render_settings_panel(SDL_Renderer* renderer, SettingsPanel* panel) {
         int panel_x = panel->rect.x;
         int panel_y = panel->rect.y;
 
-        // Widgets (avec scroll)
+        // Widgets (avec scroll), limités au panneau : le clipping coupe les
+        // widgets à cheval sur le bord et sert de zone visible au culling
+        SDL_Rect previous_clip;
+        bool had_clip = SDL_RenderIsClipEnabled(renderer);
+        if (had_clip) SDL_RenderGetClipRect(renderer, &previous_clip);
+
+        SDL_RenderSetClipRect(renderer, &panel->rect);
         render_all_widgets(renderer, panel->widget_list, panel_x, panel_y, panel->rect.w, panel->scroll_offset);
+        SDL_RenderSetClipRect(renderer, had_clip ? &previous_clip : NULL);
     }
 }
 
@@ -1155,8 +1160,10 @@ static void restore_label_position(LabelWidget* label) {
 /**
  * Recalcule la position d'un LABEL selon son alignement et un nouveau panel_width
  * Utilisé lors des resize/empilement avec nouvelle largeur de panneau
+ * text_width : largeur du texte à la taille de police DE BASE (mémo du layout),
+ * -1 si la mesure a échoué
  */
-static void recalculate_label_position(LabelWidget* label, int panel_width) {
+static void recalculate_label_position(LabelWidget* label, int panel_width, int text_width) {
     if (!label) return;
 
     label->base.y = label->base.base_y;  // Toujours restaurer Y
@@ -1168,21 +1175,14 @@ static void recalculate_label_position(LabelWidget* label, int panel_width) {
             break;
 
         case LABEL_ALIGN_CENTER:
-        case LABEL_ALIGN_RIGHT: {
-            // CENTER/RIGHT : Recalculer avec la taille de police DE BASE
-            TTF_Font* font = get_font_for_size(label->base_text_size);
-            if (font) {
-                int text_width = 0;
-                if (TTF_SizeUTF8(font, label->text, &text_width, NULL) == 0) {
-                    if (label->alignment == LABEL_ALIGN_CENTER) {
-                        label->base.x = (panel_width - text_width) / 2;
-                    } else {  // RIGHT
-                        label->base.x = panel_width - text_width - 20;
-                    }
-                }
+        case LABEL_ALIGN_RIGHT:
+            if (text_width < 0) break;
+            if (label->alignment == LABEL_ALIGN_CENTER) {
+                label->base.x = (panel_width - text_width) / 2;
+            } else {  // RIGHT
+                label->base.x = panel_width - text_width - 20;
             }
             break;
-        }
     }
 }
 
@@ -1269,6 +1269,7 @@ static void restore_json_positions(SettingsPanel* panel) {
 /**
  * Empile les widgets verticalement pour éviter les collisions (empilement)
  * Utilise la liste de rectangles déjà calculée pour déterminer l'ordre
+ * (rects[i] correspond à panel->layout_memo.items[i])
  *
  * LOGIQUE SPÉCIALE POUR LES SÉPARATEURS :
  * - Si widget au-dessus = LABEL (titre) → garder position Y fixe (base_y)
@@ -1285,38 +1286,9 @@ static void stack_widgets_vertically(SettingsPanel* panel, WidgetRect* rects, in
 
     debug_printf("🔧 Empilement vertical des widgets (avec centrage)...\n");
 
-    // ─────────────────────────────────────────────────────────────────────────
-    // ÉTAPE 1: Trouver la largeur RÉELLE maximum des widgets INCREMENT
-    // ─────────────────────────────────────────────────────────────────────────
-    // Ne PAS utiliser rects[i].width qui contient container_width (pour alignement)
-    // Calculer la largeur réelle de chaque INCREMENT (nom + flèches + valeur)
-    int max_increment_width = 0;
-    for (int i = 0; i < rect_count; i++) {
-        if (rects[i].type == WIDGET_TYPE_INCREMENT &&
-            rects[i].node->widget.increment_widget) {
-
-            ConfigWidget* w = rects[i].node->widget.increment_widget;
-
-            // Mesurer la largeur de la valeur actuelle
-            char value_str[16];
-            snprintf(value_str, sizeof(value_str), "%d", w->value);
-            int value_width = 0;
-
-            TTF_Font* font = get_font_for_size(w->current_text_size);
-            if (font) {
-                TTF_SizeUTF8(font, value_str, &value_width, NULL);
-            } else {
-                value_width = strlen(value_str) * (w->current_text_size / 2);
-            }
-
-            // Largeur réelle = local_arrows_x + arrow_size + espace + value_width + marge
-            int real_width = w->local_roller_x + w->roller_width + 10;
-
-            if (real_width > max_increment_width) {
-                max_increment_width = real_width;
-            }
-        }
-    }
+    // Largeur RÉELLE maximum des widgets INCREMENT (nom + roller), mesurée
+    // une fois par layout_memo_measure()
+    int max_increment_width = panel->layout_memo.max_increment_width;
 
     // Calculer la position de départ pour centrer les INCREMENT
     int increment_start_x = (panel_width - max_increment_width) / 2;
@@ -1335,7 +1307,8 @@ static void stack_widgets_vertically(SettingsPanel* panel, WidgetRect* rects, in
             case WIDGET_TYPE_LABEL:
                 if (r->node->widget.label_widget) {
                     LabelWidget* w = r->node->widget.label_widget;
-                    recalculate_label_position(w, panel_width);
+                    recalculate_label_position(w, panel_width,
+                                               panel->layout_memo.items[i].text_width);
                     const char* align_str = (w->alignment == LABEL_ALIGN_LEFT) ? "LEFT" :
                                            (w->alignment == LABEL_ALIGN_CENTER) ? "CENTER" : "RIGHT";
                     debug_printf("   📝 LABEL '%s' %s à x=%d\n", w->text, align_str, w->base.x);
@@ -1458,25 +1431,13 @@ static void stack_widgets_vertically(SettingsPanel* panel, WidgetRect* rects, in
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
-// HELPER: Vérifier si on doit dépiler les widgets et le faire si nécessaire
+// HELPER: Dépiler les widgets (positions JSON + UIButton)
 // ═══════════════════════════════════════════════════════════════════════════
-// Retourne true si le dépilement a été effectué (on doit sauter à calculate_heights)
-static bool should_unstack_widgets(SettingsPanel* panel) {
-    if (!panel) return false;
+static void unstack_widgets(SettingsPanel* panel) {
+    if (!panel) return;
 
-    const int UNSTACK_MARGIN = 80;  // Marge d'hystérésis pour éviter oscillations
     int panel_width = panel->rect.w;
 
-    // Si widgets empilés ET largeur suffisante → dépiler
-    if (!panel->widgets_stacked ||
-        panel->panel_width_when_stacked <= 0 ||
-        panel_width < panel->panel_width_when_stacked + UNSTACK_MARGIN) {
-        return false;  // Pas de dépilement nécessaire
-    }
-
-    debug_printf("🔄 DÉPILEMENT: panel_width=%dpx >= (saved_width=%dpx + marge=%dpx)\n",
-                panel_width, panel->panel_width_when_stacked, UNSTACK_MARGIN);
-
     // Restaurer positions JSON originales (helper function)
     restore_json_positions(panel);
 
@@ -1534,8 +1495,6 @@ static bool should_unstack_widgets(SettingsPanel* panel) {
     debug_printf("✅ Widgets dépilés - positions JSON restaurées\n");
     debug_printf("   📌 panel_width_when_stacked=%dpx (gardé en mémoire)\n",
                 panel->panel_width_when_stacked);
-
-    return true;  // Dépilement effectué, caller doit sauter à calculate_heights
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -1559,7 +1518,8 @@ static int calculate_increment_groups(SettingsPanel* panel, IncrementLayoutInfo*
             }
 
             increment_infos[increment_count].widget = w;
-            increment_infos[increment_count].y_position = w->base.y;
+            // Y JSON (et non Y courant) : les groupes ne dépendent pas de l'empilement
+            increment_infos[increment_count].y_position = w->base.base_y;
             increment_infos[increment_count].text_width = text_width;
             increment_infos[increment_count].group_id = -1;
             increment_infos[increment_count].container_width_for_group = 0;
@@ -1626,46 +1586,156 @@ static int calculate_increment_groups(SettingsPanel* panel, IncrementLayoutInfo*
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
-// HELPER: Construire la liste des rectangles de collision
+// MÉMO DU LAYOUT : MESURES (une fois par liste de widgets)
 // ═══════════════════════════════════════════════════════════════════════════
-static int build_collision_rects(SettingsPanel* panel, IncrementLayoutInfo* increment_infos,
-                                 int increment_count, WidgetRect* rects, int max_rects) {
-    if (!panel || !panel->widget_list || !rects) return 0;
+// Rectangle de chaque widget à sa position JSON, largeur des groupes
+// d'INCREMENT et largeur des textes des labels centrés/alignés à droite.
+// Les widgets ne sont pas redimensionnés au resize (seule la largeur du
+// panneau change) : ces valeurs restent justes jusqu'au rechargement du JSON.
+static void layout_memo_measure(SettingsPanel* panel) {
+    PanelLayoutMemo* memo = &panel->layout_memo;
+
+    IncrementLayoutInfo increment_infos[LAYOUT_MAX_ITEMS];
+    int increment_count = calculate_increment_groups(panel, increment_infos, LAYOUT_MAX_ITEMS);
+
+    memo->item_count = 0;
+    memo->max_increment_width = 0;
+
+    for (WidgetNode* node = panel->widget_list->first;
+         node && memo->item_count < LAYOUT_MAX_ITEMS; node = node->next) {
+        WidgetRect rect;
+        if (!get_widget_rect(node, &rect)) continue;
+
+        LayoutItem* item = &memo->items[memo->item_count++];
+        item->node = node;
+        item->width = rect.width;
+        item->height = rect.height;
+        item->json_x = rect.x;
+        item->json_y = rect.y;
+        item->text_width = -1;
 
-    int rect_count = 0;
-    WidgetNode* node = panel->widget_list->first;
+        switch (node->type) {
+            case WIDGET_TYPE_INCREMENT: {
+                ConfigWidget* w = node->widget.increment_widget;
+                item->json_x = w->base.base_x;
+                item->json_y = w->base.base_y;
+
+                // Largeur commune du groupe (alignement des rollers)
+                for (int i = 0; i < increment_count; i++) {
+                    if (increment_infos[i].widget == w) {
+                        item->width = increment_infos[i].container_width_for_group;
+                        break;
+                    }
+                }
 
-    while (node && rect_count < max_rects) {
-        // Pour les widgets INCREMENT, utiliser le container_width calculé
-        if (node->type == WIDGET_TYPE_INCREMENT && node->widget.increment_widget) {
-            ConfigWidget* w = node->widget.increment_widget;
-            rects[rect_count].node = node;
-            rects[rect_count].type = node->type;
-            rects[rect_count].x = w->base.x;
-            rects[rect_count].y = w->base.y;
-
-            // Trouver le container_width pour ce widget
-            int container_width = w->base.width;  // Défaut
-            for (int i = 0; i < increment_count; i++) {
-                if (increment_infos[i].widget == w) {
-                    container_width = increment_infos[i].container_width_for_group;
-                    break;
+                int real_width = w->local_roller_x + w->roller_width + 10;
+                if (real_width > memo->max_increment_width) {
+                    memo->max_increment_width = real_width;
+                }
+                break;
+            }
+            case WIDGET_TYPE_LABEL: {
+                LabelWidget* w = node->widget.label_widget;
+                item->json_x = w->base.base_x;
+                item->json_y = w->base.base_y;
+
+                if (w->alignment != LABEL_ALIGN_LEFT) {
+                    TTF_Font* font = get_font_for_size(w->base_text_size);
+                    int text_width = 0;
+                    if (font && TTF_SizeUTF8(font, w->text, &text_width, NULL) == 0) {
+                        item->text_width = text_width;
+                    }
                 }
+                break;
             }
+            case WIDGET_TYPE_PREVIEW:
+                item->json_x = node->widget.preview_widget->base.base_x;
+                item->json_y = node->widget.preview_widget->base.base_y;
+                break;
+            case WIDGET_TYPE_SELECTOR:
+                item->json_x = node->widget.selector_widget->base.base_x;
+                item->json_y = node->widget.selector_widget->base.base_y;
+                break;
+            case WIDGET_TYPE_TOGGLE:
+                item->json_x = node->widget.toggle_widget->base.base_x;
+                item->json_y = node->widget.toggle_widget->base.base_y;
+                break;
+            case WIDGET_TYPE_SEPARATOR:
+                item->json_x = node->widget.separator_widget->base_start_margin;
+                item->json_y = node->widget.separator_widget->base.base_y;
+                break;
+            case WIDGET_TYPE_BUTTON:
+                item->json_x = node->widget.button_widget->base_x;
+                item->json_y = node->widget.button_widget->base_y;
+                break;
+            default:
+                break;
+        }
+    }
 
-            rects[rect_count].width = container_width;
-            rects[rect_count].height = w->base.height > 0 ? w->base.height : 30;
-            rect_count++;
-        } else {
-            // Autres widgets: utiliser get_widget_rect normal
-            if (get_widget_rect(node, &rects[rect_count])) {
-                rect_count++;
+    memo->list = panel->widget_list;
+    memo->measured = true;
+    memo->screen_height = -1;      // Force la remise à zéro des décisions
+
+    debug_printf("📐 LAYOUT: %d widgets mesurés (INCREMENT max=%dpx)\n",
+                 memo->item_count, memo->max_increment_width);
+}
+
+// Oublie mesures et décisions (liste rechargée : même adresse possible)
+static void layout_memo_invalidate(SettingsPanel* panel) {
+    panel->layout_memo.measured = false;
+    panel->layout_memo.list = NULL;
+}
+
+// Remet le mémo en phase avec le panneau
+static void layout_memo_sync(SettingsPanel* panel) {
+    PanelLayoutMemo* memo = &panel->layout_memo;
+
+    if (!memo->measured || memo->list != panel->widget_list) {
+        layout_memo_measure(panel);
+    }
+
+    if (memo->screen_height != panel->screen_height ||
+        memo->threshold_width != panel->layout_threshold_width) {
+        for (int i = 0; i < LAYOUT_DECISION_SLOTS; i++) {
+            memo->decisions[i].bucket = -1;
+        }
+        memo->screen_height = panel->screen_height;
+        memo->threshold_width = panel->layout_threshold_width;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HELPER: Construire la liste des rectangles aux positions JSON
+// ═══════════════════════════════════════════════════════════════════════════
+// Sans mesure de texte : seuls les séparateurs (largeur) et les boutons
+// ancrés en bas (hauteur d'écran) dépendent des dimensions courantes.
+static int build_collision_rects(SettingsPanel* panel, int panel_width, WidgetRect* rects) {
+    const PanelLayoutMemo* memo = &panel->layout_memo;
+
+    for (int i = 0; i < memo->item_count; i++) {
+        const LayoutItem* item = &memo->items[i];
+        WidgetRect* rect = &rects[i];
+
+        rect->node = item->node;
+        rect->type = item->node->type;
+        rect->x = item->json_x;
+        rect->y = item->json_y;
+        rect->width = item->width;
+        rect->height = item->height;
+
+        if (rect->type == WIDGET_TYPE_SEPARATOR) {
+            SeparatorWidget* w = item->node->widget.separator_widget;
+            rect->width = panel_width - w->base_start_margin - w->base_end_margin;
+        } else if (rect->type == WIDGET_TYPE_BUTTON) {
+            ButtonWidget* w = item->node->widget.button_widget;
+            if (w->y_anchor == BUTTON_ANCHOR_BOTTOM) {
+                rect->y = panel->screen_height - w->base_y - w->base_height / 2;
             }
         }
-        node = node->next;
     }
 
-    return rect_count;
+    return memo->item_count;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -1674,10 +1744,10 @@ static int build_collision_rects(SettingsPanel* panel, IncrementLayoutInfo* incr
 // Critère 1: Largeur de la fenêtre (si trop étroit, forcer l'empilement)
 // Critère 2: Widget qui dépasse le bord droit du panneau (avec marge)
 // Critère 3: Détection de collision entre widgets
-static bool check_reorganization_needed(SettingsPanel* panel, WidgetRect* rects, int rect_count) {
+static bool check_reorganization_needed(SettingsPanel* panel, int panel_width,
+                                        WidgetRect* rects, int rect_count) {
     if (!panel || !rects) return false;
 
-    int panel_width = panel->rect.w;
     bool needs_reorganization = false;
 
     // Critère 1: Vérifier si le panneau est trop étroit
@@ -1804,6 +1874,47 @@ static void calculate_content_height(SettingsPanel* panel) {
     debug_printf("✅ Recalcul terminé - layout_dirty=false\n\n");
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// HELPER: Décision d'empilement, fonction de la seule largeur du panneau
+// ═══════════════════════════════════════════════════════════════════════════
+// Mémorisée par tranche de LAYOUT_WIDTH_BUCKET px et évaluée à la plus petite
+// largeur de la tranche : glisser le bord de la fenêtre ne refait les tests
+// de collision qu'une fois par tranche traversée.
+static bool layout_json_overflows(SettingsPanel* panel, int panel_width,
+                                  WidgetRect* rects, int rect_count) {
+    PanelLayoutMemo* memo = &panel->layout_memo;
+
+    if (panel_width < panel->layout_threshold_width) {
+        return true;  // Critère 1 exact (pas d'arrondi à la tranche)
+    }
+
+    int bucket = panel_width / LAYOUT_WIDTH_BUCKET;
+    LayoutDecision* slot = &memo->decisions[bucket % LAYOUT_DECISION_SLOTS];
+    if (slot->bucket == bucket) {
+        memo->hits++;
+        return slot->overflows;
+    }
+
+    int eval_width = bucket * LAYOUT_WIDTH_BUCKET;
+    if (eval_width != panel_width) {
+        rect_count = build_collision_rects(panel, eval_width, rects);
+    }
+
+    slot->bucket = bucket;
+    slot->overflows = check_reorganization_needed(panel, eval_width, rects, rect_count);
+    memo->misses++;
+
+    debug_printf("📐 LAYOUT: tranche %d-%dpx → %s (%d réutilisations, %d calculs)\n",
+                 eval_width, eval_width + LAYOUT_WIDTH_BUCKET - 1,
+                 slot->overflows ? "empilé" : "positions JSON",
+                 memo->hits, memo->misses);
+
+    if (eval_width != panel_width) {
+        build_collision_rects(panel, panel_width, rects);
+    }
+    return slot->overflows;
+}
+
 void recalculate_widget_layout(SettingsPanel* panel) {
     if (!panel || !panel->widget_list) return;
 
@@ -1817,40 +1928,41 @@ void recalculate_widget_layout(SettingsPanel* panel) {
         return;  // Déjà à jour, pas besoin de recalculer
     }
 
-    debug_printf("\n🔄 === RECALCULATE_WIDGET_LAYOUT (layout_dirty=true) ===\n");
+    TRACE_BEGIN("recalculate_widget_layout");
 
+    const int UNSTACK_MARGIN = 80;  // Marge d'hystérésis pour éviter oscillations
     int panel_width = panel->rect.w;
 
     // ═══════════════════════════════════════════════════════════════════════════
-    // ÉTAPE 1: DÉCISION DE DÉPILEMENT AVEC MÉMOIRE PERSISTANTE
-    // ═══════════════════════════════════════════════════════════════════════════
-    if (should_unstack_widgets(panel)) {
-        goto calculate_heights;  // Dépilement effectué, sauter directement au calcul des hauteurs
-    }
-
-    // ═══════════════════════════════════════════════════════════════════════════
-    // ÉTAPE 0bis: CALCULER LES GROUPES ET LARGEURS DES WIDGETS INCREMENT
+    // ÉTAPE 1: MESURES (mémo) ET RECTANGLES AUX POSITIONS JSON
     // ═══════════════════════════════════════════════════════════════════════════
-    IncrementLayoutInfo increment_infos[50];
-    int increment_count = calculate_increment_groups(panel, increment_infos, 50);
+    layout_memo_sync(panel);
 
-    // ═══════════════════════════════════════════════════════════════════════════
-    // ÉTAPE 1: CONSTRUIRE LA LISTE DES RECTANGLES DE COLLISION
-    // ═══════════════════════════════════════════════════════════════════════════
-    WidgetRect rects[50];  // Maximum 50 widgets
-    int rect_count = build_collision_rects(panel, increment_infos, increment_count, rects, 50);
+    WidgetRect rects[LAYOUT_MAX_ITEMS];
+    int rect_count = build_collision_rects(panel, panel_width, rects);
 
     // ═══════════════════════════════════════════════════════════════════════════
-    // ÉTAPE 2: DÉTERMINER SI ON DOIT RÉORGANISER
+    // ÉTAPE 2: LES POSITIONS JSON TIENNENT-ELLES DANS CETTE LARGEUR ?
     // ═══════════════════════════════════════════════════════════════════════════
-    bool needs_reorganization = check_reorganization_needed(panel, rects, rect_count);
+    bool overflows = layout_json_overflows(panel, panel_width, rects, rect_count);
 
     // ═══════════════════════════════════════════════════════════════════════════
-    // ÉTAPE 3: RÉORGANISER SI NÉCESSAIRE (empilement)
+    // ÉTAPE 3: EMPILER / DÉPILER AVEC MÉMOIRE PERSISTANTE
     // ═══════════════════════════════════════════════════════════════════════════
-    // Si needs_reorganization=true, empiler. Sinon, garder les positions restaurées.
+    // Une fois empilés, les widgets ne sont dépilés qu'au-delà de
+    // panel_width_when_stacked + UNSTACK_MARGIN (évite les oscillations)
     // ═══════════════════════════════════════════════════════════════════════════
-    if (needs_reorganization) {
+    if (panel->widgets_stacked) {
+        if (!overflows && panel->panel_width_when_stacked > 0 &&
+            panel_width >= panel->panel_width_when_stacked + UNSTACK_MARGIN) {
+            debug_printf("🔄 DÉPILEMENT: panel_width=%dpx >= (saved_width=%dpx + marge=%dpx)\n",
+                        panel_width, panel->panel_width_when_stacked, UNSTACK_MARGIN);
+            unstack_widgets(panel);
+        } else {
+            // Recentrer la pile pour la largeur courante (sans mesure de texte)
+            stack_widgets_vertically(panel, rects, rect_count);
+        }
+    } else if (overflows) {
         debug_printf("🔧 EMPILEMENT: collisions détectées ou panneau trop étroit\n");
 
         // Marquer que les widgets sont maintenant empilés
@@ -1867,26 +1979,21 @@ void recalculate_widget_layout(SettingsPanel* panel) {
             panel->panel_width_when_stacked = panel_width;
             debug_printf("   💾 SAUVEGARDE panel_width_when_stacked=%dpx (PREMIER empilement)\n",
                         panel->panel_width_when_stacked);
-        } else {
-            debug_printf("   ♻️  panel_width_when_stacked=%dpx déjà sauvegardé (ré-empilement)\n",
-                        panel->panel_width_when_stacked);
         }
 
-        // Empiler les widgets verticalement (helper function)
         stack_widgets_vertically(panel, rects, rect_count);
-
-    } else {
-        debug_printf("✅ Aucune collision détectée - conserver positions actuelles\n");
-        // Note: Ne pas modifier widgets_stacked ici!
-        // Si widgets_stacked = true, on le garde car le dépilement n'a pas eu lieu
-        // Ne passer à widgets_stacked = false QUE lors du dépilement explicite
     }
+    // Sinon : positions JSON déjà en place
 
-calculate_heights:
     // ═══════════════════════════════════════════════════════════════════════════
     // ÉTAPE 4: CALCULER LA HAUTEUR TOTALE DU CONTENU ET LE MAX_SCROLL
     // ═══════════════════════════════════════════════════════════════════════════
     calculate_content_height(panel);
+
+    // Positions changées : l'index de hit-test sera reconstruit au prochain événement
+    widget_list_invalidate_layout(panel->widget_list);
+
+    TRACE_END("recalculate_widget_layout");
 }
 void handle_panel_scroll(SettingsPanel* panel, SDL_Event* event) {
     if (!panel || !event) return;
@@ -1989,17 +2096,20 @@ void reload_widgets_from_json(SettingsPanel* panel, int screen_width, int screen
     if (!panel) return;
 
     debug_printf("🔄 RECHARGEMENT des widgets depuis JSON...\n");
+    TRACE_BEGIN("reload_widgets_from_json");
 
     // Libérer l'ancienne liste de widgets
     if (panel->widget_list) {
         free_widget_list(panel->widget_list);
         panel->widget_list = NULL;
     }
+    layout_memo_invalidate(panel);
 
     // Créer une nouvelle liste
     panel->widget_list = create_widget_list();
     if (!panel->widget_list) {
         debug_printf("❌ Impossible de créer la nouvelle widget_list\n");
+        TRACE_END("reload_widgets_from_json");
         return;
     }
 
@@ -2014,14 +2124,17 @@ void reload_widgets_from_json(SettingsPanel* panel, int screen_width, int screen
 
     if (!charger_widgets_depuis_json(panel->json_config_path, &ctx, panel->widget_list)) {
         debug_printf("❌ Échec rechargement JSON\n");
+        TRACE_END("reload_widgets_from_json");
         return;
     }
+    resolve_config_widgets(panel->widget_list);
 
     // Mettre à jour le timestamp
     struct stat file_stat;
     if (stat(panel->json_config_path, &file_stat) == 0) {
-        panel->last_json_mtime = file_stat.st_mtime;
-        debug_printf("📅 JSON timestamp mis à jour: %ld\n", (long)panel->last_json_mtime);
+        panel->last_json_mtime = file_stat.st_mtim;
+        panel->last_json_size = file_stat.st_size;
+        debug_printf("📅 JSON timestamp mis à jour: %ld\n", (long)panel->last_json_mtime.tv_sec);
     }
 
     // Recalculer les positions et dimensions
@@ -2032,6 +2145,8 @@ void reload_widgets_from_json(SettingsPanel* panel, int screen_width, int screen
 
     debug_printf("✅ Widgets rechargés avec succès\n");
     debug_print_widget_list(panel->widget_list);
+
+    TRACE_END("reload_widgets_from_json");
 }
 
 //  MISE À JOUR DE LA LARGEUR MINIMALE DE FENÊTRE
@@ -2045,33 +2160,25 @@ void update_window_minimum_size(SettingsPanel* panel, SDL_Window* window) {
     debug_printf("🔄 Taille minimale fenêtre mise à jour: %dx%d\n", min_width, MIN_PANEL_HEIGHT);
 }
 
-//  VÉRIFICATION PÉRIODIQUE DU FICHIER JSON
-void check_json_hot_reload(SettingsPanel* panel, float delta_time, int screen_width, int screen_height) {
+//  NOTIFICATION DE MODIFICATION DU FICHIER JSON (file_watcher)
+void handle_json_file_changed(SettingsPanel* panel, int screen_width, int screen_height) {
     if (!panel) return;
 
-    // Accumuler le temps
-    panel->time_since_last_check += delta_time;
-
-    // Vérifier seulement si l'intervalle est écoulé
-    if (panel->time_since_last_check < panel->json_check_interval) {
-        return;
-    }
-
-    // Réinitialiser le timer
-    panel->time_since_last_check = 0.0f;
-
-    // Obtenir le timestamp actuel du fichier
     struct stat file_stat;
     if (stat(panel->json_config_path, &file_stat) != 0) {
-        // Fichier non accessible (peut-être supprimé)
+        // Fichier non accessible (supprimé ou en cours de remplacement)
         return;
     }
 
-    // Comparer avec le timestamp précédent
-    if (file_stat.st_mtime != panel->last_json_mtime) {
-        debug_printf("🔥 HOT RELOAD: Fichier JSON modifié détecté!\n");
-        reload_widgets_from_json(panel, screen_width, screen_height);
+    // Déjà chargé (F5, ou notification de notre propre rechargement)
+    if (file_stat.st_mtim.tv_sec == panel->last_json_mtime.tv_sec &&
+        file_stat.st_mtim.tv_nsec == panel->last_json_mtime.tv_nsec &&
+        file_stat.st_size == panel->last_json_size) {
+        return;
     }
+
+    debug_printf("🔥 HOT RELOAD: Fichier JSON modifié détecté!\n");
+    reload_widgets_from_json(panel, screen_width, screen_height);
 }
 
 //  CALCUL DE LA LARGEUR MINIMALE DE FENÊTRE
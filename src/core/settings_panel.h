@@ -54,6 +54,41 @@ typedef struct {
 } PreviewSystem;
 
 // === STRUCTURE DU PANNEAU DE CONFIGURATION ===
+// === MÉMO DU LAYOUT (recalculate_widget_layout) ===
+// Les mesures de texte et les rectangles JSON des widgets sont calculés une
+// fois par liste de widgets ; la décision "faut-il empiler ?" ne dépend plus
+// que de la largeur du panneau et est mémorisée par tranche de largeur.
+#define LAYOUT_MAX_ITEMS 50
+#define LAYOUT_WIDTH_BUCKET 4          // Largeurs regroupées par tranches de 4px
+#define LAYOUT_DECISION_SLOTS 64       // Table à accès direct (tranche % slots)
+
+typedef struct {
+    WidgetNode* node;
+    int json_x, json_y;        // Position JSON (séparateurs et boutons ancrés en bas : recalculés)
+    int width, height;         // Rectangle de collision
+    int text_width;            // Texte mesuré (labels CENTER/RIGHT), -1 sinon
+} LayoutItem;
+
+typedef struct {
+    int bucket;                // -1 = slot vide
+    bool overflows;            // Positions JSON en collision ou hors du panneau
+} LayoutDecision;
+
+typedef struct {
+    bool measured;
+    WidgetList* list;          // Liste mesurée
+    int screen_height;         // Clé des décisions (boutons ancrés en bas)
+    int threshold_width;
+
+    LayoutItem items[LAYOUT_MAX_ITEMS];
+    int item_count;
+    int max_increment_width;   // Largeur réelle du plus large INCREMENT (empilement)
+
+    LayoutDecision decisions[LAYOUT_DECISION_SLOTS];
+    int hits;
+    int misses;
+} PanelLayoutMemo;
+
 typedef struct {
     PanelState state;
     SDL_Rect rect;
@@ -93,9 +128,8 @@ typedef struct {
     // HOT RELOAD DU JSON ET GESTION FENÊTRE
     // ═══════════════════════════════════════════════════════════════════════════
     const char* json_config_path;   // Chemin vers widgets_config.json
-    time_t last_json_mtime;         // Timestamp de dernière modification
-    float json_check_interval;      // Intervalle de vérification (secondes)
-    float time_since_last_check;    // Temps écoulé depuis dernière vérification
+    struct timespec last_json_mtime; // Date de modification au dernier chargement (ns)
+    off_t last_json_size;           // Taille au dernier chargement
     SDL_Renderer* renderer;         // Nécessaire pour recharger les widgets
     SDL_Window* window;             // Nécessaire pour SDL_SetWindowMinimumSize
     int screen_width;               // Largeur de l'écran (mise à jour lors du resize)
@@ -129,6 +163,7 @@ typedef struct {
     // ═══════════════════════════════════════════════════════════════════════════
     int panel_width_when_stacked;  // Largeur du panneau au moment de l'empilement (0 = jamais empilé)
     bool layout_dirty;             // Flag pour recalculer le layout (évite recalculs multiples par frame)
+    PanelLayoutMemo layout_memo;   // Mesures et décisions d'empilement mémorisées
 
     // Anciens éléments (à supprimer progressivement)
     SDL_Texture* apply_button_texture;
@@ -199,7 +234,10 @@ void update_panel_scale(SettingsPanel* panel, int screen_width, int screen_heigh
 
 // Hot reload du JSON
 void reload_widgets_from_json(SettingsPanel* panel, int screen_width, int screen_height);
-void check_json_hot_reload(SettingsPanel* panel, float delta_time, int screen_width, int screen_height);
+// Appelé sur notification du file_watcher : recharge si le fichier a
+// réellement changé depuis le dernier chargement (évite de recharger deux
+// fois après F5 ou une sauvegarde de l'éditeur)
+void handle_json_file_changed(SettingsPanel* panel, int screen_width, int screen_height);
 
 // Calcul de la largeur minimale de fenêtre
 int get_minimum_window_width(SettingsPanel* panel);
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "startup_timeline.h"
+#include "debug.h"
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+typedef struct {
+    double ms;                  // Depuis le premier jalon
+    char label[64];
+} StartupMark;
+
+static StartupMark marks[STARTUP_TIMELINE_MAX];
+static atomic_int mark_count;
+static struct timespec origin;
+static atomic_bool origin_set;
+static bool reported;
+static double first_frame_ms = -1.0;
+
+static double elapsed_ms(const struct timespec* now) {
+    return (double)(now->tv_sec - origin.tv_sec) * 1000.0 +
+           (double)(now->tv_nsec - origin.tv_nsec) / 1e6;
+}
+
+void startup_mark(const char* format, ...) {
+    if (reported) return;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    // Le premier jalon (début de main) est appelé avant tout thread
+    if (!atomic_load(&origin_set)) {
+        origin = now;
+        atomic_store(&origin_set, true);
+    }
+
+    int index = atomic_fetch_add(&mark_count, 1);
+    if (index >= STARTUP_TIMELINE_MAX) return;
+
+    StartupMark* mark = &marks[index];
+    mark->ms = elapsed_ms(&now);
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(mark->label, sizeof(mark->label), format, args);
+    va_end(args);
+}
+
+void startup_first_frame(void) {
+    if (first_frame_ms >= 0.0 || !atomic_load(&origin_set)) return;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    first_frame_ms = elapsed_ms(&now);
+    startup_mark("première frame affichée");
+}
+
+void startup_report(void) {
+    if (reported) return;
+    reported = true;
+
+    int count = atomic_load(&mark_count);
+    if (count > STARTUP_TIMELINE_MAX) count = STARTUP_TIMELINE_MAX;
+    if (count == 0) return;
+
+    // Les jalons des threads de décodage arrivent dans le désordre
+    for (int i = 1; i < count; i++) {
+        StartupMark current = marks[i];
+        int j = i - 1;
+        while (j >= 0 && marks[j].ms > current.ms) {
+            marks[j + 1] = marks[j];
+            j--;
+        }
+        marks[j + 1] = current;
+    }
+
+    debug_section("CHRONOLOGIE DU DÉMARRAGE");
+    double previous = 0.0;
+    for (int i = 0; i < count; i++) {
+        debug_printf("  %8.1f ms  (+%6.1f)  %s\n",
+                     marks[i].ms, marks[i].ms - previous, marks[i].label);
+        previous = marks[i].ms;
+    }
+
+    if (first_frame_ms < 0.0) {
+        debug_printf("⚠️ Première frame non atteinte\n");
+    } else if (first_frame_ms <= STARTUP_FIRST_FRAME_TARGET_MS) {
+        debug_printf("✅ Première frame en %.1f ms (objectif < %.0f ms)\n",
+                     first_frame_ms, STARTUP_FIRST_FRAME_TARGET_MS);
+    } else {
+        debug_printf("⚠️ Première frame en %.1f ms (objectif < %.0f ms)\n",
+                     first_frame_ms, STARTUP_FIRST_FRAME_TARGET_MS);
+    }
+    debug_blank_line();
+}
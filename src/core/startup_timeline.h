@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef STARTUP_TIMELINE_H
+#define STARTUP_TIMELINE_H
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CHRONOLOGIE DU DÉMARRAGE
+// ═══════════════════════════════════════════════════════════════════════════
+// Jalons horodatés depuis le lancement du programme, écrits dans debug.txt
+// (--debug) une fois la première frame affichée. Objectif : première frame
+// en moins de STARTUP_FIRST_FRAME_TARGET_MS.
+// Utilisable depuis n'importe quel thread (libellé copié).
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define STARTUP_TIMELINE_MAX 48
+#define STARTUP_FIRST_FRAME_TARGET_MS 100.0
+
+// Ajoute un jalon (format printf)
+void startup_mark(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+// Jalon de la première frame présentée (référence de l'objectif)
+void startup_first_frame(void);
+
+// Écrit la chronologie (une seule fois)
+void startup_report(void);
+
+#endif
@@ -0,0 +1,566 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// stats_exchange.c
+#include "stats_exchange.h"
+#include "stats_store.h"
+#include "debug.h"
+#include "core/memory/memory.h"
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Décimales écrites et relues sans %f/strtod : la locale (virgule décimale
+// après setlocale en mode debug) ne doit pas changer le format des fichiers
+#define EXCHANGE_LINE_MAX 16384     // Une ligne : STATS_MAX_SESSIONS temps au plus
+#define EXCHANGE_MAX_TIME 86400.0   // Temps de session au-delà : ligne rejetée
+#define EXCHANGE_BUFFER (64 * 1024)
+
+static const char CSV_HEADER[] = "timestamp,date,session_count,sessions";
+
+StatsExchangeFormat stats_exchange_format(const char* path) {
+    const char* dot = path ? strrchr(path, '.') : NULL;
+    if (dot && (strcmp(dot, ".jsonl") == 0 || strcmp(dot, ".json") == 0)) {
+        return STATS_FORMAT_JSONL;
+    }
+    return STATS_FORMAT_CSV;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// EXPORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+    FILE* file;
+    StatsExchangeFormat format;
+    int count;
+} ExportState;
+
+// Temps en secondes avec 3 décimales ("62.500")
+static int format_time(char* buffer, size_t size, float seconds) {
+    if (!isfinite(seconds) || seconds < 0.0f) seconds = 0.0f;
+    long long millis = llroundf(seconds * 1000.0f);
+    return snprintf(buffer, size, "%lld.%03lld", millis / 1000, millis % 1000);
+}
+
+static bool export_record(time_t timestamp, const float* session_times,
+                          int session_count, void* user) {
+    ExportState* state = user;
+    char date[32] = "";
+    struct tm tm_utc;
+    if (gmtime_r(&timestamp, &tm_utc)) {
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", &tm_utc);
+    }
+
+    if (state->format == STATS_FORMAT_JSONL) {
+        fprintf(state->file, "{\"timestamp\":%lld,\"date\":\"%s\",\"sessions\":[",
+                (long long)timestamp, date);
+    } else {
+        fprintf(state->file, "%lld,%s,%d,", (long long)timestamp, date, session_count);
+    }
+
+    char number[32];
+    for (int i = 0; i < session_count; i++) {
+        if (i > 0) fputc(state->format == STATS_FORMAT_JSONL ? ',' : ';', state->file);
+        format_time(number, sizeof(number), session_times[i]);
+        fputs(number, state->file);
+    }
+    fputs(state->format == STATS_FORMAT_JSONL ? "]}\n" : "\n", state->file);
+
+    state->count++;
+    return !ferror(state->file);
+}
+
+int stats_export(const char* path, StatsExchangeFormat format) {
+    bool to_stdout = !path || strcmp(path, "-") == 0;
+    char tmp_path[512] = "";
+    FILE* file = stdout;
+
+    // Fichier : écrit à part puis renommé (pas d'export à moitié écrit)
+    if (!to_stdout) {
+        snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+        file = fopen(tmp_path, "w");
+        if (!file) {
+            debug_printf("❌ STATS: export impossible vers %s (%s)\n", path, strerror(errno));
+            return -1;
+        }
+        setvbuf(file, NULL, _IOFBF, EXCHANGE_BUFFER);
+    }
+
+    ExportState state = { file, format, 0 };
+    if (format == STATS_FORMAT_CSV) fprintf(file, "%s\n", CSV_HEADER);
+
+    int visited = stats_store_foreach(export_record, &state);
+    bool ok = visited >= 0 && visited == state.count && fflush(file) == 0 && !ferror(file);
+
+    if (!to_stdout) {
+        if (fclose(file) != 0) ok = false;
+        if (!ok || rename(tmp_path, path) != 0) {
+            remove(tmp_path);
+            ok = false;
+        }
+    }
+
+    if (!ok) {
+        debug_printf("❌ STATS: export échoué\n");
+        return -1;
+    }
+    debug_printf("📤 STATS: %d exercice(s) exporté(s) (%s)\n", state.count,
+                 format == STATS_FORMAT_JSONL ? "JSON Lines" : "CSV");
+    return state.count;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// EMPREINTES (DOUBLONS)
+// ═══════════════════════════════════════════════════════════════════════════
+// Ensemble des exercices connus (adressage ouvert, rempli au plus à moitié).
+// L'empreinte ne prend que la date et le nombre de sessions : aucun arrondi,
+// donc pas d'effet de bord (12.49 / 12.51). Les candidats de même empreinte
+// sont confirmés en comparant les temps à EXCHANGE_DUPLICATE_TOLERANCE près.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define EXCHANGE_DUPLICATE_TOLERANCE 0.5f     // Même tolérance que le panneau stats
+
+typedef struct {
+    uint64_t hash;              // 0 = case vide
+    int session_count;
+    size_t first;               // Premier temps dans FingerprintSet.times
+} FingerprintSlot;
+
+typedef struct {
+    FingerprintSlot* slots;
+    size_t capacity;            // Puissance de 2
+    size_t count;
+    float* times;               // Temps des exercices de l'ensemble
+    size_t time_count;
+    size_t time_capacity;
+    bool failed;                // Allocation impossible pendant la collecte
+} FingerprintSet;
+
+// Agrandit un tableau (×2) pour contenir needed éléments
+static bool grow_array(void** data, size_t* capacity, size_t needed, size_t element_size) {
+    if (needed <= *capacity) return true;
+
+    size_t new_capacity = *capacity ? *capacity : 256;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = SAFE_MALLOC(new_capacity * element_size);
+    if (!grown) return false;
+    if (*data) {
+        memcpy(grown, *data, *capacity * element_size);
+        SAFE_FREE(*data);
+    }
+    *data = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+static uint64_t exercise_fingerprint(int64_t timestamp, int session_count) {
+    uint64_t hash = 14695981039346656037ull;    // FNV-1a
+    int64_t values[2] = { timestamp, session_count };
+    const unsigned char* bytes = (const unsigned char*)values;
+    for (size_t i = 0; i < sizeof(values); i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash ? hash : 1;
+}
+
+static bool fingerprint_set_grow(FingerprintSet* set) {
+    size_t capacity = set->capacity ? set->capacity * 2 : 1024;
+    FingerprintSlot* slots = SAFE_MALLOC(capacity * sizeof(FingerprintSlot));
+    if (!slots) return false;
+    memset(slots, 0, capacity * sizeof(FingerprintSlot));
+
+    for (size_t i = 0; i < set->capacity; i++) {
+        if (!set->slots[i].hash) continue;
+        size_t slot = set->slots[i].hash & (capacity - 1);
+        while (slots[slot].hash) slot = (slot + 1) & (capacity - 1);
+        slots[slot] = set->slots[i];
+    }
+
+    if (set->slots) SAFE_FREE(set->slots);
+    set->slots = slots;
+    set->capacity = capacity;
+    return true;
+}
+
+// 1 = ajouté, 0 = déjà présent (doublon), -1 = allocation impossible
+static int fingerprint_set_insert(FingerprintSet* set, int64_t timestamp,
+                                  const float* session_times, int session_count) {
+    if ((set->count + 1) * 2 > set->capacity && !fingerprint_set_grow(set)) return -1;
+
+    uint64_t hash = exercise_fingerprint(timestamp, session_count);
+    size_t mask = set->capacity - 1;
+    size_t slot = hash & mask;
+    for (; set->slots[slot].hash; slot = (slot + 1) & mask) {
+        const FingerprintSlot* candidate = &set->slots[slot];
+        if (candidate->hash != hash || candidate->session_count != session_count) continue;
+
+        const float* known = set->times + candidate->first;
+        int i = 0;
+        while (i < session_count &&
+               fabsf(known[i] - session_times[i]) <= EXCHANGE_DUPLICATE_TOLERANCE) {
+            i++;
+        }
+        if (i == session_count) return 0;
+    }
+
+    if (!grow_array((void**)&set->times, &set->time_capacity,
+                    set->time_count + (size_t)session_count, sizeof(float))) {
+        return -1;
+    }
+    memcpy(set->times + set->time_count, session_times, (size_t)session_count * sizeof(float));
+    set->slots[slot] = (FingerprintSlot){ hash, session_count, set->time_count };
+    set->time_count += (size_t)session_count;
+    set->count++;
+    return 1;
+}
+
+static bool collect_fingerprint(time_t timestamp, const float* session_times,
+                                int session_count, void* user) {
+    FingerprintSet* set = user;
+    if (fingerprint_set_insert(set, (int64_t)timestamp, session_times, session_count) < 0) {
+        set->failed = true;
+        return false;
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LECTURE DES LIGNES
+// ═══════════════════════════════════════════════════════════════════════════
+
+static const char* skip_spaces(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    return p;
+}
+
+// Nombre décimal ([-]chiffres[.chiffres][e[±]chiffres]), indépendant de la
+// locale. NULL si aucun nombre
+static const char* parse_number(const char* p, double* value) {
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p++;
+
+    double result = 0.0;
+    int digits = 0;
+    for (; *p >= '0' && *p <= '9'; p++, digits++) result = result * 10.0 + (*p - '0');
+    if (*p == '.') {
+        double scale = 0.1;
+        for (p++; *p >= '0' && *p <= '9'; p++, digits++, scale *= 0.1) result += (*p - '0') * scale;
+    }
+    if (digits == 0) return NULL;
+
+    if (*p == 'e' || *p == 'E') {
+        const char* exponent_start = p++;
+        bool exponent_negative = *p == '-';
+        if (*p == '-' || *p == '+') p++;
+        int exponent = 0;
+        if (*p < '0' || *p > '9') {
+            p = exponent_start;     // "e" sans chiffres : pas un exposant
+        } else {
+            for (; *p >= '0' && *p <= '9' && exponent < 400; p++) exponent = exponent * 10 + (*p - '0');
+            result *= pow(10.0, exponent_negative ? -exponent : exponent);
+        }
+    }
+
+    *value = negative ? -result : result;
+    return p;
+}
+
+static const char* parse_timestamp(const char* p, int64_t* timestamp) {
+    double value;
+    p = parse_number(p, &value);
+    if (!p || value != floor(value) || value < 0.0 || value > 9.0e15) return NULL;
+    *timestamp = (int64_t)value;
+    return p;
+}
+
+// timestamp,date,session_count,t1;t2;...
+static bool parse_csv_line(const char* line, int64_t* timestamp, float* times, int* count) {
+    const char* p = parse_timestamp(skip_spaces(line), timestamp);
+    if (!p || *p != ',') return false;
+
+    p = strchr(p + 1, ',');         // Date : informative
+    if (!p) return false;
+
+    double declared;
+    p = parse_number(p + 1, &declared);
+    if (!p || *p != ',') return false;
+
+    int parsed = 0;
+    do {
+        double value;
+        p = parse_number(p + 1, &value);
+        if (!p || parsed >= STATS_MAX_SESSIONS) return false;
+        times[parsed++] = (float)value;
+    } while (*p == ';');
+
+    *count = parsed;
+    return *skip_spaces(p) == '\0' && declared == parsed;
+}
+
+// Chaîne JSON : p sur le guillemet ouvrant, retourne après le fermant. Les
+// échappements sont recopiés tels quels (clés attendues sans échappement)
+static const char* json_string(const char* p, char* out, size_t size) {
+    size_t length = 0;
+    for (p++; *p && *p != '"'; p++) {
+        if (*p == '\\' && p[1]) p++;
+        if (out && length + 1 < size) out[length++] = *p;
+    }
+    if (out) out[length] = '\0';
+    return *p == '"' ? p + 1 : NULL;
+}
+
+// Valeur JSON quelconque (champ inconnu) : chaîne, nombre, littéral,
+// objet ou tableau imbriqué
+static const char* json_skip_value(const char* p) {
+    if (*p == '"') return json_string(p, NULL, 0);
+
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (*p) {
+            if (*p == '"') {
+                p = json_string(p, NULL, 0);
+                if (!p) return NULL;
+                continue;
+            }
+            if (*p == '{' || *p == '[') depth++;
+            if (*p == '}' || *p == ']') depth--;
+            p++;
+            if (depth == 0) return p;
+        }
+        return NULL;
+    }
+
+    const char* start = p;
+    while (*p && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t') p++;
+    return p > start ? p : NULL;
+}
+
+// {"timestamp":..., "sessions":[...], ...} dans n'importe quel ordre
+static bool parse_json_line(const char* line, int64_t* timestamp, float* times, int* count) {
+    const char* p = skip_spaces(line);
+    if (*p != '{') return false;
+    p = skip_spaces(p + 1);
+
+    bool has_timestamp = false, has_sessions = false;
+    double declared = -1.0;
+    *count = 0;
+
+    while (*p == '"') {
+        char key[32];
+        p = json_string(p, key, sizeof(key));
+        if (!p) return false;
+        p = skip_spaces(p);
+        if (*p != ':') return false;
+        p = skip_spaces(p + 1);
+
+        if (strcmp(key, "timestamp") == 0) {
+            p = parse_timestamp(p, timestamp);
+            has_timestamp = true;
+        } else if (strcmp(key, "session_count") == 0) {
+            p = parse_number(p, &declared);
+        } else if (strcmp(key, "sessions") == 0) {
+            if (*p != '[') return false;
+            p = skip_spaces(p + 1);
+            while (p && *p != ']') {
+                double value;
+                p = parse_number(p, &value);
+                if (!p || *count >= STATS_MAX_SESSIONS) return false;
+                times[(*count)++] = (float)value;
+                p = skip_spaces(p);
+                if (*p == ',') p = skip_spaces(p + 1);
+                else if (*p != ']') return false;
+            }
+            if (p) p++;
+            has_sessions = true;
+        } else {
+            p = json_skip_value(p);
+        }
+        if (!p) return false;
+
+        p = skip_spaces(p);
+        if (*p == ',') p = skip_spaces(p + 1);
+        else if (*p != '}') return false;
+    }
+
+    if (*p != '}' || *skip_spaces(p + 1) != '\0') return false;
+    return has_timestamp && has_sessions && (declared < 0.0 || declared == *count);
+}
+
+// Valeurs plausibles : date passée (un jour de marge pour les fuseaux et
+// horloges), temps finis et positifs
+static bool exercise_valid(int64_t timestamp, const float* times, int count) {
+    if (timestamp <= 0 || timestamp > (int64_t)time(NULL) + 86400) return false;
+    if (count <= 0 || count > STATS_MAX_SESSIONS) return false;
+    for (int i = 0; i < count; i++) {
+        if (!isfinite(times[i]) || times[i] < 0.0f || times[i] > EXCHANGE_MAX_TIME) return false;
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// IMPORT
+// ═══════════════════════════════════════════════════════════════════════════
+// Les lignes acceptées sont gardées en mémoire puis ajoutées au journal triées
+// par date : un fichier dans le désordre n'ajoute pas d'exercices dans le
+// désordre (à date égale, l'ordre du fichier est conservé).
+
+typedef struct {
+    int64_t timestamp;
+    int session_count;
+    size_t first;               // Premier temps dans ImportBatch.times (et ordre du fichier)
+} ImportRow;
+
+typedef struct {
+    ImportRow* rows;
+    size_t count;
+    size_t capacity;
+    float* times;
+    size_t time_count;
+    size_t time_capacity;
+} ImportBatch;
+
+static bool import_batch_add(ImportBatch* batch, int64_t timestamp, const float* times, int count) {
+    if (!grow_array((void**)&batch->rows, &batch->capacity, batch->count + 1, sizeof(ImportRow)) ||
+        !grow_array((void**)&batch->times, &batch->time_capacity,
+                    batch->time_count + (size_t)count, sizeof(float))) {
+        return false;
+    }
+
+    batch->rows[batch->count++] = (ImportRow){ timestamp, count, batch->time_count };
+    memcpy(batch->times + batch->time_count, times, (size_t)count * sizeof(float));
+    batch->time_count += (size_t)count;
+    return true;
+}
+
+static int compare_import_rows(const void* a, const void* b) {
+    const ImportRow* ra = a;
+    const ImportRow* rb = b;
+    if (ra->timestamp != rb->timestamp) return ra->timestamp < rb->timestamp ? -1 : 1;
+    return ra->first < rb->first ? -1 : (ra->first > rb->first);
+}
+
+bool stats_import(const char* path, StatsImportResult* result) {
+    StatsImportResult counts = {0, 0, 0};
+    bool from_stdin = !path || strcmp(path, "-") == 0;
+    FingerprintSet known = {0};
+    ImportBatch batch = {0};
+    StatsAppender* appender = NULL;
+    bool ok = false;
+
+    char* line = NULL;
+    float* times = NULL;
+    FILE* file = from_stdin ? stdin : fopen(path, "r");
+    if (!file) {
+        debug_printf("❌ STATS: import impossible depuis %s (%s)\n", path, strerror(errno));
+        goto cleanup;
+    }
+
+    line = SAFE_MALLOC(EXCHANGE_LINE_MAX);
+    times = SAFE_MALLOC(STATS_MAX_SESSIONS * sizeof(float));
+    if (!line || !times) goto cleanup;
+
+    // Exercices déjà dans le journal
+    if (stats_store_foreach(collect_fingerprint, &known) < 0 || known.failed) goto cleanup;
+
+    bool complete = true;
+    int line_number = 0;
+    while (fgets(line, EXCHANGE_LINE_MAX, file)) {
+        line_number++;
+        size_t length = strlen(line);
+
+        // Ligne trop longue : le reste est sauté, la ligne rejetée
+        if (length == EXCHANGE_LINE_MAX - 1 && line[length - 1] != '\n') {
+            int c;
+            while ((c = fgetc(file)) != EOF && c != '\n') {}
+            counts.invalid++;
+            continue;
+        }
+
+        const char* start = skip_spaces(line);
+        if (*start == '\0' || *start == '#' || strncmp(start, "timestamp,", 10) == 0) continue;
+
+        int64_t timestamp = 0;
+        int count = 0;
+        bool parsed = *start == '{' ? parse_json_line(start, &timestamp, times, &count)
+                                    : parse_csv_line(start, &timestamp, times, &count);
+        if (!parsed || !exercise_valid(timestamp, times, count)) {
+            if (counts.invalid++ < 5) {
+                debug_printf("⚠️ STATS: ligne %d rejetée à l'import\n", line_number);
+            }
+            continue;
+        }
+
+        int inserted = fingerprint_set_insert(&known, timestamp, times, count);
+        if (inserted == 0) {
+            counts.duplicates++;
+            continue;
+        }
+        if (inserted < 0 || !import_batch_add(&batch, timestamp, times, count)) {
+            complete = false;
+            break;
+        }
+    }
+
+    // Lecture incomplète : rien n'est ajouté
+    if (!complete || ferror(file)) goto cleanup;
+
+    qsort(batch.rows, batch.count, sizeof(ImportRow), compare_import_rows);
+
+    appender = stats_store_append_begin();
+    if (!appender) goto cleanup;
+
+    ok = true;
+    for (size_t i = 0; i < batch.count && ok; i++) {
+        const ImportRow* row = &batch.rows[i];
+        ok = stats_store_append_add(appender, (time_t)row->timestamp,
+                                    batch.times + row->first, row->session_count);
+        if (ok) counts.imported++;
+    }
+
+cleanup:
+    if (appender && !stats_store_append_end(appender)) ok = false;
+    if (file && !from_stdin) fclose(file);
+    if (line) SAFE_FREE(line);
+    if (times) SAFE_FREE(times);
+    if (known.slots) SAFE_FREE(known.slots);
+    if (known.times) SAFE_FREE(known.times);
+    if (batch.rows) SAFE_FREE(batch.rows);
+    if (batch.times) SAFE_FREE(batch.times);
+
+    debug_printf("📥 STATS: import %s — %d ajouté(s), %d doublon(s), %d ligne(s) rejetée(s)\n",
+                 ok ? "terminé" : "interrompu", counts.imported, counts.duplicates, counts.invalid);
+    if (result) *result = counts;
+    return ok;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LIGNE DE COMMANDE
+// ═══════════════════════════════════════════════════════════════════════════
+
+int stats_exchange_cli(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--export-stats") == 0 || strncmp(argv[i], "--export-stats=", 15) == 0) {
+            const char* path = argv[i][14] == '=' ? argv[i] + 15 : NULL;
+            int exported = stats_export(path, stats_exchange_format(path));
+            if (exported < 0) {
+                fprintf(stderr, "Export de l'historique échoué\n");
+                return EXIT_FAILURE;
+            }
+            fprintf(stderr, "%d exercice(s) exporté(s)\n", exported);
+            return EXIT_SUCCESS;
+        }
+
+        if (strncmp(argv[i], "--import-stats=", 15) == 0) {
+            StatsImportResult result;
+            bool ok = stats_import(argv[i] + 15, &result);
+            fprintf(stderr, "%d exercice(s) importé(s), %d doublon(s), %d ligne(s) rejetée(s)%s\n",
+                    result.imported, result.duplicates, result.invalid,
+                    ok ? "" : " — import interrompu");
+            return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    return -1;
+}
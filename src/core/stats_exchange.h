@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// stats_exchange.h
+// EXPORT / IMPORT DE L'HISTORIQUE (CSV, JSON LINES)
+// Échange des exercices entre bornes et vers les outils d'analyse, dans des
+// formats texte indépendants de la machine. Un exercice par ligne. L'export
+// écrit en flux ; l'import garde les empreintes des exercices déjà connus
+// (doublons) et les exercices acceptés, ajoutés au journal triés par date.
+//
+// CSV   : timestamp,date,session_count,sessions
+//         1700000000,2023-11-14T22:13:20Z,3,62.500;90.120;30.000
+// JSONL : {"timestamp":1700000000,"date":"2023-11-14T22:13:20Z","sessions":[62.500,90.120,30.000]}
+//
+// - timestamp : secondes depuis 1970 (UTC) ; date : lisible, ignorée à l'import
+// - Import : format reconnu ligne par ligne ('{' = JSON) ; lignes vides, '#'
+//   et en-tête CSV ignorés ; exercice déjà présent (même date, mêmes temps à
+//   0.5 seconde près) compté comme doublon
+
+#ifndef __STATS_EXCHANGE_H__
+#define __STATS_EXCHANGE_H__
+
+#include <stdbool.h>
+
+typedef enum {
+    STATS_FORMAT_CSV,
+    STATS_FORMAT_JSONL
+} StatsExchangeFormat;
+
+typedef struct {
+    int imported;
+    int duplicates;
+    int invalid;                // Lignes rejetées (format ou valeurs)
+} StatsImportResult;
+
+// Format selon l'extension (.jsonl / .json → JSON Lines, sinon CSV)
+StatsExchangeFormat stats_exchange_format(const char* path);
+
+// Exporte tout le journal ; path NULL ou "-" = sortie standard. Retourne le
+// nombre d'exercices exportés, -1 si erreur
+int stats_export(const char* path, StatsExchangeFormat format);
+
+// Importe un fichier (path "-" = entrée standard) dans le journal. false si
+// le fichier ou le journal n'a pas pu être ouvert
+bool stats_import(const char* path, StatsImportResult* result);
+
+// Options --export-stats[=fichier] et --import-stats=fichier : traitées sans
+// lancer l'interface. Retourne le code de sortie, -1 si aucune n'est présente
+int stats_exchange_cli(int argc, char** argv);
+
+#endif
@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// stats_history.c
+#include "stats_history.h"
+#include "stats_store.h"
+#include "debug.h"
+#include "core/memory/memory.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STATS_DUPLICATE_TOLERANCE 0.5f
+
+// ═══════════════════════════════════════════════════════════════════════════
+// EMPREINTES (DOUBLONS)
+// ═══════════════════════════════════════════════════════════════════════════
+
+// FNV-1a du nombre de sessions et de la première session arrondie
+static uint64_t exercise_fingerprint(int session_count, int32_t first_second) {
+    uint64_t hash = 14695981039346656037ULL;
+    uint32_t values[2] = { (uint32_t)session_count, (uint32_t)first_second };
+
+    for (int i = 0; i < 2; i++) {
+        for (int byte = 0; byte < 4; byte++) {
+            hash ^= (values[i] >> (byte * 8)) & 0xFFu;
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash ? hash : 1;     // 0 réservé aux cases vides
+}
+
+static uint64_t entry_fingerprint(const ExerciseEntry* entry) {
+    int32_t first_second = entry->session_count > 0 ?
+                           (int32_t)lroundf(entry->session_times[0]) : 0;
+    return exercise_fingerprint(entry->session_count, first_second);
+}
+
+// Même nombre de sessions et temps égaux à 0.5 seconde près
+static bool exercise_matches(const ExerciseEntry* entry, const float* session_times,
+                             int session_count) {
+    if (entry->session_count != session_count) return false;
+
+    for (int j = 0; j < session_count; j++) {
+        if (fabsf(entry->session_times[j] - session_times[j]) > STATS_DUPLICATE_TOLERANCE) return false;
+    }
+    return true;
+}
+
+static void fingerprint_insert(ExerciseHistory* history, int index) {
+    uint64_t hash = entry_fingerprint(&history->entries[index]);
+    int mask = history->fingerprint_capacity - 1;
+    int slot = (int)(hash & (uint64_t)mask);
+    while (history->fingerprints[slot].hash != 0) slot = (slot + 1) & mask;
+    history->fingerprints[slot].hash = hash;
+    history->fingerprints[slot].entry = index;
+}
+
+// (Re)construit l'ensemble des empreintes, rempli au plus au quart : les
+// ajouts suivants ont de la place jusqu'au double de l'historique
+static void build_exercise_fingerprints(ExerciseHistory* history) {
+    if (history->fingerprints) SAFE_FREE(history->fingerprints);
+    history->fingerprint_capacity = 0;
+
+    int capacity = 16;
+    while (capacity < (history->count + STATS_HISTORY_RESERVE) * 4) capacity *= 2;
+
+    history->fingerprints = SAFE_MALLOC(capacity * sizeof(ExerciseFingerprint));
+    if (!history->fingerprints) return;
+    memset(history->fingerprints, 0, capacity * sizeof(ExerciseFingerprint));
+    history->fingerprint_capacity = capacity;
+
+    for (int i = 0; i < history->count; i++) fingerprint_insert(history, i);
+}
+
+bool is_exercise_in_history(const ExerciseHistory* history, const float* session_times,
+                            int session_count) {
+    if (!history || !session_times || session_count <= 0) return false;
+
+    // Sans ensemble d'empreintes : parcours complet de l'historique
+    if (!history->fingerprints) {
+        for (int i = 0; i < history->count; i++) {
+            if (exercise_matches(&history->entries[i], session_times, session_count)) return true;
+        }
+        return false;
+    }
+
+    // Candidats de même empreinte (arrondi de la première session et ses
+    // voisins), confirmés avec la tolérance
+    int32_t first_second = (int32_t)lroundf(session_times[0]);
+    int mask = history->fingerprint_capacity - 1;
+    for (int delta = -1; delta <= 1; delta++) {
+        uint64_t hash = exercise_fingerprint(session_count, first_second + delta);
+        for (int slot = (int)(hash & (uint64_t)mask); history->fingerprints[slot].hash != 0;
+             slot = (slot + 1) & mask) {
+            const ExerciseFingerprint* fingerprint = &history->fingerprints[slot];
+            if (fingerprint->hash == hash &&
+                exercise_matches(&history->entries[fingerprint->entry], session_times, session_count)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CHARGEMENT ET AJOUTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Série de la vue chronologique, avec de la place pour des ajouts
+static void build_exercise_timeline(ExerciseHistory* history, int capacity) {
+    stats_timeline_free(&history->timeline);
+    if (!stats_timeline_begin(&history->timeline, capacity)) return;
+    for (int i = 0; i < history->count; i++) {
+        const ExerciseEntry* entry = &history->entries[i];
+        stats_timeline_add(&history->timeline, entry->timestamp,
+                           entry->session_times, entry->session_count);
+    }
+    stats_timeline_finish(&history->timeline);
+}
+
+int load_exercise_history(ExerciseHistory* history) {
+    int count = stats_store_load(history);
+    build_exercise_fingerprints(history);
+    build_exercise_timeline(history, history->count + STATS_HISTORY_RESERVE);
+    return count;
+}
+
+void free_exercise_history(ExerciseHistory* history) {
+    if (!history) return;
+
+    // Les session_times pointent dans session_pool : rien à libérer par entrée
+    if (history->entries) SAFE_FREE(history->entries);
+    if (history->session_pool) SAFE_FREE(history->session_pool);
+    if (history->fingerprints) SAFE_FREE(history->fingerprints);
+    stats_timeline_free(&history->timeline);
+    history->count = 0;
+    history->capacity = 0;
+    history->session_used = 0;
+    history->session_capacity = 0;
+    history->fingerprint_capacity = 0;
+}
+
+// Place pour un exercice de plus (×2 ; SAFE_MALLOC + copie, pas de realloc).
+// Le bloc des temps déplacé, chaque entrée est repointée
+static bool reserve_history(ExerciseHistory* history, int session_count) {
+    if (history->count == history->capacity) {
+        int capacity = history->capacity ? history->capacity * 2 : STATS_HISTORY_RESERVE;
+        ExerciseEntry* entries = SAFE_MALLOC((size_t)capacity * sizeof(ExerciseEntry));
+        if (!entries) return false;
+        if (history->entries) {
+            memcpy(entries, history->entries, (size_t)history->count * sizeof(ExerciseEntry));
+            SAFE_FREE(history->entries);
+        }
+        history->entries = entries;
+        history->capacity = capacity;
+    }
+
+    size_t needed = history->session_used + (size_t)session_count;
+    if (needed > history->session_capacity) {
+        size_t capacity = history->session_capacity ? history->session_capacity * 2 : 1024;
+        while (capacity < needed) capacity *= 2;
+        float* pool = SAFE_MALLOC(capacity * sizeof(float));
+        if (!pool) return false;
+        if (history->session_pool) {
+            memcpy(pool, history->session_pool, history->session_used * sizeof(float));
+            for (int i = 0; i < history->count; i++) {
+                history->entries[i].session_times = pool + (history->entries[i].session_times - history->session_pool);
+            }
+            SAFE_FREE(history->session_pool);
+        }
+        history->session_pool = pool;
+        history->session_capacity = capacity;
+    }
+    return true;
+}
+
+bool append_exercise_to_history(ExerciseHistory* history, time_t timestamp,
+                                const float* session_times, int session_count) {
+    if (!history || !session_times || session_count <= 0) return false;
+    if (!reserve_history(history, session_count)) {
+        debug_printf("❌ STATS: ajout à l'historique en mémoire impossible\n");
+        return false;
+    }
+
+    float* times = history->session_pool + history->session_used;
+    memcpy(times, session_times, (size_t)session_count * sizeof(float));
+    history->session_used += (size_t)session_count;
+
+    // Place chronologique : à la fin sauf horloge reculée (à date égale,
+    // après les exercices déjà présents, comme au chargement)
+    int index = history->count;
+    while (index > 0 && history->entries[index - 1].timestamp > timestamp) index--;
+    if (index < history->count) {
+        memmove(&history->entries[index + 1], &history->entries[index],
+                (size_t)(history->count - index) * sizeof(ExerciseEntry));
+    }
+    history->entries[index] = (ExerciseEntry){ timestamp, session_count, times };
+    history->count++;
+
+    // Cas courant : dernier exercice, de la place partout
+    bool last = index == history->count - 1;
+    if (last && history->fingerprints && history->count * 2 <= history->fingerprint_capacity) {
+        fingerprint_insert(history, index);
+    } else {
+        build_exercise_fingerprints(history);
+    }
+    if (!last || !stats_timeline_append(&history->timeline, timestamp, session_times, session_count)) {
+        build_exercise_timeline(history, history->count * 2 + STATS_HISTORY_RESERVE);
+    }
+    return true;
+}
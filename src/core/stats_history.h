@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// stats_history.h
+// HISTORIQUE DES EXERCICES EN MÉMOIRE
+// Chargé une fois depuis le journal (stats_store.h), puis tenu à jour à
+// chaque enregistrement sans relecture : entrées et temps (place réservée),
+// empreintes des doublons et chronologie reçoivent le nouvel exercice.
+//
+// Doublon : même nombre de sessions, temps égaux à 0.5 seconde près.
+// Empreinte : nombre de sessions + première session arrondie à la seconde.
+// Deux temps à 0.5 s près peuvent s'arrondir différemment (12.49 / 12.51),
+// mais jamais à plus d'une seconde d'écart : la recherche essaie l'arrondi et
+// ses deux voisins, puis confirme avec la tolérance.
+
+#ifndef __STATS_HISTORY_H__
+#define __STATS_HISTORY_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include "stats_timeline.h"
+
+#define STATS_HISTORY_RESERVE 64    // Exercices ajoutables après un chargement sans réallocation
+
+// Une entrée d'exercice (enregistrement du journal, voir stats_store.h)
+typedef struct {
+    time_t timestamp;           // Date et heure de l'exercice
+    int session_count;          // Nombre de sessions dans cet exercice
+    float* session_times;       // Temps de chaque session (en secondes, dans session_pool)
+} ExerciseEntry;
+
+// Empreinte d'un exercice (nombre de sessions + première session arrondie à la seconde)
+typedef struct {
+    uint64_t hash;              // 0 = case vide
+    int entry;                  // Index dans entries
+} ExerciseFingerprint;
+
+// Collection d'exercices (chargée depuis le journal)
+typedef struct {
+    ExerciseEntry* entries;     // Tableau d'exercices (ordre chronologique)
+    int count;                  // Nombre d'exercices chargés
+    int capacity;               // Capacité du tableau
+    float* session_pool;        // Bloc unique des temps de toutes les entrées
+    size_t session_used;        // Temps rangés dans session_pool
+    size_t session_capacity;
+
+    // Ensemble des empreintes (adressage ouvert) : détection des doublons
+    // sans parcourir l'historique. NULL si allocation impossible
+    ExerciseFingerprint* fingerprints;
+    int fingerprint_capacity;   // Puissance de 2, remplie au plus à moitié
+
+    // Série par date pour la vue chronologique (vide si allocation impossible)
+    StatsTimeline timeline;
+} ExerciseHistory;
+
+/**
+ * Charger l'historique depuis le journal des stats (empreintes et chronologie
+ * comprises)
+ * @param history Structure à remplir
+ * @return Nombre d'exercices chargés
+ */
+int load_exercise_history(ExerciseHistory* history);
+
+/**
+ * Libérer un historique chargé (remis à vide)
+ * @param history Historique à libérer
+ */
+void free_exercise_history(ExerciseHistory* history);
+
+/**
+ * Exercice déjà présent (doublon) ? Par les empreintes, ou en parcourant
+ * l'historique si elles n'ont pas pu être allouées
+ */
+bool is_exercise_in_history(const ExerciseHistory* history, const float* session_times,
+                            int session_count);
+
+/**
+ * Ajouter un exercice déjà écrit dans le journal, à sa place chronologique.
+ * Coût constant dans le cas courant (exercice le plus récent, place
+ * réservée) ; sinon empreintes et chronologie sont reconstruites
+ * @return false si allocation impossible (historique inchangé)
+ */
+bool append_exercise_to_history(ExerciseHistory* history, time_t timestamp,
+                                const float* session_times, int session_count);
+
+#endif
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // stats_panel.c - Panneau de statistiques avec graphique
 #include "stats_panel.h"
+#include "stats_store.h"
+#include "stats_exchange.h"
 #include "debug.h"
 #include "paths.h"
 #include "button_widget.h"
@@ -11,8 +13,6 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
-#include <dirent.h>
-#include <sys/stat.h>
 #include <cairo/cairo.h>
 #include <SDL2/SDL2_gfxPrimitives.h>
 #include <SDL2/SDL_ttf.h>
@@ -36,63 +36,15 @@ static const SDL_Color RAINBOW_COLORS[] = {
 };
 #define RAINBOW_COUNT 7
 
-// UTILITAIRES FICHIERS BINAIRES
-
-// Créer le dossier stats s'il n'existe pas
-static void ensure_stats_dir(void) {
-    struct stat st = {0};
-    if (stat(CONFIG_STATS_DIR, &st) == -1) {
-        mkdir(CONFIG_STATS_DIR, 0700);
-    }
-}
-
-// Générer un nom de fichier unique : stats_YYYYMMDD_HHMMSS.bin
-static void generate_filename(char* buffer, size_t size) {
-    time_t now = time(NULL);
-    struct tm* tm_info = localtime(&now);
-    snprintf(buffer, size, "%s/stats_%04d%02d%02d_%02d%02d%02d.bin",
-             CONFIG_STATS_DIR,
-             tm_info->tm_year + 1900,
-             tm_info->tm_mon + 1,
-             tm_info->tm_mday,
-             tm_info->tm_hour,
-             tm_info->tm_min,
-             tm_info->tm_sec);
-}
-
-// SAUVEGARDE/CHARGEMENT BINAIRE
+// SAUVEGARDE/CHARGEMENT (JOURNAL DES STATS)
 
 // Vérifier si l'exercice actuel est déjà sauvegardé dans l'historique
 static bool is_exercise_already_saved(StatsPanel* panel) {
     if (!panel || !panel->current_session_times || panel->current_session_count == 0) {
         return false;
     }
-
-    // Parcourir l'historique
-    for (int i = 0; i < panel->history.count; i++) {
-        ExerciseEntry* entry = &panel->history.entries[i];
-
-        // Vérifier si le nombre de sessions correspond
-        if (entry->session_count != panel->current_session_count) {
-            continue;
-        }
-
-        // Comparer les temps de chaque session (tolérance de 0.5 seconde)
-        bool all_match = true;
-        for (int j = 0; j < panel->current_session_count; j++) {
-            float diff = fabs(entry->session_times[j] - panel->current_session_times[j]);
-            if (diff > 0.5f) {
-                all_match = false;
-                break;
-            }
-        }
-
-        if (all_match) {
-            return true; // Exercice identique trouvé
-        }
-    }
-
-    return false; // Pas de doublon trouvé
+    return is_exercise_in_history(&panel->history, panel->current_session_times,
+                                  panel->current_session_count);
 }
 
 bool save_exercise_to_file(StatsPanel* panel) {
@@ -107,165 +59,78 @@ bool save_exercise_to_file(StatsPanel* panel) {
         return false;
     }
 
-    ensure_stats_dir();
-
-    char filename[256];
-    generate_filename(filename, sizeof(filename));
-
-    FILE* file = fopen(filename, "wb");
-    if (!file) {
-        debug_printf("❌ Erreur ouverture fichier: %s\n", filename);
-        return false;
-    }
-
-    // Écrire timestamp
     time_t now = time(NULL);
-    fwrite(&now, sizeof(time_t), 1, file);
-
-    // Écrire nombre de sessions
-    fwrite(&panel->current_session_count, sizeof(int), 1, file);
-
-    // Écrire les temps
-    fwrite(panel->current_session_times, sizeof(float), panel->current_session_count, file);
-
-    fclose(file);
-    debug_printf("✅ Exercice sauvegardé: %s (%d sessions)\n", filename, panel->current_session_count);
-
-    return true;
-}
-
-int load_exercise_history(ExerciseHistory* history) {
-    Error err;
-    error_init(&err);
-
-    if (!history) return 0;
-
-    // Initialiser
-    history->entries = NULL;
-    history->count = 0;
-    history->capacity = 10;
-
-    // Allocation initiale
-    history->entries = SAFE_MALLOC(history->capacity * sizeof(ExerciseEntry));
-    if (!history->entries) {
-        SET_ERROR(&err, ERR_ALLOC, "Échec allocation entries");
-        error_print(&err);
-        return 0;
-    }
-
-    // Lire tous les fichiers .bin du dossier
-    DIR* dir = opendir(CONFIG_STATS_DIR);
-    if (!dir) {
-        // BUG FIX: libérer entries si opendir échoue
-        SAFE_FREE(history->entries);
-        history->entries = NULL;
-        return 0;
+    if (!stats_store_append(now, panel->current_session_times,
+                            panel->current_session_count)) {
+        debug_printf("❌ Erreur sauvegarde de l'exercice\n");
+        return false;
     }
 
-    struct dirent* entry;
-    while ((entry = readdir(dir)) != NULL) {
-        // Vérifier extension .bin
-        size_t len = strlen(entry->d_name);
-        if (len < 4 || strcmp(entry->d_name + len - 4, ".bin") != 0) {
-            continue;
-        }
-
-        // Construire le chemin complet
-        char filepath[512];
-        snprintf(filepath, sizeof(filepath), "%s/%s", CONFIG_STATS_DIR, entry->d_name);
-
-        // Lire le fichier
-        FILE* file = fopen(filepath, "rb");
-        if (!file) continue;
-
-        // Réallouer si nécessaire
-        if (history->count >= history->capacity) {
-            history->capacity *= 2;
-            ExerciseEntry* new_entries = realloc(history->entries,
-                                                 history->capacity * sizeof(ExerciseEntry));
-            if (!new_entries) {
-                SET_ERROR(&err, ERR_ALLOC, "Échec realloc entries");
-                error_print(&err);
-                fclose(file);
-                break;  // Sortir de la boucle, les entries existantes sont OK
-            }
-            history->entries = new_entries;
-        }
-
-        ExerciseEntry* e = &history->entries[history->count];
-
-        // Initialiser session_times à NULL pour cleanup sécurisé
-        e->session_times = NULL;
-
-        // Lire timestamp
-        if (fread(&e->timestamp, sizeof(time_t), 1, file) != 1) {
-            fclose(file);
-            continue;
-        }
-
-        // Lire nombre de sessions
-        if (fread(&e->session_count, sizeof(int), 1, file) != 1) {
-            fclose(file);
-            continue;
-        }
-
-        // Lire les temps - allocation critique
-        e->session_times = SAFE_MALLOC(e->session_count * sizeof(float));
-        if (!e->session_times) {
-            SET_ERROR(&err, ERR_ALLOC, "Échec allocation session_times pour exercice");
-            error_print(&err);
-            fclose(file);
-            continue;  // Passer à l'exercice suivant
-        }
-
-        if (fread(e->session_times, sizeof(float), e->session_count, file) != (size_t)e->session_count) {
-            // Échec lecture: libérer session_times de CET exercice
-            SAFE_FREE(e->session_times);
-            e->session_times = NULL;
-            fclose(file);
-            continue;  // Passer à l'exercice suivant
-        }
-
-        fclose(file);
-        history->count++;  // Exercice chargé avec succès
+    // Historique et cumuls en mémoire : l'exercice est ajouté, rien n'est
+    // relu (coût indépendant de la taille de l'historique)
+    stats_rollup_add(&panel->rollup, now, panel->current_session_times,
+                     panel->current_session_count);
+    if (!append_exercise_to_history(&panel->history, now, panel->current_session_times,
+                                    panel->current_session_count)) {
+        free_exercise_history(&panel->history);
+        load_exercise_history(&panel->history);
     }
-
-    closedir(dir);
-    debug_printf("✅ Historique chargé: %d exercices\n", history->count);
-
-    return history->count;
+    return true;
 }
 
 bool reset_exercise_history(void) {
-    DIR* dir = opendir(CONFIG_STATS_DIR);
-    if (!dir) return true; // Pas de dossier = déjà vide
+    return stats_store_reset();
+}
 
-    struct dirent* entry;
-    int deleted = 0;
+// RENDU DU GRAPHIQUE AVEC CAIRO
 
-    while ((entry = readdir(dir)) != NULL) {
-        // Vérifier extension .bin
-        size_t len = strlen(entry->d_name);
-        if (len < 4 || strcmp(entry->d_name + len - 4, ".bin") != 0) {
-            continue;
-        }
+// Durée en m:ss
+static void format_duration(char* buffer, size_t size, float seconds) {
+    int total = (int)seconds;
+    snprintf(buffer, size, "%d:%02d", total / 60, total % 60);
+}
 
-        // Supprimer le fichier
-        char filepath[512];
-        snprintf(filepath, sizeof(filepath), "%s/%s", CONFIG_STATS_DIR, entry->d_name);
-        if (remove(filepath) == 0) {
-            deleted++;
-        }
+// Lignes de résumé sous le graphique, depuis les cumuls (coût indépendant
+// de la taille de l'historique)
+static void draw_rollup_summary(cairo_t* cr, const StatsRollup* rollup, int x, int y) {
+    char line[160];
+    char best_session[16], best_total[16];
+    int32_t today = stats_rollup_day(time(NULL));
+
+    cairo_set_source_rgb(cr, 0.2, 0.2, 0.2);
+    cairo_set_font_size(cr, 11);
+
+    snprintf(line, sizeof(line), "Aujourd'hui : %u · Semaine : %u · Série : %u j (record %u j)",
+             stats_rollup_day_exercises(rollup, today),
+             stats_rollup_week_exercises(rollup, stats_rollup_week(today)),
+             stats_rollup_current_streak(rollup, today), rollup->best_streak);
+    cairo_move_to(cr, x, y);
+    cairo_show_text(cr, line);
+
+    format_duration(best_session, sizeof(best_session), rollup->best_session);
+    format_duration(best_total, sizeof(best_total), rollup->best_total);
+    snprintf(line, sizeof(line), "Records : session %s · exercice %s · %u exercices au total",
+             best_session, best_total, rollup->exercises);
+    cairo_move_to(cr, x, y + 16);
+    cairo_show_text(cr, line);
+
+    // Moyenne / médiane / max des premiers rangs de session
+    int length = snprintf(line, sizeof(line), "Moy./méd./max :");
+    for (int rank = 0; rank < 3 && rollup->by_rank[rank].count > 0; rank++) {
+        char mean[16], median[16], max[16];
+        format_duration(mean, sizeof(mean), stats_rollup_mean(rollup, rank));
+        format_duration(median, sizeof(median), stats_rollup_median(rollup, rank));
+        format_duration(max, sizeof(max), rollup->by_rank[rank].max);
+        length += snprintf(line + length, sizeof(line) - length, "%s S%d %s/%s/%s",
+                           rank ? " ·" : "", rank + 1, mean, median, max);
+        if (length >= (int)sizeof(line)) break;
+    }
+    if (rollup->by_rank[0].count > 0) {
+        cairo_move_to(cr, x, y + 32);
+        cairo_show_text(cr, line);
     }
-
-    closedir(dir);
-    debug_printf("🗑️ Historique réinitialisé: %d fichiers supprimés\n", deleted);
-
-    return true;
 }
 
-// RENDU DU GRAPHIQUE AVEC CAIRO
-
 // Structure temporaire pour un exercice à afficher
 typedef struct {
     time_t timestamp;
@@ -274,68 +139,121 @@ typedef struct {
     bool is_current; // true = exercice actuel (non enregistré)
 } DisplayExercise;
 
-// Créer la texture du graphique
-static SDL_Texture* create_graph_texture(SDL_Renderer* renderer, StatsPanel* panel,
-                                         int width, int height) {
-    Error err;
-    error_init(&err);
-
-    // Créer surface Cairo
-    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
-    cairo_t* cr = cairo_create(surface);
-    cairo_set_antialias(cr, CAIRO_ANTIALIAS_BEST);
-
-    // Fond blanc
-    cairo_set_source_rgb(cr, 1.0, 1.0, 1.0);
-    cairo_paint(cr);
-
-    // Zone du graphique (avec marges pour les axes)
-    int graph_x = GRAPH_MARGIN;
-    int graph_y = GRAPH_MARGIN + 20; // Espace pour le titre
-    int graph_width = width - 2 * GRAPH_MARGIN;
-    int graph_height = height - 2 * GRAPH_MARGIN - 100; // Espace pour date/heure et boutons
-
-    // ═══ PRÉPARER LES EXERCICES (avec scroll) ═══
-    // Calculer le nombre total d'exercices disponibles
-    int total_exercises = panel->history.count;
+// Nombre d'exercices du graphique (historique + exercice actuel)
+static int graph_total_exercises(const StatsPanel* panel) {
+    int total = panel->history.count;
     if (panel->current_session_count > 0 && panel->current_session_times) {
-        total_exercises++; // Ajouter l'exercice actuel
+        total++; // Ajouter l'exercice actuel
     }
+    return total;
+}
 
-    // Limiter scroll_offset
+// Limiter scroll_offset aux exercices disponibles
+static void clamp_graph_scroll(StatsPanel* panel) {
+    int total_exercises = graph_total_exercises(panel);
     int max_offset = total_exercises > GRAPH_EXERCISES ? total_exercises - GRAPH_EXERCISES : 0;
-    if (panel->scroll_offset < 0) panel->scroll_offset = 0;
     if (panel->scroll_offset > max_offset) panel->scroll_offset = max_offset;
+    if (panel->scroll_offset < 0) panel->scroll_offset = 0;
+}
 
-    // Créer la liste temporaire de tous les exercices (historique + actuel)
-    DisplayExercise* all_exercises = SAFE_MALLOC(total_exercises * sizeof(DisplayExercise));
-    CHECK_ALLOC(all_exercises, &err, "Échec allocation all_exercises");
-    int all_count = 0;
+// Fenêtre de la chronologie : de tout l'historique (et aujourd'hui) jusqu'à
+// TIMELINE_MIN_SPAN ; la molette zoome de TIMELINE_ZOOM_STEP par cran et
+// Maj+molette défile d'un TIMELINE_PAN_DIVISIONS-ième de la fenêtre
+#define TIMELINE_MIN_SPAN (6 * 3600)
+#define TIMELINE_ZOOM_STEP 0.8
+#define TIMELINE_PAN_DIVISIONS 8
+
+// Fenêtre maximale : premier exercice → maintenant, avec une marge
+static void timeline_bounds(const StatsPanel* panel, int64_t* start, int64_t* end) {
+    int64_t now = (int64_t)time(NULL);
+    int64_t first = now, last = now;
+    stats_timeline_range(&panel->history.timeline, &first, &last);
+    if (first > now) first = now;
+    if (last < now) last = now;
+
+    int64_t margin = (last - first) / 50;
+    if (margin < TIMELINE_MIN_SPAN / 2) margin = TIMELINE_MIN_SPAN / 2;
+    *start = first - margin;
+    *end = last + margin;
+}
 
-    // Ajouter l'historique (du plus ancien au plus récent)
-    for (int i = 0; i < panel->history.count; i++) {
-        all_exercises[all_count].timestamp = panel->history.entries[i].timestamp;
-        all_exercises[all_count].session_times = panel->history.entries[i].session_times;
-        all_exercises[all_count].session_count = panel->history.entries[i].session_count;
-        all_exercises[all_count].is_current = false;
-        all_count++;
-    }
+static int64_t timeline_pan_step(const StatsPanel* panel) {
+    int64_t step = (panel->timeline_end - panel->timeline_start) / TIMELINE_PAN_DIVISIONS;
+    return step > 0 ? step : 1;
+}
 
-    // Ajouter l'exercice actuel à la fin (plus récent)
-    if (panel->current_session_count > 0 && panel->current_session_times) {
-        all_exercises[all_count].timestamp = time(NULL);
-        all_exercises[all_count].session_times = panel->current_session_times;
-        all_exercises[all_count].session_count = panel->current_session_count;
-        all_exercises[all_count].is_current = true;
-        all_count++;
+// Limiter la fenêtre à l'historique (cadrée sur tout l'historique si vide)
+static void clamp_timeline(StatsPanel* panel) {
+    int64_t min_start, max_end;
+    timeline_bounds(panel, &min_start, &max_end);
+
+    if (panel->timeline_end <= panel->timeline_start) {
+        panel->timeline_start = min_start;
+        panel->timeline_end = max_end;
+        return;
     }
 
-    // Sélectionner les GRAPH_EXERCISES exercices à afficher (avec scroll)
-    int start_index = panel->scroll_offset;
-    int exercise_count = (all_count - start_index) > GRAPH_EXERCISES ? GRAPH_EXERCISES : (all_count - start_index);
+    int64_t span = panel->timeline_end - panel->timeline_start;
+    if (span > max_end - min_start) span = max_end - min_start;
+    if (span < TIMELINE_MIN_SPAN) span = TIMELINE_MIN_SPAN;
+
+    int64_t start = panel->timeline_start;
+    if (start + span > max_end) start = max_end - span;
+    if (start < min_start) start = min_start;
+    panel->timeline_start = start;
+    panel->timeline_end = start + span;
+}
+
+// Zoom de `notches` crans (positif = rapprocher) autour de la date sous la souris
+static void timeline_zoom(StatsPanel* panel, int notches, int mouse_x) {
+    double graph_x = panel->current_x + GRAPH_MARGIN;
+    double graph_width = panel->panel_width - 2 * GRAPH_MARGIN;
+    double ratio = (mouse_x - graph_x) / graph_width;
+    if (ratio < 0.0) ratio = 0.0;
+    if (ratio > 1.0) ratio = 1.0;
+
+    double span = (double)(panel->timeline_end - panel->timeline_start);
+    double anchor = panel->timeline_start + ratio * span;
+    double new_span = span * pow(TIMELINE_ZOOM_STEP, notches);
+    if (new_span < TIMELINE_MIN_SPAN) new_span = TIMELINE_MIN_SPAN;
+
+    panel->timeline_start = (int64_t)llround(anchor - ratio * new_span);
+    panel->timeline_end = panel->timeline_start + (int64_t)llround(new_span);
+    clamp_timeline(panel);
+}
+
+// Défilement de `steps` pas (positif = plus récent)
+static void timeline_pan(StatsPanel* panel, int steps) {
+    int64_t shift = timeline_pan_step(panel) * steps;
+    panel->timeline_start += shift;
+    panel->timeline_end += shift;
+    clamp_timeline(panel);
+}
+
+// Page de GRAPH_EXERCISES exercices : une barre arrondie par session
+static void draw_exercise_page(cairo_t* cr, const StatsPanel* panel, StatsGraphKey key,
+                               int graph_x, int graph_y, int graph_width, int graph_height) {
+    // ═══ PRÉPARER LES EXERCICES (avec scroll) ═══
+    // Les GRAPH_EXERCISES exercices de la page, pris directement dans
+    // l'historique (du plus ancien au plus récent) puis l'exercice actuel
+    int total_exercises = graph_total_exercises(panel);
     DisplayExercise exercises[GRAPH_EXERCISES];
-    for (int i = 0; i < exercise_count; i++) {
-        exercises[i] = all_exercises[start_index + i];
+    int exercise_count = 0;
+
+    for (int i = key.scroll_offset; i < total_exercises && exercise_count < GRAPH_EXERCISES; i++) {
+        DisplayExercise* exercise = &exercises[exercise_count++];
+        if (i < panel->history.count) {
+            exercise->timestamp = panel->history.entries[i].timestamp;
+            exercise->session_times = panel->history.entries[i].session_times;
+            exercise->session_count = panel->history.entries[i].session_count;
+            exercise->is_current = false;
+        } else {
+            // Exercice actuel à la fin (plus récent)
+            exercise->timestamp = time(NULL);
+            exercise->session_times = panel->current_session_times;
+            exercise->session_count = panel->current_session_count;
+            exercise->is_current = true;
+        }
     }
 
     // ═══ TROUVER LE TEMPS MAXIMUM ═══
@@ -356,7 +274,7 @@ static SDL_Texture* create_graph_texture(SDL_Renderer* renderer, StatsPanel* pan
 
     if (exercise_count > 0) {
         // Déterminer quel exercice afficher (par défaut le dernier)
-        int selected_idx = panel->selected_exercise_index;
+        int selected_idx = key.selected;
         if (selected_idx == -1 || selected_idx >= exercise_count) {
             selected_idx = exercise_count - 1;
         }
@@ -462,7 +380,8 @@ static SDL_Texture* create_graph_texture(SDL_Renderer* renderer, StatsPanel* pan
     cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
 
     for (int e = 0; e < exercise_count; e++) {
-        struct tm* tm_ex = localtime(&exercises[e].timestamp);
+        struct tm tm_buf;   // localtime_r : rastérisation hors du thread principal
+        struct tm* tm_ex = localtime_r(&exercises[e].timestamp, &tm_buf);
         double center_x = graph_x + e * exercise_width + exercise_width / 2;
 
         // Date (jj/mm)
@@ -484,10 +403,220 @@ static SDL_Texture* create_graph_texture(SDL_Renderer* renderer, StatsPanel* pan
         cairo_move_to(cr, center_x - extents.width / 2, graph_y + graph_height + 38);
         cairo_show_text(cr, time_label);
     }
+}
+
+// Format de date des graduations selon la durée affichée
+static const char* timeline_tick_format(int64_t span) {
+    const int64_t day = 24 * 3600;
+    if (span > 3 * 365 * day) return "%Y";
+    if (span > 90 * day) return "%m/%Y";
+    if (span > 3 * day) return "%d/%m";
+    return "%d/%m %Hh";
+}
+
+// Chronologie de la fenêtre [key.start, key.end] : meilleur temps de chaque
+// exercice (ligne) et enveloppe min/max des sessions, échantillonnés à la
+// largeur du graphique (coût indépendant de la longueur de l'historique)
+static void draw_timeline(cairo_t* cr, const StatsPanel* panel, StatsGraphKey key,
+                          int graph_x, int graph_y, int graph_width, int graph_height) {
+    const StatsTimeline* timeline = &panel->history.timeline;
+    double span = (double)(key.end - key.start);
+    if (span <= 0) span = 1;
+
+    int budget = graph_width > 3 ? graph_width : 3;
+    TimelinePoint* points = SAFE_MALLOC((budget + 2) * sizeof(TimelinePoint));
+    int count = points ? stats_timeline_sample(timeline, key.start, key.end, budget, points) : 0;
+
+    // Exercice actuel (non enregistré) : point à la date du jour
+    time_t now = time(NULL);
+    float current_best = 0.0f;
+    for (int i = 0; i < panel->current_session_count && panel->current_session_times; i++) {
+        if (panel->current_session_times[i] > current_best) current_best = panel->current_session_times[i];
+    }
+    bool show_current = current_best > 0.0f && now >= key.start && now <= key.end;
+
+    // ═══ TROUVER LE TEMPS MAXIMUM ═══
+    float max_time = 60.0f; // Minimum 1 minute
+    for (int i = 0; i < count; i++) {
+        if (points[i].high > max_time) max_time = points[i].high;
+    }
+    if (show_current && current_best > max_time) max_time = current_best;
+
+    // ═══ GRILLE HORIZONTALE (temps) ═══
+    cairo_set_line_width(cr, 1.0);
+    double dash[] = {5.0, 5.0};
+    cairo_set_dash(cr, dash, 2, 0);
+    cairo_set_font_size(cr, 12);
+    for (int g = 1; g <= 4; g++) {
+        float value = max_time * g / 4.0f;
+        double y = graph_y + graph_height - (value / max_time) * graph_height;
+
+        cairo_set_source_rgb(cr, 0.5, 0.5, 0.5);
+        cairo_move_to(cr, graph_x, y);
+        cairo_line_to(cr, graph_x + graph_width, y);
+        cairo_stroke(cr);
+
+        char label[16];
+        format_duration(label, sizeof(label), value);
+        cairo_text_extents_t extents;
+        cairo_text_extents(cr, label, &extents);
+        cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+        cairo_move_to(cr, graph_x - extents.width - 5, y + 4);
+        cairo_show_text(cr, label);
+    }
+
+    // ═══ GRADUATIONS DE DATES ═══
+    const char* format = timeline_tick_format(key.end - key.start);
+    cairo_set_font_size(cr, 11);
+    for (int t = 0; t <= 4; t++) {
+        double x = graph_x + graph_width * t / 4.0;
+        time_t tick = (time_t)(key.start + (int64_t)(span * t / 4.0));
+        struct tm tm_buf;
+        char label[32];
+        if (!localtime_r(&tick, &tm_buf) || !strftime(label, sizeof(label), format, &tm_buf)) continue;
+
+        cairo_set_source_rgb(cr, 0.5, 0.5, 0.5);
+        cairo_move_to(cr, x, graph_y);
+        cairo_line_to(cr, x, graph_y + graph_height);
+        cairo_stroke(cr);
+
+        cairo_text_extents_t extents;
+        cairo_text_extents(cr, label, &extents);
+        double label_x = x - extents.width / 2;
+        if (t == 0) label_x = x;
+        if (t == 4) label_x = x - extents.width;
+        cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+        cairo_move_to(cr, label_x, graph_y + graph_height + 20);
+        cairo_show_text(cr, label);
+    }
+
+    // ═══ AXES PRINCIPAUX ═══
+    cairo_set_dash(cr, NULL, 0, 0); // Ligne continue
+    cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+    cairo_move_to(cr, graph_x, graph_y + graph_height);
+    cairo_line_to(cr, graph_x + graph_width, graph_y + graph_height);
+    cairo_move_to(cr, graph_x, graph_y);
+    cairo_line_to(cr, graph_x, graph_y + graph_height);
+    cairo_stroke(cr);
+
+    cairo_set_font_size(cr, 10);
+    cairo_save(cr);
+    cairo_move_to(cr, 5, graph_y + graph_height / 2);
+    cairo_rotate(cr, -M_PI / 2); // Rotation -90° pour texte vertical
+    cairo_show_text(cr, "temps");
+    cairo_restore(cr);
+
+    // ═══ COURBE ET ENVELOPPE (limitées à la zone du graphique) ═══
+    cairo_save(cr);
+    cairo_rectangle(cr, graph_x, graph_y, graph_width, graph_height);
+    cairo_clip(cr);
+
+    #define TIMELINE_X(t) (graph_x + ((t) - (double)key.start) / span * graph_width)
+    #define TIMELINE_Y(v) (graph_y + graph_height - ((v) / max_time) * graph_height)
+
+    if (count > 1) {
+        // Enveloppe : aller par les max, retour par les min
+        cairo_move_to(cr, TIMELINE_X(points[0].time), TIMELINE_Y(points[0].high));
+        for (int i = 1; i < count; i++) {
+            cairo_line_to(cr, TIMELINE_X(points[i].time), TIMELINE_Y(points[i].high));
+        }
+        for (int i = count - 1; i >= 0; i--) {
+            cairo_line_to(cr, TIMELINE_X(points[i].time), TIMELINE_Y(points[i].low));
+        }
+        cairo_close_path(cr);
+        cairo_set_source_rgba(cr, 0.25, 0.45, 0.85, 0.2);
+        cairo_fill(cr);
+
+        cairo_move_to(cr, TIMELINE_X(points[0].time), TIMELINE_Y(points[0].value));
+        for (int i = 1; i < count; i++) {
+            cairo_line_to(cr, TIMELINE_X(points[i].time), TIMELINE_Y(points[i].value));
+        }
+        cairo_set_source_rgb(cr, 0.2, 0.4, 0.8);
+        cairo_set_line_width(cr, 1.5);
+        cairo_stroke(cr);
+    }
+
+    // Points visibles un par un quand ils sont assez espacés
+    if (count > 0 && count * 6 < graph_width) {
+        cairo_set_source_rgb(cr, 0.2, 0.4, 0.8);
+        for (int i = 0; i < count; i++) {
+            cairo_new_sub_path(cr);
+            cairo_arc(cr, TIMELINE_X(points[i].time), TIMELINE_Y(points[i].value), 3.0, 0, 2 * M_PI);
+        }
+        cairo_fill(cr);
+    }
+
+    if (show_current) {
+        SDL_Color color = RAINBOW_COLORS[1];
+        cairo_set_source_rgb(cr, color.r / 255.0, color.g / 255.0, color.b / 255.0);
+        cairo_new_sub_path(cr);
+        cairo_arc(cr, TIMELINE_X((double)now), TIMELINE_Y(current_best), 4.0, 0, 2 * M_PI);
+        cairo_fill(cr);
+    }
+
+    #undef TIMELINE_X
+    #undef TIMELINE_Y
+    cairo_restore(cr);
+
+    // ═══ FENÊTRE AFFICHÉE ═══
+    cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+    cairo_set_font_size(cr, 11);
+    if (timeline->count == 0) {
+        const char* empty = "Aucun exercice enregistré";
+        cairo_text_extents_t extents;
+        cairo_text_extents(cr, empty, &extents);
+        cairo_move_to(cr, graph_x + (graph_width - extents.width) / 2, graph_y + graph_height / 2);
+        cairo_show_text(cr, empty);
+    } else {
+        char from[16], to[16], line[96];
+        time_t start = (time_t)key.start, end = (time_t)key.end;
+        struct tm tm_start, tm_end;
+        localtime_r(&start, &tm_start);
+        localtime_r(&end, &tm_end);
+        strftime(from, sizeof(from), "%d/%m/%Y", &tm_start);
+        strftime(to, sizeof(to), "%d/%m/%Y", &tm_end);
+        snprintf(line, sizeof(line), "%s → %s · molette : zoom, Maj+molette : défiler", from, to);
+        cairo_move_to(cr, graph_x, graph_y + graph_height + 38);
+        cairo_show_text(cr, line);
+    }
+
+    if (points) SAFE_FREE(points);
+}
+
+// Rastériser une page du graphique dans une surface ARGB8888.
+// Peut tourner hors du thread principal : ne lit que l'historique, l'exercice
+// actuel et les cumuls du panneau (inchangés pendant la rastérisation, voir
+// stats_worker_quiesce) et ne crée aucune ressource du renderer.
+static SDL_Surface* rasterize_graph(const StatsPanel* panel, StatsGraphKey key,
+                                    int width, int height) {
+    // Créer surface Cairo
+    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    cairo_t* cr = cairo_create(surface);
+    cairo_set_antialias(cr, CAIRO_ANTIALIAS_BEST);
+
+    // Fond blanc
+    cairo_set_source_rgb(cr, 1.0, 1.0, 1.0);
+    cairo_paint(cr);
+
+    // Zone du graphique (avec marges pour les axes)
+    int graph_x = GRAPH_MARGIN;
+    int graph_y = GRAPH_MARGIN + 20; // Espace pour le titre
+    int graph_width = width - 2 * GRAPH_MARGIN;
+    int graph_height = height - 2 * GRAPH_MARGIN - 100; // Espace pour date/heure et boutons
+
+    if (key.view == STATS_VIEW_TIMELINE) {
+        draw_timeline(cr, panel, key, graph_x, graph_y, graph_width, graph_height);
+    } else {
+        draw_exercise_page(cr, panel, key, graph_x, graph_y, graph_width, graph_height);
+    }
+
+    // ═══ RÉSUMÉ (CUMULS) ═══
+    draw_rollup_summary(cr, &panel->rollup, graph_x - GRAPH_MARGIN / 2, graph_y + graph_height + 58);
 
     // ═══ TITRE (DATE DU JOUR) ═══
     time_t now = time(NULL);
-    struct tm* tm_now = localtime(&now);
+    struct tm tm_now_buf;
+    struct tm* tm_now = localtime_r(&now, &tm_now_buf);
     char today_label[64];
     const char* days[] = {"Dimanche", "Lundi", "Mardi", "Mercredi", "Jeudi", "Vendredi", "Samedi"};
     const char* months[] = {"janvier", "février", "mars", "avril", "mai", "juin",
@@ -504,37 +633,354 @@ static SDL_Texture* create_graph_texture(SDL_Renderer* renderer, StatsPanel* pan
     // Finaliser
     cairo_surface_flush(surface);
 
-    // Convertir en texture SDL
+    // Copier dans une surface SDL (convertie en texture par le thread principal)
     SDL_Surface* sdl_surface = SDL_CreateRGBSurfaceWithFormat(
         0, width, height, 32, SDL_PIXELFORMAT_ARGB8888
     );
 
     if (sdl_surface) {
-        memcpy(sdl_surface->pixels,
-               cairo_image_surface_get_data(surface),
-               height * cairo_image_surface_get_stride(surface));
+        const unsigned char* pixels = cairo_image_surface_get_data(surface);
+        int stride = cairo_image_surface_get_stride(surface);
+        for (int row = 0; row < height; row++) {
+            memcpy((unsigned char*)sdl_surface->pixels + row * sdl_surface->pitch,
+                   pixels + row * stride, width * 4);
+        }
+    }
+
+    cairo_destroy(cr);
+    cairo_surface_destroy(surface);
+    return sdl_surface;
+}
+
+// TRAVAIL EN ARRIÈRE-PLAN
+// ═══════════════════════════════════════════════════════════════════════════
+// Un thread par panneau :
+// - Charge l'historique (+ cumuls et empreintes) pendant l'animation
+//   d'ouverture, et après un import ; un graphique d'attente est affiché en
+//   attendant
+// - Rastérise les pages du graphique demandées : la page affichée d'abord,
+//   puis ses voisines, pour que le scroll trouve la sienne déjà prête
+// Le thread lit l'historique sans le copier : le thread principal attend
+// qu'il soit au repos (stats_worker_quiesce) avant de le modifier. Les
+// textures ne sont créées et détruites que par le thread principal.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define GRAPH_CACHE_PAGES 6     // Page affichée, ses voisines et de la marge
+
+typedef struct {
+    StatsGraphKey key;
+    bool used;
+    bool wanted;                // À rastériser
+    bool in_progress;           // En cours dans le thread
+    int priority;               // 0 = page affichée, 1 = voisine
+    SDL_Surface* surface;       // Résultat du thread, pas encore converti
+    SDL_Texture* texture;       // Thread principal uniquement
+} GraphPage;
+
+struct StatsWorker {
+    SDL_Thread* thread;
+    SDL_mutex* lock;
+    SDL_cond* wake;             // Travail disponible ou arrêt
+    SDL_cond* idle;             // Une tâche vient de se terminer
+    bool quit;
+    bool busy;
+
+    bool load_pending;          // Chargement de l'historique demandé
+    bool load_ready;            // Résultat à adopter par le thread principal
+    ExerciseHistory loaded;
+    StatsRollup loaded_rollup;
+
+    GraphPage pages[GRAPH_CACHE_PAGES];
+    int width, height;
+};
+
+static bool graph_key_equal(StatsGraphKey a, StatsGraphKey b) {
+    return a.view == b.view && a.scroll_offset == b.scroll_offset && a.selected == b.selected &&
+           a.start == b.start && a.end == b.end && a.version == b.version;
+}
 
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, sdl_surface);
-        SDL_FreeSurface(sdl_surface);
+// Clé de la page affichée, décalée de `shift` pas de scroll (ou de
+// défilement de la chronologie) pour les pages voisines
+static StatsGraphKey current_graph_key(const StatsPanel* panel, int shift) {
+    StatsGraphKey key = { panel->view, 0, panel->selected_exercise_index, 0, 0, panel->graph_version };
+    if (panel->view == STATS_VIEW_TIMELINE) {
+        int64_t step = timeline_pan_step(panel) * shift;
+        key.start = panel->timeline_start + step;
+        key.end = panel->timeline_end + step;
+    } else {
+        key.scroll_offset = panel->scroll_offset + shift;
+    }
+    return key;
+}
 
-        cairo_destroy(cr);
-        cairo_surface_destroy(surface);
-        SAFE_FREE(all_exercises);
+// Page demandée la plus prioritaire (verrou tenu)
+static GraphPage* worker_next_page(StatsWorker* worker) {
+    GraphPage* best = NULL;
+    for (int i = 0; i < GRAPH_CACHE_PAGES; i++) {
+        GraphPage* page = &worker->pages[i];
+        if (page->used && page->wanted && (!best || page->priority < best->priority)) {
+            best = page;
+        }
+    }
+    return best;
+}
 
-        return texture;
+static int stats_worker_thread(void* data) {
+    StatsPanel* panel = data;
+    StatsWorker* worker = panel->worker;
+
+    SDL_LockMutex(worker->lock);
+    while (!worker->quit) {
+        if (worker->load_pending) {
+            worker->load_pending = false;
+            worker->busy = true;
+            SDL_UnlockMutex(worker->lock);
+
+            ExerciseHistory history;
+            load_exercise_history(&history);
+            stats_store_load_rollup(&worker->loaded_rollup);
+
+            SDL_LockMutex(worker->lock);
+            worker->loaded = history;
+            worker->load_ready = true;
+            worker->busy = false;
+            SDL_CondBroadcast(worker->idle);
+            continue;
+        }
+
+        GraphPage* page = worker_next_page(worker);
+        if (!page) {
+            SDL_CondWait(worker->wake, worker->lock);
+            continue;
+        }
+
+        page->wanted = false;
+        page->in_progress = true;
+        worker->busy = true;
+        StatsGraphKey key = page->key;
+        SDL_UnlockMutex(worker->lock);
+
+        SDL_Surface* surface = rasterize_graph(panel, key, worker->width, worker->height);
+
+        SDL_LockMutex(worker->lock);
+        page->in_progress = false;
+        worker->busy = false;
+        if (page->used && graph_key_equal(page->key, key)) {
+            page->surface = surface;
+        } else if (surface) {
+            SDL_FreeSurface(surface);   // Page abandonnée entre-temps
+        }
+        SDL_CondBroadcast(worker->idle);
     }
+    SDL_UnlockMutex(worker->lock);
+    return 0;
+}
 
-    cairo_destroy(cr);
-    cairo_surface_destroy(surface);
-    SAFE_FREE(all_exercises);
-    return NULL;
+// Démarre le thread et le chargement de l'historique ; false si impossible
+static bool stats_worker_start(StatsPanel* panel) {
+    StatsWorker* worker = SAFE_MALLOC(sizeof(StatsWorker));
+    if (!worker) return false;
+    memset(worker, 0, sizeof(*worker));
+
+    worker->width = panel->panel_width;
+    worker->height = panel->panel_height;
+    worker->load_pending = true;
+    worker->lock = SDL_CreateMutex();
+    worker->wake = SDL_CreateCond();
+    worker->idle = SDL_CreateCond();
+    if (!worker->lock || !worker->wake || !worker->idle) goto fail;
+
+    panel->worker = worker;
+    worker->thread = SDL_CreateThread(stats_worker_thread, "stats_worker", panel);
+    if (!worker->thread) {
+        debug_printf("⚠️ STATS: thread non créé (%s), chargement synchrone\n", SDL_GetError());
+        panel->worker = NULL;
+        goto fail;
+    }
+    return true;
 
-cleanup:
-    error_print(&err);
-    if (all_exercises) SAFE_FREE(all_exercises);
-    if (cr) cairo_destroy(cr);
-    if (surface) cairo_surface_destroy(surface);
-    return NULL;
+fail:
+    if (worker->lock) SDL_DestroyMutex(worker->lock);
+    if (worker->wake) SDL_DestroyCond(worker->wake);
+    if (worker->idle) SDL_DestroyCond(worker->idle);
+    SAFE_FREE(worker);
+    return false;
+}
+
+// Libère une page (verrou tenu)
+static void graph_page_release(GraphPage* page) {
+    if (page->surface) SDL_FreeSurface(page->surface);
+    if (page->texture) SDL_DestroyTexture(page->texture);
+    memset(page, 0, sizeof(*page));
+}
+
+// Annule les pages demandées et attend la fin de la tâche en cours : le
+// thread ne lit plus l'historique ensuite, jusqu'à la prochaine demande
+static void stats_worker_quiesce(StatsPanel* panel) {
+    StatsWorker* worker = panel->worker;
+    if (!worker) return;
+
+    SDL_LockMutex(worker->lock);
+    for (int i = 0; i < GRAPH_CACHE_PAGES; i++) worker->pages[i].wanted = false;
+    while (worker->busy) SDL_CondWait(worker->idle, worker->lock);
+    SDL_UnlockMutex(worker->lock);
+}
+
+// Oublie toutes les pages (données changées)
+static void stats_worker_drop_pages(StatsPanel* panel) {
+    StatsWorker* worker = panel->worker;
+    if (!worker) return;
+
+    stats_worker_quiesce(panel);
+    SDL_LockMutex(worker->lock);
+    for (int i = 0; i < GRAPH_CACHE_PAGES; i++) graph_page_release(&worker->pages[i]);
+    SDL_UnlockMutex(worker->lock);
+}
+
+static void stats_worker_stop(StatsPanel* panel) {
+    StatsWorker* worker = panel->worker;
+    if (!worker) return;
+
+    SDL_LockMutex(worker->lock);
+    worker->quit = true;
+    SDL_CondSignal(worker->wake);
+    SDL_UnlockMutex(worker->lock);
+    SDL_WaitThread(worker->thread, NULL);
+
+    for (int i = 0; i < GRAPH_CACHE_PAGES; i++) graph_page_release(&worker->pages[i]);
+    if (worker->load_ready) free_exercise_history(&worker->loaded);
+
+    SDL_DestroyMutex(worker->lock);
+    SDL_DestroyCond(worker->wake);
+    SDL_DestroyCond(worker->idle);
+    SAFE_FREE(panel->worker);
+}
+
+// Reprend l'historique chargé et convertit en textures les pages terminées
+static void stats_worker_poll(StatsPanel* panel, SDL_Renderer* renderer) {
+    StatsWorker* worker = panel->worker;
+
+    SDL_LockMutex(worker->lock);
+    if (worker->load_ready) {
+        free_exercise_history(&panel->history);
+        panel->history = worker->loaded;
+        panel->rollup = worker->loaded_rollup;
+        memset(&worker->loaded, 0, sizeof(worker->loaded));
+        worker->load_ready = false;
+        panel->history_loading = false;
+        panel->needs_redraw = true;
+        debug_printf("📊 Historique reçu du thread (%d exercices)\n", panel->history.count);
+    }
+
+    for (int i = 0; i < GRAPH_CACHE_PAGES; i++) {
+        GraphPage* page = &worker->pages[i];
+        if (!page->surface) continue;
+
+        page->texture = SDL_CreateTextureFromSurface(renderer, page->surface);
+        SDL_FreeSurface(page->surface);
+        page->surface = NULL;
+    }
+    SDL_UnlockMutex(worker->lock);
+}
+
+// Demande une page si elle n'est ni prête ni en cours (verrou tenu)
+static void stats_worker_want(StatsWorker* worker, StatsGraphKey key, int priority,
+                              const StatsGraphKey* keep, int keep_count) {
+    GraphPage* free_page = NULL;
+    for (int i = 0; i < GRAPH_CACHE_PAGES; i++) {
+        GraphPage* page = &worker->pages[i];
+        if (page->used && graph_key_equal(page->key, key)) {
+            page->priority = priority;
+            if (!page->texture && !page->surface && !page->in_progress) page->wanted = true;
+            return;
+        }
+        if (!free_page && !page->used) free_page = page;
+    }
+
+    // Pas de case libre : récupérer une page qui n'est plus utile
+    for (int i = 0; !free_page && i < GRAPH_CACHE_PAGES; i++) {
+        GraphPage* page = &worker->pages[i];
+        bool kept = page->in_progress;
+        for (int k = 0; k < keep_count && !kept; k++) kept = graph_key_equal(page->key, keep[k]);
+        if (!kept) free_page = page;
+    }
+    if (!free_page) return;
+
+    graph_page_release(free_page);
+    free_page->used = true;
+    free_page->key = key;
+    free_page->priority = priority;
+    free_page->wanted = true;
+}
+
+// Texture de la page affichée ; demande aussi les pages voisines. Si la page
+// n'est pas prête, une autre page des mêmes données (souvent la précédente)
+// est rendue en attendant, sinon NULL
+static SDL_Texture* stats_worker_page(StatsPanel* panel) {
+    StatsWorker* worker = panel->worker;
+    int total_exercises = graph_total_exercises(panel);
+    int max_offset = total_exercises > GRAPH_EXERCISES ? total_exercises - GRAPH_EXERCISES : 0;
+    bool timeline = panel->view == STATS_VIEW_TIMELINE;
+
+    StatsGraphKey keys[3];
+    int key_count = 0;
+    keys[key_count++] = current_graph_key(panel, 0);
+    if (timeline || panel->scroll_offset > 0) {
+        keys[key_count++] = current_graph_key(panel, -1);
+    }
+    if (timeline || panel->scroll_offset < max_offset) {
+        keys[key_count++] = current_graph_key(panel, 1);
+    }
+
+    SDL_Texture* shown = NULL;
+    SDL_Texture* fallback = NULL;
+
+    SDL_LockMutex(worker->lock);
+    for (int k = 0; k < key_count; k++) {
+        stats_worker_want(worker, keys[k], k == 0 ? 0 : 1, keys, key_count);
+    }
+    for (int i = 0; i < GRAPH_CACHE_PAGES; i++) {
+        GraphPage* page = &worker->pages[i];
+        if (!page->used || !page->texture) continue;
+        if (graph_key_equal(page->key, keys[0])) shown = page->texture;
+        else if (page->key.version == panel->graph_version && page->key.view == panel->view) {
+            fallback = page->texture;
+        }
+    }
+    SDL_CondSignal(worker->wake);
+    SDL_UnlockMutex(worker->lock);
+
+    return shown ? shown : fallback;
+}
+
+// Graphique d'attente (historique en cours de chargement)
+static void render_graph_placeholder(SDL_Renderer* renderer, const StatsPanel* panel) {
+    SDL_Rect dest = {panel->current_x, panel->y, panel->panel_width, panel->panel_height};
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderFillRect(renderer, &dest);
+
+    // Cadre du graphique
+    SDL_Rect frame = {panel->current_x + GRAPH_MARGIN, GRAPH_MARGIN + 20,
+                      panel->panel_width - 2 * GRAPH_MARGIN,
+                      panel->panel_height - 2 * GRAPH_MARGIN - 100};
+    SDL_SetRenderDrawColor(renderer, 210, 210, 210, 255);
+    SDL_RenderDrawRect(renderer, &frame);
+
+    TTF_Font* font = get_font_for_size(14);
+    if (!font) return;
+
+    SDL_Surface* text = TTF_RenderUTF8_Blended(font, "Chargement de l'historique…",
+                                               (SDL_Color){120, 120, 120, 255});
+    if (!text) return;
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, text);
+    if (texture) {
+        SDL_Rect text_rect = {frame.x + (frame.w - text->w) / 2, frame.y + (frame.h - text->h) / 2,
+                              text->w, text->h};
+        SDL_RenderCopy(renderer, texture, NULL, &text_rect);
+        SDL_DestroyTexture(texture);
+    }
+    SDL_FreeSurface(text);
 }
 
 // CRÉATION ET DESTRUCTION
@@ -570,17 +1016,30 @@ StatsPanel* create_stats_panel(int screen_width, int screen_height,
     CHECK_ALLOC(panel->current_session_times, &err, "Échec allocation current_session_times");
     memcpy(panel->current_session_times, session_times, session_count * sizeof(float));
 
-    // Charger l'historique
-    load_exercise_history(&panel->history);
+    // Historique et cumuls : chargés par le thread pendant l'ouverture,
+    // sinon tout de suite
+    memset(&panel->history, 0, sizeof(panel->history));
+    stats_rollup_reset(&panel->rollup);
+    panel->worker = NULL;
+    panel->history_loading = stats_worker_start(panel);
+    if (!panel->history_loading) {
+        load_exercise_history(&panel->history);
+        stats_store_load_rollup(&panel->rollup);
+    }
 
     // Initialiser textures
     panel->graph_texture = NULL;
+    memset(&panel->graph_key, 0, sizeof(panel->graph_key));
+    panel->graph_version = 0;
     panel->needs_redraw = true;
 
     // Interaction et navigation
     panel->scroll_offset = 0;
     panel->selected_exercise_index = -1; // -1 = dernier exercice par défaut
     panel->is_already_saved = false;
+    panel->view = STATS_VIEW_EXERCISES;
+    panel->timeline_start = 0;      // Cadrée au premier affichage
+    panel->timeline_end = 0;
 
     // Boutons (en bas du panneau)
     int button_width = (panel->panel_width - 4 * BUTTON_MARGIN) / 3;
@@ -590,12 +1049,22 @@ StatsPanel* create_stats_panel(int screen_width, int screen_height,
     panel->cancel_button = (SDL_Rect){BUTTON_MARGIN * 2 + button_width, button_y, button_width, BUTTON_HEIGHT};
     panel->reset_button = (SDL_Rect){BUTTON_MARGIN * 3 + button_width * 2, button_y, button_width, BUTTON_HEIGHT};
 
+    // Rangée du haut : export/import à gauche, bascule de vue à droite du titre
+    panel->export_button = (SDL_Rect){BUTTON_MARGIN, BUTTON_MARGIN, 80, 24};
+    panel->import_button = (SDL_Rect){BUTTON_MARGIN * 2 + 80, BUTTON_MARGIN, 80, 24};
+    panel->view_button = (SDL_Rect){panel->panel_width - BUTTON_MARGIN - 100, BUTTON_MARGIN, 100, 24};
+    panel->exchange_message[0] = '\0';
+
     panel->save_hovered = false;
     panel->cancel_hovered = false;
     panel->reset_hovered = false;
+    panel->view_hovered = false;
+    panel->export_hovered = false;
+    panel->import_hovered = false;
 
-    debug_printf("✅ Panneau stats créé (%dx%d, %d exercices dans l'historique)\n",
-                 panel->panel_width, panel->panel_height, panel->history.count);
+    debug_printf("✅ Panneau stats créé (%dx%d, historique %s)\n",
+                 panel->panel_width, panel->panel_height,
+                 panel->history_loading ? "en cours de chargement" : "chargé");
 
     return panel;
 
@@ -611,6 +1080,9 @@ cleanup:
 void destroy_stats_panel(StatsPanel* panel) {
     if (!panel) return;
 
+    // Arrêter le thread avant de libérer ce qu'il lit
+    stats_worker_stop(panel);
+
     if (panel->current_session_times) {
         SAFE_FREE(panel->current_session_times);
     }
@@ -620,14 +1092,7 @@ void destroy_stats_panel(StatsPanel* panel) {
     }
 
     // Libérer l'historique
-    for (int i = 0; i < panel->history.count; i++) {
-        if (panel->history.entries[i].session_times) {
-            SAFE_FREE(panel->history.entries[i].session_times);
-        }
-    }
-    if (panel->history.entries) {
-        SAFE_FREE(panel->history.entries);
-    }
+    free_exercise_history(&panel->history);
 
     SAFE_FREE(panel);
     debug_printf("🗑️ Panneau stats détruit\n");
@@ -672,23 +1137,82 @@ void update_stats_panel(StatsPanel* panel, float delta_time) {
 
 // RENDU
 
+// Petit bouton de la rangée du haut (bleu foncé ou bleu clair si survolé)
+static void render_top_button(SDL_Renderer* renderer, const StatsPanel* panel,
+                              SDL_Rect button, bool hovered, const char* label) {
+    SDL_Rect rect = {panel->current_x + button.x, button.y, button.w, button.h};
+    SDL_Color color = hovered ? (SDL_Color){90, 130, 210, 255} : (SDL_Color){50, 90, 170, 255};
+    roundedBoxRGBA(renderer, rect.x, rect.y, rect.x + rect.w, rect.y + rect.h,
+                   6, color.r, color.g, color.b, color.a);
+
+    TTF_Font* font = get_font_for_size(14);
+    if (!font) return;
+
+    SDL_Surface* surface = TTF_RenderUTF8_Blended(font, label, (SDL_Color){255, 255, 255, 255});
+    if (!surface) return;
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (texture) {
+        SDL_Rect text_rect = {
+            rect.x + (rect.w - surface->w) / 2,
+            rect.y + (rect.h - surface->h) / 2,
+            surface->w,
+            surface->h
+        };
+        SDL_RenderCopy(renderer, texture, NULL, &text_rect);
+        SDL_DestroyTexture(texture);
+    }
+    SDL_FreeSurface(surface);
+}
+
 void render_stats_panel(SDL_Renderer* renderer, StatsPanel* panel) {
     if (!panel || panel->state == STATS_CLOSED) return;
 
-    // Recréer le graphique si nécessaire
-    if (panel->needs_redraw || !panel->graph_texture) {
-        if (panel->graph_texture) {
-            SDL_DestroyTexture(panel->graph_texture);
+    SDL_Rect dest = {panel->current_x, panel->y, panel->panel_width, panel->panel_height};
+    SDL_Texture* graph = NULL;
+
+    if (panel->worker) {
+        stats_worker_poll(panel, renderer);
+
+        // Données changées : les pages existantes sont périmées
+        if (panel->needs_redraw) {
+            stats_worker_drop_pages(panel);
+            panel->graph_version++;
+            panel->needs_redraw = false;
+        }
+
+        if (!panel->history_loading) {
+            clamp_graph_scroll(panel);
+            if (panel->view == STATS_VIEW_TIMELINE) clamp_timeline(panel);
+            graph = stats_worker_page(panel);
         }
-        panel->graph_texture = create_graph_texture(renderer, panel,
-                                                    panel->panel_width, panel->panel_height);
-        panel->needs_redraw = false;
+    } else {
+        // Sans thread : rastériser ici quand la page change
+        clamp_graph_scroll(panel);
+        if (panel->view == STATS_VIEW_TIMELINE) clamp_timeline(panel);
+        StatsGraphKey key = current_graph_key(panel, 0);
+        if (panel->needs_redraw || !panel->graph_texture ||
+            !graph_key_equal(key, panel->graph_key)) {
+            if (panel->graph_texture) {
+                SDL_DestroyTexture(panel->graph_texture);
+                panel->graph_texture = NULL;
+            }
+            SDL_Surface* surface = rasterize_graph(panel, key, panel->panel_width, panel->panel_height);
+            if (surface) {
+                panel->graph_texture = SDL_CreateTextureFromSurface(renderer, surface);
+                SDL_FreeSurface(surface);
+            }
+            panel->graph_key = key;
+            panel->needs_redraw = false;
+        }
+        graph = panel->graph_texture;
     }
 
-    // Dessiner le graphique
-    if (panel->graph_texture) {
-        SDL_Rect dest = {panel->current_x, panel->y, panel->panel_width, panel->panel_height};
-        SDL_RenderCopy(renderer, panel->graph_texture, NULL, &dest);
+    // Dessiner le graphique (ou l'attente s'il n'est pas encore prêt)
+    if (graph) {
+        SDL_RenderCopy(renderer, graph, NULL, &dest);
+    } else {
+        render_graph_placeholder(renderer, panel);
     }
 
     // Dessiner les boutons (rounded rectangles)
@@ -771,6 +1295,35 @@ void render_stats_panel(SDL_Renderer* renderer, StatsPanel* panel) {
         }
     }
 
+    // ═══ BOUTONS DU HAUT (export, import, vue) ═══
+    render_top_button(renderer, panel, panel->export_button, panel->export_hovered, "Exporter");
+    render_top_button(renderer, panel, panel->import_button, panel->import_hovered, "Importer");
+    // La bascule affiche la vue vers laquelle basculer
+    render_top_button(renderer, panel, panel->view_button, panel->view_hovered,
+                      panel->view == STATS_VIEW_TIMELINE ? "Exercices" : "Chronologie");
+
+    // Résultat du dernier export/import
+    if (panel->exchange_message[0]) {
+        TTF_Font* message_font = get_font_for_size(12);
+        SDL_Surface* message_surface = message_font
+            ? TTF_RenderUTF8_Blended(message_font, panel->exchange_message, (SDL_Color){60, 60, 60, 255})
+            : NULL;
+        if (message_surface) {
+            SDL_Texture* message_texture = SDL_CreateTextureFromSurface(renderer, message_surface);
+            if (message_texture) {
+                SDL_Rect text_rect = {
+                    panel->current_x + panel->export_button.x,
+                    panel->export_button.y + panel->export_button.h + 4,
+                    message_surface->w,
+                    message_surface->h
+                };
+                SDL_RenderCopy(renderer, message_texture, NULL, &text_rect);
+                SDL_DestroyTexture(message_texture);
+            }
+            SDL_FreeSurface(message_surface);
+        }
+    }
+
     // ═══ INFOBULLE SI EXERCICE DÉJÀ SAUVEGARDÉ ═══
     if (panel->is_already_saved) {
         const char* message = "⚠️ Exercice déjà enregistré";
@@ -810,19 +1363,82 @@ void render_stats_panel(SDL_Renderer* renderer, StatsPanel* panel) {
 
 // GESTION DES ÉVÉNEMENTS
 
+static void export_stats_from_panel(StatsPanel* panel) {
+    int exported = stats_export(CONFIG_STATS_EXCHANGE, STATS_FORMAT_CSV);
+    if (exported < 0) {
+        snprintf(panel->exchange_message, sizeof(panel->exchange_message), "Export échoué");
+    } else {
+        snprintf(panel->exchange_message, sizeof(panel->exchange_message),
+                 "%d exercice(s) exporté(s) dans stats/exercises.csv", exported);
+    }
+}
+
+// Recharge l'historique et les cumuls : par le thread, le graphique d'attente
+// étant affiché pendant ce temps ; sans thread, tout de suite
+static void reload_stats_history(StatsPanel* panel) {
+    StatsWorker* worker = panel->worker;
+    if (!worker) {
+        free_exercise_history(&panel->history);
+        load_exercise_history(&panel->history);
+        stats_store_load_rollup(&panel->rollup);
+        panel->needs_redraw = true;
+        return;
+    }
+
+    stats_worker_quiesce(panel);
+    SDL_LockMutex(worker->lock);
+    worker->load_pending = true;
+    SDL_CondSignal(worker->wake);
+    SDL_UnlockMutex(worker->lock);
+    panel->history_loading = true;
+}
+
+// Importe CONFIG_STATS_EXCHANGE puis recharge l'historique (exercices à
+// n'importe quelle date, en nombre quelconque)
+static void import_stats_into_panel(StatsPanel* panel) {
+    StatsImportResult result;
+    stats_worker_quiesce(panel);
+    bool ok = stats_import(CONFIG_STATS_EXCHANGE, &result);
+
+    if (!ok && result.imported == 0) {
+        snprintf(panel->exchange_message, sizeof(panel->exchange_message),
+                 "Import impossible (stats/exercises.csv)");
+        return;
+    }
+    snprintf(panel->exchange_message, sizeof(panel->exchange_message),
+             "Import : %d ajouté(s), %d doublon(s), %d rejeté(s)",
+             result.imported, result.duplicates, result.invalid);
+
+    if (result.imported > 0) {
+        panel->timeline_start = panel->timeline_end = 0;  // Recadrer
+        reload_stats_history(panel);
+    }
+}
+
 void handle_stats_panel_event(StatsPanel* panel, SDL_Event* event) {
     if (!panel || panel->state != STATS_OPEN) return;
 
     // Gestion du scroll (molette souris)
     if (event->type == SDL_MOUSEWHEEL) {
-        if (event->wheel.y > 0) {
-            // Scroll vers le haut = voir les exercices plus anciens
-            panel->scroll_offset--;
-        } else if (event->wheel.y < 0) {
-            // Scroll vers le bas = voir les exercices plus récents
-            panel->scroll_offset++;
+        // Chronologie : molette = zoom sous la souris, Maj+molette ou molette
+        // horizontale = défilement (vers le haut = plus ancien)
+        if (panel->view == STATS_VIEW_TIMELINE) {
+            if (SDL_GetModState() & KMOD_SHIFT) {
+                timeline_pan(panel, -event->wheel.y);
+            } else if (event->wheel.y != 0) {
+                int mouse_x;
+                SDL_GetMouseState(&mouse_x, NULL);
+                timeline_zoom(panel, event->wheel.y, mouse_x);
+            }
+            if (event->wheel.x != 0) timeline_pan(panel, event->wheel.x);
+            return;
         }
-        panel->needs_redraw = true;
+
+        // Un exercice par cran (les crans regroupés arrivent additionnés)
+        // Vers le haut = exercices plus anciens, vers le bas = plus récents
+        // Pages voisines déjà rastérisées : rien à redessiner
+        panel->scroll_offset -= event->wheel.y;
+        clamp_graph_scroll(panel);
         return;
     }
 
@@ -837,6 +1453,12 @@ void handle_stats_panel_event(StatsPanel* panel, SDL_Event* event) {
                                 panel->cancel_button.w, panel->cancel_button.h};
         SDL_Rect reset_zone = {panel->current_x + panel->reset_button.x, panel->reset_button.y,
                                panel->reset_button.w, panel->reset_button.h};
+        SDL_Rect view_zone = {panel->current_x + panel->view_button.x, panel->view_button.y,
+                              panel->view_button.w, panel->view_button.h};
+        SDL_Rect export_zone = {panel->current_x + panel->export_button.x, panel->export_button.y,
+                                panel->export_button.w, panel->export_button.h};
+        SDL_Rect import_zone = {panel->current_x + panel->import_button.x, panel->import_button.y,
+                                panel->import_button.w, panel->import_button.h};
 
         panel->save_hovered = (mx >= save_zone.x && mx < save_zone.x + save_zone.w &&
                                my >= save_zone.y && my < save_zone.y + save_zone.h);
@@ -844,11 +1466,34 @@ void handle_stats_panel_event(StatsPanel* panel, SDL_Event* event) {
                                  my >= cancel_zone.y && my < cancel_zone.y + cancel_zone.h);
         panel->reset_hovered = (mx >= reset_zone.x && mx < reset_zone.x + reset_zone.w &&
                                 my >= reset_zone.y && my < reset_zone.y + reset_zone.h);
+        panel->view_hovered = (mx >= view_zone.x && mx < view_zone.x + view_zone.w &&
+                               my >= view_zone.y && my < view_zone.y + view_zone.h);
+        panel->export_hovered = (mx >= export_zone.x && mx < export_zone.x + export_zone.w &&
+                                 my >= export_zone.y && my < export_zone.y + export_zone.h);
+        panel->import_hovered = (mx >= import_zone.x && mx < import_zone.x + import_zone.w &&
+                                 my >= import_zone.y && my < import_zone.y + import_zone.h);
     }
     else if (event->type == SDL_MOUSEBUTTONDOWN && event->button.button == SDL_BUTTON_LEFT) {
         int mx = event->button.x;
         int my = event->button.y;
 
+        // Basculer entre les exercices et la chronologie
+        if (panel->view_hovered) {
+            panel->view = panel->view == STATS_VIEW_TIMELINE ? STATS_VIEW_EXERCISES : STATS_VIEW_TIMELINE;
+            debug_printf("📊 Vue %s\n", panel->view == STATS_VIEW_TIMELINE ? "chronologie" : "exercices");
+            return;
+        }
+
+        // Export / import (CONFIG_STATS_EXCHANGE), après le chargement de
+        // l'historique : le journal ne bouge plus sous le thread
+        if (panel->export_hovered || panel->import_hovered) {
+            if (!panel->history_loading) {
+                if (panel->export_hovered) export_stats_from_panel(panel);
+                else import_stats_into_panel(panel);
+            }
+            return;
+        }
+
         // Calculer la zone du graphique
         int graph_x = panel->current_x + GRAPH_MARGIN;
         int graph_y = GRAPH_MARGIN + 20;
@@ -856,18 +1501,13 @@ void handle_stats_panel_event(StatsPanel* panel, SDL_Event* event) {
         int graph_height = panel->panel_height - 2 * GRAPH_MARGIN - 100;
 
         // Vérifier si le clic est dans la zone du graphique
-        if (mx >= graph_x && mx < graph_x + graph_width &&
+        if (panel->view == STATS_VIEW_EXERCISES &&
+            mx >= graph_x && mx < graph_x + graph_width &&
             my >= graph_y && my < graph_y + graph_height) {
 
-            // Calculer le nombre total d'exercices
-            int total_exercises = panel->history.count;
-            if (panel->current_session_count > 0 && panel->current_session_times) {
-                total_exercises++;
-            }
-
             // Calculer le nombre d'exercices affichés
-            int max_offset = total_exercises > GRAPH_EXERCISES ? total_exercises - GRAPH_EXERCISES : 0;
-            if (panel->scroll_offset > max_offset) panel->scroll_offset = max_offset;
+            int total_exercises = graph_total_exercises(panel);
+            clamp_graph_scroll(panel);
             int start_index = panel->scroll_offset;
             int exercise_count = (total_exercises - start_index) > GRAPH_EXERCISES ? GRAPH_EXERCISES : (total_exercises - start_index);
 
@@ -875,9 +1515,9 @@ void handle_stats_panel_event(StatsPanel* panel, SDL_Event* event) {
             double exercise_width = (double)graph_width / (double)exercise_count;
             int clicked_exercise = (int)((mx - graph_x) / exercise_width);
 
+            // La sélection fait partie de la clé de page : pas d'invalidation
             if (clicked_exercise >= 0 && clicked_exercise < exercise_count) {
                 panel->selected_exercise_index = clicked_exercise;
-                panel->needs_redraw = true;
                 debug_printf("📊 Exercice sélectionné: %d\n", clicked_exercise);
             }
             return;
@@ -885,18 +1525,13 @@ void handle_stats_panel_event(StatsPanel* panel, SDL_Event* event) {
 
         // Gestion des boutons
         if (panel->save_hovered) {
-            // Sauvegarder
+            // Historique pas encore chargé : le doublon ne peut pas être vérifié
+            if (panel->history_loading) return;
+
+            // Sauvegarder (le thread ne doit plus lire l'historique, que
+            // l'enregistrement complète sur place) et redessiner
+            stats_worker_quiesce(panel);
             if (save_exercise_to_file(panel)) {
-                // Recharger l'historique et redessiner
-                for (int i = 0; i < panel->history.count; i++) {
-                    if (panel->history.entries[i].session_times) {
-                        SAFE_FREE(panel->history.entries[i].session_times);
-                    }
-                }
-                if (panel->history.entries) {
-                    SAFE_FREE(panel->history.entries);
-                }
-                load_exercise_history(&panel->history);
                 panel->needs_redraw = true;
             }
         }
@@ -905,20 +1540,14 @@ void handle_stats_panel_event(StatsPanel* panel, SDL_Event* event) {
             close_stats_panel(panel);
         }
         else if (panel->reset_hovered) {
-            // Réinitialiser l'historique
+            // Réinitialiser l'historique (après son chargement, qui le recréerait)
+            if (panel->history_loading) return;
+            stats_worker_quiesce(panel);
             if (reset_exercise_history()) {
                 // Vider l'historique en mémoire
-                for (int i = 0; i < panel->history.count; i++) {
-                    if (panel->history.entries[i].session_times) {
-                        SAFE_FREE(panel->history.entries[i].session_times);
-                    }
-                }
-                if (panel->history.entries) {
-                    SAFE_FREE(panel->history.entries);
-                }
-                panel->history.entries = NULL;
-                panel->history.count = 0;
-                panel->history.capacity = 0;
+                free_exercise_history(&panel->history);
+                stats_rollup_reset(&panel->rollup);
+                panel->timeline_start = panel->timeline_end = 0;  // Recadrer
                 panel->needs_redraw = true;
             }
         }
@@ -5,23 +5,13 @@
 
 #include <SDL2/SDL.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <time.h>
+#include "stats_rollup.h"
+#include "stats_history.h"
 
 // STRUCTURES DE DONNÉES STATISTIQUES
-
-// Une entrée d'exercice (sauvegardée en binaire)
-typedef struct {
-    time_t timestamp;           // Date et heure de l'exercice
-    int session_count;          // Nombre de sessions dans cet exercice
-    float* session_times;       // Temps de chaque session (en secondes)
-} ExerciseEntry;
-
-// Collection d'exercices (chargée depuis les fichiers)
-typedef struct {
-    ExerciseEntry* entries;     // Tableau d'exercices
-    int count;                  // Nombre d'exercices chargés
-    int capacity;               // Capacité du tableau
-} ExerciseHistory;
+// Historique (entrées, empreintes, chronologie) : stats_history.h
 
 // STRUCTURE DU PANNEAU DE STATISTIQUES
 
@@ -32,6 +22,25 @@ typedef enum {
     STATS_CLOSING
 } StatsPanelState;
 
+// Vue du graphique
+typedef enum {
+    STATS_VIEW_EXERCISES,       // GRAPH_EXERCISES exercices, une barre par session
+    STATS_VIEW_TIMELINE         // Chronologie zoomable de tout l'historique
+} StatsGraphView;
+
+// Page du graphique : vue, scroll (ou fenêtre de dates), sélection et
+// version des données affichées
+typedef struct {
+    StatsGraphView view;
+    int scroll_offset;
+    int selected;
+    int64_t start, end;         // Fenêtre de la chronologie (0 en vue exercices)
+    uint32_t version;
+} StatsGraphKey;
+
+// Thread de chargement/rastérisation (stats_panel.c)
+typedef struct StatsWorker StatsWorker;
+
 typedef struct {
     // État et animation
     StatsPanelState state;
@@ -51,23 +60,41 @@ typedef struct {
 
     // Historique chargé depuis les fichiers
     ExerciseHistory history;
+    StatsRollup rollup;         // Cumuls (lignes de résumé), sans parcourir l'historique
 
     // Textures et rendu
-    SDL_Texture* graph_texture; // Texture du graphique
-    bool needs_redraw;          // Flag pour recalcul du graphique
+    SDL_Texture* graph_texture; // Texture du graphique (mode sans thread)
+    StatsGraphKey graph_key;    // Page de graph_texture
+    bool needs_redraw;          // Données changées : pages du graphique à refaire
+    uint32_t graph_version;     // Incrémentée à chaque changement de données
+
+    // Arrière-plan : historique chargé et graphique rastérisé hors du thread
+    // principal (NULL si le thread n'a pas pu être créé : tout en synchrone)
+    StatsWorker* worker;
+    bool history_loading;       // Historique pas encore reçu du thread
 
     // Interaction et navigation
     int scroll_offset;          // Offset de scroll (pour historique long)
     int selected_exercise_index; // Index de l'exercice sélectionné (-1 = dernier)
+    StatsGraphView view;
+    int64_t timeline_start;     // Fenêtre de la chronologie (secondes, 0 = à cadrer)
+    int64_t timeline_end;
     bool is_already_saved;      // L'exercice actuel est déjà sauvegardé
 
     // Boutons
     SDL_Rect save_button;
     SDL_Rect cancel_button;
     SDL_Rect reset_button;
+    SDL_Rect view_button;       // Bascule exercices / chronologie (en haut à droite)
+    SDL_Rect export_button;     // Export / import CSV (en haut à gauche)
+    SDL_Rect import_button;
     bool save_hovered;
     bool cancel_hovered;
     bool reset_hovered;
+    bool view_hovered;
+    bool export_hovered;
+    bool import_hovered;
+    char exchange_message[96];  // Résultat du dernier export/import ("" = aucun)
 
 } StatsPanel;
 
@@ -118,21 +145,15 @@ void render_stats_panel(SDL_Renderer* renderer, StatsPanel* panel);
 void handle_stats_panel_event(StatsPanel* panel, SDL_Event* event);
 
 /**
- * Sauvegarder l'exercice actuel dans un fichier binaire
+ * Sauvegarder l'exercice actuel (ajout à la fin du journal des stats, puis à
+ * l'historique et aux cumuls en mémoire, sans rechargement)
  * @param panel Panneau contenant les données
  * @return true si succès
  */
 bool save_exercise_to_file(StatsPanel* panel);
 
 /**
- * Charger l'historique depuis les fichiers binaires
- * @param history Structure à remplir
- * @return Nombre d'exercices chargés
- */
-int load_exercise_history(ExerciseHistory* history);
-
-/**
- * Réinitialiser l'historique (supprimer tous les fichiers)
+ * Réinitialiser l'historique (supprimer journal, index et anciens fichiers)
  * @return true si succès
  */
 bool reset_exercise_history(void);
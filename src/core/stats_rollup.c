@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// stats_rollup.c
+#include "stats_rollup.h"
+#include "debug.h"
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FORMAT DU FICHIER
+// ═══════════════════════════════════════════════════════════════════════════
+// [RollupFileHeader][StatsRollup]
+// La taille de la structure est dans l'en-tête : un binaire recompilé avec
+// d'autres tailles de tables repart de zéro (cumuls recalculés depuis le journal).
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define ROLLUP_MAGIC 0x52545357u        // "WSTR"
+#define ROLLUP_VERSION 2u
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t rollup_size;
+    uint32_t records;               // Enregistrements du journal couverts
+    uint64_t log_end;               // Octets du journal couverts
+} RollupFileHeader;
+
+void stats_rollup_reset(StatsRollup* rollup) {
+    memset(rollup, 0, sizeof(*rollup));
+    for (int i = 0; i < ROLLUP_DAYS; i++) rollup->days[i].key = -1;
+    for (int i = 0; i < ROLLUP_WEEKS; i++) rollup->weeks[i].key = -1;
+    rollup->last_day = -1;
+}
+
+// Jours depuis 1970-01-01 d'une date civile (algorithme de H. Hinnant)
+static int32_t days_from_civil(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yoe = year - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+int32_t stats_rollup_day(time_t timestamp) {
+    struct tm tm_local;
+    if (!localtime_r(&timestamp, &tm_local)) return 0;
+    return days_from_civil(tm_local.tm_year + 1900, tm_local.tm_mon + 1, tm_local.tm_mday);
+}
+
+int32_t stats_rollup_week(int32_t day) {
+    // Le 1970-01-01 était un jeudi : +3 pour démarrer les semaines le lundi
+    int32_t shifted = day + 3;
+    return shifted >= 0 ? shifted / 7 : (shifted - 6) / 7;
+}
+
+// Case d'une table circulaire pour une clé de la fenêtre (newest - size, newest].
+// Dans la fenêtre chaque case n'a qu'une clé possible : une autre clé dans la
+// case est sortie de la fenêtre et on la remplace. NULL si la clé est trop ancienne
+static RollupBucket* bucket_for(RollupBucket* table, int size, int32_t key, int32_t newest) {
+    if (key <= newest - size) return NULL;
+
+    int slot = (int)(((key % size) + size) % size);
+    RollupBucket* bucket = &table[slot];
+
+    if (bucket->key != key) {
+        bucket->key = key;
+        bucket->exercises = 0;
+        bucket->seconds = 0.0f;
+    }
+    return bucket;
+}
+
+static uint32_t bucket_exercises(const RollupBucket* table, int size, int32_t key, int32_t newest) {
+    if (key > newest || key <= newest - size) return 0;
+    int slot = (int)(((key % size) + size) % size);
+    return table[slot].key == key ? table[slot].exercises : 0;
+}
+
+static uint32_t run_length(const RollupRun* run) {
+    return (uint32_t)(run->last - run->first + 1);
+}
+
+// Ajoute un jour actif aux plages (fusion avec les voisines), puis met à jour
+// la série en cours et le record
+static void add_active_day(StatsRollup* rollup, int32_t day) {
+    RollupRun* runs = rollup->runs;
+    int count = (int)rollup->run_count;
+
+    // Première plage qui commence après day
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (runs[mid].first <= day) lo = mid + 1; else hi = mid;
+    }
+    int next = lo;
+    RollupRun* prev = next > 0 ? &runs[next - 1] : NULL;
+
+    if (prev && day <= prev->last) return;     // Jour déjà actif
+
+    bool joins_prev = prev && prev->last == day - 1;
+    bool joins_next = next < count && runs[next].first == day + 1;
+    RollupRun* changed;
+
+    if (joins_prev && joins_next) {
+        prev->last = runs[next].last;
+        memmove(&runs[next], &runs[next + 1], (size_t)(count - next - 1) * sizeof(RollupRun));
+        count--;
+        changed = prev;
+    } else if (joins_prev) {
+        prev->last = day;
+        changed = prev;
+    } else if (joins_next) {
+        runs[next].first = day;
+        changed = &runs[next];
+    } else {
+        if (count == ROLLUP_RUNS) {
+            // Table pleine : la plus ancienne plage (ou ce jour, s'il est plus
+            // ancien que toutes) n'est plus suivie ; best_streak la compte déjà
+            if (next == 0) {
+                if (rollup->best_streak < 1) rollup->best_streak = 1;
+                return;
+            }
+            memmove(&runs[0], &runs[1], (size_t)(count - 1) * sizeof(RollupRun));
+            count--;
+            next--;
+        }
+        memmove(&runs[next + 1], &runs[next], (size_t)(count - next) * sizeof(RollupRun));
+        runs[next].first = day;
+        runs[next].last = day;
+        count++;
+        changed = &runs[next];
+    }
+    rollup->run_count = (uint32_t)count;
+
+    // Série en cours : la plage la plus récente. Les plages ne font que
+    // grandir : le record ne peut venir que de celle qui a changé
+    rollup->last_day = runs[count - 1].last;
+    rollup->streak = run_length(&runs[count - 1]);
+    if (run_length(changed) > rollup->best_streak) rollup->best_streak = run_length(changed);
+}
+
+void stats_rollup_add(StatsRollup* rollup, time_t timestamp,
+                      const float* session_times, int session_count) {
+    if (!rollup || !session_times || session_count <= 0) return;
+
+    float total = 0.0f;
+    for (int i = 0; i < session_count; i++) {
+        float time = session_times[i] > 0.0f ? session_times[i] : 0.0f;
+        total += time;
+
+        if (time > rollup->best_session) {
+            rollup->best_session = time;
+            rollup->best_session_at = (int64_t)timestamp;
+        }
+
+        if (i < ROLLUP_SESSIONS) {
+            RollupSession* rank = &rollup->by_rank[i];
+            int bin = (int)(time / ROLLUP_HIST_STEP);
+            if (bin >= ROLLUP_HIST_BINS) bin = ROLLUP_HIST_BINS - 1;
+
+            rank->count++;
+            rank->sum += time;
+            if (time > rank->max) rank->max = time;
+            rank->histogram[bin]++;
+        }
+    }
+
+    rollup->exercises++;
+    rollup->sessions += (uint32_t)session_count;
+    if (total > rollup->best_total) {
+        rollup->best_total = total;
+        rollup->best_total_at = (int64_t)timestamp;
+    }
+
+    // Séries (avant les tables : last_day est le plus récent jour actif,
+    // qui fixe leur fenêtre)
+    int32_t day = stats_rollup_day(timestamp);
+    add_active_day(rollup, day);
+
+    // Tables par jour et par semaine
+    RollupBucket* day_bucket = bucket_for(rollup->days, ROLLUP_DAYS, day, rollup->last_day);
+    if (day_bucket) {
+        day_bucket->exercises++;
+        day_bucket->seconds += total;
+    }
+    RollupBucket* week_bucket = bucket_for(rollup->weeks, ROLLUP_WEEKS, stats_rollup_week(day),
+                                           stats_rollup_week(rollup->last_day));
+    if (week_bucket) {
+        week_bucket->exercises++;
+        week_bucket->seconds += total;
+    }
+}
+
+uint32_t stats_rollup_day_exercises(const StatsRollup* rollup, int32_t day) {
+    if (rollup->last_day < 0) return 0;
+    return bucket_exercises(rollup->days, ROLLUP_DAYS, day, rollup->last_day);
+}
+
+uint32_t stats_rollup_week_exercises(const StatsRollup* rollup, int32_t week) {
+    if (rollup->last_day < 0) return 0;
+    return bucket_exercises(rollup->weeks, ROLLUP_WEEKS, week, stats_rollup_week(rollup->last_day));
+}
+
+float stats_rollup_mean(const StatsRollup* rollup, int rank) {
+    if (rank < 0 || rank >= ROLLUP_SESSIONS || rollup->by_rank[rank].count == 0) return 0.0f;
+    return (float)(rollup->by_rank[rank].sum / rollup->by_rank[rank].count);
+}
+
+float stats_rollup_median(const StatsRollup* rollup, int rank) {
+    if (rank < 0 || rank >= ROLLUP_SESSIONS || rollup->by_rank[rank].count == 0) return 0.0f;
+
+    const RollupSession* session = &rollup->by_rank[rank];
+    uint32_t half = (session->count + 1) / 2;
+    uint32_t seen = 0;
+    for (int bin = 0; bin < ROLLUP_HIST_BINS; bin++) {
+        seen += session->histogram[bin];
+        if (seen >= half) {
+            // Milieu de la tranche, sans dépasser le maximum observé
+            float middle = (bin + 0.5f) * ROLLUP_HIST_STEP;
+            return middle < session->max ? middle : session->max;
+        }
+    }
+    return session->max;
+}
+
+uint32_t stats_rollup_current_streak(const StatsRollup* rollup, int32_t today) {
+    if (rollup->last_day < 0 || today - rollup->last_day > 1) return 0;
+    return rollup->streak;
+}
+
+bool stats_rollup_load(const char* path, StatsRollup* rollup,
+                       uint64_t* log_end, uint32_t* records) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    RollupFileHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              header.magic == ROLLUP_MAGIC &&
+              header.version == ROLLUP_VERSION &&
+              header.rollup_size == sizeof(StatsRollup) &&
+              fread(rollup, sizeof(StatsRollup), 1, file) == 1;
+    fclose(file);
+
+    if (!ok) {
+        debug_printf("🔁 STATS: cumuls %s d'un autre format, recalculés\n", path);
+        return false;
+    }
+
+    *log_end = header.log_end;
+    *records = header.records;
+    return true;
+}
+
+bool stats_rollup_save(const char* path, const StatsRollup* rollup,
+                       uint64_t log_end, uint32_t records) {
+    char tmp_path[512];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    FILE* file = fopen(tmp_path, "wb");
+    if (!file) return false;
+
+    RollupFileHeader header = {
+        .magic = ROLLUP_MAGIC,
+        .version = ROLLUP_VERSION,
+        .rollup_size = sizeof(StatsRollup),
+        .records = records,
+        .log_end = log_end,
+    };
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(rollup, sizeof(StatsRollup), 1, file) == 1;
+    if (fclose(file) != 0) ok = false;
+
+    if (!ok || rename(tmp_path, path) != 0) {
+        debug_printf("⚠️ STATS: écriture des cumuls échouée\n");
+        remove(tmp_path);
+        return false;
+    }
+    return true;
+}
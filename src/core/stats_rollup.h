@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// stats_rollup.h
+// CUMULS DE L'HISTORIQUE (JOUR, SEMAINE, SESSIONS, RECORDS, SÉRIES)
+// Tenus à jour à chaque exercice ajouté au journal et sauvegardés à côté de
+// lui : le panneau stats les lit en une fois, quelle que soit la longueur de
+// l'historique.
+//
+// - Jours et semaines : tables circulaires sur les ROLLUP_DAYS / ROLLUP_WEEKS
+//   derniers jours / semaines (plus récent exercice vu), quel que soit
+//   l'ordre d'arrivée des exercices
+// - Par rang de session : nombre, somme, max et histogramme de tranches de
+//   ROLLUP_HIST_STEP secondes (médiane approchée à une demi-tranche près)
+// - Séries : jours consécutifs avec au moins un exercice, tenus comme une
+//   liste triée de plages de jours actifs (un exercice ancien, importé après
+//   coup, comble ou prolonge une plage). Au-delà de ROLLUP_RUNS plages, les
+//   plus anciennes ne comptent plus que pour le record
+
+#ifndef __STATS_ROLLUP_H__
+#define __STATS_ROLLUP_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#define ROLLUP_DAYS 400             // Jours conservés
+#define ROLLUP_WEEKS 120            // Semaines conservées
+#define ROLLUP_SESSIONS 8           // Rangs de session suivis (les suivants sont ignorés)
+#define ROLLUP_HIST_STEP 5          // Largeur d'une tranche d'histogramme (secondes)
+#define ROLLUP_HIST_BINS 144        // 12 minutes ; la dernière tranche reçoit le reste
+#define ROLLUP_RUNS 512             // Plages de jours actifs conservées
+
+typedef struct {
+    int32_t key;                    // Numéro de jour/semaine (-1 = vide)
+    uint32_t exercises;
+    float seconds;                  // Somme des temps de session
+} RollupBucket;
+
+typedef struct {
+    int32_t first;                  // Premier et dernier jour d'une plage active
+    int32_t last;
+} RollupRun;
+
+typedef struct {
+    uint32_t count;
+    float max;
+    double sum;
+    uint32_t histogram[ROLLUP_HIST_BINS];
+} RollupSession;
+
+typedef struct {
+    uint32_t exercises;
+    uint32_t sessions;
+
+    RollupBucket days[ROLLUP_DAYS];
+    RollupBucket weeks[ROLLUP_WEEKS];
+    RollupSession by_rank[ROLLUP_SESSIONS];
+
+    // Records personnels
+    float best_session;             // Plus long temps d'une session
+    int64_t best_session_at;
+    float best_total;               // Plus long cumul d'un exercice
+    int64_t best_total_at;
+
+    // Séries (en jours)
+    int32_t last_day;               // Dernier jour actif (-1 : aucun exercice)
+    uint32_t streak;                // Série se terminant à last_day
+    uint32_t best_streak;
+    uint32_t run_count;
+    RollupRun runs[ROLLUP_RUNS];    // Plages disjointes, non contiguës, triées
+} StatsRollup;
+
+// Vide les cumuls
+void stats_rollup_reset(StatsRollup* rollup);
+
+// Ajoute un exercice aux cumuls
+void stats_rollup_add(StatsRollup* rollup, time_t timestamp,
+                      const float* session_times, int session_count);
+
+// Numéro de jour local (jours depuis 1970-01-01) et de semaine (lundi)
+int32_t stats_rollup_day(time_t timestamp);
+int32_t stats_rollup_week(int32_t day);
+
+// Exercices d'un jour / d'une semaine (0 si hors de la table)
+uint32_t stats_rollup_day_exercises(const StatsRollup* rollup, int32_t day);
+uint32_t stats_rollup_week_exercises(const StatsRollup* rollup, int32_t week);
+
+// Moyenne et médiane (approchée) d'un rang de session, 0 si aucune donnée
+float stats_rollup_mean(const StatsRollup* rollup, int rank);
+float stats_rollup_median(const StatsRollup* rollup, int rank);
+
+// Série en cours à la date `today` (0 si interrompue)
+uint32_t stats_rollup_current_streak(const StatsRollup* rollup, int32_t today);
+
+// Fichier : cumuls + position du journal qu'ils couvrent (octets, enregistrements)
+bool stats_rollup_load(const char* path, StatsRollup* rollup,
+                       uint64_t* log_end, uint32_t* records);
+bool stats_rollup_save(const char* path, const StatsRollup* rollup,
+                       uint64_t log_end, uint32_t records);
+
+#endif
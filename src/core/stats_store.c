@@ -0,0 +1,901 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// stats_store.c
+#include "stats_store.h"
+#include "debug.h"
+#include "paths.h"
+#include "core/memory/memory.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FORMAT DES FICHIERS
+// ═══════════════════════════════════════════════════════════════════════════
+// Journal : [StatsLogHeader][enregistrement][enregistrement]...
+//   enregistrement = [StatsRecordHeader][float × session_count][bourrage]
+// Index   : [StatsIndexHeader][uint64_t offset × count]
+// Les enregistrements sont alignés sur 8 octets : leurs en-têtes se lisent
+// directement dans la projection mémoire du journal.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define STATS_LOG_MAGIC 0x4C545357u     // "WSTL"
+#define STATS_INDEX_MAGIC 0x49545357u   // "WSTI"
+#define STATS_RECORD_MAGIC 0x43455845u  // "EXEC"
+#define STATS_STORE_VERSION 1u
+#define STATS_RECORD_ALIGN 8
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t reserved;
+} StatsLogHeader;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t session_count;
+    int64_t timestamp;
+    uint32_t crc;               // CRC32 de l'en-tête (crc à 0) puis des temps
+    uint32_t reserved;
+} StatsRecordHeader;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t log_size;          // Taille du journal couverte par l'index
+    uint32_t count;
+    uint32_t reserved;
+} StatsIndexHeader;
+
+// Journal ouvert : projection en mémoire + offsets des enregistrements valides.
+// Ouvert pour un ajout (log_open_tail), les first_loaded premiers
+// enregistrements sont ceux de l'index, ni relus ni vérifiés : offsets ne
+// contient que les suivants
+typedef struct {
+    int fd;
+    const unsigned char* data;  // NULL si aucun enregistrement possible
+    size_t size;
+    uint64_t* offsets;          // Enregistrements first_loaded .. count - 1
+    uint32_t first_loaded;
+    uint32_t count;
+    uint32_t capacity;
+    uint64_t indexed_end;       // Fin couverte par l'index (ouverture pour ajout)
+    uint64_t valid_end;         // Fin du dernier enregistrement valide
+    bool index_stale;           // L'index sur disque ne couvre pas tout le journal
+} StatsLog;
+
+// CRC32 (polynôme IEEE), sans table : quelques centaines de Ko au plus
+static uint32_t crc32_update(uint32_t crc, const void* data, size_t size) {
+    const unsigned char* bytes = data;
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static size_t record_size(uint32_t session_count) {
+    size_t size = sizeof(StatsRecordHeader) + (size_t)session_count * sizeof(float);
+    return (size + STATS_RECORD_ALIGN - 1) & ~(size_t)(STATS_RECORD_ALIGN - 1);
+}
+
+static uint32_t record_crc(const StatsRecordHeader* header, const float* times) {
+    StatsRecordHeader copy = *header;
+    copy.crc = 0;
+    uint32_t crc = crc32_update(0, &copy, sizeof(copy));
+    return crc32_update(crc, times, (size_t)header->session_count * sizeof(float));
+}
+
+// Enregistrement complet et cohérent à cet offset (CRC vérifié si demandé)
+static bool record_valid(const StatsLog* log, uint64_t offset, bool check_crc) {
+    if (offset % STATS_RECORD_ALIGN != 0 || offset + sizeof(StatsRecordHeader) > log->size) {
+        return false;
+    }
+
+    const StatsRecordHeader* header = (const StatsRecordHeader*)(log->data + offset);
+    if (header->magic != STATS_RECORD_MAGIC ||
+        header->session_count == 0 || header->session_count > STATS_MAX_SESSIONS ||
+        offset + record_size(header->session_count) > log->size) {
+        return false;
+    }
+
+    return !check_crc || record_crc(header, (const float*)(header + 1)) == header->crc;
+}
+
+static uint64_t log_offset(const StatsLog* log, uint32_t record) {
+    return log->offsets[record - log->first_loaded];
+}
+
+// Ajoute un offset (×2 ; SAFE_MALLOC + copie, pas de realloc)
+static bool log_push_offset(StatsLog* log, uint64_t offset) {
+    uint32_t loaded = log->count - log->first_loaded;
+    if (loaded == log->capacity) {
+        uint32_t capacity = log->capacity ? log->capacity * 2 : 64;
+        uint64_t* grown = SAFE_MALLOC(capacity * sizeof(uint64_t));
+        if (!grown) return false;
+
+        if (log->offsets) {
+            memcpy(grown, log->offsets, loaded * sizeof(uint64_t));
+            SAFE_FREE(log->offsets);
+        }
+        log->offsets = grown;
+        log->capacity = capacity;
+    }
+    log->offsets[loaded] = offset;
+    log->count++;
+    return true;
+}
+
+// Prochain enregistrement valide à partir de *offset, qui passe derrière lui.
+// Un enregistrement invalide est sauté en cherchant le suivant à l'alignement
+// près (données abîmées au milieu). NULL à la fin du journal
+static const StatsRecordHeader* log_next_record(const StatsLog* log, uint64_t* offset, int* skipped) {
+    while (*offset + sizeof(StatsRecordHeader) <= log->size) {
+        if (!record_valid(log, *offset, true)) {
+            *offset += STATS_RECORD_ALIGN;
+            (*skipped)++;
+            continue;
+        }
+
+        const StatsRecordHeader* header = (const StatsRecordHeader*)(log->data + *offset);
+        *offset += record_size(header->session_count);
+        return header;
+    }
+    return NULL;
+}
+
+// Parcourt le journal depuis `from` et ajoute les offsets trouvés
+static void log_scan(StatsLog* log, uint64_t from) {
+    uint64_t offset = from;
+    int skipped = 0;
+    const StatsRecordHeader* header;
+
+    while ((header = log_next_record(log, &offset, &skipped)) != NULL) {
+        if (!log_push_offset(log, (uint64_t)((const unsigned char*)header - log->data))) break;
+        log->valid_end = offset;
+    }
+
+    if (skipped > 0) {
+        debug_printf("⚠️ STATS: %d bloc(s) illisible(s) ignoré(s) dans le journal\n", skipped);
+    }
+}
+
+// En-tête d'index lu et plausible pour ce journal
+static bool index_read_header(FILE* file, const StatsLog* log, StatsIndexHeader* header) {
+    return fread(header, sizeof(*header), 1, file) == 1 &&
+           header->magic == STATS_INDEX_MAGIC &&
+           header->version == STATS_STORE_VERSION &&
+           header->log_size >= sizeof(StatsLogHeader) &&
+           header->log_size <= log->size &&
+           (uint64_t)header->count * record_size(1) <= header->log_size;
+}
+
+// Reprend les offsets de l'index s'il correspond au journal ; false sinon
+static bool log_read_index(StatsLog* log, uint64_t* covered) {
+    FILE* file = fopen(CONFIG_STATS_INDEX, "rb");
+    if (!file) return false;
+
+    StatsIndexHeader header;
+    bool ok = index_read_header(file, log, &header);
+
+    uint64_t* offsets = NULL;
+    if (ok && header.count > 0) {
+        offsets = SAFE_MALLOC(header.count * sizeof(uint64_t));
+        ok = offsets && fread(offsets, sizeof(uint64_t), header.count, file) == header.count;
+    }
+    fclose(file);
+
+    // Offsets croissants, en-têtes cohérents (les CRC sont vérifiés à la copie)
+    uint64_t end = sizeof(StatsLogHeader);
+    for (uint32_t i = 0; ok && i < header.count; i++) {
+        ok = offsets[i] >= end && record_valid(log, offsets[i], false);
+        if (ok) {
+            const StatsRecordHeader* record = (const StatsRecordHeader*)(log->data + offsets[i]);
+            end = offsets[i] + record_size(record->session_count);
+            ok = end <= header.log_size;
+        }
+    }
+
+    if (!ok) {
+        debug_printf("🔁 STATS: index absent ou périmé, journal reparcouru\n");
+        if (offsets) SAFE_FREE(offsets);
+        return false;
+    }
+
+    log->offsets = offsets;
+    log->count = log->capacity = header.count;
+    log->valid_end = end;
+    *covered = header.log_size;
+    return true;
+}
+
+static void log_close(StatsLog* log) {
+    if (log->data) munmap((void*)log->data, log->size);
+    if (log->fd >= 0) close(log->fd);
+    if (log->offsets) SAFE_FREE(log->offsets);
+    memset(log, 0, sizeof(*log));
+    log->fd = -1;
+}
+
+// Ouvre et projette le journal, sans index. En écriture, le crée (avec son
+// en-tête) s'il n'existe pas. Retourne false si absent (lecture) ou d'un
+// autre format.
+static bool log_map(StatsLog* log, bool writable) {
+    memset(log, 0, sizeof(*log));
+    log->fd = open(CONFIG_STATS_LOG, writable ? (O_RDWR | O_CREAT | O_CLOEXEC)
+                                              : (O_RDONLY | O_CLOEXEC), 0600);
+    if (log->fd < 0) {
+        if (errno != ENOENT) {
+            debug_printf("❌ STATS: ouverture de %s impossible (%s)\n",
+                         CONFIG_STATS_LOG, strerror(errno));
+        }
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(log->fd, &st) != 0) goto fail;
+
+    // Fichier neuf (ou création interrompue avant la fin de l'en-tête)
+    if ((size_t)st.st_size < sizeof(StatsLogHeader)) {
+        if (!writable) goto fail;
+
+        StatsLogHeader header = {
+            .magic = STATS_LOG_MAGIC,
+            .version = STATS_STORE_VERSION,
+            .header_size = sizeof(StatsLogHeader),
+        };
+        if (ftruncate(log->fd, 0) != 0 ||
+            pwrite(log->fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+            fsync(log->fd) != 0) {
+            goto fail;
+        }
+        st.st_size = sizeof(header);
+    }
+
+    log->size = (size_t)st.st_size;
+    void* data = mmap(NULL, log->size, PROT_READ, MAP_SHARED, log->fd, 0);
+    if (data == MAP_FAILED) {
+        debug_printf("❌ STATS: mmap du journal impossible (%s)\n", strerror(errno));
+        goto fail;
+    }
+    log->data = data;
+
+    const StatsLogHeader* header = (const StatsLogHeader*)log->data;
+    if (header->magic != STATS_LOG_MAGIC || header->version != STATS_STORE_VERSION ||
+        header->header_size != sizeof(StatsLogHeader)) {
+        // Ne jamais écrire par-dessus un fichier qu'on ne comprend pas
+        debug_printf("⚠️ STATS: %s d'un autre format, ignoré\n", CONFIG_STATS_LOG);
+        goto fail;
+    }
+    log->valid_end = sizeof(StatsLogHeader);
+    return true;
+
+fail:
+    log_close(log);
+    return false;
+}
+
+// Offsets de tous les enregistrements valides d'un journal projeté (index,
+// puis parcours de la fin éventuelle qu'il ne couvre pas)
+static void log_load_offsets(StatsLog* log) {
+    uint64_t covered = 0;
+    if (!log_read_index(log, &covered)) {
+        log->valid_end = sizeof(StatsLogHeader);
+        covered = sizeof(StatsLogHeader);
+        log->index_stale = true;
+    }
+    uint32_t indexed = log->count;
+    log_scan(log, covered);
+    if (log->count != indexed || covered != log->size) log->index_stale = true;
+}
+
+// log_map + offsets de tous les enregistrements valides
+static bool log_open(StatsLog* log, bool writable) {
+    if (!log_map(log, writable)) return false;
+    log_load_offsets(log);
+    return true;
+}
+
+// Ouverture pour un ajout : l'en-tête de l'index (taille couverte, nombre)
+// est cru, seul son dernier enregistrement est contrôlé, et seule la fin du
+// journal qu'il ne couvre pas est parcourue. Coût indépendant de la taille
+// de l'historique. Sans index utilisable : comme log_open
+static bool log_open_tail(StatsLog* log) {
+    if (!log_map(log, true)) return false;
+
+    FILE* file = fopen(CONFIG_STATS_INDEX, "rb");
+    StatsIndexHeader header;
+    uint64_t last = 0;
+    bool ok = file && index_read_header(file, log, &header);
+    if (ok && header.count > 0) {
+        ok = fseek(file, (long)(sizeof(header) + (header.count - 1) * sizeof(uint64_t)), SEEK_SET) == 0 &&
+             fread(&last, sizeof(last), 1, file) == 1 &&
+             record_valid(log, last, false) &&
+             last + record_size(((const StatsRecordHeader*)(log->data + last))->session_count) == header.log_size;
+    } else if (ok) {
+        ok = header.log_size == sizeof(StatsLogHeader);
+    }
+    if (file) fclose(file);
+
+    if (!ok) {
+        log_load_offsets(log);
+        return true;
+    }
+
+    log->first_loaded = log->count = header.count;
+    log->indexed_end = log->valid_end = header.log_size;
+    log_scan(log, header.log_size);
+    if (log->count != header.count || header.log_size != log->size) log->index_stale = true;
+    return true;
+}
+
+// Réécrit l'index (fichier temporaire puis rename). Journal ouvert par log_open
+static bool log_write_index(const StatsLog* log) {
+    char tmp_path[512];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", CONFIG_STATS_INDEX);
+
+    FILE* file = fopen(tmp_path, "wb");
+    if (!file) return false;
+
+    StatsIndexHeader header = {
+        .magic = STATS_INDEX_MAGIC,
+        .version = STATS_STORE_VERSION,
+        .log_size = log->valid_end,
+        .count = log->count,
+    };
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(log->offsets, sizeof(uint64_t), log->count, file) == log->count;
+    if (fclose(file) != 0) ok = false;
+
+    if (!ok || rename(tmp_path, CONFIG_STATS_INDEX) != 0) {
+        debug_printf("⚠️ STATS: écriture de l'index échouée\n");
+        remove(tmp_path);
+        return false;
+    }
+    return true;
+}
+
+// Journal ouvert par log_open_tail : les offsets relus ou ajoutés sont écrits
+// derrière ceux de l'index, puis l'en-tête est mis à jour (en dernier : une
+// coupure avant laisse l'ancien index valide, la fin est reparcourue)
+static bool log_append_index(const StatsLog* log) {
+    if (log->first_loaded == 0) return log_write_index(log);
+
+    FILE* file = fopen(CONFIG_STATS_INDEX, "r+b");
+    if (!file) return false;
+
+    StatsIndexHeader header = {
+        .magic = STATS_INDEX_MAGIC,
+        .version = STATS_STORE_VERSION,
+        .log_size = log->valid_end,
+        .count = log->count,
+    };
+
+    uint32_t loaded = log->count - log->first_loaded;
+    long position = (long)(sizeof(header) + (size_t)log->first_loaded * sizeof(uint64_t));
+    bool ok = fseek(file, position, SEEK_SET) == 0 &&
+              fwrite(log->offsets, sizeof(uint64_t), loaded, file) == loaded &&
+              fflush(file) == 0 &&
+              fseek(file, 0, SEEK_SET) == 0 &&
+              fwrite(&header, sizeof(header), 1, file) == 1;
+    if (fclose(file) != 0) ok = false;
+
+    if (!ok) {
+        // En-tête peut-être abîmé : reconstruit au prochain chargement
+        debug_printf("⚠️ STATS: mise à jour de l'index échouée\n");
+        remove(CONFIG_STATS_INDEX);
+    }
+    return ok;
+}
+
+// Intègre aux cumuls les enregistrements du journal qu'ils ne couvrent pas
+// encore. S'ils ne correspondent à aucune position du journal (journal
+// réinitialisé, réparé, cumuls perdus), ils sont recalculés entièrement.
+// false si le journal, ouvert pour un ajout, n'a pas les offsets nécessaires
+static bool log_sync_rollup(const StatsLog* log, StatsRollup* rollup,
+                            uint64_t* log_end, uint32_t* records) {
+    uint32_t first = *records;
+    bool aligned = first >= log->first_loaded && first <= log->count &&
+                   (first == log->count ? *log_end == log->valid_end
+                    : log_offset(log, first) >= *log_end &&
+                      (first == log->first_loaded ? first == 0 || *log_end == log->indexed_end
+                                                  : log_offset(log, first - 1) < *log_end));
+    if (!aligned) {
+        if (log->first_loaded > 0) return false;
+        debug_printf("🔁 STATS: cumuls recalculés sur %u exercice(s)\n", log->count);
+        stats_rollup_reset(rollup);
+        first = 0;
+    }
+
+    for (uint32_t i = first; i < log->count; i++) {
+        const StatsRecordHeader* header = (const StatsRecordHeader*)(log->data + log_offset(log, i));
+        const float* times = (const float*)(header + 1);
+        if (record_crc(header, times) != header->crc) continue;
+        stats_rollup_add(rollup, (time_t)header->timestamp, times, (int)header->session_count);
+    }
+
+    *log_end = log->valid_end;
+    *records = log->count;
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// IMPORT DES ANCIENS FICHIERS stats_*.bin
+// ─────────────────────────────────────────────────────────────────────────────
+// Format : [time_t][int session_count][float × session_count]. Fait une seule
+// fois, quand le journal n'existe pas encore : le journal est écrit à part
+// puis renommé, et les .bin ne sont supprimés qu'ensuite.
+
+typedef struct {
+    char path[512];
+    int64_t timestamp;
+    int session_count;
+    float* session_times;
+} LegacyExercise;
+
+static bool is_legacy_file(const char* name) {
+    size_t len = strlen(name);
+    return len > 4 && strcmp(name + len - 4, ".bin") == 0;
+}
+
+static int compare_legacy(const void* a, const void* b) {
+    const LegacyExercise* ea = a;
+    const LegacyExercise* eb = b;
+    return (ea->timestamp > eb->timestamp) - (ea->timestamp < eb->timestamp);
+}
+
+static bool read_legacy_file(LegacyExercise* exercise) {
+    FILE* file = fopen(exercise->path, "rb");
+    if (!file) return false;
+
+    time_t timestamp;
+    int count = 0;
+    bool ok = fread(&timestamp, sizeof(time_t), 1, file) == 1 &&
+              fread(&count, sizeof(int), 1, file) == 1 &&
+              count > 0 && count <= STATS_MAX_SESSIONS;
+
+    if (ok) {
+        exercise->session_times = SAFE_MALLOC(count * sizeof(float));
+        ok = exercise->session_times &&
+             fread(exercise->session_times, sizeof(float), count, file) == (size_t)count;
+    }
+    fclose(file);
+
+    if (!ok) {
+        if (exercise->session_times) SAFE_FREE(exercise->session_times);
+        return false;
+    }
+    exercise->timestamp = (int64_t)timestamp;
+    exercise->session_count = count;
+    return true;
+}
+
+static void migrate_legacy_files(void) {
+    if (access(CONFIG_STATS_LOG, F_OK) == 0) return;
+
+    DIR* dir = opendir(CONFIG_STATS_DIR);
+    if (!dir) return;
+
+    LegacyExercise* exercises = NULL;
+    int count = 0, capacity = 0;
+    FILE* file = NULL;
+    char tmp_path[512];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", CONFIG_STATS_LOG);
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (!is_legacy_file(entry->d_name)) continue;
+
+        if (count == capacity) {
+            int new_capacity = capacity ? capacity * 2 : 64;
+            LegacyExercise* grown = SAFE_MALLOC(new_capacity * sizeof(LegacyExercise));
+            if (!grown) break;
+            if (exercises) {
+                memcpy(grown, exercises, count * sizeof(LegacyExercise));
+                SAFE_FREE(exercises);
+            }
+            exercises = grown;
+            capacity = new_capacity;
+        }
+
+        LegacyExercise* exercise = &exercises[count];
+        memset(exercise, 0, sizeof(*exercise));
+        snprintf(exercise->path, sizeof(exercise->path), "%s/%s", CONFIG_STATS_DIR, entry->d_name);
+        if (read_legacy_file(exercise)) {
+            count++;
+        } else {
+            // Illisible : laissé en place (supprimé par la réinitialisation)
+            debug_printf("⚠️ STATS: %s illisible, non importé\n", exercise->path);
+        }
+    }
+    closedir(dir);
+
+    if (count == 0) goto cleanup;
+
+    // readdir ne donne aucun ordre : journal chronologique
+    qsort(exercises, count, sizeof(LegacyExercise), compare_legacy);
+
+    file = fopen(tmp_path, "wb");
+    if (!file) goto fail;
+
+    StatsLogHeader header = {
+        .magic = STATS_LOG_MAGIC,
+        .version = STATS_STORE_VERSION,
+        .header_size = sizeof(StatsLogHeader),
+    };
+    if (fwrite(&header, sizeof(header), 1, file) != 1) goto fail;
+
+    unsigned char record[sizeof(StatsRecordHeader) + STATS_MAX_SESSIONS * sizeof(float) + STATS_RECORD_ALIGN];
+    for (int i = 0; i < count; i++) {
+        size_t size = record_size(exercises[i].session_count);
+        memset(record, 0, size);
+
+        StatsRecordHeader* record_header = (StatsRecordHeader*)record;
+        record_header->magic = STATS_RECORD_MAGIC;
+        record_header->session_count = exercises[i].session_count;
+        record_header->timestamp = exercises[i].timestamp;
+        memcpy(record_header + 1, exercises[i].session_times,
+               exercises[i].session_count * sizeof(float));
+        record_header->crc = record_crc(record_header, exercises[i].session_times);
+
+        if (fwrite(record, 1, size, file) != size) goto fail;
+    }
+
+    if (fflush(file) != 0 || fsync(fileno(file)) != 0) goto fail;
+    int close_result = fclose(file);
+    file = NULL;
+    if (close_result != 0 || rename(tmp_path, CONFIG_STATS_LOG) != 0) goto fail;
+
+    // Journal en place : les anciens fichiers peuvent partir
+    for (int i = 0; i < count; i++) {
+        remove(exercises[i].path);
+    }
+    debug_printf("📦 STATS: %d ancien(s) fichier(s) .bin importé(s) dans le journal\n", count);
+    goto cleanup;
+
+fail:
+    debug_printf("❌ STATS: import des anciens fichiers échoué (conservés)\n");
+    if (file) fclose(file);
+    remove(tmp_path);
+
+cleanup:
+    for (int i = 0; i < count; i++) {
+        SAFE_FREE(exercises[i].session_times);
+    }
+    if (exercises) SAFE_FREE(exercises);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// API
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Ordre chronologique ; à date égale, ordre du journal (les temps sont
+// copiés dans session_pool dans cet ordre)
+static int compare_entries(const void* a, const void* b) {
+    const ExerciseEntry* ea = a;
+    const ExerciseEntry* eb = b;
+    if (ea->timestamp != eb->timestamp) return ea->timestamp < eb->timestamp ? -1 : 1;
+    return ea->session_times < eb->session_times ? -1 : (ea->session_times > eb->session_times);
+}
+
+int stats_store_load(ExerciseHistory* history) {
+    if (!history) return 0;
+    memset(history, 0, sizeof(*history));
+
+    migrate_legacy_files();
+
+    StatsLog log;
+    if (!log_open(&log, false)) return 0;
+
+    // Deux allocations pour tout l'historique : entrées + bloc des temps, avec
+    // de la place pour les prochains enregistrements (stats_history.h)
+    size_t total_sessions = 0;
+    for (uint32_t i = 0; i < log.count; i++) {
+        const StatsRecordHeader* header = (const StatsRecordHeader*)(log.data + log.offsets[i]);
+        total_sessions += header->session_count;
+    }
+
+    if (log.count > 0) {
+        history->capacity = (int)log.count + STATS_HISTORY_RESERVE;
+        history->session_capacity = total_sessions + (total_sessions / log.count + 1) * STATS_HISTORY_RESERVE;
+        history->entries = SAFE_MALLOC((size_t)history->capacity * sizeof(ExerciseEntry));
+        history->session_pool = SAFE_MALLOC(history->session_capacity * sizeof(float));
+        if (!history->entries || !history->session_pool) {
+            debug_printf("❌ STATS: allocation de l'historique impossible\n");
+            free_exercise_history(history);
+            log_close(&log);
+            return 0;
+        }
+    }
+
+    float* times = history->session_pool;
+    for (uint32_t i = 0; i < log.count; i++) {
+        const StatsRecordHeader* header = (const StatsRecordHeader*)(log.data + log.offsets[i]);
+        const float* record_times = (const float*)(header + 1);
+
+        // Enregistrements venus de l'index : CRC pas encore vérifié
+        if (record_crc(header, record_times) != header->crc) {
+            debug_printf("⚠️ STATS: enregistrement corrompu à l'offset %llu, ignoré\n",
+                         (unsigned long long)log.offsets[i]);
+            continue;
+        }
+
+        ExerciseEntry* entry = &history->entries[history->count++];
+        entry->timestamp = (time_t)header->timestamp;
+        entry->session_count = (int)header->session_count;
+        entry->session_times = times;
+        memcpy(times, record_times, header->session_count * sizeof(float));
+        times += header->session_count;
+    }
+    history->session_used = history->session_pool ? (size_t)(times - history->session_pool) : 0;
+
+    // Le journal suit l'ordre d'ajout : un import d'exercices plus anciens
+    // (ou une horloge reculée) le met dans le désordre
+    bool sorted = true;
+    for (int i = 1; i < history->count && sorted; i++) {
+        sorted = history->entries[i - 1].timestamp <= history->entries[i].timestamp;
+    }
+    if (!sorted) qsort(history->entries, history->count, sizeof(ExerciseEntry), compare_entries);
+
+    if (log.index_stale) log_write_index(&log);
+    log_close(&log);
+
+    debug_printf("✅ Historique chargé: %d exercices\n", history->count);
+    return history->count;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AJOUT EN LOT
+// ─────────────────────────────────────────────────────────────────────────────
+// Les enregistrements passent par un tampon écrit à la fin du journal quand il
+// est plein ; fsync, index et cumuls une seule fois à la fin du lot. Une
+// coupure en cours de lot laisse une fin incomplète, retirée à l'ouverture
+// suivante (comme une écriture unique interrompue).
+
+#define STATS_APPEND_BUFFER (64 * 1024)
+
+struct StatsAppender {
+    StatsLog log;
+    StatsRollup* rollup;            // NULL : cumuls recalculés au prochain chargement
+    uint64_t rollup_end;
+    uint32_t rollup_records;
+    uint64_t write_end;             // Fin des données déjà écrites dans le fichier
+    size_t buffered;
+    bool failed;
+    int added;
+    uint64_t buffer[STATS_APPEND_BUFFER / sizeof(uint64_t)];  // Aligné pour les en-têtes
+};
+
+static bool appender_flush(StatsAppender* appender) {
+    if (appender->buffered == 0 || appender->failed) return !appender->failed;
+
+    if (pwrite(appender->log.fd, appender->buffer, appender->buffered,
+               (off_t)appender->write_end) != (ssize_t)appender->buffered) {
+        debug_printf("❌ STATS: écriture dans le journal échouée (%s)\n", strerror(errno));
+        appender->failed = true;
+        return false;
+    }
+    appender->write_end += appender->buffered;
+    appender->buffered = 0;
+    return true;
+}
+
+StatsAppender* stats_store_append_begin(void) {
+    struct stat st;
+    if (stat(CONFIG_STATS_DIR, &st) == -1) {
+        mkdir(CONFIG_STATS_DIR, 0700);
+    }
+    migrate_legacy_files();
+
+    StatsAppender* appender = SAFE_MALLOC(sizeof(StatsAppender));
+    if (!appender) return NULL;
+    memset(appender, 0, sizeof(*appender));
+
+    StatsLog* log = &appender->log;
+    if (!log_open_tail(log)) {
+        SAFE_FREE(appender);
+        return NULL;
+    }
+
+    // Cumuls : rattrapage éventuel sur le journal existant. En retard sur
+    // l'index (rare) : tous les offsets sont relus
+    appender->rollup = SAFE_MALLOC(sizeof(StatsRollup));
+    if (appender->rollup) {
+        appender->rollup_end = sizeof(StatsLogHeader);
+        appender->rollup_records = 0;
+        if (!stats_rollup_load(CONFIG_STATS_ROLLUP, appender->rollup,
+                               &appender->rollup_end, &appender->rollup_records)) {
+            stats_rollup_reset(appender->rollup);
+        }
+        if (!log_sync_rollup(log, appender->rollup, &appender->rollup_end, &appender->rollup_records)) {
+            log_close(log);
+            if (!log_open(log, true)) {
+                SAFE_FREE(appender->rollup);
+                SAFE_FREE(appender);
+                return NULL;
+            }
+            log_sync_rollup(log, appender->rollup, &appender->rollup_end, &appender->rollup_records);
+        }
+    }
+
+    // Fin abîmée (écriture interrompue) : repartir du dernier enregistrement valide
+    if (log->valid_end < log->size) {
+        debug_printf("✂️ STATS: %zu octet(s) incomplet(s) retirés du journal\n",
+                     (size_t)(log->size - log->valid_end));
+        if (ftruncate(log->fd, (off_t)log->valid_end) != 0) {
+            log_close(log);
+            if (appender->rollup) SAFE_FREE(appender->rollup);
+            SAFE_FREE(appender);
+            return NULL;
+        }
+    }
+    appender->write_end = log->valid_end;
+    return appender;
+}
+
+bool stats_store_append_add(StatsAppender* appender, time_t timestamp,
+                            const float* session_times, int session_count) {
+    if (!appender || appender->failed || !session_times ||
+        session_count <= 0 || session_count > STATS_MAX_SESSIONS) {
+        return false;
+    }
+
+    size_t size = record_size(session_count);
+    if (appender->buffered + size > STATS_APPEND_BUFFER && !appender_flush(appender)) return false;
+
+    unsigned char* record = (unsigned char*)appender->buffer + appender->buffered;
+    memset(record, 0, size);
+    StatsRecordHeader* header = (StatsRecordHeader*)record;
+    header->magic = STATS_RECORD_MAGIC;
+    header->session_count = (uint32_t)session_count;
+    header->timestamp = (int64_t)timestamp;
+    memcpy(header + 1, session_times, session_count * sizeof(float));
+    header->crc = record_crc(header, session_times);
+
+    uint64_t offset = appender->write_end + appender->buffered;
+    if (!log_push_offset(&appender->log, offset)) {
+        appender->failed = true;
+        return false;
+    }
+    appender->buffered += size;
+    appender->log.valid_end = offset + size;
+    appender->added++;
+
+    if (appender->rollup) stats_rollup_add(appender->rollup, timestamp, session_times, session_count);
+    return true;
+}
+
+bool stats_store_append_end(StatsAppender* appender) {
+    if (!appender) return false;
+
+    StatsLog* log = &appender->log;
+    bool ok = appender_flush(appender) && fsync(log->fd) == 0;
+
+    // Enregistrements sur disque : l'index et les cumuls peuvent les référencer.
+    // En cas d'échec, ceux écrits sont retrouvés par le prochain parcours
+    if (ok && appender->added > 0) {
+        log_append_index(log);
+        if (appender->rollup) {
+            stats_rollup_save(CONFIG_STATS_ROLLUP, appender->rollup, log->valid_end, log->count);
+        }
+    }
+    if (ok) {
+        debug_printf("✅ %d exercice(s) ajouté(s) au journal (%u au total)\n",
+                     appender->added, log->count);
+    }
+
+    if (appender->rollup) SAFE_FREE(appender->rollup);
+    log_close(log);
+    SAFE_FREE(appender);
+    return ok;
+}
+
+bool stats_store_append(time_t timestamp, const float* session_times, int session_count) {
+    if (!session_times || session_count <= 0 || session_count > STATS_MAX_SESSIONS) return false;
+
+    StatsAppender* appender = stats_store_append_begin();
+    if (!appender) return false;
+
+    bool added = stats_store_append_add(appender, timestamp, session_times, session_count);
+    return stats_store_append_end(appender) && added;
+}
+
+int stats_store_foreach(StatsRecordVisitor visit, void* user) {
+    if (!visit) return -1;
+    migrate_legacy_files();
+
+    StatsLog log;
+    if (!log_map(&log, false)) return access(CONFIG_STATS_LOG, F_OK) == 0 ? -1 : 0;
+
+    // Parcours séquentiel de la projection : ni index ni copie
+    uint64_t offset = sizeof(StatsLogHeader);
+    int skipped = 0, visited = 0;
+    const StatsRecordHeader* header;
+    while ((header = log_next_record(&log, &offset, &skipped)) != NULL) {
+        visited++;
+        if (!visit((time_t)header->timestamp, (const float*)(header + 1),
+                   (int)header->session_count, user)) {
+            break;
+        }
+    }
+
+    if (skipped > 0) {
+        debug_printf("⚠️ STATS: %d bloc(s) illisible(s) ignoré(s) dans le journal\n", skipped);
+    }
+    log_close(&log);
+    return visited;
+}
+
+bool stats_store_load_rollup(StatsRollup* rollup) {
+    if (!rollup) return false;
+
+    uint64_t log_end = sizeof(StatsLogHeader);
+    uint32_t records = 0;
+    bool loaded = stats_rollup_load(CONFIG_STATS_ROLLUP, rollup, &log_end, &records);
+
+    // Cas courant : l'index (réécrit à chaque ajout) couvre ce que couvrent les cumuls
+    if (loaded) {
+        FILE* file = fopen(CONFIG_STATS_INDEX, "rb");
+        StatsIndexHeader header;
+        bool current = file && fread(&header, sizeof(header), 1, file) == 1 &&
+                       header.magic == STATS_INDEX_MAGIC &&
+                       header.version == STATS_STORE_VERSION &&
+                       header.log_size == log_end && header.count == records;
+        if (file) fclose(file);
+        if (current) return true;
+    } else {
+        stats_rollup_reset(rollup);
+        log_end = sizeof(StatsLogHeader);
+        records = 0;
+    }
+
+    // En retard : rattrapage depuis le journal
+    migrate_legacy_files();
+
+    StatsLog log;
+    if (!log_open(&log, false)) {
+        stats_rollup_reset(rollup);     // Pas de journal : historique vide
+        return true;
+    }
+
+    log_sync_rollup(&log, rollup, &log_end, &records);
+    stats_rollup_save(CONFIG_STATS_ROLLUP, rollup, log_end, records);
+    if (log.index_stale) log_write_index(&log);
+    log_close(&log);
+    return true;
+}
+
+bool stats_store_reset(void) {
+    int deleted = 0;
+    if (remove(CONFIG_STATS_LOG) == 0) deleted++;
+    if (remove(CONFIG_STATS_INDEX) == 0) deleted++;
+    if (remove(CONFIG_STATS_ROLLUP) == 0) deleted++;
+
+    // Anciens fichiers pas (ou pas encore) importés
+    DIR* dir = opendir(CONFIG_STATS_DIR);
+    if (dir) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (!is_legacy_file(entry->d_name)) continue;
+
+            char filepath[512];
+            snprintf(filepath, sizeof(filepath), "%s/%s", CONFIG_STATS_DIR, entry->d_name);
+            if (remove(filepath) == 0) deleted++;
+        }
+        closedir(dir);
+    }
+
+    debug_printf("🗑️ Historique réinitialisé: %d fichiers supprimés\n", deleted);
+    return true;
+}
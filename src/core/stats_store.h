@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// stats_store.h
+// JOURNAL DES EXERCICES (AJOUT SEUL + INDEX)
+// Tous les exercices sont dans un seul fichier journal : un en-tête fixe puis
+// des enregistrements ajoutés à la fin, chacun protégé par un CRC32. Un index
+// à côté (offsets des enregistrements + taille du journal couverte) évite de
+// parcourir le journal au chargement, fait en un seul mmap.
+//
+// - Enregistrement incomplet (coupure pendant l'écriture) : ignoré au
+//   chargement, tronqué avant l'ajout suivant
+// - Index absent, périmé ou corrompu : le journal est reparcouru et l'index
+//   réécrit
+// - Ajout : l'en-tête de l'index est cru, seule la fin du journal qu'il ne
+//   couvre pas est vérifiée, et les nouveaux offsets sont ajoutés à sa suite
+//   (coût indépendant de la taille de l'historique)
+// - Anciens fichiers stats_*.bin : importés une fois dans le journal à sa
+//   création, puis supprimés
+// - Cumuls (stats_rollup.h) : mis à jour à chaque ajout, recalculés depuis
+//   le journal s'ils ne le couvrent pas exactement
+
+#ifndef __STATS_STORE_H__
+#define __STATS_STORE_H__
+
+#include <stdbool.h>
+#include <time.h>
+#include "stats_history.h"
+#include "stats_rollup.h"
+
+#define STATS_MAX_SESSIONS 1024     // Au-delà : enregistrement considéré corrompu
+
+// Charge tout l'historique, trié par date (à date égale : ordre d'ajout).
+// L'historique doit être vide ; à libérer avec free_exercise_history.
+// Entrées et temps ont de la place pour STATS_HISTORY_RESERVE ajouts.
+// Retourne le nombre d'exercices chargés
+int stats_store_load(ExerciseHistory* history);
+
+// Ajoute un exercice à la fin du journal (écrit sur disque avant de rendre la main)
+bool stats_store_append(time_t timestamp, const float* session_times, int session_count);
+
+// Ajout en lot (import) : un seul fsync, une seule écriture de l'index et des
+// cumuls, à la fin. end libère l'appender et retourne false si une écriture a
+// échoué (les enregistrements déjà écrits restent valides)
+typedef struct StatsAppender StatsAppender;
+StatsAppender* stats_store_append_begin(void);
+bool stats_store_append_add(StatsAppender* appender, time_t timestamp,
+                            const float* session_times, int session_count);
+bool stats_store_append_end(StatsAppender* appender);
+
+// Parcourt tous les exercices valides du journal dans l'ordre, sans charger
+// l'historique (mémoire constante). visit retourne false pour arrêter.
+// Retourne le nombre d'exercices visités, -1 si le journal est illisible
+typedef bool (*StatsRecordVisitor)(time_t timestamp, const float* session_times,
+                                   int session_count, void* user);
+int stats_store_foreach(StatsRecordVisitor visit, void* user);
+
+// Cumuls à jour de tout le journal : lecture du fichier des cumuls (et de
+// l'en-tête de l'index) sauf s'ils sont en retard. false si erreur
+bool stats_store_load_rollup(StatsRollup* rollup);
+
+// Supprime journal, index, cumuls et anciens fichiers .bin
+bool stats_store_reset(void);
+
+#endif
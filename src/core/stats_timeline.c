@@ -0,0 +1,258 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// stats_timeline.c
+#include "stats_timeline.h"
+#include "core/memory/memory.h"
+#include "debug.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONSTRUCTION
+// ═══════════════════════════════════════════════════════════════════════════
+// Nœuds du niveau 0 remplis par stats_timeline_add, triés par finish, puis
+// chaque niveau suivant fusionne les nœuds par paires. Chaque niveau a sa
+// place pour capacity exercices : total < 2 × capacity + niveaux.
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool stats_timeline_begin(StatsTimeline* timeline, int capacity) {
+    memset(timeline, 0, sizeof(*timeline));
+    if (capacity <= 0) return true;
+
+    timeline->nodes = SAFE_MALLOC(((size_t)capacity * 2 + TIMELINE_MAX_LEVELS) * sizeof(TimelineNode));
+    if (!timeline->nodes) {
+        debug_printf("⚠️ STATS: chronologie non allouée (%d exercices)\n", capacity);
+        return false;
+    }
+    timeline->count = capacity;
+    timeline->capacity = capacity;
+    timeline->levels = 1;
+    return true;
+}
+
+// Nœuds réservés au niveau (capacity / 2^level, arrondi au-dessus)
+static int level_capacity(const StatsTimeline* timeline, int level) {
+    return ((timeline->capacity - 1) >> level) + 1;
+}
+
+static void fill_node(TimelineNode* node, time_t timestamp,
+                      const float* session_times, int session_count) {
+    node->first = node->last = (int64_t)timestamp;
+    node->time = (double)timestamp;
+    node->exercises = 1;
+    node->value = 0.0f;
+    node->low = 0.0f;
+    node->high = 0.0f;
+
+    for (int i = 0; i < session_count; i++) {
+        float time = session_times[i] > 0.0f ? session_times[i] : 0.0f;
+        if (i == 0 || time < node->low) node->low = time;
+        if (time > node->high) node->high = time;
+    }
+    node->value = node->high;
+}
+
+void stats_timeline_add(StatsTimeline* timeline, time_t timestamp,
+                        const float* session_times, int session_count) {
+    if (!timeline->nodes || timeline->level_count[0] >= timeline->capacity) return;
+    fill_node(&timeline->nodes[timeline->level_count[0]++], timestamp, session_times, session_count);
+}
+
+static int compare_nodes(const void* a, const void* b) {
+    int64_t ta = ((const TimelineNode*)a)->first;
+    int64_t tb = ((const TimelineNode*)b)->first;
+    return (ta > tb) - (ta < tb);
+}
+
+static void merge_nodes(TimelineNode* out, const TimelineNode* a, const TimelineNode* b) {
+    uint32_t total = a->exercises + b->exercises;
+    out->first = a->first;
+    out->last = b->last;
+    out->time = (a->time * a->exercises + b->time * b->exercises) / total;
+    out->value = (float)(((double)a->value * a->exercises + (double)b->value * b->exercises) / total);
+    out->low = a->low < b->low ? a->low : b->low;
+    out->high = a->high > b->high ? a->high : b->high;
+    out->exercises = total;
+}
+
+void stats_timeline_finish(StatsTimeline* timeline) {
+    if (!timeline->nodes) return;
+
+    // Exercices ajoutés en moins que prévu (entrées ignorées)
+    timeline->count = timeline->level_count[0];
+    if (timeline->count == 0) {
+        stats_timeline_free(timeline);
+        return;
+    }
+
+    // Le journal est presque toujours déjà trié (horloge reculée : rare)
+    bool sorted = true;
+    for (int i = 1; i < timeline->count && sorted; i++) {
+        sorted = timeline->nodes[i - 1].first <= timeline->nodes[i].first;
+    }
+    if (!sorted) qsort(timeline->nodes, timeline->count, sizeof(TimelineNode), compare_nodes);
+
+    timeline->levels = 1;
+    timeline->level_start[0] = 0;
+    while (timeline->level_count[timeline->levels - 1] > 1 &&
+           timeline->levels < TIMELINE_MAX_LEVELS) {
+        int level = timeline->levels;
+        const TimelineNode* below = &timeline->nodes[timeline->level_start[level - 1]];
+        int below_count = timeline->level_count[level - 1];
+
+        timeline->level_start[level] = timeline->level_start[level - 1] +
+                                       level_capacity(timeline, level - 1);
+        timeline->level_count[level] = (below_count + 1) / 2;
+        TimelineNode* nodes = &timeline->nodes[timeline->level_start[level]];
+
+        for (int i = 0; i < below_count / 2; i++) {
+            merge_nodes(&nodes[i], &below[2 * i], &below[2 * i + 1]);
+        }
+        if (below_count % 2) nodes[below_count / 2] = below[below_count - 1];
+        timeline->levels++;
+    }
+}
+
+bool stats_timeline_append(StatsTimeline* timeline, time_t timestamp,
+                           const float* session_times, int session_count) {
+    if (!timeline->nodes || timeline->count >= timeline->capacity) return false;
+    if ((int64_t)timestamp < timeline->nodes[timeline->count - 1].first) return false;
+
+    fill_node(&timeline->nodes[timeline->count], timestamp, session_times, session_count);
+    timeline->count = ++timeline->level_count[0];
+
+    // Dernier nœud de chaque niveau : fusion de la dernière paire ou copie
+    // du dernier nœud s'il est seul (comme finish)
+    for (int level = 1; timeline->level_count[level - 1] > 1 && level < TIMELINE_MAX_LEVELS; level++) {
+        if (level == timeline->levels) {
+            timeline->level_start[level] = timeline->level_start[level - 1] +
+                                           level_capacity(timeline, level - 1);
+            timeline->levels++;
+        }
+        const TimelineNode* below = &timeline->nodes[timeline->level_start[level - 1]];
+        int below_count = timeline->level_count[level - 1];
+        timeline->level_count[level] = (below_count + 1) / 2;
+
+        TimelineNode* last = &timeline->nodes[timeline->level_start[level] + timeline->level_count[level] - 1];
+        if (below_count % 2) *last = below[below_count - 1];
+        else merge_nodes(last, &below[below_count - 2], &below[below_count - 1]);
+    }
+    return true;
+}
+
+void stats_timeline_free(StatsTimeline* timeline) {
+    if (!timeline) return;
+    if (timeline->nodes) SAFE_FREE(timeline->nodes);
+    memset(timeline, 0, sizeof(*timeline));
+}
+
+bool stats_timeline_range(const StatsTimeline* timeline, int64_t* first, int64_t* last) {
+    if (!timeline->nodes || timeline->count == 0) return false;
+    *first = timeline->nodes[0].first;
+    *last = timeline->nodes[timeline->count - 1].last;
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ÉCHANTILLONNAGE
+// ═══════════════════════════════════════════════════════════════════════════
+
+static TimelinePoint node_point(const TimelineNode* node) {
+    return (TimelinePoint){ node->time, node->value, node->low, node->high };
+}
+
+// Premier exercice daté au moins de t (count si aucun)
+static int lower_bound(const TimelineNode* nodes, int count, int64_t t) {
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (nodes[mid].first < t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// LTTB : garde le premier et le dernier nœud, puis dans chaque tranche le
+// nœud qui forme le plus grand triangle avec le point gardé précédent et la
+// moyenne de la tranche suivante. Chaque point reçoit l'enveloppe de sa tranche
+static int lttb(const TimelineNode* src, int count, int target, TimelinePoint* out) {
+    double origin = src[0].time;    // Différences de dates : précision du double
+    double every = (double)(count - 2) / (double)(target - 2);
+    int kept = 0;
+
+    out[0] = node_point(&src[0]);
+    for (int bucket = 0; bucket < target - 2; bucket++) {
+        int start = (int)(bucket * every) + 1;
+        int end = (int)((bucket + 1) * every) + 1;
+        if (end > count - 1) end = count - 1;
+
+        // Moyenne de la tranche suivante (le dernier nœud pour la dernière)
+        int next_start = end;
+        int next_end = (int)((bucket + 2) * every) + 1;
+        if (next_end > count) next_end = count;
+        if (next_start >= next_end) next_start = next_end - 1;
+
+        double avg_x = 0.0, avg_y = 0.0;
+        for (int i = next_start; i < next_end; i++) {
+            avg_x += src[i].time - origin;
+            avg_y += src[i].value;
+        }
+        avg_x /= (next_end - next_start);
+        avg_y /= (next_end - next_start);
+
+        double ax = src[kept].time - origin;
+        double ay = src[kept].value;
+        double best_area = -1.0;
+        int best = start;
+        float low = src[start].low, high = src[start].high;
+
+        for (int i = start; i < end; i++) {
+            double bx = src[i].time - origin;
+            double area = (ax - avg_x) * (src[i].value - ay) - (ax - bx) * (avg_y - ay);
+            if (area < 0) area = -area;
+            if (area > best_area) {
+                best_area = area;
+                best = i;
+            }
+            if (src[i].low < low) low = src[i].low;
+            if (src[i].high > high) high = src[i].high;
+        }
+
+        out[bucket + 1] = node_point(&src[best]);
+        out[bucket + 1].low = low;
+        out[bucket + 1].high = high;
+        kept = best;
+    }
+    out[target - 1] = node_point(&src[count - 1]);
+    return target;
+}
+
+int stats_timeline_sample(const StatsTimeline* timeline, int64_t t0, int64_t t1,
+                          int budget, TimelinePoint* out) {
+    if (!timeline->nodes || timeline->count == 0 || t1 < t0) return 0;
+    if (budget < 3) budget = 3;
+
+    // Exercices de la fenêtre, plus un voisin de chaque côté (niveau 0)
+    const TimelineNode* exercises = timeline->nodes;
+    int first = lower_bound(exercises, timeline->count, t0);
+    int last = lower_bound(exercises, timeline->count, t1 + 1) - 1;
+    if (first > 0) first--;
+    if (last < timeline->count - 1) last++;
+    if (last < first) return 0;
+
+    // Niveau le plus fin qui tient dans le suréchantillonnage autorisé
+    int level = 0;
+    while (level + 1 < timeline->levels &&
+           ((last - first + 1) >> level) > TIMELINE_OVERSAMPLE * budget) {
+        level++;
+    }
+
+    const TimelineNode* nodes = &timeline->nodes[timeline->level_start[level]];
+    int start = first >> level;
+    int count = (last >> level) - start + 1;
+
+    if (count <= budget + 2) {
+        for (int i = 0; i < count; i++) out[i] = node_point(&nodes[start + i]);
+        return count;
+    }
+    return lttb(&nodes[start], count, budget, out);
+}
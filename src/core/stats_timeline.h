@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// stats_timeline.h
+// CHRONOLOGIE DE L'HISTORIQUE (VUE LONGUE DURÉE)
+// Série par exercice : meilleur temps de rétention + enveloppe min/max de
+// toutes ses sessions, triée par date. Construite une fois par chargement de
+// l'historique, puis échantillonnée à chaque rendu :
+//
+// - Pyramide : chaque niveau regroupe les nœuds du niveau inférieur par deux
+//   (moyennes, min/max) ; l'échantillonnage part du niveau le plus fin qui
+//   tient dans TIMELINE_OVERSAMPLE × budget nœuds
+// - LTTB (Largest-Triangle-Three-Buckets) réduit ces nœuds au budget (en
+//   pratique la largeur du graphique en pixels), chaque point gardant
+//   l'enveloppe de sa tranche
+// Coût d'un rendu borné par le budget, quelle que soit la longueur de
+// l'historique.
+
+#ifndef __STATS_TIMELINE_H__
+#define __STATS_TIMELINE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#define TIMELINE_MAX_LEVELS 32
+#define TIMELINE_OVERSAMPLE 4       // Nœuds par point en entrée de LTTB, au plus
+
+// Nœud de la pyramide (un exercice au niveau 0)
+typedef struct {
+    int64_t first;                  // Date du premier exercice couvert
+    int64_t last;                   // Date du dernier exercice couvert
+    double time;                    // Date moyenne
+    float value;                    // Meilleur temps (moyenne au-delà du niveau 0)
+    float low;                      // Plus court temps de session
+    float high;                     // Plus long temps de session
+    uint32_t exercises;
+} TimelineNode;
+
+typedef struct {
+    TimelineNode* nodes;            // Tous les niveaux à la suite (NULL si vide)
+    int count;                      // Exercices (nœuds du niveau 0)
+    int capacity;                   // Exercices réservés (place de chaque niveau)
+    int levels;
+    int level_start[TIMELINE_MAX_LEVELS];
+    int level_count[TIMELINE_MAX_LEVELS];
+} StatsTimeline;
+
+// Point échantillonné pour le rendu
+typedef struct {
+    double time;
+    float value;
+    float low;
+    float high;
+} TimelinePoint;
+
+// Construction : begin (allocation pour capacity exercices), un add par
+// exercice dans n'importe quel ordre, puis finish (tri et niveaux).
+// false si allocation impossible : la chronologie reste vide
+bool stats_timeline_begin(StatsTimeline* timeline, int capacity);
+void stats_timeline_add(StatsTimeline* timeline, time_t timestamp,
+                        const float* session_times, int session_count);
+void stats_timeline_finish(StatsTimeline* timeline);
+
+// Ajout après finish d'un exercice qui ne précède pas le dernier : nouveau
+// nœud en fin de niveau 0, seul le dernier nœud de chaque niveau est
+// recalculé. false si la place réservée est pleine ou l'exercice plus
+// ancien : la chronologie est à reconstruire
+bool stats_timeline_append(StatsTimeline* timeline, time_t timestamp,
+                           const float* session_times, int session_count);
+
+void stats_timeline_free(StatsTimeline* timeline);
+
+// Échantillonne [t0, t1] en au plus `budget` points (au moins 3), plus un
+// point de chaque côté de la fenêtre pour prolonger la courbe jusqu'aux
+// bords. Retourne le nombre de points écrits dans out (budget + 2 places)
+int stats_timeline_sample(const StatsTimeline* timeline, int64_t t0, int64_t t1,
+                          int budget, TimelinePoint* out);
+
+// Premier et dernier exercice ; false si la chronologie est vide
+bool stats_timeline_range(const StatsTimeline* timeline, int64_t* first, int64_t* last);
+
+#endif
@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "trace.h"
+#include "debug.h"
+#include "core/memory/memory.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STOCKAGE DES ÉVÉNEMENTS
+// ═══════════════════════════════════════════════════════════════════════════
+// - Chunks de taille fixe chaînés : pas de realloc, les événements déjà
+//   écrits ne bougent jamais
+// - Verrou spinlock très court (copie de 32 octets), compatible avec
+//   plusieurs threads producteurs
+// - Plafond TRACE_MAX_EVENTS : au-delà, les événements sont comptés et perdus
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define TRACE_CHUNK_EVENTS 16384
+#define TRACE_MAX_EVENTS (4 * 1024 * 1024)
+#define TRACE_MAX_THREAD_NAMES 16
+
+typedef struct {
+    const char* name;
+    uint64_t timestamp_ns;      // Depuis trace_init()
+    uint64_t id;                // Spans asynchrones uniquement
+    uint32_t thread_id;
+    char phase;
+} TraceEvent;
+
+typedef struct TraceChunk {
+    struct TraceChunk* next;
+    size_t count;
+    TraceEvent events[TRACE_CHUNK_EVENTS];
+} TraceChunk;
+
+typedef struct {
+    uint32_t thread_id;
+    const char* name;
+} TraceThreadName;
+
+bool trace_enabled = false;
+
+static struct {
+    char path[256];
+    struct timespec start;
+    TraceChunk* first;
+    TraceChunk* last;
+    size_t total_events;
+    size_t dropped_events;
+    TraceThreadName thread_names[TRACE_MAX_THREAD_NAMES];
+    int thread_name_count;
+    atomic_flag lock;
+} trace_state = { .lock = ATOMIC_FLAG_INIT };
+
+static inline void trace_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&trace_state.lock, memory_order_acquire)) {
+        // Attente active : la section critique ne fait qu'une copie
+    }
+}
+
+static inline void trace_unlock(void) {
+    atomic_flag_clear_explicit(&trace_state.lock, memory_order_release);
+}
+
+static uint64_t trace_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - trace_state.start.tv_sec) * 1000000000ULL
+         + (uint64_t)(now.tv_nsec - trace_state.start.tv_nsec);
+}
+
+void trace_init(const char* path) {
+    if (trace_enabled) return;
+
+    snprintf(trace_state.path, sizeof(trace_state.path), "%s", path ? path : "trace.json");
+    clock_gettime(CLOCK_MONOTONIC, &trace_state.start);
+    trace_state.first = NULL;
+    trace_state.last = NULL;
+    trace_state.total_events = 0;
+    trace_state.dropped_events = 0;
+    trace_state.thread_name_count = 0;
+
+    trace_enabled = true;
+    trace_set_thread_name("main");
+    debug_printf("📈 Trace activée → %s\n", trace_state.path);
+}
+
+void trace_set_thread_name(const char* name) {
+    if (!trace_enabled) return;
+
+    trace_lock();
+    if (trace_state.thread_name_count < TRACE_MAX_THREAD_NAMES) {
+        TraceThreadName* entry = &trace_state.thread_names[trace_state.thread_name_count++];
+        entry->thread_id = (uint32_t)SDL_ThreadID();
+        entry->name = name;
+    }
+    trace_unlock();
+}
+
+void trace_event(const char* name, char phase, uint64_t id) {
+    TraceEvent event = {
+        .name = name,
+        .timestamp_ns = trace_now_ns(),
+        .id = id,
+        .thread_id = (uint32_t)SDL_ThreadID(),
+        .phase = phase,
+    };
+
+    trace_lock();
+
+    // trace_shutdown() a pu passer entre le test de la macro et le verrou
+    if (!trace_enabled) {
+        trace_unlock();
+        return;
+    }
+
+    if (trace_state.total_events >= TRACE_MAX_EVENTS) {
+        trace_state.dropped_events++;
+        trace_unlock();
+        return;
+    }
+
+    TraceChunk* chunk = trace_state.last;
+    if (!chunk || chunk->count == TRACE_CHUNK_EVENTS) {
+        chunk = SAFE_MALLOC(sizeof(TraceChunk));
+        if (!chunk) {
+            trace_state.dropped_events++;
+            trace_unlock();
+            return;
+        }
+        chunk->next = NULL;
+        chunk->count = 0;
+
+        if (trace_state.last) {
+            trace_state.last->next = chunk;
+        } else {
+            trace_state.first = chunk;
+        }
+        trace_state.last = chunk;
+    }
+
+    chunk->events[chunk->count++] = event;
+    trace_state.total_events++;
+
+    trace_unlock();
+}
+
+// Écrit une chaîne JSON (les noms sont des littéraux, mais on reste prudent)
+static void trace_write_string(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', file);
+            fputc(*c, file);
+        } else if ((unsigned char)*c < 0x20) {
+            fprintf(file, "\\u%04x", (unsigned char)*c);
+        } else {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+void trace_shutdown(void) {
+    if (!trace_enabled) return;
+
+    trace_lock();
+    trace_enabled = false;
+    trace_unlock();
+
+    FILE* file = fopen(trace_state.path, "w");
+    if (!file) {
+        debug_printf("❌ Trace: impossible d'écrire %s\n", trace_state.path);
+    } else {
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+        bool first = true;
+        for (int i = 0; i < trace_state.thread_name_count; i++) {
+            const TraceThreadName* entry = &trace_state.thread_names[i];
+            fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                    first ? "" : ",\n", entry->thread_id);
+            trace_write_string(file, entry->name);
+            fprintf(file, "}}");
+            first = false;
+        }
+
+        for (TraceChunk* chunk = trace_state.first; chunk; chunk = chunk->next) {
+            for (size_t i = 0; i < chunk->count; i++) {
+                const TraceEvent* event = &chunk->events[i];
+
+                fprintf(file, "%s{\"ph\":\"%c\",\"name\":", first ? "" : ",\n", event->phase);
+                trace_write_string(file, event->name);
+                fprintf(file, ",\"pid\":1,\"tid\":%u,\"ts\":%.3f",
+                        event->thread_id, (double)event->timestamp_ns / 1000.0);
+
+                if (event->phase == 'b' || event->phase == 'e') {
+                    fprintf(file, ",\"cat\":\"async\",\"id\":%llu",
+                            (unsigned long long)event->id);
+                } else if (event->phase == 'i') {
+                    fprintf(file, ",\"s\":\"t\"");
+                }
+                fprintf(file, "}");
+                first = false;
+            }
+        }
+
+        fprintf(file, "\n]}\n");
+        fclose(file);
+
+        debug_printf("📈 Trace écrite: %s (%zu événements, %zu perdus)\n",
+                     trace_state.path, trace_state.total_events, trace_state.dropped_events);
+    }
+
+    TraceChunk* chunk = trace_state.first;
+    while (chunk) {
+        TraceChunk* next = chunk->next;
+        SAFE_FREE(chunk);
+        chunk = next;
+    }
+    trace_state.first = NULL;
+    trace_state.last = NULL;
+}
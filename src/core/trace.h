@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TRACE D'EXÉCUTION (format Chrome trace-event / Perfetto)
+// ═══════════════════════════════════════════════════════════════════════════
+// Activée avec --trace (ou --trace=fichier.json). Les événements sont
+// stockés en mémoire et écrits en une fois par trace_shutdown() : ouvrir le
+// fichier dans chrome://tracing ou https://ui.perfetto.dev
+//
+// Les noms passés aux macros doivent être des chaînes littérales (seul le
+// pointeur est stocké). Désactivée, une macro coûte un test de booléen.
+// ═══════════════════════════════════════════════════════════════════════════
+
+extern bool trace_enabled;
+
+// Démarre l'enregistrement (path NULL → "trace.json")
+void trace_init(const char* path);
+
+// Écrit le fichier JSON et libère les événements
+void trace_shutdown(void);
+
+// Nomme le thread appelant dans la timeline
+void trace_set_thread_name(const char* name);
+
+// Point d'entrée des macros (phase = 'B', 'E', 'i', 'b' ou 'e')
+void trace_event(const char* name, char phase, uint64_t id);
+
+// Span synchrone : BEGIN et END doivent être appariés sur le même thread
+#define TRACE_BEGIN(name) do { if (trace_enabled) trace_event((name), 'B', 0); } while (0)
+#define TRACE_END(name)   do { if (trace_enabled) trace_event((name), 'E', 0); } while (0)
+
+// Événement ponctuel (transition, clic...)
+#define TRACE_INSTANT(name) do { if (trace_enabled) trace_event((name), 'i', 0); } while (0)
+
+// Span asynchrone (peut couvrir plusieurs frames, ex: phase de session)
+#define TRACE_ASYNC_BEGIN(name, id) do { if (trace_enabled) trace_event((name), 'b', (id)); } while (0)
+#define TRACE_ASYNC_END(name, id)   do { if (trace_enabled) trace_event((name), 'e', (id)); } while (0)
+
+#endif
@@ -546,45 +546,49 @@ void handle_config_widget_events(ConfigWidget* widget, SDL_Event* event,
         if (widget->base.hovered) {
             int direction = (event->wheel.y > 0) ? 1 : -1;  // 1 = haut, -1 = bas
 
-            if (strcmp(widget->widget_display_type, "time") == 0) {
-                // ─────────────────────────────────────────────────────────────
-                // MODE TIME : Modifier le champ survolé (mm ou ss)
-                // ─────────────────────────────────────────────────────────────
-                int total_seconds = widget->value;
-                int minutes = total_seconds / 60;
-                int seconds = total_seconds % 60;
+            // Crans de molette regroupés (input_coalesce) : appliqués un par un
+            int steps = (event->wheel.y != 0) ? abs(event->wheel.y) : 1;
+            for (int step = 0; step < steps; step++) {
+                if (strcmp(widget->widget_display_type, "time") == 0) {
+                    // ─────────────────────────────────────────────────────────────
+                    // MODE TIME : Modifier le champ survolé (mm ou ss)
+                    // ─────────────────────────────────────────────────────────────
+                    int total_seconds = widget->value;
+                    int minutes = total_seconds / 60;
+                    int seconds = total_seconds % 60;
+
+                    if (widget->selected_field == 0) {
+                        // Modifier les minutes
+                        minutes += direction;
+                        if (minutes < 0) minutes = 0;
+                        if (minutes > 99) minutes = 99;  // Limite arbitraire
+                    } else if (widget->selected_field == 1) {
+                        // Modifier les secondes
+                        seconds += direction;
+                        if (seconds < 0) seconds = 0;
+                        if (seconds > 59) seconds = 59;
+                    }
 
-                if (widget->selected_field == 0) {
-                    // Modifier les minutes
-                    minutes += direction;
-                    if (minutes < 0) minutes = 0;
-                    if (minutes > 99) minutes = 99;  // Limite arbitraire
-                } else if (widget->selected_field == 1) {
-                    // Modifier les secondes
-                    seconds += direction;
-                    if (seconds < 0) seconds = 0;
-                    if (seconds > 59) seconds = 59;
-                }
+                    int new_value = minutes * 60 + seconds;
 
-                int new_value = minutes * 60 + seconds;
+                    // Appliquer les limites min/max
+                    if (new_value < widget->min_value) new_value = widget->min_value;
+                    if (new_value > widget->max_value) new_value = widget->max_value;
 
-                // Appliquer les limites min/max
-                if (new_value < widget->min_value) new_value = widget->min_value;
-                if (new_value > widget->max_value) new_value = widget->max_value;
-
-                if (new_value != widget->value) {
-                    widget->value = new_value;
-                    if (widget->on_value_changed) widget->on_value_changed(widget->value);
-                }
-            } else {
-                // ─────────────────────────────────────────────────────────────
-                // MODE NUMERIC : Incrémenter/décrémenter
-                // ─────────────────────────────────────────────────────────────
-                int new_value = widget->value + (direction * widget->increment);
+                    if (new_value != widget->value) {
+                        widget->value = new_value;
+                        if (widget->on_value_changed) widget->on_value_changed(widget->value);
+                    }
+                } else {
+                    // ─────────────────────────────────────────────────────────────
+                    // MODE NUMERIC : Incrémenter/décrémenter
+                    // ─────────────────────────────────────────────────────────────
+                    int new_value = widget->value + (direction * widget->increment);
 
-                if (new_value >= widget->min_value && new_value <= widget->max_value) {
-                    widget->value = new_value;
-                    if (widget->on_value_changed) widget->on_value_changed(widget->value);
+                    if (new_value >= widget->min_value && new_value <= widget->max_value) {
+                        widget->value = new_value;
+                        if (widget->on_value_changed) widget->on_value_changed(widget->value);
+                    }
                 }
             }
         }
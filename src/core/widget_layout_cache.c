@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// widget_layout_cache.c
+#include "widget_layout_cache.h"
+#include "debug.h"
+#include "core/memory/memory.h"
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FORMAT DU FICHIER
+// ═══════════════════════════════════════════════════════════════════════════
+// [LayoutCacheHeader][WidgetSpec × count][SelectorOptionSpec × option_count]
+// [table de chaînes]
+// Les tailles des structures sont dans l'en-tête : un binaire recompilé avec
+// une autre disposition rejette le cache au lieu de mal le lire.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define LAYOUT_CACHE_MAGIC 0x54594C57u     // "WLYT"
+#define LAYOUT_CACHE_VERSION 1u
+#define LAYOUT_CACHE_MAX_BYTES (4 * 1024 * 1024)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t json_hash;
+    uint32_t spec_size;
+    uint32_t option_size;
+    uint32_t count;
+    uint32_t option_count;
+    uint32_t strings_size;
+    uint32_t reserved;
+} LayoutCacheHeader;
+
+void widget_layout_init(WidgetLayout* layout) {
+    memset(layout, 0, sizeof(*layout));
+}
+
+void widget_layout_free(WidgetLayout* layout) {
+    if (!layout) return;
+
+    if (layout->blob) {
+        SAFE_FREE(layout->blob);
+    } else {
+        SAFE_FREE(layout->specs);
+        SAFE_FREE(layout->options);
+        SAFE_FREE(layout->strings);
+    }
+    widget_layout_init(layout);
+}
+
+// Agrandit un tableau (×2), retourne false si erreur d'allocation
+static bool layout_grow(void** array, uint32_t* capacity, uint32_t needed, size_t element_size) {
+    if (needed <= *capacity) return true;
+
+    uint32_t new_capacity = *capacity ? *capacity * 2 : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+
+    // SAFE_MALLOC + copie plutôt que realloc : les blocs restent trackés
+    void* grown = SAFE_MALLOC(new_capacity * element_size);
+    if (!grown) return false;
+
+    if (*array) {
+        memcpy(grown, *array, *capacity * element_size);
+        SAFE_FREE(*array);
+    }
+    *array = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+WidgetSpec* widget_layout_add(WidgetLayout* layout, WidgetSpecType type) {
+    if (!layout_grow((void**)&layout->specs, &layout->capacity,
+                     layout->count + 1, sizeof(WidgetSpec))) {
+        return NULL;
+    }
+
+    WidgetSpec* spec = &layout->specs[layout->count++];
+    memset(spec, 0, sizeof(*spec));
+    spec->type = type;
+    return spec;
+}
+
+uint32_t widget_layout_intern(WidgetLayout* layout, const char* text) {
+    if (!text) return 0;
+
+    // Offset 0 réservé à la chaîne absente
+    if (layout->strings_size == 0) {
+        if (!layout_grow((void**)&layout->strings, &layout->strings_capacity, 1, 1)) return 0;
+        layout->strings[0] = '\0';
+        layout->strings_size = 1;
+    }
+
+    uint32_t length = (uint32_t)strlen(text) + 1;
+    if (!layout_grow((void**)&layout->strings, &layout->strings_capacity,
+                     layout->strings_size + length, 1)) {
+        return 0;
+    }
+
+    uint32_t offset = layout->strings_size;
+    memcpy(layout->strings + offset, text, length);
+    layout->strings_size += length;
+    return offset;
+}
+
+bool widget_layout_add_option(WidgetLayout* layout, const char* texte, const char* callback) {
+    if (!layout_grow((void**)&layout->options, &layout->option_capacity,
+                     layout->option_count + 1, sizeof(SelectorOptionSpec))) {
+        return false;
+    }
+
+    SelectorOptionSpec* option = &layout->options[layout->option_count++];
+    option->texte = widget_layout_intern(layout, texte);
+    option->callback = widget_layout_intern(layout, callback);
+    return true;
+}
+
+uint64_t widget_layout_hash(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Vérifie que les offsets d'une description restent dans les tableaux chargés
+static bool layout_spec_valid(const WidgetLayout* layout, const WidgetSpec* spec) {
+    if (spec->type > WIDGET_SPEC_SELECTOR) return false;
+    if (spec->id >= layout->strings_size || spec->label >= layout->strings_size ||
+        spec->callback >= layout->strings_size) {
+        return false;
+    }
+    if (spec->type == WIDGET_SPEC_SELECTOR) {
+        uint32_t first = spec->u.selector.first_option;
+        uint32_t count = spec->u.selector.option_count;
+        if (first > layout->option_count || count > layout->option_count - first) return false;
+    }
+    return true;
+}
+
+bool widget_layout_cache_load(const char* path, uint64_t json_hash, WidgetLayout* layout) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    LayoutCacheHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != LAYOUT_CACHE_MAGIC ||
+        header.version != LAYOUT_CACHE_VERSION ||
+        header.spec_size != sizeof(WidgetSpec) ||
+        header.option_size != sizeof(SelectorOptionSpec)) {
+        debug_printf("⚠️ LAYOUT: cache %s d'un autre format, ignoré\n", path);
+        fclose(file);
+        return false;
+    }
+
+    if (header.json_hash != json_hash) {
+        debug_printf("🔁 LAYOUT: cache périmé (JSON modifié)\n");
+        fclose(file);
+        return false;
+    }
+
+    size_t specs_bytes = (size_t)header.count * sizeof(WidgetSpec);
+    size_t options_bytes = (size_t)header.option_count * sizeof(SelectorOptionSpec);
+    size_t total = specs_bytes + options_bytes + header.strings_size;
+    if (total > LAYOUT_CACHE_MAX_BYTES || header.strings_size == 0) {
+        fclose(file);
+        return false;
+    }
+
+    char* blob = SAFE_MALLOC(total);
+    if (!blob) {
+        fclose(file);
+        return false;
+    }
+
+    bool complete = fread(blob, 1, total, file) == total;
+    fclose(file);
+    if (!complete) {
+        SAFE_FREE(blob);
+        return false;
+    }
+
+    widget_layout_init(layout);
+    layout->blob = blob;
+    layout->specs = (WidgetSpec*)blob;
+    layout->count = layout->capacity = header.count;
+    layout->options = (SelectorOptionSpec*)(blob + specs_bytes);
+    layout->option_count = layout->option_capacity = header.option_count;
+    layout->strings = blob + specs_bytes + options_bytes;
+    layout->strings_size = layout->strings_capacity = header.strings_size;
+
+    // Table de chaînes terminée et offsets cohérents (fichier tronqué/corrompu)
+    bool valid = layout->strings[layout->strings_size - 1] == '\0';
+    for (uint32_t i = 0; valid && i < layout->count; i++) {
+        valid = layout_spec_valid(layout, &layout->specs[i]);
+    }
+    for (uint32_t i = 0; valid && i < layout->option_count; i++) {
+        valid = layout->options[i].texte < layout->strings_size &&
+                layout->options[i].callback < layout->strings_size;
+    }
+
+    if (!valid) {
+        debug_printf("⚠️ LAYOUT: cache %s corrompu, ignoré\n", path);
+        widget_layout_free(layout);
+        return false;
+    }
+
+    debug_printf("⚡ LAYOUT: %u widgets chargés depuis le cache (%zu octets)\n",
+                 layout->count, total);
+    return true;
+}
+
+bool widget_layout_cache_save(const char* path, uint64_t json_hash, const WidgetLayout* layout) {
+    char tmp_path[512];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    FILE* file = fopen(tmp_path, "wb");
+    if (!file) {
+        debug_printf("⚠️ LAYOUT: impossible d'écrire %s\n", tmp_path);
+        return false;
+    }
+
+    // Liste sans aucune chaîne : écrire au moins l'entrée "absente"
+    static const char empty_strings[1] = { '\0' };
+    const char* strings = layout->strings_size ? layout->strings : empty_strings;
+    uint32_t strings_size = layout->strings_size ? layout->strings_size : 1;
+
+    LayoutCacheHeader header = {
+        .magic = LAYOUT_CACHE_MAGIC,
+        .version = LAYOUT_CACHE_VERSION,
+        .json_hash = json_hash,
+        .spec_size = sizeof(WidgetSpec),
+        .option_size = sizeof(SelectorOptionSpec),
+        .count = layout->count,
+        .option_count = layout->option_count,
+        .strings_size = strings_size,
+    };
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(layout->specs, sizeof(WidgetSpec), layout->count, file) == layout->count &&
+              fwrite(layout->options, sizeof(SelectorOptionSpec), layout->option_count, file)
+                  == layout->option_count &&
+              fwrite(strings, 1, strings_size, file) == strings_size;
+
+    if (fclose(file) != 0) ok = false;
+
+    if (!ok || rename(tmp_path, path) != 0) {
+        debug_printf("⚠️ LAYOUT: écriture du cache %s échouée\n", path);
+        remove(tmp_path);
+        return false;
+    }
+
+    debug_printf("💾 LAYOUT: cache écrit (%u widgets, %u options, %u octets de chaînes)\n",
+                 layout->count, layout->option_count, strings_size);
+    return true;
+}
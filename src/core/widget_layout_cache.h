@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// widget_layout_cache.h
+// DESCRIPTION COMPILÉE DES WIDGETS + CACHE BINAIRE
+// Le JSON des widgets est d'abord traduit en une liste de WidgetSpec (valeurs
+// déjà validées, défauts appliqués, chaînes dans une table unique), puis les
+// widgets sont construits depuis cette liste. La liste est sauvegardée telle
+// quelle dans un fichier binaire, associée au hash du contenu du JSON : tant
+// que le JSON ne change pas, la création du panneau ne parse plus de JSON.
+
+#ifndef __WIDGET_LAYOUT_CACHE_H__
+#define __WIDGET_LAYOUT_CACHE_H__
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//  TYPES DE WIDGETS DÉCRITS
+typedef enum {
+    WIDGET_SPEC_INCREMENT,
+    WIDGET_SPEC_TOGGLE,
+    WIDGET_SPEC_TITRE,
+    WIDGET_SPEC_SEPARATEUR,
+    WIDGET_SPEC_PREVIEW,
+    WIDGET_SPEC_BUTTON,
+    WIDGET_SPEC_SELECTOR,
+} WidgetSpecType;
+
+//  OPTION D'UN SELECTOR
+typedef struct {
+    uint32_t texte;             // Offsets dans la table de chaînes
+    uint32_t callback;
+} SelectorOptionSpec;
+
+//  DESCRIPTION D'UN WIDGET
+// Les chaînes sont des offsets dans WidgetLayout.strings (0 = absente).
+// Structure écrite telle quelle dans le cache : pas de pointeurs.
+typedef struct {
+    uint32_t type;              // WidgetSpecType
+    uint32_t id;
+    uint32_t label;             // nom_affichage ou texte
+    uint32_t callback;
+    int32_t x;
+    int32_t y;
+
+    union {
+        struct {
+            int32_t min, max, start, step, text_size;
+            uint32_t display_type;
+        } increment;
+        struct {
+            int32_t start_state, width, height, thumb_size, text_size;
+        } toggle;
+        struct {
+            int32_t text_size, alignment, underlined;
+        } titre;
+        struct {
+            int32_t width, thickness;
+            SDL_Color color;
+        } separateur;
+        struct {
+            int32_t frame_size;
+            float size_ratio, breath_duration;
+        } preview;
+        struct {
+            int32_t width, height, text_size, y_anchor;
+            SDL_Color color;
+        } button;
+        struct {
+            int32_t default_index, text_size, submenu_enabled;
+            int32_t seq1_type, seq1_count, seq2_type, seq2_count;
+            uint32_t roller_callback;
+            uint32_t first_option, option_count;
+        } selector;
+    } u;
+} WidgetSpec;
+
+//  LISTE COMPLÈTE
+typedef struct {
+    WidgetSpec* specs;
+    uint32_t count;
+    uint32_t capacity;
+
+    SelectorOptionSpec* options;
+    uint32_t option_count;
+    uint32_t option_capacity;
+
+    char* strings;              // strings[0] = '\0' (chaîne absente)
+    uint32_t strings_size;
+    uint32_t strings_capacity;
+
+    void* blob;                 // Chargé depuis le cache : un seul bloc, les
+                                // trois tableaux pointent dedans
+} WidgetLayout;
+
+//  CONSTRUCTION
+void widget_layout_init(WidgetLayout* layout);
+void widget_layout_free(WidgetLayout* layout);
+
+// Ajoute une description (mise à zéro), NULL si erreur d'allocation
+WidgetSpec* widget_layout_add(WidgetLayout* layout, WidgetSpecType type);
+
+// Ajoute une option de selector, retourne false si erreur d'allocation
+bool widget_layout_add_option(WidgetLayout* layout, const char* texte, const char* callback);
+
+// Copie une chaîne dans la table, retourne son offset (0 si NULL ou erreur)
+uint32_t widget_layout_intern(WidgetLayout* layout, const char* text);
+
+// Chaîne à un offset (NULL si absente)
+static inline const char* widget_layout_string(const WidgetLayout* layout, uint32_t offset) {
+    return (offset && offset < layout->strings_size) ? layout->strings + offset : NULL;
+}
+
+//  CACHE BINAIRE
+// Hash FNV-1a 64 bits du contenu du JSON
+uint64_t widget_layout_hash(const char* data, size_t size);
+
+// Charge le cache s'il correspond au hash ; false si absent, périmé ou invalide
+bool widget_layout_cache_load(const char* path, uint64_t json_hash, WidgetLayout* layout);
+
+// Écrit le cache (fichier temporaire puis rename)
+bool widget_layout_cache_save(const char* path, uint64_t json_hash, const WidgetLayout* layout);
+
+#endif
@@ -4,9 +4,77 @@
 #include "debug.h"
 #include "core/error/error.h"
 #include "core/memory/memory.h"
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
+// Pool des nœuds : le hot reload recrée toute la liste d'un coup
+static ObjectPool widget_node_pool = OBJECT_POOL_INIT("WidgetNode", WidgetNode, 64);
+
+// Compteur global : une liste recréée à la même adresse a une autre génération
+static uint32_t widget_list_generation = 0;
+
+// ═════════════════════════════════════════════════════════════════════════════
+//  INDEX ID → NŒUD
+// ═════════════════════════════════════════════════════════════════════════════
+// Adressage ouvert (sondage linéaire), capacité puissance de 2, rempli au plus
+// à moitié. En cas d'ID dupliqué, le premier nœud ajouté reste indexé, comme
+// avec l'ancien parcours de la liste.
+
+#define WIDGET_INDEX_INITIAL_CAPACITY 64
+
+static uint32_t widget_id_hash(const char* id) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* c = (const unsigned char*)id; *c; c++) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Case de l'ID : celle qui le contient, ou la case vide où l'insérer
+static WidgetNode** widget_index_slot(WidgetNode** index, int capacity, const char* id) {
+    uint32_t mask = (uint32_t)capacity - 1;
+    uint32_t i = widget_id_hash(id) & mask;
+    while (index[i] && strcmp(index[i]->id, id) != 0) {
+        i = (i + 1) & mask;
+    }
+    return &index[i];
+}
+
+// Double la capacité (ou crée l'index) et réinsère tous les nœuds
+static bool widget_index_grow(WidgetList* list) {
+    int capacity = list->index_capacity ? list->index_capacity * 2
+                                        : WIDGET_INDEX_INITIAL_CAPACITY;
+    WidgetNode** index = SAFE_MALLOC(sizeof(WidgetNode*) * capacity);
+    if (!index) return false;
+    memset(index, 0, sizeof(WidgetNode*) * capacity);
+
+    for (int i = 0; i < list->index_capacity; i++) {
+        WidgetNode* node = list->index[i];
+        if (node) *widget_index_slot(index, capacity, node->id) = node;
+    }
+
+    SAFE_FREE(list->index);
+    list->index = index;
+    list->index_capacity = capacity;
+    return true;
+}
+
+static void widget_index_insert(WidgetList* list, WidgetNode* node) {
+    if ((list->count + 1) * 2 > list->index_capacity && !widget_index_grow(list)) {
+        // Index abandonné : find_widget_by_id repasse en recherche linéaire
+        debug_printf("⚠️ Index des widgets désactivé (allocation)\n");
+        SAFE_FREE(list->index);
+        list->index = NULL;
+        list->index_capacity = 0;
+        return;
+    }
+
+    WidgetNode** slot = widget_index_slot(list->index, list->index_capacity, node->id);
+    if (!*slot) *slot = node;
+}
+
 //  CRÉATION D'UNE LISTE DE WIDGETS VIDE
 // Alloue une nouvelle liste vide prête à recevoir des widgets
 WidgetList* create_widget_list(void) {
@@ -20,6 +88,13 @@ WidgetList* create_widget_list(void) {
     list->first = NULL;
     list->last = NULL;
     list->count = 0;
+    list->index = NULL;
+    list->index_capacity = 0;
+    list->generation = ++widget_list_generation;
+    memset(&list->layout_index, 0, sizeof(list->layout_index));
+
+    // Index créé d'avance : un échec ici laisse seulement la recherche linéaire
+    widget_index_grow(list);
 
     debug_printf("✅ Liste de widgets créée\n");
     return list;
@@ -48,7 +123,7 @@ static WidgetNode* init_widget_node_base(WidgetList* list, const char* id,
     CHECK_PTR(id, err, "ID widget NULL");
     CHECK_PTR(display_name, err, "Nom d'affichage NULL");
 
-    WidgetNode* node = SAFE_MALLOC(sizeof(WidgetNode));
+    WidgetNode* node = POOL_ALLOC(widget_node_pool);
     CHECK_ALLOC(node, err, "Erreur allocation nœud widget");
 
     // Initialiser tous les pointeurs à NULL pour cleanup sécurisé
@@ -77,7 +152,7 @@ cleanup:
     if (node) {
         if (node->id) SAFE_FREE(node->id);
         if (node->display_name) SAFE_FREE(node->display_name);
-        SAFE_FREE(node);
+        POOL_FREE(widget_node_pool, node);
     }
     return NULL;
 }
@@ -89,6 +164,13 @@ static void add_node_to_list(WidgetList* list, WidgetNode* node,
     node->next = NULL;
     node->prev = list->last;
 
+    // Indexer avant d'incrémenter count (taux de remplissage)
+    if (list->index || list->count == 0) {
+        widget_index_insert(list, node);
+    }
+    list->generation = ++widget_list_generation;
+    list->layout_index.valid = false;
+
     if (list->last) {
         list->last->next = node;
     } else {
@@ -108,7 +190,7 @@ static void add_node_to_list(WidgetList* list, WidgetNode* node,
             if (node->id) SAFE_FREE(node->id); \
             if (node->display_name) SAFE_FREE(node->display_name); \
             if (node->widget.widget_field) free_func(node->widget.widget_field); \
-            SAFE_FREE(node); \
+            POOL_FREE(widget_node_pool, node); \
         } \
     } while(0)
 
@@ -222,70 +304,189 @@ cleanup:
     return false;
 }
 
-//  RENDU DE TOUS LES WIDGETS (FACTORISATION ✨)
-// Parcourt toute la liste et appelle la fonction de rendu appropriée
-// selon le type de chaque widget
-//
-// PARAMÈTRES :
-//   - renderer : Le renderer SDL
-//   - list : La liste de widgets à afficher
-//   - offset_x, offset_y : Offset du conteneur parent (panneau)
-//   - panel_width : Largeur actuelle du panneau (pour separator responsive)
-void render_all_widgets(SDL_Renderer* renderer, WidgetList* list,
-                       int offset_x, int offset_y, int panel_width, int scroll_offset) {
-    if (!renderer || is_widget_list_empty(list)) return;
+// ═════════════════════════════════════════════════════════════════════════════
+//  INDEX DE DISPOSITION
+// ═════════════════════════════════════════════════════════════════════════════
+// Construit en coordonnées du contenu (offset du panneau et scroll non
+// compris) : l'animation du panneau et le scroll ne l'invalident pas, seul
+// un changement de disposition le fait (widget_list_invalidate_layout).
+
+#define LAYOUT_HIT_SLACK 2          // Marge verticale (tests inclusifs des widgets)
+#define LAYOUT_DRAW_SLACK 16        // Marge du culling (ombres, soulignés, arrondis)
+#define SELECTOR_SUBMENU_HEIGHT 120 // Même valeur que handle_selector_widget_events
+
+static void layout_index_release(WidgetLayoutIndex* index) {
+    SAFE_FREE(index->entries);
+    SAFE_FREE(index->band_start);
+    SAFE_FREE(index->band_entries);
+    SAFE_FREE(index->candidates);
+    memset(index, 0, sizeof(*index));
+}
 
-    // Appliquer le scroll_offset au offset_y
-    int adjusted_offset_y = offset_y - scroll_offset;
+void widget_list_invalidate_layout(WidgetList* list) {
+    if (list) list->layout_index.valid = false;
+}
+
+// Étendue verticale interactive d'un widget (false s'il ne gère pas d'événements)
+static bool hit_entry_extent(const WidgetNode* node, int* y0, int* y1) {
+    int top, bottom;
+
+    switch (node->type) {
+        case WIDGET_TYPE_INCREMENT: {
+            const ConfigWidget* w = node->widget.increment_widget;
+            if (!w) return false;
+            top = w->base.y + (w->roller_rect.y < 0 ? w->roller_rect.y : 0);
+            bottom = w->base.y + w->base.height;
+            if (w->base.y + w->roller_rect.y + w->roller_rect.h > bottom) {
+                bottom = w->base.y + w->roller_rect.y + w->roller_rect.h;
+            }
+            break;
+        }
+
+        case WIDGET_TYPE_TOGGLE: {
+            const ToggleWidget* w = node->widget.toggle_widget;
+            if (!w) return false;
+            top = w->base.y;
+            bottom = w->base.y + w->base.height;
+            if (w->base.y + w->local_toggle_y + w->toggle_height > bottom) {
+                bottom = w->base.y + w->local_toggle_y + w->toggle_height;
+            }
+            break;
+        }
 
-    // ═════════════════════════════════════════════════════════════════════════
-    // ÉTAPE 1 : PRÉ-CALCUL DES GROUPES DE WIDGETS INCREMENT
-    // ═════════════════════════════════════════════════════════════════════════
-    // On regroupe les widgets INCREMENT proches verticalement
-    // et on trouve le plus long nom dans chaque groupe pour aligner les flèches
+        case WIDGET_TYPE_BUTTON: {
+            const ButtonWidget* w = node->widget.button_widget;
+            if (!w) return false;
+            top = w->base.y;
+            bottom = w->base.y + w->base.height;
+            break;
+        }
+
+        case WIDGET_TYPE_SELECTOR: {
+            const SelectorWidget* w = node->widget.selector_widget;
+            if (!w) return false;
+            top = w->base.y;
+            bottom = w->base.y + w->base.height;
+
+            // Flèches et valeur peuvent déborder de la boîte
+            const SDL_Rect* rects[] = { &w->left_arrow_rect, &w->right_arrow_rect, &w->value_rect };
+            for (int i = 0; i < 3; i++) {
+                if (w->base.y + rects[i]->y < top) top = w->base.y + rects[i]->y;
+                if (w->base.y + rects[i]->y + rects[i]->h > bottom) {
+                    bottom = w->base.y + rects[i]->y + rects[i]->h;
+                }
+            }
+
+            // Sous-menu : toujours compté ouvert (son animation ne reconstruit pas l'index)
+            if (w->submenu_enabled) bottom = w->base.y + w->base.height + SELECTOR_SUBMENU_HEIGHT;
+            break;
+        }
+
+        // Labels, séparateurs, preview : aucun événement
+        default:
+            return false;
+    }
 
-    // Si l'écart entre deux widgets > seuil, c'est un nouveau groupe
-    // Espacement dans JSON = 30px, donc on utilise ce seuil
+    *y0 = top - LAYOUT_HIT_SLACK;
+    *y1 = bottom + LAYOUT_HIT_SLACK;
+    return true;
+}
+
+// Étendue verticale dessinée d'un widget (false si le widget est absent)
+static bool draw_entry_extent(const WidgetNode* node, int* y0, int* y1) {
+    int top, bottom;
+
+    switch (node->type) {
+        case WIDGET_TYPE_LABEL: {
+            const LabelWidget* w = node->widget.label_widget;
+            if (!w) return false;
+            // Hauteur connue après le premier rendu ; avant, celle de la police
+            // (hauteur des surfaces de TTF_RenderUTF8_Blended)
+            int height = w->base.height;
+            if (height <= 0) {
+                TTF_Font* font = get_font_for_size(w->current_text_size);
+                height = font ? TTF_FontHeight(font) : w->current_text_size * 2;
+            }
+            top = w->base.y;
+            bottom = w->base.y + height;
+            break;
+        }
+
+        case WIDGET_TYPE_SEPARATOR: {
+            const SeparatorWidget* w = node->widget.separator_widget;
+            if (!w) return false;
+            top = w->base.y;
+            bottom = w->base.y + (w->thickness > w->base.height ? w->thickness : w->base.height);
+            break;
+        }
+
+        case WIDGET_TYPE_PREVIEW: {
+            const PreviewWidget* w = node->widget.preview_widget;
+            if (!w) return false;
+            top = w->base.y;
+            bottom = w->base.y + (w->container_size > w->base.height ? w->container_size
+                                                                     : w->base.height);
+            break;
+        }
+
+        // Widgets interactifs : l'étendue du hit-test couvre ce qu'ils dessinent
+        default:
+            if (!hit_entry_extent(node, &top, &bottom)) return false;
+            break;
+    }
+
+    *y0 = top - LAYOUT_DRAW_SLACK;
+    *y1 = bottom + LAYOUT_DRAW_SLACK;
+    return true;
+}
+
+// Première bande couverte par une entrée (hit-test et dessin confondus)
+static int layout_entry_first_band(const WidgetLayoutEntry* entry) {
+    int top = entry->y0 < entry->draw_y0 ? entry->y0 : entry->draw_y0;
+    return top < 0 ? 0 : top / WIDGET_LAYOUT_BAND;
+}
+
+static int layout_entry_last_band(const WidgetLayoutEntry* entry) {
+    int bottom = entry->y1 > entry->draw_y1 ? entry->y1 : entry->draw_y1;
+    return bottom < 0 ? 0 : bottom / WIDGET_LAYOUT_BAND;
+}
+
+// Largeur de conteneur de chaque INCREMENT (alignement des rollers par groupe).
+// Mesure les textes : fait une fois par reconstruction et non plus à chaque
+// événement ni à chaque image.
+static void layout_index_group_widths(WidgetLayoutIndex* index) {
     const int GROUP_SPACING_THRESHOLD = 30;
 
-    // Structure pour stocker les infos des widgets INCREMENT
     typedef struct {
-        ConfigWidget* widget;
+        WidgetLayoutEntry* entry;
         int y_position;
         int text_width;
         int group_id;
-        int max_text_width_in_group;
-        int container_width_for_group;  // Largeur totale du widget le plus long
     } IncrementInfo;
 
-    IncrementInfo increment_infos[50];  // Max 50 widgets INCREMENT
+    IncrementInfo increment_infos[50];
     int increment_count = 0;
 
     // Premier passage : collecter tous les widgets INCREMENT
-    WidgetNode* node = list->first;
-    while (node && increment_count < 50) {
-        if (node->type == WIDGET_TYPE_INCREMENT && node->widget.increment_widget) {
-            ConfigWidget* w = node->widget.increment_widget;
-
-            // Mesurer la largeur du texte actuel (avec taille de police actuelle)
-            TTF_Font* font = get_font_for_size(w->current_text_size);
-            int text_width = 0;
-            if (font) {
-                TTF_SizeUTF8(font, w->option_name, &text_width, NULL);
-            }
-
-            increment_infos[increment_count].widget = w;
-            increment_infos[increment_count].y_position = w->base.y;
-            increment_infos[increment_count].text_width = text_width;
-            increment_infos[increment_count].group_id = -1;
-            increment_infos[increment_count].max_text_width_in_group = 0;
-            increment_infos[increment_count].container_width_for_group = 0;
-            increment_count++;
+    for (int i = 0; i < index->entry_count && increment_count < 50; i++) {
+        WidgetLayoutEntry* entry = &index->entries[i];
+        if (entry->node->type != WIDGET_TYPE_INCREMENT) continue;
+
+        ConfigWidget* w = entry->node->widget.increment_widget;
+        TTF_Font* font = get_font_for_size(w->current_text_size);
+        int text_width = 0;
+        if (font) {
+            TTF_SizeUTF8(font, w->option_name, &text_width, NULL);
         }
-        node = node->next;
+
+        increment_infos[increment_count].entry = entry;
+        increment_infos[increment_count].y_position = w->base.y;
+        increment_infos[increment_count].text_width = text_width;
+        increment_infos[increment_count].group_id = -1;
+        increment_count++;
     }
 
-    // Deuxième passage : trier par position Y pour faciliter le regroupement
+    // Deuxième passage : trier par position Y
     for (int i = 0; i < increment_count - 1; i++) {
         for (int j = i + 1; j < increment_count; j++) {
             if (increment_infos[j].y_position < increment_infos[i].y_position) {
@@ -300,11 +501,9 @@ void render_all_widgets(SDL_Renderer* renderer, WidgetList* list,
     int current_group = 0;
     for (int i = 0; i < increment_count; i++) {
         if (increment_infos[i].group_id == -1) {
-            // Nouveau groupe
             increment_infos[i].group_id = current_group;
             int last_y = increment_infos[i].y_position;
 
-            // Trouver tous les widgets proches qui suivent (maintenant triés par Y)
             for (int j = i + 1; j < increment_count; j++) {
                 int y_diff = increment_infos[j].y_position - last_y;
                 if (y_diff > 0 && y_diff <= GROUP_SPACING_THRESHOLD &&
@@ -317,124 +516,328 @@ void render_all_widgets(SDL_Renderer* renderer, WidgetList* list,
         }
     }
 
-    // Quatrième passage : calculer container_width pour chaque groupe
-    // On utilise le local_arrows_x + arrow_size + espace + valeur du widget le plus long
+    // Quatrième passage : container_width du plus long nom de chaque groupe
     for (int g = 0; g < current_group; g++) {
         int max_text_width = 0;
         ConfigWidget* longest_widget = NULL;
 
-        // Trouver le widget avec le texte le plus long dans ce groupe
         for (int i = 0; i < increment_count; i++) {
             if (increment_infos[i].group_id == g && increment_infos[i].text_width > max_text_width) {
                 max_text_width = increment_infos[i].text_width;
-                longest_widget = increment_infos[i].widget;
+                longest_widget = increment_infos[i].entry->node->widget.increment_widget;
             }
         }
 
-        // Calculer le container_width basé sur le widget le plus long
         int container_width = 0;
         if (longest_widget) {
-            // Utiliser local_roller_x (qui inclut texte + espace après texte)
-            // + largeur du roller + RIGHT_MARGIN pour alignement à droite
             container_width = longest_widget->local_roller_x +
                             longest_widget->roller_width +
                             10;  // RIGHT_MARGIN (cohérent avec calculate_roller_x_offset)
         }
 
-        // Appliquer cette largeur et max_text_width à tous les widgets du groupe
         for (int i = 0; i < increment_count; i++) {
             if (increment_infos[i].group_id == g) {
-                increment_infos[i].max_text_width_in_group = max_text_width;
-                increment_infos[i].container_width_for_group = container_width;
+                increment_infos[i].entry->container_width = container_width;
             }
         }
     }
+}
 
-    // ═════════════════════════════════════════════════════════════════════════
-    // ÉTAPE 2 : RENDU DE TOUS LES WIDGETS
-    // ═════════════════════════════════════════════════════════════════════════
+// Reconstruit l'index ; false si allocation impossible (dispatch à tous)
+static bool layout_index_rebuild(WidgetList* list) {
+    WidgetLayoutIndex* index = &list->layout_index;
+    layout_index_release(index);
 
-    node = list->first;
-    while (node) {
-        // ─────────────────────────────────────────────────────────────────────
-        // SWITCH sur le type de widget
-        // ─────────────────────────────────────────────────────────────────────
-        switch (node->type) {
-            case WIDGET_TYPE_INCREMENT:
-                if (node->widget.increment_widget) {
-                    // Trouver le container_width pour ce widget (basé sur son groupe)
-                    int container_width = 0;
-                    for (int i = 0; i < increment_count; i++) {
-                        if (increment_infos[i].widget == node->widget.increment_widget) {
-                            container_width = increment_infos[i].container_width_for_group;
-                            break;
-                        }
-                    }
-
-                    render_config_widget(renderer, node->widget.increment_widget,
-                                       offset_x, adjusted_offset_y, container_width);
-                }
-                break;
+    if (list->count == 0) {
+        index->valid = true;
+        return true;
+    }
 
-            case WIDGET_TYPE_TOGGLE:
-                if (node->widget.toggle_widget) {
-                    render_toggle_widget(renderer, node->widget.toggle_widget,
-                                       offset_x, adjusted_offset_y);
-                }
-                break;
+    index->entries = SAFE_MALLOC(sizeof(WidgetLayoutEntry) * list->count);
+    index->candidates = SAFE_MALLOC(sizeof(int) * list->count);
+    if (!index->entries || !index->candidates) goto fail;
+
+    // Tous les widgets, dans l'ordre de la liste
+    int max_band = 0;
+    for (WidgetNode* node = list->first; node; node = node->next) {
+        int draw_y0, draw_y1;
+        if (!draw_entry_extent(node, &draw_y0, &draw_y1)) continue;
+
+        WidgetLayoutEntry* entry = &index->entries[index->entry_count++];
+        entry->node = node;
+        entry->draw_y0 = draw_y0;
+        entry->draw_y1 = draw_y1;
+        entry->interactive = hit_entry_extent(node, &entry->y0, &entry->y1);
+        if (!entry->interactive) {
+            entry->y0 = draw_y0;
+            entry->y1 = draw_y1;
+        }
+        entry->container_width = 0;
+        // Premier mouvement : tous les interactifs (survols à effacer)
+        entry->hot = entry->interactive;
 
-            case WIDGET_TYPE_LABEL:
-                if (node->widget.label_widget) {
-                    render_label_widget(renderer, node->widget.label_widget,
-                                       offset_x, adjusted_offset_y);
-                }
-                break;
+        int last = layout_entry_last_band(entry);
+        if (last > max_band) max_band = last;
+    }
 
-            case WIDGET_TYPE_SEPARATOR:
-                if (node->widget.separator_widget) {
-                    // Utiliser la largeur dynamique du panneau pour le responsive
-                    render_separator_widget(renderer, node->widget.separator_widget,
-                                          offset_x, adjusted_offset_y, panel_width);
-                }
-                break;
+    layout_index_group_widths(index);
 
-            case WIDGET_TYPE_PREVIEW:
-                if (node->widget.preview_widget) {
-                    render_preview_widget(renderer, node->widget.preview_widget,
-                                        offset_x, adjusted_offset_y);
-                }
-                break;
+    // Bandes : comptage puis remplissage (tableaux compacts)
+    index->band_count = max_band + 1;
+    index->band_start = SAFE_MALLOC(sizeof(int) * (index->band_count + 1));
+    if (!index->band_start) goto fail;
+    memset(index->band_start, 0, sizeof(int) * (index->band_count + 1));
 
-            case WIDGET_TYPE_BUTTON:
-                if (node->widget.button_widget) {
-                    render_button_widget(renderer, node->widget.button_widget,
-                                       offset_x, adjusted_offset_y);
-                }
-                break;
+    int total = 0;
+    for (int i = 0; i < index->entry_count; i++) {
+        int first = layout_entry_first_band(&index->entries[i]);
+        int last = layout_entry_last_band(&index->entries[i]);
+        for (int band = first; band <= last; band++) {
+            index->band_start[band + 1]++;
+        }
+        total += last - first + 1;
+    }
+    for (int band = 0; band < index->band_count; band++) {
+        index->band_start[band + 1] += index->band_start[band];
+    }
 
-            case WIDGET_TYPE_SLIDER:
-                // TODO: À implémenter plus tard
-                break;
+    index->band_entries = SAFE_MALLOC(sizeof(int) * (total ? total : 1));
+    if (!index->band_entries) goto fail;
 
-            case WIDGET_TYPE_SELECTOR:
-                if (node->widget.selector_widget) {
-                    render_selector_widget(renderer, node->widget.selector_widget,
-                                         offset_x, adjusted_offset_y);
-                }
-                break;
+    int* fill = index->candidates;  // Curseurs de remplissage temporaires
+    if (index->band_count > list->count) {
+        fill = SAFE_MALLOC(sizeof(int) * index->band_count);
+        if (!fill) goto fail;
+    }
+    memcpy(fill, index->band_start, sizeof(int) * index->band_count);
 
-            default:
-                debug_printf("❌ Type de widget inconnu: %d\n", node->type);
-                break;
+    for (int i = 0; i < index->entry_count; i++) {
+        int first = layout_entry_first_band(&index->entries[i]);
+        int last = layout_entry_last_band(&index->entries[i]);
+        for (int band = first; band <= last; band++) {
+            index->band_entries[fill[band]++] = i;
         }
+    }
+    if (fill != index->candidates) SAFE_FREE(fill);
 
-        node = node->next;
+    index->valid = true;
+    debug_verbose("🎯 Index de disposition : %d widget(s), %d bande(s)\n",
+                  index->entry_count, index->band_count);
+    return true;
+
+fail:
+    debug_printf("⚠️ Index de disposition non construit (allocation)\n");
+    layout_index_release(index);
+    return false;
+}
+
+// Ajoute aux candidats les entrées interactives dont l'étendue contient y,
+// sans doublon. Les entrées des bandes sont en ordre croissant : la fusion
+// garde l'ordre de la liste.
+static int layout_index_hits(WidgetLayoutIndex* index, int y, int* out, int count) {
+    if (y < 0) return count;
+    int band = y / WIDGET_LAYOUT_BAND;
+    if (band >= index->band_count) return count;
+
+    for (int k = index->band_start[band]; k < index->band_start[band + 1]; k++) {
+        int i = index->band_entries[k];
+        if (!index->entries[i].interactive) continue;
+        if (y < index->entries[i].y0 || y > index->entries[i].y1) continue;
+
+        bool present = false;
+        for (int c = 0; c < count && !present; c++) present = (out[c] == i);
+        if (!present) out[count++] = i;
+    }
+    return count;
+}
+
+// Entrées dont l'étendue dessinée coupe [top, bottom], dans l'ordre de la liste.
+// Une entrée présente dans plusieurs bandes n'est prise que dans la première
+// bande parcourue qui la contient.
+static int layout_index_visible(WidgetLayoutIndex* index, int top, int bottom, int* out) {
+    int first = top < 0 ? 0 : top / WIDGET_LAYOUT_BAND;
+    int last = bottom / WIDGET_LAYOUT_BAND;
+    if (last >= index->band_count) last = index->band_count - 1;
+
+    int count = 0;
+    for (int band = first; band <= last; band++) {
+        for (int k = index->band_start[band]; k < index->band_start[band + 1]; k++) {
+            int i = index->band_entries[k];
+            const WidgetLayoutEntry* entry = &index->entries[i];
+            if (entry->draw_y1 < top || entry->draw_y0 > bottom) continue;
+
+            int entry_first = layout_entry_first_band(entry);
+            if (band != (entry_first > first ? entry_first : first)) continue;
+            out[count++] = i;
+        }
+    }
+
+    // Tri par insertion : peu de widgets visibles, déjà presque ordonnés
+    for (int c = 1; c < count; c++) {
+        int value = out[c];
+        int d = c - 1;
+        while (d >= 0 && out[d] > value) {
+            out[d + 1] = out[d];
+            d--;
+        }
+        out[d + 1] = value;
+    }
+    return count;
+}
+
+// Dessine un widget selon son type
+static void draw_widget_node(SDL_Renderer* renderer, WidgetNode* node, int offset_x,
+                             int adjusted_offset_y, int panel_width, int container_width) {
+    switch (node->type) {
+        case WIDGET_TYPE_INCREMENT:
+            render_config_widget(renderer, node->widget.increment_widget,
+                               offset_x, adjusted_offset_y, container_width);
+            break;
+
+        case WIDGET_TYPE_TOGGLE:
+            render_toggle_widget(renderer, node->widget.toggle_widget,
+                               offset_x, adjusted_offset_y);
+            break;
+
+        case WIDGET_TYPE_LABEL:
+            render_label_widget(renderer, node->widget.label_widget,
+                               offset_x, adjusted_offset_y);
+            break;
+
+        case WIDGET_TYPE_SEPARATOR:
+            // Utiliser la largeur dynamique du panneau pour le responsive
+            render_separator_widget(renderer, node->widget.separator_widget,
+                                  offset_x, adjusted_offset_y, panel_width);
+            break;
+
+        case WIDGET_TYPE_PREVIEW:
+            render_preview_widget(renderer, node->widget.preview_widget,
+                                offset_x, adjusted_offset_y);
+            break;
+
+        case WIDGET_TYPE_BUTTON:
+            render_button_widget(renderer, node->widget.button_widget,
+                               offset_x, adjusted_offset_y);
+            break;
+
+        case WIDGET_TYPE_SLIDER:
+            // TODO: À implémenter plus tard
+            break;
+
+        case WIDGET_TYPE_SELECTOR:
+            render_selector_widget(renderer, node->widget.selector_widget,
+                                 offset_x, adjusted_offset_y);
+            break;
+
+        default:
+            debug_printf("❌ Type de widget inconnu: %d\n", node->type);
+            break;
+    }
+}
+
+// Transmet l'événement à un widget selon son type
+static void dispatch_widget_event(WidgetNode* node, SDL_Event* event, int offset_x,
+                                  int adjusted_offset_y, int container_width) {
+    switch (node->type) {
+        case WIDGET_TYPE_INCREMENT:
+            handle_config_widget_events(node->widget.increment_widget,
+                                      event, offset_x, adjusted_offset_y, container_width);
+            break;
+
+        case WIDGET_TYPE_TOGGLE:
+            handle_toggle_widget_events(node->widget.toggle_widget,
+                                      event, offset_x, adjusted_offset_y);
+            break;
+
+        case WIDGET_TYPE_BUTTON:
+            handle_button_widget_events(node->widget.button_widget,
+                                      event, offset_x, adjusted_offset_y);
+            break;
+
+        case WIDGET_TYPE_SELECTOR:
+            handle_selector_widget_events(node->widget.selector_widget,
+                                         event, offset_x, adjusted_offset_y);
+            break;
+
+        // Les autres widgets ne gèrent pas d'événements (jamais candidats)
+        default:
+            break;
+    }
+}
+
+//  RENDU DE TOUS LES WIDGETS (FACTORISATION ✨)
+// Ne dessine que les widgets dont l'étendue (index de disposition) coupe la
+// zone visible : le rectangle de clipping du renderer s'il est actif, sinon
+// toute la sortie. Le coût suit le nombre de widgets visibles et non la
+// longueur du JSON.
+//
+// PARAMÈTRES :
+//   - renderer : Le renderer SDL
+//   - list : La liste de widgets à afficher
+//   - offset_x, offset_y : Offset du conteneur parent (panneau)
+//   - panel_width : Largeur actuelle du panneau (pour separator responsive)
+//   - scroll_offset : Décalage vertical du scroll
+void render_all_widgets(SDL_Renderer* renderer, WidgetList* list,
+                       int offset_x, int offset_y, int panel_width, int scroll_offset) {
+    if (!renderer || is_widget_list_empty(list)) return;
+
+    // Appliquer le scroll_offset au offset_y
+    int adjusted_offset_y = offset_y - scroll_offset;
+
+    WidgetLayoutIndex* index = &list->layout_index;
+    if (!index->valid && !layout_index_rebuild(list)) {
+        // Sans index : tous les widgets (alignement des INCREMENT non calculé)
+        for (WidgetNode* node = list->first; node; node = node->next) {
+            int y0, y1;
+            if (draw_entry_extent(node, &y0, &y1)) {
+                draw_widget_node(renderer, node, offset_x, adjusted_offset_y, panel_width, 0);
+            }
+        }
+        return;
+    }
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // ZONE VISIBLE (coordonnées du contenu)
+    // ─────────────────────────────────────────────────────────────────────────
+    SDL_Rect visible = {0, 0, 0, 0};
+    if (SDL_RenderIsClipEnabled(renderer)) {
+        SDL_RenderGetClipRect(renderer, &visible);
+    } else if (SDL_GetRendererOutputSize(renderer, &visible.w, &visible.h) != 0) {
+        visible.h = INT_MAX / 2;    // Taille inconnue : pas de culling
+    }
+    if (visible.h <= 0) return;
+
+    int top = visible.y - adjusted_offset_y;
+    int bottom = top + visible.h - 1;
+
+    // ─────────────────────────────────────────────────────────────────────────
+    // RENDU DES WIDGETS VISIBLES
+    // ─────────────────────────────────────────────────────────────────────────
+    int count = layout_index_visible(index, top, bottom, index->candidates);
+    for (int c = 0; c < count; c++) {
+        WidgetLayoutEntry* entry = &index->entries[index->candidates[c]];
+        draw_widget_node(renderer, entry->node, offset_x, adjusted_offset_y,
+                         panel_width, entry->container_width);
+
+        // Un label mesure sa hauteur au rendu (premier rendu, rescale) : si elle
+        // diffère de celle de l'index, il est reconstruit à la prochaine image
+        if (entry->node->type == WIDGET_TYPE_LABEL) {
+            int y0, y1;
+            if (draw_entry_extent(entry->node, &y0, &y1) && y1 != entry->draw_y1) {
+                widget_list_invalidate_layout(list);
+            }
+        }
     }
 }
 
 //  GESTION DES ÉVÉNEMENTS POUR TOUS LES WIDGETS (FACTORISATION ✨)
-// Parcourt toute la liste et transmet l'événement à chaque widget
-// selon son type
+// Transmet l'événement aux seuls widgets concernés, trouvés via l'index :
+//   - Mouvement : widgets sous le curseur + ceux du mouvement précédent
+//     (pour qu'ils effacent leur survol)
+//   - Clic : widgets sous le clic + ceux du dernier mouvement (le survol
+//     décide du clic pour les toggles et boutons)
+//   - Molette : widgets du dernier mouvement (seuls à pouvoir être survolés)
+//   - Autres événements : tous les widgets interactifs
 //
 // PARAMÈTRES :
 //   - list : La liste de widgets
@@ -445,170 +848,62 @@ void handle_widget_list_events(WidgetList* list, SDL_Event* event,
                                int offset_x, int offset_y, int scroll_offset) {
     if (is_widget_list_empty(list) || !event) return;
 
-    // ═════════════════════════════════════════════════════════════════════════
-    // APPLIQUER LE SCROLL À L'OFFSET VERTICAL
-    // ═════════════════════════════════════════════════════════════════════════
     // IMPORTANT : Le rendu utilise (offset_y - scroll_offset), donc la détection
     // de collision doit utiliser la MÊME formule pour que les zones cliquables
     // correspondent exactement aux zones rendues à l'écran !
     int adjusted_offset_y = offset_y - scroll_offset;
 
-    // ═════════════════════════════════════════════════════════════════════════
-    // ÉTAPE 1 : PRÉ-CALCUL DES GROUPES DE WIDGETS INCREMENT (même logique que render)
-    // ═════════════════════════════════════════════════════════════════════════
-    const int GROUP_SPACING_THRESHOLD = 30;
-
-    typedef struct {
-        ConfigWidget* widget;
-        int y_position;
-        int text_width;
-        int group_id;
-        int max_text_width_in_group;
-        int container_width_for_group;
-    } IncrementInfo;
-
-    IncrementInfo increment_infos[50];
-    int increment_count = 0;
-
-    // Premier passage : collecter tous les widgets INCREMENT
-    WidgetNode* node = list->first;
-    while (node && increment_count < 50) {
-        if (node->type == WIDGET_TYPE_INCREMENT && node->widget.increment_widget) {
-            ConfigWidget* w = node->widget.increment_widget;
-
-            TTF_Font* font = get_font_for_size(w->current_text_size);
-            int text_width = 0;
-            if (font) {
-                TTF_SizeUTF8(font, w->option_name, &text_width, NULL);
+    WidgetLayoutIndex* index = &list->layout_index;
+    if (!index->valid && !layout_index_rebuild(list)) {
+        // Sans index : ancien comportement, tous les widgets (alignement non calculé)
+        for (WidgetNode* node = list->first; node; node = node->next) {
+            int y0, y1;
+            if (hit_entry_extent(node, &y0, &y1)) {
+                dispatch_widget_event(node, event, offset_x, adjusted_offset_y, 0);
             }
-
-            increment_infos[increment_count].widget = w;
-            increment_infos[increment_count].y_position = w->base.y;
-            increment_infos[increment_count].text_width = text_width;
-            increment_infos[increment_count].group_id = -1;
-            increment_infos[increment_count].max_text_width_in_group = 0;
-            increment_infos[increment_count].container_width_for_group = 0;
-            increment_count++;
         }
-        node = node->next;
+        return;
     }
 
-    // Deuxième passage : trier par position Y
-    for (int i = 0; i < increment_count - 1; i++) {
-        for (int j = i + 1; j < increment_count; j++) {
-            if (increment_infos[j].y_position < increment_infos[i].y_position) {
-                IncrementInfo temp = increment_infos[i];
-                increment_infos[i] = increment_infos[j];
-                increment_infos[j] = temp;
-            }
-        }
-    }
+    // ─────────────────────────────────────────────────────────────────────────
+    // SÉLECTION DES CANDIDATS
+    // ─────────────────────────────────────────────────────────────────────────
+    int* candidates = index->candidates;
+    int count = 0;
+    bool is_motion = (event->type == SDL_MOUSEMOTION);
 
-    // Troisième passage : regrouper par proximité verticale
-    int current_group = 0;
-    for (int i = 0; i < increment_count; i++) {
-        if (increment_infos[i].group_id == -1) {
-            increment_infos[i].group_id = current_group;
-            int last_y = increment_infos[i].y_position;
-
-            for (int j = i + 1; j < increment_count; j++) {
-                int y_diff = increment_infos[j].y_position - last_y;
-                if (y_diff > 0 && y_diff <= GROUP_SPACING_THRESHOLD &&
-                    increment_infos[j].group_id == -1) {
-                    increment_infos[j].group_id = current_group;
-                    last_y = increment_infos[j].y_position;
-                }
-            }
-            current_group++;
+    if (is_motion || event->type == SDL_MOUSEBUTTONDOWN || event->type == SDL_MOUSEWHEEL) {
+        for (int i = 0; i < index->entry_count; i++) {
+            if (index->entries[i].hot) candidates[count++] = i;
         }
-    }
-
-    // Quatrième passage : calculer container_width pour chaque groupe
-    for (int g = 0; g < current_group; g++) {
-        int max_text_width = 0;
-        ConfigWidget* longest_widget = NULL;
-
-        for (int i = 0; i < increment_count; i++) {
-            if (increment_infos[i].group_id == g && increment_infos[i].text_width > max_text_width) {
-                max_text_width = increment_infos[i].text_width;
-                longest_widget = increment_infos[i].widget;
-            }
-        }
-
-        int container_width = 0;
-        if (longest_widget) {
-            container_width = longest_widget->local_roller_x +
-                            longest_widget->roller_width +
-                            10;  // RIGHT_MARGIN (cohérent avec render_all_widgets)
+        if (is_motion) {
+            count = layout_index_hits(index, event->motion.y - adjusted_offset_y, candidates, count);
+        } else if (event->type == SDL_MOUSEBUTTONDOWN) {
+            count = layout_index_hits(index, event->button.y - adjusted_offset_y, candidates, count);
         }
-
-        for (int i = 0; i < increment_count; i++) {
-            if (increment_infos[i].group_id == g) {
-                increment_infos[i].max_text_width_in_group = max_text_width;
-                increment_infos[i].container_width_for_group = container_width;
-            }
+    } else {
+        for (int i = 0; i < index->entry_count; i++) {
+            if (index->entries[i].interactive) candidates[count++] = i;
         }
     }
 
-    // ═════════════════════════════════════════════════════════════════════════
-    // ÉTAPE 2 : TRAITEMENT DES ÉVÉNEMENTS
-    // ═════════════════════════════════════════════════════════════════════════
-
-    node = list->first;
-    while (node) {
-        // ─────────────────────────────────────────────────────────────────────
-        // SWITCH sur le type de widget
-        // ─────────────────────────────────────────────────────────────────────
-        switch (node->type) {
-            case WIDGET_TYPE_INCREMENT:
-                if (node->widget.increment_widget) {
-                    // Trouver le container_width pour ce widget (basé sur son groupe)
-                    int container_width = 0;
-                    for (int i = 0; i < increment_count; i++) {
-                        if (increment_infos[i].widget == node->widget.increment_widget) {
-                            container_width = increment_infos[i].container_width_for_group;
-                            break;
-                        }
-                    }
-
-                    handle_config_widget_events(node->widget.increment_widget,
-                                              event, offset_x, adjusted_offset_y, container_width);
-                }
-                break;
-
-            case WIDGET_TYPE_TOGGLE:
-                if (node->widget.toggle_widget) {
-                    handle_toggle_widget_events(node->widget.toggle_widget,
-                                              event, offset_x, adjusted_offset_y);
-                }
-                break;
-
-            case WIDGET_TYPE_BUTTON:
-                if (node->widget.button_widget) {
-                    handle_button_widget_events(node->widget.button_widget,
-                                              event, offset_x, adjusted_offset_y);
-                }
-                break;
-
-            case WIDGET_TYPE_SELECTOR:
-                if (node->widget.selector_widget) {
-                    handle_selector_widget_events(node->widget.selector_widget,
-                                                 event, offset_x, adjusted_offset_y);
-                }
-                break;
+    // ─────────────────────────────────────────────────────────────────────────
+    // TRAITEMENT DES ÉVÉNEMENTS
+    // ─────────────────────────────────────────────────────────────────────────
+    if (is_motion) {
+        for (int i = 0; i < index->entry_count; i++) index->entries[i].hot = false;
+    }
 
-            // Les autres widgets ne gèrent pas d'événements
-            case WIDGET_TYPE_LABEL:
-            case WIDGET_TYPE_SEPARATOR:
-            case WIDGET_TYPE_PREVIEW:
-            case WIDGET_TYPE_SLIDER:
-                break;
+    for (int c = 0; c < count; c++) {
+        WidgetLayoutEntry* entry = &index->entries[candidates[c]];
+        dispatch_widget_event(entry->node, event, offset_x, adjusted_offset_y,
+                              entry->container_width);
 
-            default:
-                break;
+        // Reste "chaud" tant que le curseur est dans son étendue
+        if (is_motion) {
+            int y = event->motion.y - adjusted_offset_y;
+            entry->hot = (y >= entry->y0 && y <= entry->y1);
         }
-
-        node = node->next;
     }
 }
 
@@ -664,6 +959,14 @@ void update_widget_list_animations(WidgetList* list, float delta_time) {
 WidgetNode* find_widget_by_id(WidgetList* list, const char* id) {
     if (is_widget_list_empty(list) || !id) return NULL;
 
+    if (list->index) {
+        WidgetNode* found = *widget_index_slot(list->index, list->index_capacity, id);
+        if (found) return found;
+
+        debug_printf("⚠️ Widget '%s' non trouvé dans la liste\n", id);
+        return NULL;
+    }
+
     WidgetNode* node = list->first;
     while (node) {
         if (strcmp(node->id, id) == 0) {
@@ -682,11 +985,8 @@ WidgetNode* find_widget_by_id(WidgetList* list, const char* id) {
 // RETOURNE :
 //   - true si succès (valeur stockée dans out_value)
 //   - false si échec (widget non trouvé ou mauvais type)
-bool get_widget_int_value(WidgetList* list, const char* id, int* out_value) {
-    if (!out_value) return false;
-
-    WidgetNode* node = find_widget_by_id(list, id);
-    if (!node) return false;
+bool get_widget_node_int_value(const WidgetNode* node, int* out_value) {
+    if (!node || !out_value) return false;
 
     // Gérer les widgets INCREMENT
     if (node->type == WIDGET_TYPE_INCREMENT) {
@@ -702,24 +1002,26 @@ bool get_widget_int_value(WidgetList* list, const char* id, int* out_value) {
         return true;
     }
 
-    debug_printf("❌ Widget '%s' n'est ni INCREMENT ni SELECTOR\n", id);
+    debug_printf("❌ Widget '%s' n'est ni INCREMENT ni SELECTOR\n", node->id);
     return false;
 }
 
+bool get_widget_int_value(WidgetList* list, const char* id, int* out_value) {
+    if (!out_value) return false;
+    return get_widget_node_int_value(find_widget_by_id(list, id), out_value);
+}
+
 //  RÉCUPÉRATION DE LA VALEUR BOOL D'UN WIDGET
 // Récupère l'état actuel d'un widget TOGGLE
 //
 // RETOURNE :
 //   - true si succès (état stocké dans out_value)
 //   - false si échec
-bool get_widget_bool_value(WidgetList* list, const char* id, bool* out_value) {
-    if (!out_value) return false;
-
-    WidgetNode* node = find_widget_by_id(list, id);
-    if (!node) return false;
+bool get_widget_node_bool_value(const WidgetNode* node, bool* out_value) {
+    if (!node || !out_value) return false;
 
     if (node->type != WIDGET_TYPE_TOGGLE) {
-        debug_printf("❌ Widget '%s' n'est pas de type TOGGLE\n", id);
+        debug_printf("❌ Widget '%s' n'est pas de type TOGGLE\n", node->id);
         return false;
     }
 
@@ -729,6 +1031,11 @@ bool get_widget_bool_value(WidgetList* list, const char* id, bool* out_value) {
     return true;
 }
 
+bool get_widget_bool_value(WidgetList* list, const char* id, bool* out_value) {
+    if (!out_value) return false;
+    return get_widget_node_bool_value(find_widget_by_id(list, id), out_value);
+}
+
 //  MODIFICATION DE LA VALEUR INT D'UN WIDGET
 // Change la valeur d'un widget INCREMENT par programmation
 // (sans interaction utilisateur)
@@ -736,8 +1043,7 @@ bool get_widget_bool_value(WidgetList* list, const char* id, bool* out_value) {
 // RETOURNE :
 //   - true si succès
 //   - false si échec
-bool set_widget_int_value(WidgetList* list, const char* id, int new_value) {
-    WidgetNode* node = find_widget_by_id(list, id);
+bool set_widget_node_int_value(WidgetNode* node, int new_value) {
     if (!node) return false;
 
     // Gérer les widgets INCREMENT
@@ -749,12 +1055,12 @@ bool set_widget_int_value(WidgetList* list, const char* id, int new_value) {
         // Vérifier les limites
         if (new_value < widget->min_value || new_value > widget->max_value) {
             debug_printf("⚠️ Valeur %d hors limites pour '%s' [%d, %d]\n",
-                         new_value, id, widget->min_value, widget->max_value);
+                         new_value, node->id, widget->min_value, widget->max_value);
             return false;
         }
 
         widget->value = new_value;
-        debug_printf("🔧 Widget '%s' mis à jour: %d\n", id, new_value);
+        debug_printf("🔧 Widget '%s' mis à jour: %d\n", node->id, new_value);
         return true;
     }
 
@@ -767,32 +1073,35 @@ bool set_widget_int_value(WidgetList* list, const char* id, int new_value) {
         // Vérifier que l'index est valide
         if (new_value < 0 || new_value >= widget->num_options) {
             debug_printf("⚠️ Index %d hors limites pour selector '%s' [0, %d]\n",
-                         new_value, id, widget->num_options - 1);
+                         new_value, node->id, widget->num_options - 1);
             return false;
         }
 
         widget->current_index = new_value;
         debug_printf("🔧 Selector '%s' mis à jour: index %d (%s)\n",
-                     id, new_value, widget->options[new_value].text);
+                     node->id, new_value, widget->options[new_value].text);
         return true;
     }
 
-    debug_printf("❌ Widget '%s' n'est ni INCREMENT ni SELECTOR\n", id);
+    debug_printf("❌ Widget '%s' n'est ni INCREMENT ni SELECTOR\n", node->id);
     return false;
 }
 
+bool set_widget_int_value(WidgetList* list, const char* id, int new_value) {
+    return set_widget_node_int_value(find_widget_by_id(list, id), new_value);
+}
+
 //  MODIFICATION DE LA VALEUR BOOL D'UN WIDGET
 // Change l'état d'un widget TOGGLE par programmation
 //
 // RETOURNE :
 //   - true si succès
 //   - false si échec
-bool set_widget_bool_value(WidgetList* list, const char* id, bool new_value) {
-    WidgetNode* node = find_widget_by_id(list, id);
+bool set_widget_node_bool_value(WidgetNode* node, bool new_value) {
     if (!node) return false;
 
     if (node->type != WIDGET_TYPE_TOGGLE) {
-        debug_printf("❌ Widget '%s' n'est pas de type TOGGLE\n", id);
+        debug_printf("❌ Widget '%s' n'est pas de type TOGGLE\n", node->id);
         return false;
     }
 
@@ -800,11 +1109,15 @@ bool set_widget_bool_value(WidgetList* list, const char* id, bool new_value) {
 
     node->widget.toggle_widget->value = new_value;
     node->widget.toggle_widget->animation_progress = new_value ? 1.0f : 0.0f;
-    debug_printf("🔧 Widget '%s' mis à jour: %s\n", id, new_value ? "ON" : "OFF");
+    debug_printf("🔧 Widget '%s' mis à jour: %s\n", node->id, new_value ? "ON" : "OFF");
 
     return true;
 }
 
+bool set_widget_bool_value(WidgetList* list, const char* id, bool new_value) {
+    return set_widget_node_bool_value(find_widget_by_id(list, id), new_value);
+}
+
 //  AFFICHAGE DEBUG DE LA LISTE
 //  AJOUT D'UN WIDGET LABEL (texte/titre)
 bool add_label_widget(WidgetList* list,
@@ -1066,11 +1379,13 @@ void free_widget_list(WidgetList* list) {
         // ─────────────────────────────────────────────────────────────────────
         SAFE_FREE(current->id);
         SAFE_FREE(current->display_name);
-        SAFE_FREE(current);
+        POOL_FREE(widget_node_pool, current);
 
         current = next;
     }
 
+    layout_index_release(&list->layout_index);
+    SAFE_FREE(list->index);
     SAFE_FREE(list);
     debug_printf("🗑️ Liste de widgets libérée\n");
 }
@@ -3,6 +3,7 @@
 #define __WIDGET_LIST_H__
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include "widget_types.h"
@@ -55,11 +56,46 @@ typedef struct WidgetNode {
     struct WidgetNode* prev;
 } WidgetNode;
 
+//  INDEX DE DISPOSITION
+// Bandes horizontales de WIDGET_LAYOUT_BAND pixels (coordonnées du contenu,
+// sans offset du panneau ni scroll) → widgets qui les touchent. Sert au
+// hit-test (événements souris transmis aux seuls widgets sous le curseur) et
+// au rendu (widgets hors de la zone visible ignorés).
+// Reconstruit à la demande après widget_list_invalidate_layout().
+#define WIDGET_LAYOUT_BAND 32
+
+typedef struct {
+    WidgetNode* node;
+    int y0, y1;                   // Étendue verticale interactive (contenu)
+    int draw_y0, draw_y1;         // Étendue verticale dessinée (contenu)
+    bool interactive;             // Gère des événements (y0/y1 significatifs)
+    int container_width;          // INCREMENT : largeur d'alignement du groupe
+    bool hot;                     // Curseur dans l'étendue au dernier mouvement
+} WidgetLayoutEntry;
+
+typedef struct {
+    bool valid;
+    WidgetLayoutEntry* entries;   // Tous les widgets, dans l'ordre de la liste
+    int entry_count;
+    int* band_start;              // band_count + 1 débuts dans band_entries
+    int* band_entries;            // Index dans entries, croissants par bande
+    int band_count;
+    int* candidates;              // Tampon de dispatch/rendu (entry_count max)
+} WidgetLayoutIndex;
+
 //  STRUCTURE DE LA LISTE DE WIDGETS
+// L'index est une table de hachage (adressage ouvert) id → nœud, tenue à
+// jour par les add_*_widget : find_widget_by_id ne parcourt plus la liste.
 typedef struct WidgetList {
     WidgetNode* first;
     WidgetNode* last;
     int count;
+
+    WidgetNode** index;           // NULL si allocation impossible (recherche linéaire)
+    int index_capacity;           // Puissance de 2, remplie au plus à moitié
+    uint32_t generation;          // Change à chaque création/ajout (invalide les handles)
+
+    WidgetLayoutIndex layout_index; // Reconstruit après un changement de disposition
 } WidgetList;
 
 //  PROTOTYPES DES FONCTIONS
@@ -140,14 +176,18 @@ bool add_selector_widget(WidgetList* list,
                          TTF_Font* font);
 
 // RENDU ET ÉVÉNEMENTS (FACTORISATION MAGIQUE ✨)
-// Ces fonctions parcourent TOUTE la liste et appellent les bonnes fonctions
-// pour chaque widget selon son type
+// Ces fonctions appellent les bonnes fonctions pour chaque widget selon son
+// type. Le rendu ne dessine que les widgets qui coupent la zone de clipping
+// du renderer (ou la sortie entière si aucun clipping n'est actif).
 void render_all_widgets(SDL_Renderer* renderer, WidgetList* list,
                         int offset_x, int offset_y, int panel_width, int scroll_offset);
 
 void handle_widget_list_events(WidgetList* list, SDL_Event* event,
                                int offset_x, int offset_y, int scroll_offset);
 
+// À appeler quand positions ou dimensions des widgets changent
+void widget_list_invalidate_layout(WidgetList* list);
+
 void update_widget_list_animations(WidgetList* list, float delta_time);
 
 // UTILITAIRES
@@ -162,6 +202,12 @@ bool get_widget_bool_value(WidgetList* list, const char* id, bool* out_value);
 bool set_widget_int_value(WidgetList* list, const char* id, int new_value);
 bool set_widget_bool_value(WidgetList* list, const char* id, bool new_value);
 
+// Mêmes opérations sur un nœud déjà trouvé (handle résolu une fois)
+bool get_widget_node_int_value(const WidgetNode* node, int* out_value);
+bool get_widget_node_bool_value(const WidgetNode* node, bool* out_value);
+bool set_widget_node_int_value(WidgetNode* node, int new_value);
+bool set_widget_node_bool_value(WidgetNode* node, bool new_value);
+
 // Debug
 void debug_print_widget_list(WidgetList* list);
 
@@ -2,6 +2,8 @@
 #include "whm.h"
 #include "core/config.h"
 #include "core/debug.h"
+#include "core/trace.h"
+#include "core/config_deps.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -14,6 +16,48 @@ static void whm_update(TechniqueInstance* self, float delta_time);
 static void whm_render(TechniqueInstance* self, SDL_Renderer* renderer);
 static void whm_cleanup(TechniqueInstance* self);
 
+// COMPOSANTS CONSERVÉS ENTRE DEUX INSTANCES
+// whm_cleanup() range ici les composants coûteux à reconstruire. L'instance
+// suivante les reprend si config_deps confirme que leurs dépendances n'ont
+// pas changé, sinon ils sont détruits et recréés.
+static struct {
+    TimerState* session_timer;
+    CounterState* breath_counter;
+    SessionCardState* session_card;
+} whm_retained;
+
+static uint64_t counter_context_key(SDL_Renderer* renderer, int font_size,
+                                    double scale_min, double scale_max) {
+    struct {
+        SDL_Renderer* renderer;
+        int font_size;
+        double scale_min;
+        double scale_max;
+    } key;
+    memset(&key, 0, sizeof(key));   // Octets de padding déterministes
+    key.renderer = renderer;
+    key.font_size = font_size;
+    key.scale_min = scale_min;
+    key.scale_max = scale_max;
+    return derived_context_key(&key, sizeof(key));
+}
+
+static uint64_t card_context_key(SDL_Renderer* renderer, int width, int height,
+                                 float scale_factor) {
+    struct {
+        SDL_Renderer* renderer;
+        int width;
+        int height;
+        float scale_factor;
+    } key;
+    memset(&key, 0, sizeof(key));
+    key.renderer = renderer;
+    key.width = width;
+    key.height = height;
+    key.scale_factor = scale_factor;
+    return derived_context_key(&key, sizeof(key));
+}
+
 // CRÉATION DE L'INSTANCE
 
 /**
@@ -79,16 +123,42 @@ void whm_set_screen_info(TechniqueInstance* instance, int width, int height, flo
     AppConfig config;
     load_config(&config);
 
-    // Créer la carte de session
+    // Créer la carte de session (ou reprendre celle de l'instance précédente)
     if (!data->session_card && data->hexagones && data->session_controller) {
-        data->session_card = session_card_create(
-            data->session_controller->current_session,
-            width,
-            height,
-            FONT_ARIAL_BOLD,
-            scale_factor
-        );
-        debug_printf("✅ [WHM] Carte de session créée\n");
+        int current_session = data->session_controller->current_session;
+        uint64_t card_key = card_context_key(data->renderer, width, height, scale_factor);
+
+        if (!whm_retained.session_card) derived_invalidate(DERIVED_SESSION_CARD);
+
+        if (whm_retained.session_card &&
+            derived_is_current(DERIVED_SESSION_CARD, &config, card_key)) {
+            data->session_card = whm_retained.session_card;
+            whm_retained.session_card = NULL;
+
+            // La texture porte le numéro de session : ne la refaire que s'il diffère
+            if (data->session_card->session_number != current_session) {
+                session_card_reset(data->session_card, current_session, data->renderer);
+            } else {
+                data->session_card->phase = CARD_FINISHED;
+                data->session_card->elapsed_time = 0.0f;
+            }
+        } else {
+            if (whm_retained.session_card) {
+                session_card_destroy(whm_retained.session_card);
+                whm_retained.session_card = NULL;
+            }
+            data->session_card = session_card_create(
+                current_session,
+                width,
+                height,
+                FONT_ARIAL_BOLD,
+                scale_factor
+            );
+            if (data->session_card) {
+                derived_mark_built(DERIVED_SESSION_CARD, &config, card_key);
+            }
+            debug_printf("✅ [WHM] Carte de session créée\n");
+        }
     }
 
     // 🆕 Mettre à jour la session_card si elle existe déjà (responsive lors redimensionnement)
@@ -143,6 +213,25 @@ void whm_create_counter(TechniqueInstance* instance, SDL_Renderer* renderer) {
                    retention_type_for_counter == 0 ? "poumons PLEINS" : "poumons VIDES");
     }
 
+    // Reprendre le compteur précédent si son cache de textures est encore valide
+    // (Nb_respiration × fps × breath_duration textures Cairo à reconstruire sinon)
+    uint64_t counter_key = counter_context_key(renderer, counter_font_size, scale_min, scale_max);
+
+    if (!whm_retained.breath_counter) derived_invalidate(DERIVED_COUNTER_CACHE);
+
+    if (whm_retained.breath_counter &&
+        derived_is_current(DERIVED_COUNTER_CACHE, &config, counter_key)) {
+        data->breath_counter = whm_retained.breath_counter;
+        whm_retained.breath_counter = NULL;
+        counter_reset(data->breath_counter, config.Nb_respiration, retention_type_for_counter);
+        return;
+    }
+
+    if (whm_retained.breath_counter) {
+        counter_destroy(whm_retained.breath_counter);
+        whm_retained.breath_counter = NULL;
+    }
+
     // Créer le compteur
     data->breath_counter = counter_create(
         renderer,
@@ -158,6 +247,7 @@ void whm_create_counter(TechniqueInstance* instance, SDL_Renderer* renderer) {
 
     if (data->breath_counter) {
         data->breath_counter->is_active = false;
+        derived_mark_built(DERIVED_COUNTER_CACHE, &config, counter_key);
         debug_printf("✅ [WHM] Compteur créé: 0/%d respirations\n", config.Nb_respiration);
     } else {
         debug_printf("❌ [WHM] Échec création compteur\n");
@@ -182,8 +272,26 @@ static void whm_init(TechniqueInstance* self, SDL_Renderer* renderer) {
     // ════════════════════════════════════════════════════════════════════
     int timer_duration = config.start_duration;
     int timer_font_size = 48;  // Sera ajusté plus tard avec screen_info
+    uint64_t timer_key = derived_context_key(&timer_font_size, sizeof(timer_font_size));
+
+    if (!whm_retained.session_timer) derived_invalidate(DERIVED_SESSION_TIMER);
+
+    if (whm_retained.session_timer &&
+        derived_is_current(DERIVED_SESSION_TIMER, &config, timer_key)) {
+        data->session_timer = whm_retained.session_timer;
+        whm_retained.session_timer = NULL;
+        timer_reset(data->session_timer);
+    } else {
+        if (whm_retained.session_timer) {
+            timer_destroy(whm_retained.session_timer);
+            whm_retained.session_timer = NULL;
+        }
+        data->session_timer = breathing_timer_create(timer_duration, FONT_ARIAL_BOLD, timer_font_size);
+        if (data->session_timer) {
+            derived_mark_built(DERIVED_SESSION_TIMER, &config, timer_key);
+        }
+    }
 
-    data->session_timer = breathing_timer_create(timer_duration, FONT_ARIAL_BOLD, timer_font_size);
     if (data->session_timer) {
         timer_start(data->session_timer);
         data->timer_phase = true;
@@ -314,12 +422,48 @@ static void whm_handle_event(TechniqueInstance* self, SDL_Event* event) {
     }
 }
 
+// ════════════════════════════════════════════════════════════════════
+// TRACE DES PHASES
+// ════════════════════════════════════════════════════════════════════
+#define WHM_TRACE_ID 1
+
+static const char* whm_phase_name(const WHMData* data) {
+    if (data->timer_phase) return "WHM timer";
+    if (data->session_card_phase) return "WHM carte de session";
+    if (data->counter_phase) return "WHM respirations";
+    if (data->reappear_phase) return "WHM réapparition";
+    if (data->chrono_phase) return "WHM chrono";
+    if (data->inspiration_phase) return "WHM inspiration";
+    if (data->retention_phase) return "WHM rétention";
+    return NULL;
+}
+
+// Ferme le span de l'ancienne phase et ouvre celui de la nouvelle
+static void whm_trace_phase(WHMData* data) {
+    if (!trace_enabled) return;
+
+    const char* phase = whm_phase_name(data);
+    if (phase == data->traced_phase) return;
+
+    if (data->traced_phase) {
+        TRACE_ASYNC_END(data->traced_phase, WHM_TRACE_ID);
+    }
+    if (phase) {
+        TRACE_ASYNC_BEGIN(phase, WHM_TRACE_ID);
+    }
+    TRACE_INSTANT("WHM transition");
+    data->traced_phase = phase;
+}
+
 /**
  * Mise à jour de l'état (appelée chaque frame)
  */
 static void whm_update(TechniqueInstance* self, float delta_time) {
     WHMData* data = (WHMData*)self->technique_data;
 
+    TRACE_BEGIN("whm_update");
+    whm_trace_phase(data);  // Transitions venant de whm_handle_event (clic)
+
     // ════════════════════════════════════════════════════════════════════
     // PHASE 1 : TIMER AVANT SESSION
     // ════════════════════════════════════════════════════════════════════
@@ -656,10 +800,9 @@ static void whm_update(TechniqueInstance* self, float delta_time) {
                            data->session_controller->current_session,
                            data->session_controller->total_sessions);
 
-                // Libérer les données précompilées (~100 MB)
+                // Les données précompilées sont conservées : le prochain clic
+                // sur Wim les réutilise si breath_duration n'a pas changé (config_deps)
                 if (data->hexagones) {
-                    free_precomputed_data(data->hexagones);
-
                     // 🔥 FIX CRUCIAL: Repositionner les hexagones à scale_max pour le prochain stage
                     // Les hexagones sont actuellement à scale_min (fin rétention poumons pleins)
                     // On les repositionne à scale_max INVISIBLEMENT (aucune phase active)
@@ -703,6 +846,9 @@ static void whm_update(TechniqueInstance* self, float delta_time) {
             node = node->next;
         }
     }
+
+    whm_trace_phase(data);
+    TRACE_END("whm_update");
 }
 
 /**
@@ -813,12 +959,28 @@ static void whm_cleanup(TechniqueInstance* self) {
 
     debug_printf("🧹 [WHM] Nettoyage de la technique\n");
 
-    // Libérer les composants
-    if (data->session_timer) timer_destroy(data->session_timer);
-    if (data->breath_counter) counter_destroy(data->breath_counter);
+    if (data->traced_phase) {
+        TRACE_ASYNC_END(data->traced_phase, WHM_TRACE_ID);
+    }
+
+    // Conserver les composants coûteux pour la prochaine instance
+    // (un composant déjà en réserve ne peut exister qu'après un échec de reprise)
+    if (data->session_timer) {
+        if (whm_retained.session_timer) timer_destroy(whm_retained.session_timer);
+        whm_retained.session_timer = data->session_timer;
+    }
+    if (data->breath_counter) {
+        if (whm_retained.breath_counter) counter_destroy(whm_retained.breath_counter);
+        whm_retained.breath_counter = data->breath_counter;
+    }
+    if (data->session_card) {
+        if (whm_retained.session_card) session_card_destroy(whm_retained.session_card);
+        whm_retained.session_card = data->session_card;
+    }
+
+    // Libérer les autres composants
     if (data->session_stopwatch) stopwatch_destroy(data->session_stopwatch);
     if (data->retention_timer) timer_destroy(data->retention_timer);
-    if (data->session_card) session_card_destroy(data->session_card);
 
     // Détruire le contrôleur de session
     if (data->session_controller) {
@@ -829,3 +991,25 @@ static void whm_cleanup(TechniqueInstance* self) {
     SAFE_FREE(data);
     self->technique_data = NULL;
 }
+
+/**
+ * Libère les composants conservés entre deux instances
+ */
+void whm_release_retained(void) {
+    if (whm_retained.session_timer) {
+        timer_destroy(whm_retained.session_timer);
+        whm_retained.session_timer = NULL;
+    }
+    if (whm_retained.breath_counter) {
+        counter_destroy(whm_retained.breath_counter);
+        whm_retained.breath_counter = NULL;
+    }
+    if (whm_retained.session_card) {
+        session_card_destroy(whm_retained.session_card);
+        whm_retained.session_card = NULL;
+    }
+
+    derived_invalidate(DERIVED_SESSION_TIMER);
+    derived_invalidate(DERIVED_COUNTER_CACHE);
+    derived_invalidate(DERIVED_SESSION_CARD);
+}
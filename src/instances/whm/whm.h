@@ -56,6 +56,11 @@ typedef struct {
     // ════════════════════════════════════════════════════════════════════════
     bool needs_high_fps;        // true si animation active (60 FPS), false sinon (15 FPS)
 
+    // ════════════════════════════════════════════════════════════════════════
+    // TRACE (--trace)
+    // ════════════════════════════════════════════════════════════════════════
+    const char* traced_phase;   // Phase ouverte dans la trace (span asynchrone)
+
 } WHMData;
 
 /**
@@ -88,4 +93,10 @@ void whm_set_screen_info(TechniqueInstance* instance, int width, int height, flo
  */
 void whm_create_counter(TechniqueInstance* instance, SDL_Renderer* renderer);
 
+/**
+ * Libérer les composants conservés entre deux instances (timer, compteur,
+ * carte de session). À appeler avant TTF_Quit() et la destruction du renderer.
+ */
+void whm_release_retained(void);
+
 #endif // WHM_H
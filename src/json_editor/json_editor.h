@@ -7,11 +7,11 @@
 #include <SDL2/SDL_ttf.h>
 #include <stdbool.h>
 
-#define JSON_BUFFER_SIZE 16384   // Taille max du JSON (16 Ko)
 #define EDITOR_WIDTH 600         // Largeur de la fenêtre
 #define EDITOR_HEIGHT 800        // Hauteur de la fenêtre
 #define LINE_HEIGHT 20           // Hauteur d'une ligne de texte
 #define LEFT_MARGIN 50           // Marge pour les numéros de ligne
+#define UNDO_MAX_OCTETS (1024 * 1024)  // Mémoire max de l'historique undo (1 Mo)
 
 // Fonctions utilitaires mathématiques (inline pour performance)
 static inline int min_int(int a, int b) { return a < b ? a : b; }
@@ -64,16 +64,95 @@ typedef struct {
     BoutonCallback callback;        // Fonction à appeler au clic
 } EditorButton;
 
+//  TEXTE DE L'ÉDITEUR (GAP BUFFER)
+// Texte en deux morceaux autour d'un trou qui suit le curseur :
+//   data[0, gap_debut) | trou | data[gap_fin, capacite)
+// Insertion et suppression au curseur en O(1) amorti. Positions toujours
+// exprimées dans le texte (trou exclu), comme dans un buffer classique.
+//
+// Index des débuts de ligne tenu à jour à chaque édition, lui aussi avec un
+// trou (à la ligne éditée) : avant le trou, positions absolues ; après,
+// distances à la fin du texte, qu'une édition plus haut ne change pas.
+// Début d'une ligne en O(1), ligne d'une position en O(log n)
+typedef struct {
+    char* data;
+    int capacite;                   // Taille allouée (texte + trou)
+    int gap_debut;                  // Début du trou = position du trou dans le texte
+    int gap_fin;                    // Premier octet après le trou
+
+    int* lignes;                    // Débuts de ligne (toujours au moins la ligne 0)
+    int lignes_capacite;
+    int lignes_gap_debut;           // Lignes avant le trou de l'index
+    int lignes_gap_fin;
+} GapBuffer;
+
+// Longueur du texte en octets
+static inline int texte_longueur(const GapBuffer* texte) {
+    return texte->capacite - (texte->gap_fin - texte->gap_debut);
+}
+
+// Octet à la position pos ('\0' hors du texte, comme après le terminateur
+// d'une chaîne)
+static inline char texte_car(const GapBuffer* texte, int pos) {
+    if (pos < 0) return '\0';
+    if (pos < texte->gap_debut) return texte->data[pos];
+    pos += texte->gap_fin - texte->gap_debut;
+    return pos < texte->capacite ? texte->data[pos] : '\0';
+}
+
 //  STRUCTURE POUR L'HISTORIQUE UNDO/REDO
+// Une opération = à `position`, `supprime` remplacé par `insere`. Une étape
+// d'undo regroupe une ou plusieurs opérations consécutives (`suite`)
 typedef struct UndoNode {
-    char* buffer_snapshot;          // Copie du buffer à cet état
-    int curseur_position;           // Position du curseur
-    int scroll_offset;              // Scroll vertical
-    int scroll_offset_x;            // Scroll horizontal
-    struct UndoNode* prev;          // État précédent
-    struct UndoNode* next;          // État suivant (pour redo)
+    int position;                   // Début de l'opération dans le texte
+    char* supprime;                 // Texte supprimé (NULL si aucun)
+    int supprime_len;
+    int supprime_capacite;
+    char* insere;                   // Texte inséré (NULL si aucun)
+    int insere_len;
+    int insere_capacite;
+    int curseur_avant;              // Curseur à restaurer par l'undo
+    bool suite;                     // Même étape que l'opération précédente
+    struct UndoNode* prev;          // Opération précédente
+    struct UndoNode* next;          // Opération suivante (pour redo)
 } UndoNode;
 
+// Type d'étape : les frappes et les effacements successifs fusionnent
+typedef enum {
+    UNDO_ACTION,                    // Action isolée (coller, formater...) : une étape
+    UNDO_FRAPPE,                    // Saisie : une étape par mot
+    UNDO_EFFACEMENT                 // Backspace / Suppr enchaînés : une étape
+} TypeEtapeUndo;
+
+//  CACHE DE RENDU
+// Textures des textes déjà rendus (lignes colorées, numéros, titre, boutons),
+// retrouvées par leur contenu : une ligne qui n'a pas changé, même déplacée,
+// n'est ni re-parsée ni re-rendue. Une frame sans modification ne fait que
+// des copies de textures ; une frappe ne rend que la ligne éditée.
+// Entrée cherchée parmi CACHE_RENDU_SONDES cases à partir de son hash ; la
+// moins récemment affichée est remplacée.
+#define CACHE_RENDU_TAILLE 256      // Entrées (puissance de 2)
+#define CACHE_RENDU_SONDES 16       // Cases examinées par recherche
+#define LIGNE_RENDU_MAX 256         // Octets affichés par ligne
+
+typedef struct {
+    Uint32 hash;
+    TTF_Font* police;
+    Uint32 couleur;                 // 0 : ligne à coloration syntaxique
+    int longueur;                   // -1 : entrée libre
+    char texte[LIGNE_RENDU_MAX];
+    SDL_Texture* texture;           // NULL : rien à dessiner (ligne blanche)
+    int largeur, hauteur;
+    Uint32 frame;                   // Dernière frame où l'entrée a servi
+} TexteEnCache;
+
+typedef struct {
+    TexteEnCache entrees[CACHE_RENDU_TAILLE];
+    Uint32 frame;
+    TTF_Font* police_avances;       // Police des avances ci-dessous
+    int avances[128];               // Avance (px) de chaque caractère ASCII
+} CacheRendu;
+
 
 //  STRUCTURE DE L'ÉDITEUR JSON
 struct JsonEditor_s {
@@ -89,13 +168,14 @@ struct JsonEditor_s {
     SDL_Renderer* renderer;
     TTF_Font* font_mono;        // Police monospace pour le code
     TTF_Font* font_ui;          // Police pour les boutons
+    CacheRendu* cache_rendu;    // Textures des lignes et libellés (json_editor_render.c)
 
 
     // ─────────────────────────────────────────────────────────────────────────
     // CONTENU DU FICHIER
     // ─────────────────────────────────────────────────────────────────────────
-    char buffer[JSON_BUFFER_SIZE];  // Contenu du JSON en mémoire
-    char clipboard[JSON_BUFFER_SIZE];  // Presse-papier interne
+    GapBuffer texte;                // Contenu du JSON en mémoire
+    char* clipboard;                // Presse-papier interne (NULL si vide)
     char filepath[256];             // Chemin du fichier JSON
     bool modified;                  // true si modifié depuis dernière sauvegarde
     bool json_valide;              // true si le JSON est bien formé
@@ -131,9 +211,13 @@ struct JsonEditor_s {
     // ─────────────────────────────────────────────────────────────────────────
     // SYSTÈME UNDO/REDO
     // ─────────────────────────────────────────────────────────────────────────
-    UndoNode* current_undo;             // Pointeur vers l'état actuel
-    int undo_count;                     // Nombre d'états dans l'historique
-    int max_undo_count;                 // Limite (ex: 100)
+    UndoNode* current_undo;             // Dernière opération appliquée (NULL : aucune)
+    UndoNode* undo_premier;             // Plus ancienne opération conservée
+    int undo_count;                     // Nombre d'opérations dans l'historique
+    size_t undo_octets;                 // Mémoire occupée par l'historique
+    size_t undo_max_octets;             // Limite (UNDO_MAX_OCTETS)
+    TypeEtapeUndo undo_type;            // Type de l'étape en cours
+    bool undo_nouvelle_etape;           // La prochaine opération ouvre une étape
 
     // ─────────────────────────────────────────────────────────────────────────
     // AUTO-SAVE POUR HOT RELOAD
@@ -197,6 +281,9 @@ void detruire_boutons(JsonEditor* editor);
 // Charge le contenu du fichier dans le buffer
 bool charger_fichier_json(JsonEditor* editor);
 
+// Recharge le buffer si le fichier a changé sur disque (file_watcher)
+bool recharger_json_si_modifie(JsonEditor* editor);
+
 // Sauvegarde le buffer dans le fichier
 bool sauvegarder_fichier_json(JsonEditor* editor);
 
@@ -238,8 +325,19 @@ void faire_redo(JsonEditor* editor);
 // Gestion de la sélection
 void deselectionner(JsonEditor* editor);
 
-// Gestion du undo/redo
-void sauvegarder_etat_undo(JsonEditor* editor);
+// Gestion du undo/redo : à appeler au début de chaque action qui modifie le
+// texte. UNDO_FRAPPE / UNDO_EFFACEMENT prolongent l'étape précédente du même
+// type tant que l'édition reste contiguë (et, pour la frappe, dans le même mot)
+void commencer_etape_undo(JsonEditor* editor, TypeEtapeUndo type);
+
+// Modifications du texte enregistrées dans l'historique (toutes les
+// modifications de l'éditeur passent par là)
+bool inserer_texte(JsonEditor* editor, int position, const char* src, int len);
+void supprimer_texte(JsonEditor* editor, int debut, int fin);
+bool remplacer_tout_le_texte(JsonEditor* editor, const char* src, int len);
+
+// Libère tout l'historique undo/redo (destruction de l'éditeur)
+void liberer_historique_undo(JsonEditor* editor);
 
 // Sélectionne le mot sous le curseur (double-clic)
 void selectionner_mot_au_curseur(JsonEditor* editor);
@@ -303,6 +401,9 @@ bool generer_code_c_depuis_json(JsonEditor* editor);
 // Rend toute la fenêtre de l'éditeur
 void rendre_json_editor(JsonEditor* editor);
 
+// Libère les textures du cache de rendu (avant de détruire le renderer)
+void liberer_cache_rendu(JsonEditor* editor);
+
 // Rend une ligne de texte avec numéro
 void rendre_ligne_texte(JsonEditor* editor, const char* ligne, int numero, int y);
 
@@ -329,14 +430,23 @@ void deplacer_curseur_vertical(JsonEditor* editor, int direction);
 // Scroll du curseur avec la souris
 void auto_scroll_curseur(JsonEditor* editor);
 
-// Compte le nombre de lignes dans le buffer
-int compter_lignes(const char* buffer);
+// Nombre de lignes du texte (O(1), lu dans l'index)
+int compter_lignes(const GapBuffer* texte);
 
 // Récupère la ligne à un index donné
-const char* obtenir_ligne(const char* buffer, int index_ligne, char* dest, int max_len);
+const char* obtenir_ligne(const GapBuffer* texte, int index_ligne, char* dest, int max_len);
+
+// Position du premier octet d'une ligne (longueur du texte si elle n'existe pas)
+int debut_ligne(const GapBuffer* texte, int index_ligne);
 
-// Convertit position curseur → (ligne, colonne)
-void position_vers_ligne_colonne(const char* buffer, int position, int* ligne, int* colonne);
+// Position du '\n' qui termine une ligne (longueur du texte pour la dernière)
+int fin_ligne(const GapBuffer* texte, int index_ligne);
+
+// Ligne qui contient une position (recherche dichotomique dans l'index)
+int ligne_a_position(const GapBuffer* texte, int position);
+
+// Convertit position curseur → (ligne, colonne en octets)
+void position_vers_ligne_colonne(const GapBuffer* texte, int position, int* ligne, int* colonne);
 
 // Trouve un nombre autour du curseur
 bool trouver_nombre_au_curseur(JsonEditor* editor, int* debut, int* fin);
@@ -361,6 +471,35 @@ int utf8_advance(const char* str, int n_chars);
 // Copie n caractères UTF-8 (pas n octets!) dans dest
 void utf8_strncpy(char* dest, const char* src, int n_chars, int max_bytes);
 
+// TEXTE (GAP BUFFER)
+
+// Alloue un texte vide ; false si allocation impossible
+bool texte_init(GapBuffer* texte);
+
+// Libère le texte
+void texte_liberer(GapBuffer* texte);
+
+// Insère len octets à la position pos ; false si allocation impossible
+bool texte_inserer(GapBuffer* texte, int pos, const char* src, int len);
+
+// Supprime les octets de [debut, fin)
+void texte_supprimer(GapBuffer* texte, int debut, int fin);
+
+// Remplace tout le texte ; false (texte inchangé) si allocation impossible
+bool texte_remplacer(GapBuffer* texte, const char* src, int len);
+
+// Copie [debut, fin) dans dest ('\0' final, tronqué à max_len - 1 octets).
+// RETOUR : nombre d'octets copiés
+int texte_copier(const GapBuffer* texte, int debut, int fin, char* dest, int max_len);
+
+// Copie [debut, fin) dans une chaîne allouée (SAFE_FREE), NULL si erreur
+char* texte_extraire(const GapBuffer* texte, int debut, int fin);
+
+// Texte entier en une chaîne terminée par '\0' (validation, sauvegarde,
+// formatage, génération de code). Déplace le trou à la fin : pointeur valide
+// jusqu'à la prochaine modification
+const char* texte_contigu(GapBuffer* texte);
+
 // GESTION DES TEMPLATES
 
 // Charge les templates depuis templates.json et crée le sous-menu
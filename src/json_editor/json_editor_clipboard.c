@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include "json_editor.h"
 #include "core/debug.h"
+#include "core/memory/memory.h"
 #include <string.h>
 
 
@@ -21,14 +22,15 @@ void copier_selection(JsonEditor* editor) {
     }
 
     int len = sel_max - sel_min;
-    if (len >= JSON_BUFFER_SIZE) {
-        debug_printf("⚠️ COPIER: Sélection trop grande\n");
-        return;
-    }
 
     // Copier dans le presse-papier interne
-    strncpy(editor->clipboard, editor->buffer + sel_min, len);
-    editor->clipboard[len] = '\0';
+    char* copie = texte_extraire(&editor->texte, sel_min, sel_max);
+    if (!copie) {
+        debug_printf("❌ COPIER: Erreur allocation (%d octets)\n", len);
+        return;
+    }
+    if (editor->clipboard) SAFE_FREE(editor->clipboard);
+    editor->clipboard = copie;
 
     // ✅ OPTIONNEL : Copier aussi dans le presse-papier système SDL
     SDL_SetClipboardText(editor->clipboard);
@@ -43,8 +45,8 @@ void couper_selection(JsonEditor* editor) {
         return;
     }
 
-    // Sauvegarder l'état pour le undo
-    sauvegarder_etat_undo(editor);
+    // Une étape d'historique
+    commencer_etape_undo(editor, UNDO_ACTION);
 
     // D'abord copier
     copier_selection(editor);
@@ -54,14 +56,11 @@ void couper_selection(JsonEditor* editor) {
     int sel_max = max_int(editor->selection_start, editor->selection_end);
 
     if (sel_min != sel_max) {
-        int len = strlen(editor->buffer);
-        memmove(&editor->buffer[sel_min],
-                &editor->buffer[sel_max],
-                len - sel_max + 1);
+        supprimer_texte(editor, sel_min, sel_max);
 
         editor->curseur_position = sel_min;
         editor->modified = true;
-        editor->nb_lignes = compter_lignes(editor->buffer);
+        editor->nb_lignes = compter_lignes(&editor->texte);
 
         deselectionner(editor);
         debug_printf("✅ COUPER: Sélection coupée\n");
@@ -72,8 +71,8 @@ void couper_selection(JsonEditor* editor) {
 void coller_texte(JsonEditor* editor) {
     if (!editor) return;
 
-    // Sauvegarder l'état pour le undo
-    sauvegarder_etat_undo(editor);
+    // Une étape d'historique
+    commencer_etape_undo(editor, UNDO_ACTION);
 
     // ✅ Essayer d'abord le presse-papier système
     char* texte_systeme = SDL_GetClipboardText();
@@ -83,7 +82,7 @@ void coller_texte(JsonEditor* editor) {
         texte_a_coller = texte_systeme;
     } else {
         // Sinon utiliser le presse-papier interne
-        texte_a_coller = editor->clipboard;
+        texte_a_coller = editor->clipboard ? editor->clipboard : "";
     }
 
     if (!texte_a_coller || texte_a_coller[0] == '\0') {
@@ -98,34 +97,22 @@ void coller_texte(JsonEditor* editor) {
         int sel_max = max_int(editor->selection_start, editor->selection_end);
 
         if (sel_min != sel_max) {
-            int len = strlen(editor->buffer);
-            memmove(&editor->buffer[sel_min],
-                    &editor->buffer[sel_max],
-                    len - sel_max + 1);
+            supprimer_texte(editor, sel_min, sel_max);
             editor->curseur_position = sel_min;
         }
         deselectionner(editor);
     }
 
-    // Insérer chaque caractère du texte à coller
-    for (int i = 0; texte_a_coller[i] != '\0'; i++) {
-        int len = strlen(editor->buffer);
-        if (len >= JSON_BUFFER_SIZE - 1) {
-            debug_printf("⚠️ COLLER: Buffer plein\n");
-            break;
-        }
-
-        // Décaler et insérer
-        memmove(&editor->buffer[editor->curseur_position + 1],
-                &editor->buffer[editor->curseur_position],
-                len - editor->curseur_position + 1);
-
-        editor->buffer[editor->curseur_position] = texte_a_coller[i];
-        editor->curseur_position++;
+    // Insérer tout le texte d'un coup (un seul déplacement du trou)
+    int len = strlen(texte_a_coller);
+    if (inserer_texte(editor, editor->curseur_position, texte_a_coller, len)) {
+        editor->curseur_position += len;
+    } else {
+        debug_printf("❌ COLLER: Erreur allocation (%d octets)\n", len);
     }
 
     editor->modified = true;
-    editor->nb_lignes = compter_lignes(editor->buffer);
+    editor->nb_lignes = compter_lignes(&editor->texte);
 
     debug_printf("✅ COLLER: Texte collé\n");
 
@@ -413,7 +413,7 @@ bool generer_code_c_depuis_json(JsonEditor* editor) {
     }
 
     // Parser le JSON actuel
-    cJSON* root = cJSON_Parse(editor->buffer);
+    cJSON* root = cJSON_Parse(texte_contigu(&editor->texte));
     if (!root) {
         fprintf(stderr, "❌ JSON invalide, impossible de générer le code C\n");
         return false;
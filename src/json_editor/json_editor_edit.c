@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include "json_editor.h"
 #include "core/debug.h"
+#include "core/memory/memory.h"
 #include <string.h>
 
 //  UTILITAIRES UTF8 POUR LA SÉLECTION
@@ -83,6 +84,9 @@ void deselectionner(JsonEditor* editor) {
 void inserer_caractere(JsonEditor* editor, char c) {
     if (!editor) return;
 
+    // Frappe : prolonge le mot en cours dans l'historique
+    commencer_etape_undo(editor, UNDO_FRAPPE);
+
     // Supprimer la sélection si elle est active
     if (editor->selection_active) {
         int sel_min = min_int(editor->selection_start, editor->selection_end);
@@ -90,10 +94,7 @@ void inserer_caractere(JsonEditor* editor, char c) {
 
         if (sel_min != sel_max) {
             // Supprimer le texte sélectionné
-            int len = strlen(editor->buffer);
-            memmove(&editor->buffer[sel_min],
-                    &editor->buffer[sel_max],
-                    len - sel_max + 1);
+            supprimer_texte(editor, sel_min, sel_max);
 
             // Placer le curseur à la position de début de la sélection
             editor->curseur_position = sel_min;
@@ -104,48 +105,28 @@ void inserer_caractere(JsonEditor* editor, char c) {
         deselectionner(editor);
     }
 
-    int len = strlen(editor->buffer);
-
-    if (len >= JSON_BUFFER_SIZE - 1) return;
-
     // LOG
     debug_printf("📝 INSERT: curseur_pos=%d, char_insere='%c'\n",
                  editor->curseur_position, c);
 
-    // Décaler tous les caractères après le curseur
-    memmove(&editor->buffer[editor->curseur_position + 1],
-            &editor->buffer[editor->curseur_position],
-            len - editor->curseur_position + 1);
-
-    // Insérer le caractère
-    editor->buffer[editor->curseur_position] = c;
+    // Insérer le caractère (dans le trou du gap buffer)
+    if (!inserer_texte(editor, editor->curseur_position, &c, 1)) return;
     editor->curseur_position++;
     editor->modified = true;
     marquer_modification(editor);
-    editor->nb_lignes = compter_lignes(editor->buffer);
+    editor->nb_lignes = compter_lignes(&editor->texte);
 
     // LOG
     debug_printf("✅ Après insertion: nouveau_curseur_pos=%d\n", editor->curseur_position);
 }
 
 
-//  NOUVELLE FONCTIONNALITÉ : PRESSE-PAPIER (CLIPBOARD)
-
-// AJOUTER dans la structure JsonEditor (dans le .h et au début du .c) :
-//
-//     char clipboard[JSON_BUFFER_SIZE];  // Presse-papier interne
-//
-
-// AJOUTER ces nouvelles fonctions dans json_editor_window.c :
-
-
-
 //  SUPPRESSION DE CARACTÈRE (BACKSPACE)
 void supprimer_caractere(JsonEditor* editor) {
     if (!editor) return;
 
-    // ✅ CORRECTION : Sauvegarder l'état AVANT toute modification
-    sauvegarder_etat_undo(editor);
+    // Effacements successifs regroupés ; une sélection est une étape à elle seule
+    commencer_etape_undo(editor, editor->selection_active ? UNDO_ACTION : UNDO_EFFACEMENT);
 
     // Si une sélection est active, supprimer toute la sélection
     if (editor->selection_active) {
@@ -154,15 +135,12 @@ void supprimer_caractere(JsonEditor* editor) {
 
         if (sel_min != sel_max) {
             // Supprimer tout le texte entre sel_min et sel_max
-            int len = strlen(editor->buffer);
-            memmove(&editor->buffer[sel_min],
-                    &editor->buffer[sel_max],
-                    len - sel_max + 1);
+            supprimer_texte(editor, sel_min, sel_max);
 
             editor->curseur_position = sel_min;
             editor->modified = true;
     marquer_modification(editor);
-            editor->nb_lignes = compter_lignes(editor->buffer);
+            editor->nb_lignes = compter_lignes(&editor->texte);
 
             deselectionner(editor);
             debug_printf("✅ Sélection supprimée (de %d à %d)\n", sel_min, sel_max);
@@ -185,9 +163,9 @@ void supprimer_caractere(JsonEditor* editor) {
 
     // Afficher le contexte avant suppression
     if (pos > 0) {
+        char avant = texte_car(&editor->texte, pos - 1);
         debug_printf("🔍 [BACKSPACE] Caractère avant curseur: 0x%02X '%c'\n",
-                     (unsigned char)editor->buffer[pos-1],
-                     (editor->buffer[pos-1] >= 32 && editor->buffer[pos-1] < 127) ? editor->buffer[pos-1] : '?');
+                     (unsigned char)avant, (avant >= 32 && avant < 127) ? avant : '?');
     }
 
     // ─────────────────────────────────────────────────────────────────────────
@@ -196,7 +174,7 @@ void supprimer_caractere(JsonEditor* editor) {
     int char_start = pos - 1;
 
     // Si on est sur un octet de continuation (10xxxxxx), reculer jusqu'au début
-    while (char_start > 0 && (editor->buffer[char_start] & 0xC0) == 0x80) {
+    while (char_start > 0 && (texte_car(&editor->texte, char_start) & 0xC0) == 0x80) {
         char_start--;
         debug_printf("🔍 [BACKSPACE] Recul UTF-8: char_start maintenant à %d\n", char_start);
     }
@@ -212,40 +190,33 @@ void supprimer_caractere(JsonEditor* editor) {
     // Afficher les octets du caractère
     debug_printf("              - Octets: ");
     for (int i = char_start; i < pos; i++) {
-        debug_printf("0x%02X ", (unsigned char)editor->buffer[i]);
+        debug_printf("0x%02X ", (unsigned char)texte_car(&editor->texte, i));
     }
     debug_printf("\n");
 
     // ─────────────────────────────────────────────────────────────────────────
     // SUPPRIMER LE CARACTÈRE
     // ─────────────────────────────────────────────────────────────────────────
-    int buffer_len = strlen(editor->buffer);
-
-    debug_printf("🔍 [BACKSPACE] memmove: dest=%d, src=%d, len=%d\n",
-                 char_start, pos, buffer_len - pos + 1);
-
-    memmove(editor->buffer + char_start,
-            editor->buffer + pos,
-            buffer_len - pos + 1);  // +1 pour le '\0'
+    supprimer_texte(editor, char_start, pos);
 
             // Mettre à jour le curseur
             editor->curseur_position = char_start;
             editor->modified = true;
     marquer_modification(editor);
-            editor->nb_lignes = compter_lignes(editor->buffer);
+            editor->nb_lignes = compter_lignes(&editor->texte);
 
             debug_printf("✅ [BACKSPACE] Caractère supprimé! Nouveau curseur_pos=%d\n",
                          editor->curseur_position);
             debug_printf("✅ [BACKSPACE] Buffer après suppression: longueur=%d\n",
-                         (int)strlen(editor->buffer));
+                         texte_longueur(&editor->texte));
 }
 
 //  SUPPRESSION DE CARACTÈRE APRÈS LE CURSEUR (DELETE)
 void supprimer_caractere_apres(JsonEditor* editor) {
     if (!editor) return;
 
-    // ✅ Sauvegarder l'état AVANT toute modification
-    sauvegarder_etat_undo(editor);
+    // Effacements successifs regroupés ; une sélection est une étape à elle seule
+    commencer_etape_undo(editor, editor->selection_active ? UNDO_ACTION : UNDO_EFFACEMENT);
 
     // Si une sélection est active, supprimer toute la sélection
     if (editor->selection_active) {
@@ -254,15 +225,12 @@ void supprimer_caractere_apres(JsonEditor* editor) {
 
         if (sel_min != sel_max) {
             // Supprimer tout le texte entre sel_min et sel_max
-            int len = strlen(editor->buffer);
-            memmove(&editor->buffer[sel_min],
-                    &editor->buffer[sel_max],
-                    len - sel_max + 1);
+            supprimer_texte(editor, sel_min, sel_max);
 
             editor->curseur_position = sel_min;
             editor->modified = true;
     marquer_modification(editor);
-            editor->nb_lignes = compter_lignes(editor->buffer);
+            editor->nb_lignes = compter_lignes(&editor->texte);
 
             deselectionner(editor);
             debug_printf("✅ [DELETE] Sélection supprimée (de %d à %d)\n", sel_min, sel_max);
@@ -276,7 +244,7 @@ void supprimer_caractere_apres(JsonEditor* editor) {
 
     debug_printf("🔍 [DELETE] Début - curseur_pos=%d\n", editor->curseur_position);
 
-    int buffer_len = strlen(editor->buffer);
+    int buffer_len = texte_longueur(&editor->texte);
     if (editor->curseur_position >= buffer_len) {
         debug_printf("⚠️ [DELETE] Curseur à la fin du buffer, rien à supprimer\n");
         return;
@@ -285,14 +253,14 @@ void supprimer_caractere_apres(JsonEditor* editor) {
     int pos = editor->curseur_position;
 
     // Afficher le contexte avant suppression
+    char apres = texte_car(&editor->texte, pos);
     debug_printf("🔍 [DELETE] Caractère après curseur: 0x%02X '%c'\n",
-                 (unsigned char)editor->buffer[pos],
-                 (editor->buffer[pos] >= 32 && editor->buffer[pos] < 127) ? editor->buffer[pos] : '?');
+                 (unsigned char)apres, (apres >= 32 && apres < 127) ? apres : '?');
 
     // ─────────────────────────────────────────────────────────────────────────
     // TROUVER LA LONGUEUR DU CARACTÈRE UTF-8 À SUPPRIMER
     // ─────────────────────────────────────────────────────────────────────────
-    int char_len = utf8_char_len(editor->buffer + pos);
+    int char_len = utf8_char_len(&apres);
 
     debug_printf("🔍 [DELETE] Caractère UTF-8 détecté:\n");
     debug_printf("              - Position début: %d\n", pos);
@@ -302,29 +270,24 @@ void supprimer_caractere_apres(JsonEditor* editor) {
     // Afficher les octets du caractère
     debug_printf("              - Octets: ");
     for (int i = pos; i < pos + char_len && i < buffer_len; i++) {
-        debug_printf("0x%02X ", (unsigned char)editor->buffer[i]);
+        debug_printf("0x%02X ", (unsigned char)texte_car(&editor->texte, i));
     }
     debug_printf("\n");
 
     // ─────────────────────────────────────────────────────────────────────────
     // SUPPRIMER LE CARACTÈRE
     // ─────────────────────────────────────────────────────────────────────────
-    debug_printf("🔍 [DELETE] memmove: dest=%d, src=%d, len=%d\n",
-                 pos, pos + char_len, buffer_len - pos - char_len + 1);
-
-    memmove(editor->buffer + pos,
-            editor->buffer + pos + char_len,
-            buffer_len - pos - char_len + 1);  // +1 pour le '\0'
+    supprimer_texte(editor, pos, pos + char_len);
 
             // Le curseur reste à la même position
             editor->modified = true;
     marquer_modification(editor);
-            editor->nb_lignes = compter_lignes(editor->buffer);
+            editor->nb_lignes = compter_lignes(&editor->texte);
 
             debug_printf("✅ [DELETE] Caractère supprimé! Curseur_pos reste à %d\n",
                          editor->curseur_position);
             debug_printf("✅ [DELETE] Buffer après suppression: longueur=%d\n",
-                         (int)strlen(editor->buffer));
+                         texte_longueur(&editor->texte));
 }
 
 //  INSERTION NOUVELLE LIGNE
@@ -332,41 +295,6 @@ void inserer_nouvelle_ligne(JsonEditor* editor) {
     inserer_caractere(editor, '\n');
 }
 
-//  UTILITAIRES
-int compter_lignes(const char* buffer) {
-    if (!buffer) return 0;
-    int count = 1;
-    for (const char* p = buffer; *p; p++) {
-        if (*p == '\n') count++;
-    }
-    return count;
-}
-
-const char* obtenir_ligne(const char* buffer, int index_ligne, char* dest, int max_len) {
-    if (!buffer || !dest || index_ligne < 0) {
-        dest[0] = '\0';
-        return dest;
-    }
-
-    const char* start = buffer;
-    int current_line = 0;
-
-    // Trouver le début de la ligne
-    while (*start && current_line < index_ligne) {
-        if (*start == '\n') current_line++;
-        start++;
-    }
-
-    // Copier jusqu'au \n ou fin
-    int i = 0;
-    while (*start && *start != '\n' && i < max_len - 1) {
-        dest[i++] = *start++;
-    }
-    dest[i] = '\0';
-
-    return dest;
-}
-
 //  DÉTECTION ET MANIPULATION DE NOMBRES
 
 // Vérifie si un caractère fait partie d'un nombre JSON
@@ -382,13 +310,13 @@ bool trouver_nombre_au_curseur(JsonEditor* editor, int* debut, int* fin) {
     int pos = editor->curseur_position;
 
     // Si on est après la fin du buffer, reculer d'un caractère
-    if (pos >= (int)strlen(editor->buffer)) {
+    if (pos >= texte_longueur(&editor->texte)) {
         pos--;
     }
 
     // Si on n'est pas sur un nombre, vérifier le caractère avant
-    if (pos >= 0 && !est_char_nombre(editor->buffer[pos])) {
-        if (pos > 0 && est_char_nombre(editor->buffer[pos - 1])) {
+    if (pos >= 0 && !est_char_nombre(texte_car(&editor->texte, pos))) {
+        if (pos > 0 && est_char_nombre(texte_car(&editor->texte, pos - 1))) {
             pos--;
         } else {
             return false;  // Pas sur un nombre
@@ -396,20 +324,20 @@ bool trouver_nombre_au_curseur(JsonEditor* editor, int* debut, int* fin) {
     }
 
     // Si on arrive ici et qu'on n'est toujours pas sur un nombre, exit
-    if (pos < 0 || !est_char_nombre(editor->buffer[pos])) {
+    if (pos < 0 || !est_char_nombre(texte_car(&editor->texte, pos))) {
         return false;
     }
 
     // Trouver le début du nombre (reculer)
     int start = pos;
-    while (start > 0 && est_char_nombre(editor->buffer[start - 1])) {
+    while (start > 0 && est_char_nombre(texte_car(&editor->texte, start - 1))) {
         start--;
     }
 
     // Trouver la fin du nombre (avancer)
     int end = pos;
-    int buffer_len = strlen(editor->buffer);
-    while (end < buffer_len && est_char_nombre(editor->buffer[end])) {
+    int buffer_len = texte_longueur(&editor->texte);
+    while (end < buffer_len && est_char_nombre(texte_car(&editor->texte, end))) {
         end++;
     }
 
@@ -427,15 +355,12 @@ void modifier_nombre_au_curseur(JsonEditor* editor, int delta) {
         return;  // Pas de nombre sous le curseur
     }
 
-    // Sauvegarder pour undo
-    sauvegarder_etat_undo(editor);
+    // Une étape d'historique
+    commencer_etape_undo(editor, UNDO_ACTION);
 
     // Extraire le nombre
     char nombre_str[64];
-    int len = fin - debut;
-    if (len >= 64) len = 63;
-    strncpy(nombre_str, editor->buffer + debut, len);
-    nombre_str[len] = '\0';
+    texte_copier(&editor->texte, debut, fin, nombre_str, sizeof(nombre_str));
 
     // Parser le nombre
     bool est_decimal = (strchr(nombre_str, '.') != NULL ||
@@ -471,33 +396,17 @@ void modifier_nombre_au_curseur(JsonEditor* editor, int delta) {
 
     // Remplacer le nombre dans le buffer
     int nouvelle_len = strlen(nouveau_nombre);
-    int ancienne_len = fin - debut;
-    int buffer_len = strlen(editor->buffer);
-
-    // Décaler le reste du buffer si les longueurs diffèrent
-    if (nouvelle_len != ancienne_len) {
-        int diff = nouvelle_len - ancienne_len;
-
-        // Vérifier qu'on a assez de place
-        if (buffer_len + diff >= JSON_BUFFER_SIZE - 1) {
-            return;  // Pas assez de place
-        }
-
-        // Décaler
-        memmove(editor->buffer + fin + diff,
-                editor->buffer + fin,
-                buffer_len - fin + 1);  // +1 pour le '\0'
+    if (!inserer_texte(editor, fin, nouveau_nombre, nouvelle_len)) {
+        return;  // Pas assez de mémoire
     }
-
-    // Copier le nouveau nombre
-    memcpy(editor->buffer + debut, nouveau_nombre, nouvelle_len);
+    supprimer_texte(editor, debut, fin);
 
     // Mettre à jour le curseur (le placer après le nombre)
     editor->curseur_position = debut + nouvelle_len;
 
     editor->modified = true;
     marquer_modification(editor);
-    editor->nb_lignes = compter_lignes(editor->buffer);
+    editor->nb_lignes = compter_lignes(&editor->texte);
 
     debug_printf("🔢 Nombre modifié: '%s' → '%s' (delta: %d)\n",
                  nombre_str, nouveau_nombre, delta);
@@ -506,10 +415,10 @@ void modifier_nombre_au_curseur(JsonEditor* editor, int delta) {
 //  SÉLECTION DE MOT ET DE LIGNE (UTF-8 AWARE)
 
 // Retourne la longueur en octets d'un caractère UTF-8 à la position donnée
-static int longueur_char_utf8_a_pos(const char* buffer, int pos) {
-    if (!buffer || pos < 0) return 1;
+static int longueur_char_utf8_a_pos(const GapBuffer* texte, int pos) {
+    if (!texte || pos < 0) return 1;
 
-    unsigned char c = (unsigned char)buffer[pos];
+    unsigned char c = (unsigned char)texte_car(texte, pos);
     if (c < 0x80) return 1;        // ASCII: 0xxxxxxx
     if ((c & 0xE0) == 0xC0) return 2;  // 110xxxxx
     if ((c & 0xF0) == 0xE0) return 3;  // 1110xxxx
@@ -519,13 +428,13 @@ static int longueur_char_utf8_a_pos(const char* buffer, int pos) {
 
 // Recule d'un caractère UTF-8 complet
 // Retourne la nouvelle position
-static int reculer_un_char_utf8(const char* buffer, int pos) {
+static int reculer_un_char_utf8(const GapBuffer* texte, int pos) {
     if (pos <= 0) return 0;
 
     pos--;  // Reculer d'au moins 1
 
     // Si on est sur un octet de continuation (10xxxxxx), reculer jusqu'au début
-    while (pos > 0 && (buffer[pos] & 0xC0) == 0x80) {
+    while (pos > 0 && (texte_car(texte, pos) & 0xC0) == 0x80) {
         pos--;
     }
 
@@ -534,10 +443,10 @@ static int reculer_un_char_utf8(const char* buffer, int pos) {
 
 // Avance d'un caractère UTF-8 complet
 // Retourne la nouvelle position
-static int avancer_un_char_utf8(const char* buffer, int pos, int buffer_len) {
+static int avancer_un_char_utf8(const GapBuffer* texte, int pos, int buffer_len) {
     if (pos >= buffer_len) return buffer_len;
 
-    int char_len = longueur_char_utf8_a_pos(buffer, pos);
+    int char_len = longueur_char_utf8_a_pos(texte, pos);
     pos += char_len;
 
     if (pos > buffer_len) pos = buffer_len;
@@ -549,10 +458,10 @@ static int avancer_un_char_utf8(const char* buffer, int pos, int buffer_len) {
 // - Les ASCII alphanumériques classiques
 // - Les caractères multi-octets (lettres accentuées, etc.) sont acceptés par défaut
 // - On exclut les ponctuations communes et les espaces
-static bool est_caractere_de_mot_utf8(const char* buffer, int pos, int buffer_len) {
+static bool est_caractere_de_mot_utf8(const GapBuffer* texte, int pos, int buffer_len) {
     if (pos < 0 || pos >= buffer_len) return false;
 
-    unsigned char c = (unsigned char)buffer[pos];
+    unsigned char c = (unsigned char)texte_car(texte, pos);
 
     // ─────────────────────────────────────────────────────────────────────────
     // Caractères ASCII : test précis
@@ -594,7 +503,7 @@ void selectionner_mot_au_curseur(JsonEditor* editor) {
     if (!editor) return;
 
     int pos = editor->curseur_position;
-    int buffer_len = strlen(editor->buffer);
+    int buffer_len = texte_longueur(&editor->texte);
 
     if (pos < 0 || pos >= buffer_len) return;
 
@@ -603,10 +512,10 @@ void selectionner_mot_au_curseur(JsonEditor* editor) {
     // ═════════════════════════════════════════════════════════════════════════
 
     // Vérifier qu'on est sur un caractère de mot
-    if (!est_caractere_de_mot_utf8(editor->buffer, pos, buffer_len)) {
+    if (!est_caractere_de_mot_utf8(&editor->texte, pos, buffer_len)) {
         // Essayer le caractère avant
-        int pos_avant = reculer_un_char_utf8(editor->buffer, pos);
-        if (pos_avant < pos && est_caractere_de_mot_utf8(editor->buffer, pos_avant, buffer_len)) {
+        int pos_avant = reculer_un_char_utf8(&editor->texte, pos);
+        if (pos_avant < pos && est_caractere_de_mot_utf8(&editor->texte, pos_avant, buffer_len)) {
             pos = pos_avant;
         } else {
             // Pas sur un mot, peut-être qu'on est sur un guillemet ou ponctuation
@@ -619,8 +528,8 @@ void selectionner_mot_au_curseur(JsonEditor* editor) {
     // Trouver le début du mot (reculer caractère par caractère)
     int debut = pos;
     while (debut > 0) {
-        int pos_avant = reculer_un_char_utf8(editor->buffer, debut);
-        if (!est_caractere_de_mot_utf8(editor->buffer, pos_avant, buffer_len)) {
+        int pos_avant = reculer_un_char_utf8(&editor->texte, debut);
+        if (!est_caractere_de_mot_utf8(&editor->texte, pos_avant, buffer_len)) {
             break;  // On a atteint le début du mot
         }
         debut = pos_avant;
@@ -629,10 +538,10 @@ void selectionner_mot_au_curseur(JsonEditor* editor) {
     // Trouver la fin du mot (avancer caractère par caractère)
     int fin = pos;
     while (fin < buffer_len) {
-        if (!est_caractere_de_mot_utf8(editor->buffer, fin, buffer_len)) {
+        if (!est_caractere_de_mot_utf8(&editor->texte, fin, buffer_len)) {
             break;  // On a atteint la fin du mot
         }
-        fin = avancer_un_char_utf8(editor->buffer, fin, buffer_len);
+        fin = avancer_un_char_utf8(&editor->texte, fin, buffer_len);
     }
 
     // Sélectionner le mot
@@ -648,23 +557,15 @@ void selectionner_mot_au_curseur(JsonEditor* editor) {
 void selectionner_ligne_courante(JsonEditor* editor) {
     if (!editor) return;
 
-    int pos = editor->curseur_position;
-    int buffer_len = strlen(editor->buffer);
+    int buffer_len = texte_longueur(&editor->texte);
+    int ligne = ligne_a_position(&editor->texte, editor->curseur_position);
 
-    // Trouver le début de la ligne (reculer jusqu'au \n précédent ou début)
-    int debut = pos;
-    while (debut > 0 && editor->buffer[debut - 1] != '\n') {
-        debut--;
-    }
-
-    // Trouver la fin de la ligne (avancer jusqu'au \n suivant ou fin)
-    int fin = pos;
-    while (fin < buffer_len && editor->buffer[fin] != '\n') {
-        fin++;
-    }
+    // Début et fin de la ligne (jusqu'au \n suivant ou fin) depuis l'index
+    int debut = debut_ligne(&editor->texte, ligne);
+    int fin = fin_ligne(&editor->texte, ligne);
 
     // Inclure le \n final si présent
-    if (fin < buffer_len && editor->buffer[fin] == '\n') {
+    if (fin < buffer_len && texte_car(&editor->texte, fin) == '\n') {
         fin++;
     }
 
@@ -681,7 +582,7 @@ void selectionner_ligne_courante(JsonEditor* editor) {
 void selectionner_tout(JsonEditor* editor) {
     if (!editor) return;
 
-    int buffer_len = strlen(editor->buffer);
+    int buffer_len = texte_longueur(&editor->texte);
 
     // Définir la sélection sur l'intégralité du buffer
     editor->selection_start = 0;
@@ -696,68 +597,48 @@ void selectionner_tout(JsonEditor* editor) {
 void dupliquer_ligne_courante(JsonEditor* editor) {
     if (!editor) return;
 
-    // Sauvegarder pour undo
-    sauvegarder_etat_undo(editor);
+    // Une étape d'historique
+    commencer_etape_undo(editor, UNDO_ACTION);
 
-    int buffer_len = strlen(editor->buffer);
-    int pos = editor->curseur_position;
+    int buffer_len = texte_longueur(&editor->texte);
+    int ligne = ligne_a_position(&editor->texte, editor->curseur_position);
 
     // ─────────────────────────────────────────────────────────────────────────
-    // Trouver le début de la ligne courante
+    // Trouver le début et la fin de la ligne courante (index des lignes)
     // ─────────────────────────────────────────────────────────────────────────
-    int debut_ligne = pos;
-    while (debut_ligne > 0 && editor->buffer[debut_ligne - 1] != '\n') {
-        debut_ligne--;
-    }
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // Trouver la fin de la ligne courante
-    // ─────────────────────────────────────────────────────────────────────────
-    int fin_ligne = pos;
-    while (fin_ligne < buffer_len && editor->buffer[fin_ligne] != '\n') {
-        fin_ligne++;
-    }
+    int debut = debut_ligne(&editor->texte, ligne);
+    int fin = fin_ligne(&editor->texte, ligne);
 
     // ─────────────────────────────────────────────────────────────────────────
     // Calculer la longueur de la ligne (sans le \n final)
     // ─────────────────────────────────────────────────────────────────────────
-    int longueur_ligne = fin_ligne - debut_ligne;
+    int longueur_ligne = fin - debut;
 
     // ─────────────────────────────────────────────────────────────────────────
-    // Vérifier qu'on a assez de place dans le buffer
+    // Copier la ligne suivie d'un \n
     // ─────────────────────────────────────────────────────────────────────────
-    // On va ajouter : la ligne + \n (donc longueur_ligne + 1)
-    if (buffer_len + longueur_ligne + 1 >= JSON_BUFFER_SIZE - 1) {
-        debug_printf("❌ Pas assez de place pour dupliquer la ligne\n");
+    char* ligne_temp = texte_extraire(&editor->texte, debut, fin + 1);
+    if (!ligne_temp) {
+        debug_printf("❌ Pas assez de mémoire pour dupliquer la ligne\n");
         return;
     }
-
-    // ─────────────────────────────────────────────────────────────────────────
-    // Copier la ligne dans un buffer temporaire
-    // ─────────────────────────────────────────────────────────────────────────
-    char ligne_temp[JSON_BUFFER_SIZE];
-    strncpy(ligne_temp, editor->buffer + debut_ligne, longueur_ligne);
-    ligne_temp[longueur_ligne] = '\0';
+    ligne_temp[longueur_ligne] = '\n';
 
     // ─────────────────────────────────────────────────────────────────────────
     // Insérer la ligne dupliquée juste après la ligne courante
     // ─────────────────────────────────────────────────────────────────────────
     // Position d'insertion : après le \n de la ligne courante (ou à fin_ligne si pas de \n)
-    int pos_insertion = fin_ligne;
-    if (fin_ligne < buffer_len && editor->buffer[fin_ligne] == '\n') {
-        pos_insertion = fin_ligne + 1;
+    int pos_insertion = fin;
+    if (fin < buffer_len && texte_car(&editor->texte, fin) == '\n') {
+        pos_insertion = fin + 1;
     }
 
-    // Décaler tout ce qui est après pour faire de la place
-    memmove(editor->buffer + pos_insertion + longueur_ligne + 1,
-            editor->buffer + pos_insertion,
-            buffer_len - pos_insertion + 1);  // +1 pour le '\0'
-
-            // Insérer la ligne dupliquée
-            memcpy(editor->buffer + pos_insertion, ligne_temp, longueur_ligne);
-
-            // Ajouter un \n après la ligne dupliquée
-            editor->buffer[pos_insertion + longueur_ligne] = '\n';
+    bool insere = inserer_texte(editor, pos_insertion, ligne_temp, longueur_ligne + 1);
+    SAFE_FREE(ligne_temp);
+    if (!insere) {
+        debug_printf("❌ Pas assez de mémoire pour dupliquer la ligne\n");
+        return;
+    }
 
             // ─────────────────────────────────────────────────────────────────────────
             // Déplacer le curseur au début de la ligne dupliquée
@@ -766,7 +647,7 @@ void dupliquer_ligne_courante(JsonEditor* editor) {
 
             editor->modified = true;
     marquer_modification(editor);
-            editor->nb_lignes = compter_lignes(editor->buffer);
+            editor->nb_lignes = compter_lignes(&editor->texte);
 
-            debug_printf("📋 Ligne dupliquée: pos %d, longueur %d\n", debut_ligne, longueur_ligne);
+            debug_printf("📋 Ligne dupliquée: pos %d, longueur %d\n", debut, longueur_ligne);
 }
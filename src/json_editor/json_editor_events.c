@@ -184,8 +184,7 @@ bool gerer_evenements_json_editor(JsonEditor* editor, SDL_Event* event) {
                         auto_scroll_curseur(editor);
                         return true;
                     case SDLK_RETURN:
-                        sauvegarder_etat_undo(editor);
-                        inserer_nouvelle_ligne(editor);
+                        inserer_nouvelle_ligne(editor);  // ✅ Le undo est géré à l'intérieur
                         auto_scroll_curseur(editor);  // ← Scroll auto
                         return true;
                     case SDLK_LEFT:
@@ -209,7 +208,7 @@ bool gerer_evenements_json_editor(JsonEditor* editor, SDL_Event* event) {
 
                             // Si on est sur un octet de continuation UTF-8 (10xxxxxx),
                             // reculer jusqu'au début du caractère
-                            while (pos > 0 && (editor->buffer[pos] & 0xC0) == 0x80) {
+                            while (pos > 0 && (texte_car(&editor->texte, pos) & 0xC0) == 0x80) {
                                 pos--;
                             }
 
@@ -236,10 +235,10 @@ bool gerer_evenements_json_editor(JsonEditor* editor, SDL_Event* event) {
                         // ═══════════════════════════════════════════════════════════════
                         // AVANCER D'UN CARACTÈRE UTF-8 COMPLET
                         // ═══════════════════════════════════════════════════════════════
-                        int buffer_len = strlen(editor->buffer);
+                        int buffer_len = texte_longueur(&editor->texte);
                         if (editor->curseur_position < buffer_len) {
                             // Déterminer la longueur du caractère UTF-8 actuel
-                            unsigned char c = (unsigned char)editor->buffer[editor->curseur_position];
+                            unsigned char c = (unsigned char)texte_car(&editor->texte, editor->curseur_position);
                             int char_len = 1;  // Par défaut, 1 octet (ASCII)
 
                             if (c < 0x80) {
@@ -276,17 +275,13 @@ bool gerer_evenements_json_editor(JsonEditor* editor, SDL_Event* event) {
                         auto_scroll_curseur(editor);  // ← Scroll auto
                         return true;
                     case SDLK_HOME:
-                        while (editor->curseur_position > 0 &&
-                            editor->buffer[editor->curseur_position - 1] != '\n') {
-                            editor->curseur_position--;
-                            }
+                        editor->curseur_position = debut_ligne(&editor->texte,
+                            ligne_a_position(&editor->texte, editor->curseur_position));
                             auto_scroll_curseur(editor);  // ← Scroll auto
                             return true;
                     case SDLK_END:
-                        while (editor->buffer[editor->curseur_position] != '\0' &&
-                            editor->buffer[editor->curseur_position] != '\n') {
-                            editor->curseur_position++;
-                            }
+                        editor->curseur_position = fin_ligne(&editor->texte,
+                            ligne_a_position(&editor->texte, editor->curseur_position));
                             auto_scroll_curseur(editor);  // ← Scroll auto
                             return true;
                 }
@@ -295,15 +290,7 @@ bool gerer_evenements_json_editor(JsonEditor* editor, SDL_Event* event) {
 
                     case SDL_TEXTINPUT:
                         if (event->text.windowID == window_id) {
-                            // Sauvegarder seulement si dernier snapshot date de plus de 1 seconde
-                            static Uint32 dernier_snapshot = 0;
-                            Uint32 maintenant = SDL_GetTicks();
-
-                            if (maintenant - dernier_snapshot > 1000) {  // 1 seconde
-                                sauvegarder_etat_undo(editor);
-                                dernier_snapshot = maintenant;
-                            }
-
+                            // Les frappes sont regroupées par mot dans l'historique
                             for (int i = 0; event->text.text[i] != '\0'; i++) {
                                 inserer_caractere(editor, event->text.text[i]);
                             }
@@ -339,7 +326,7 @@ bool gerer_evenements_json_editor(JsonEditor* editor, SDL_Event* event) {
 
                                     // Même calcul que pour le clic
                                     char ligne_texte[256];
-                                    obtenir_ligne(editor->buffer, ligne_survol, ligne_texte, sizeof(ligne_texte));
+                                    obtenir_ligne(&editor->texte, ligne_survol, ligne_texte, sizeof(ligne_texte));
 
                                     int colonne_survol = 0;
                                     int distance_min = 999999;
@@ -363,15 +350,10 @@ bool gerer_evenements_json_editor(JsonEditor* editor, SDL_Event* event) {
                                     }
 
                                     // Position dans le buffer
-                                    int pos = 0;
-                                    int ligne_courante = 0;
-                                    while (editor->buffer[pos] && ligne_courante < ligne_survol) {
-                                        if (editor->buffer[pos] == '\n') ligne_courante++;
-                                        pos++;
-                                    }
+                                    int pos = debut_ligne(&editor->texte, ligne_survol);
 
                                     // Avancer jusqu'à la colonne (en caractères UTF-8!)
-                                    int bytes_to_advance = utf8_advance(editor->buffer + pos, colonne_survol);
+                                    int bytes_to_advance = utf8_advance(ligne_texte, colonne_survol);
                                     pos += bytes_to_advance;
 
                                     // Activer la sélection et mettre à jour la fin
@@ -482,7 +464,7 @@ bool gerer_evenements_json_editor(JsonEditor* editor, SDL_Event* event) {
 
                                             // ✅ Récupérer la ligne complète
                                             char ligne_texte[256];
-                                            obtenir_ligne(editor->buffer, ligne_cliquee, ligne_texte, sizeof(ligne_texte));
+                                            obtenir_ligne(&editor->texte, ligne_cliquee, ligne_texte, sizeof(ligne_texte));
 
                                             // ✅ Trouver la colonne (UTF-8 aware)
                                             int colonne_trouvee = 0;
@@ -513,17 +495,10 @@ bool gerer_evenements_json_editor(JsonEditor* editor, SDL_Event* event) {
 
 
                                             // ✅ Trouver la position dans le buffer (en octets)
-                                            int pos = 0;
-                                            int ligne_courante = 0;
-
-                                            // Aller à la ligne
-                                            while (editor->buffer[pos] && ligne_courante < ligne_cliquee) {
-                                                if (editor->buffer[pos] == '\n') ligne_courante++;
-                                                pos++;
-                                            }
+                                            int pos = debut_ligne(&editor->texte, ligne_cliquee);
 
                                             // Avancer jusqu'à la colonne (en caractères UTF-8!)
-                                            int bytes_to_advance = utf8_advance(editor->buffer + pos, colonne_trouvee);
+                                            int bytes_to_advance = utf8_advance(ligne_texte, colonne_trouvee);
                                             pos += bytes_to_advance;
 
                                             editor->curseur_position = pos;
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include "json_editor.h"
 #include "core/debug.h"
+#include "core/memory/memory.h"
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 #include <cjson/cJSON.h>
@@ -15,31 +17,95 @@ bool charger_fichier_json(JsonEditor* editor) {
         return false;
     }
 
-    size_t bytes_read = fread(editor->buffer, 1, JSON_BUFFER_SIZE - 1, file);
-    editor->buffer[bytes_read] = '\0';
+    // Taille du fichier pour une seule lecture, sans limite fixe
+    long taille = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        taille = ftell(file);
+        rewind(file);
+    }
+    if (taille < 0 || taille >= INT_MAX) {
+        debug_printf("❌ Taille de fichier illisible: %s\n", editor->filepath);
+        fclose(file);
+        return false;
+    }
+
+    char* contenu = SAFE_MALLOC((size_t)taille + 1);
+    if (!contenu) {
+        debug_printf("❌ Erreur allocation (%ld octets)\n", taille);
+        fclose(file);
+        return false;
+    }
+    size_t bytes_read = fread(contenu, 1, (size_t)taille, file);
     fclose(file);
 
+    bool charge = texte_remplacer(&editor->texte, contenu, (int)bytes_read);
+    SAFE_FREE(contenu);
+    if (!charge) return false;
+
     editor->curseur_position = 0;  // ← Devrait être 0
     editor->scroll_offset = 0;
     editor->scroll_offset_x = 0;  // ← Scroll horizontal à 0
     editor->modified = false;
-    editor->nb_lignes = compter_lignes(editor->buffer);
+    editor->nb_lignes = compter_lignes(&editor->texte);
 
     editor->json_valide = valider_json(editor);
 
     // LOG
     debug_printf("✅ Fichier chargé: %zu octets, %d lignes\n", bytes_read, editor->nb_lignes);
     debug_printf("🎯 Position initiale du curseur: %d\n", editor->curseur_position);
-    debug_printf("🎯 Premier caractère du buffer: '%c'\n", editor->buffer[0]);
+    debug_printf("🎯 Premier caractère du buffer: '%c'\n", texte_car(&editor->texte, 0));
 
 
-    // ETAT INITIAL POUR UNDO :
-    sauvegarder_etat_undo(editor);
-    debug_printf("💾 État initial sauvegardé pour le undo\n");
+    // Nouveau document : l'historique de l'ancien n'a plus de sens
+    liberer_historique_undo(editor);
+    debug_printf("💾 Historique undo réinitialisé\n");
 
     return true;
 }
 
+//  RECHARGEMENT APRÈS MODIFICATION EXTERNE
+// Ne recharge que si le contenu sur disque diffère du buffer (notre propre
+// sauvegarde ne doit pas remettre le curseur à 0) et si l'utilisateur n'a
+// pas de modifications en cours
+bool recharger_json_si_modifie(JsonEditor* editor) {
+    if (!editor) return false;
+
+    if (editor->modified) {
+        debug_printf("⚠️ %s modifié sur disque, modifications locales conservées\n",
+                     editor->filepath);
+        return false;
+    }
+
+    FILE* file = fopen(editor->filepath, "r");
+    if (!file) return false;
+
+    // Comparaison par blocs, sans copie du fichier
+    char chunk[4096];
+    char courant[sizeof(chunk) + 1];
+    int longueur = texte_longueur(&editor->texte);
+    int offset = 0;
+    bool identical = true;
+    size_t bytes_read;
+
+    while (identical && (bytes_read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        if (offset + (int)bytes_read > longueur) {
+            identical = false;
+        } else {
+            texte_copier(&editor->texte, offset, offset + (int)bytes_read, courant, sizeof(courant));
+            identical = memcmp(courant, chunk, bytes_read) == 0;
+        }
+        offset += (int)bytes_read;
+    }
+    fclose(file);
+
+    if (identical && offset == longueur) {
+        return false;
+    }
+
+    debug_printf("🔄 %s modifié sur disque, rechargement de l'éditeur\n", editor->filepath);
+    return charger_fichier_json(editor);
+}
+
 //  SAUVEGARDE DU FICHIER
 bool sauvegarder_fichier_json(JsonEditor* editor) {
     if (!editor) return false;
@@ -56,7 +122,7 @@ bool sauvegarder_fichier_json(JsonEditor* editor) {
         return false;
     }
 
-    fprintf(file, "%s", editor->buffer);
+    fwrite(texte_contigu(&editor->texte), 1, texte_longueur(&editor->texte), file);
     fclose(file);
 
     editor->modified = false;
@@ -68,7 +134,7 @@ bool sauvegarder_fichier_json(JsonEditor* editor) {
 bool valider_json(JsonEditor* editor) {
     if (!editor) return false;
 
-    cJSON* root = cJSON_Parse(editor->buffer);
+    cJSON* root = cJSON_Parse(texte_contigu(&editor->texte));
     if (!root) {
         const char* error = cJSON_GetErrorPtr();
         if (error) {
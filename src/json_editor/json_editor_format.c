@@ -1,7 +1,10 @@
 #include "json_editor.h"
 #include "core/debug.h"
+#include "core/memory/memory.h"
 #include <cjson/cJSON.h>
 #include <SDL2/SDL.h>
+#include <limits.h>
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -190,12 +193,13 @@ void reindenter_json(JsonEditor* editor) {
         return;
     }
 
-    if (!editor->buffer[0]) {
+    int longueur = texte_longueur(&editor->texte);
+    if (longueur == 0) {
         debug_printf("❌ buffer est vide\n");
         return;
     }
 
-    debug_printf("✅ editor et buffer OK, taille buffer: %zu\n", strlen(editor->buffer));
+    debug_printf("✅ editor et buffer OK, taille buffer: %d\n", longueur);
 
     // 1. Valider le JSON
     debug_printf("🔍 Validation JSON...\n");
@@ -209,7 +213,7 @@ void reindenter_json(JsonEditor* editor) {
 
     // 2. Parser avec cJSON
     debug_printf("🔍 Parsing JSON avec cJSON...\n");
-    cJSON* root = cJSON_Parse(editor->buffer);
+    cJSON* root = cJSON_Parse(texte_contigu(&editor->texte));
     if (!root) {
         debug_printf("❌ cJSON_Parse a échoué\n");
         SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Erreur de parsing",
@@ -219,45 +223,61 @@ void reindenter_json(JsonEditor* editor) {
     debug_printf("✅ JSON parsé avec succès\n");
 
     // 3. Formater avec NOTRE style personnalisé
-    // Utiliser un buffer 2x plus grand pour l'indentation
-    debug_printf("🔍 Formatage du JSON (buffer: %d octets)...\n", JSON_BUFFER_SIZE * 2);
-    char formatted[JSON_BUFFER_SIZE * 2];
-    char* ptr = formatted;
-    size_t remaining = (JSON_BUFFER_SIZE * 2) - 1;
+    // Buffer de sortie proportionnel au texte ; saturé (indentation profonde)
+    // : on recommence avec le double
+    size_t capacite = (size_t)longueur * 2 + 4096;
+    char* formatted = NULL;
+    size_t len = 0;
 
-    formater_element(root, 0, &ptr, &remaining);
-    debug_printf("✅ Formatage terminé, octets restants: %zu\n", remaining);
+    for (;;) {
+        debug_printf("🔍 Formatage du JSON (buffer: %zu octets)...\n", capacite);
+        formatted = SAFE_MALLOC(capacite);
+        if (!formatted) {
+            debug_printf("❌ Erreur allocation du buffer de formatage\n");
+            cJSON_Delete(root);
+            return;
+        }
+
+        char* ptr = formatted;
+        size_t remaining = capacite - 1;
+        formater_element(root, 0, &ptr, &remaining);
+        debug_printf("✅ Formatage terminé, octets restants: %zu\n", remaining);
+
+        // APPEND tronque en laissant 1 octet, INDENT abandonne sous 4 :
+        // au-delà, la sortie est complète
+        if (remaining >= 4) {
+            *ptr = '\0';
+            len = (size_t)(ptr - formatted);
+            break;
+        }
 
-    // CRITIQUE : Ne pas écrire '\0' en dehors du buffer !
-    if (remaining > 0) {
-        *ptr = '\0';
-        debug_printf("✅ Terminateur NULL placé normalement\n");
-    } else {
-        formatted[(JSON_BUFFER_SIZE * 2) - 1] = '\0';
-        debug_printf("⚠️  ATTENTION : Buffer de formatage saturé (%zu octets restants)\n", remaining);
+        debug_printf("⚠️  Buffer de formatage saturé, nouvel essai\n");
+        SAFE_FREE(formatted);
+        if (capacite > INT_MAX / 2) {
+            cJSON_Delete(root);
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Trop grand",
+                                     "Le JSON formaté est trop grand pour l'éditeur.", editor->window);
+            return;
+        }
+        capacite *= 2;
     }
 
     cJSON_Delete(root);
+    debug_printf("🔍 Longueur JSON formaté: %zu octets\n", len);
 
-    // 4. Vérifier la taille
-    size_t len = strlen(formatted);
-    debug_printf("🔍 Longueur JSON formaté: %zu octets (limite: %d)\n", len, JSON_BUFFER_SIZE);
-    if (len >= JSON_BUFFER_SIZE) {
-        debug_printf("❌ JSON trop grand pour l'éditeur\n");
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Trop grand",
-                                 "Le JSON formaté dépasse la limite de 8 Ko.", editor->window);
+    // 4. Appliquer les changements
+    debug_printf("🔍 Application des changements dans le buffer de l'éditeur...\n");
+    commencer_etape_undo(editor, UNDO_ACTION);
+    bool applique = remplacer_tout_le_texte(editor, formatted, (int)len);
+    SAFE_FREE(formatted);
+    if (!applique) {
+        debug_printf("❌ Erreur allocation, JSON non réindenté\n");
         return;
     }
-
-    // 5. Appliquer les changements
-    debug_printf("🔍 Application des changements dans le buffer de l'éditeur...\n");
-    sauvegarder_etat_undo(editor);
-    strncpy(editor->buffer, formatted, JSON_BUFFER_SIZE - 1);
-    editor->buffer[JSON_BUFFER_SIZE - 1] = '\0';
     editor->curseur_position = 0;
     editor->scroll_offset = 0;
     editor->scroll_offset_x = 0;
-    editor->nb_lignes = compter_lignes(editor->buffer);
+    editor->nb_lignes = compter_lignes(&editor->texte);
     editor->selection_active = false;
     marquer_modification(editor);
 
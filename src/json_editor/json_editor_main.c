@@ -182,6 +182,11 @@ JsonEditor* creer_json_editor(const char* filepath, int pos_x, int pos_y) {
     editor->est_ouvert = true;
     editor->json_valide = true;
 
+    if (!texte_init(&editor->texte)) {
+        SAFE_FREE(editor);
+        return NULL;
+    }
+
     // ─────────────────────────────────────────────────────────────────────────
     // CRÉATION DE LA FENÊTRE
     // ─────────────────────────────────────────────────────────────────────────
@@ -194,6 +199,7 @@ JsonEditor* creer_json_editor(const char* filepath, int pos_x, int pos_y) {
 
     if (!editor->window) {
         debug_printf("❌ Erreur création fenêtre éditeur: %s\n", SDL_GetError());
+        texte_liberer(&editor->texte);
         SAFE_FREE(editor);
         return NULL;
     }
@@ -209,6 +215,7 @@ JsonEditor* creer_json_editor(const char* filepath, int pos_x, int pos_y) {
     if (!editor->renderer) {
         debug_printf("❌ Erreur création renderer éditeur: %s\n", SDL_GetError());
         SDL_DestroyWindow(editor->window);
+        texte_liberer(&editor->texte);
         SAFE_FREE(editor);
         return NULL;
     }
@@ -222,6 +229,7 @@ JsonEditor* creer_json_editor(const char* filepath, int pos_x, int pos_y) {
 
     if (!editor->font_mono || !editor->font_ui) {
         debug_printf("❌ JSON Editor: impossible d'obtenir les polices\n");
+        texte_liberer(&editor->texte);
         SAFE_FREE(editor);
         return NULL;
     }
@@ -273,8 +281,12 @@ JsonEditor* creer_json_editor(const char* filepath, int pos_x, int pos_y) {
     // INITIALISATION DU SYSTÈME UNDO
     // ─────────────────────────────────────────────────────────────────────────
     editor->current_undo = NULL;
+    editor->undo_premier = NULL;
     editor->undo_count = 0;
-    editor->max_undo_count = 100;  // Maximum 100 états dans l'historique
+    editor->undo_octets = 0;
+    editor->undo_max_octets = UNDO_MAX_OCTETS;
+    editor->undo_type = UNDO_ACTION;
+    editor->undo_nouvelle_etape = true;
 
     // ─────────────────────────────────────────────────────────────────────────
     // INITIALISATION DU SYSTÈME AUTO-SAVE
@@ -821,10 +833,10 @@ void mettre_a_jour_menu_contextuel(JsonEditor* editor) {
             item->enabled = editor->selection_active;
         }
         else if (strcmp(item->label, "Coller") == 0) {
-            item->enabled = (editor->clipboard[0] != '\0');
+            item->enabled = (editor->clipboard && editor->clipboard[0] != '\0');
         }
         else if (strcmp(item->label, "Tout sélectionner") == 0) {
-            item->enabled = (strlen(editor->buffer) > 0);
+            item->enabled = (texte_longueur(&editor->texte) > 0);
         }
         else if (strcmp(item->label, "Dupliquer") == 0) {
             item->enabled = true; // Toujours disponible
@@ -845,10 +857,14 @@ void detruire_json_editor(JsonEditor* editor) {
         }
     }
 
+    liberer_cache_rendu(editor);  // Textures du renderer : avant sa destruction
     if (editor->renderer) SDL_DestroyRenderer(editor->renderer);
     if (editor->window) SDL_DestroyWindow(editor->window);
 
     detruire_boutons(editor);
+    liberer_historique_undo(editor);
+    texte_liberer(&editor->texte);
+    if (editor->clipboard) SAFE_FREE(editor->clipboard);
     SAFE_FREE(editor);
     debug_printf("🗑️ Éditeur JSON détruit\n");
 }
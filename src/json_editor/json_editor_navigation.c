@@ -10,15 +10,8 @@ void deplacer_curseur_vertical(JsonEditor* editor, int direction) {
     // Calculer ligne et colonne actuelles
     int ligne_actuelle = 0;
     int colonne_actuelle = 0;
-
-    for (int i = 0; i < editor->curseur_position; i++) {
-        if (editor->buffer[i] == '\n') {
-            ligne_actuelle++;
-            colonne_actuelle = 0;
-        } else {
-            colonne_actuelle++;
-        }
-    }
+    position_vers_ligne_colonne(&editor->texte, editor->curseur_position,
+                                &ligne_actuelle, &colonne_actuelle);
 
     // Ligne cible
     int ligne_cible = ligne_actuelle + direction;
@@ -30,27 +23,9 @@ void deplacer_curseur_vertical(JsonEditor* editor, int direction) {
         ligne_cible = editor->nb_lignes - 1;
     }
 
-    // ✅ FIX : Trouver le début de la ligne cible CORRECTEMENT
-    int pos = 0;
-    int ligne_courante = 0;
-
-    // Parcourir jusqu'à la ligne cible
-    while (editor->buffer[pos] && ligne_courante < ligne_cible) {
-        if (editor->buffer[pos] == '\n') {
-            ligne_courante++;
-        }
-        pos++;
-    }
-
-    // Maintenant pos est au DÉBUT de la ligne cible
-    // Avancer sur la ligne jusqu'à la colonne souhaitée (ou fin de ligne)
-    int col = 0;
-    while (col < colonne_actuelle &&
-        editor->buffer[pos] &&
-        editor->buffer[pos] != '\n') {
-        pos++;
-    col++;
-        }
+    // Bornes de la ligne cible dans l'index, puis même colonne (ou fin de ligne)
+    int pos = min_int(debut_ligne(&editor->texte, ligne_cible) + colonne_actuelle,
+                      fin_ligne(&editor->texte, ligne_cible));
 
         editor->curseur_position = pos;
 
@@ -67,15 +42,7 @@ void auto_scroll_curseur(JsonEditor* editor) {
     // SCROLL VERTICAL
     // ─────────────────────────────────────────────────────────────────────────
     int curseur_ligne = 0;
-    int curseur_colonne = 0;
-    for (int i = 0; i < editor->curseur_position && editor->buffer[i]; i++) {
-        if (editor->buffer[i] == '\n') {
-            curseur_ligne++;
-            curseur_colonne = 0;
-        } else {
-            curseur_colonne++;
-        }
-    }
+    position_vers_ligne_colonne(&editor->texte, editor->curseur_position, &curseur_ligne, NULL);
 
     // Calcul du nombre de lignes visibles
     int nb_lignes_visibles = obtenir_nb_lignes_visibles(editor);
@@ -104,23 +71,13 @@ void auto_scroll_curseur(JsonEditor* editor) {
 
     // 1. Obtenir la ligne actuelle
     char ligne_actuelle[256];
-    obtenir_ligne(editor->buffer, curseur_ligne, ligne_actuelle, sizeof(ligne_actuelle));
+    obtenir_ligne(&editor->texte, curseur_ligne, ligne_actuelle, sizeof(ligne_actuelle));
 
     // 2. Trouver la position du curseur EN OCTETS sur cette ligne
-    int pos = 0;
-    int ligne_courante = 0;
-
-    // Aller au début de la ligne actuelle
-    while (editor->buffer[pos] && ligne_courante < curseur_ligne) {
-        if (editor->buffer[pos] == '\n') ligne_courante++;
-        pos++;
-    }
-
-    // pos est maintenant au début de la ligne actuelle
-    int debut_ligne = pos;
+    int debut = debut_ligne(&editor->texte, curseur_ligne);
 
     // Calculer le nombre d'OCTETS entre le début de ligne et le curseur
-    int octets_avant_curseur = editor->curseur_position - debut_ligne;
+    int octets_avant_curseur = editor->curseur_position - debut;
 
     // 3. Extraire le texte AVANT le curseur (en octets!)
     char texte_avant_curseur[256];
@@ -1,17 +1,205 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include "json_editor.h"
 #include "json_syntax.h"
+#include "core/debug.h"
+#include "core/memory/memory.h"
 #include <SDL2/SDL2_gfxPrimitives.h>
 
+// ═══════════════════════════════════════════════════════════════════════════
+// CACHE DE RENDU
+// ═══════════════════════════════════════════════════════════════════════════
+
+static CacheRendu* obtenir_cache_rendu(JsonEditor* editor) {
+    if (!editor->cache_rendu) {
+        editor->cache_rendu = SAFE_MALLOC(sizeof(CacheRendu));
+        if (!editor->cache_rendu) return NULL;
+        memset(editor->cache_rendu, 0, sizeof(CacheRendu));
+        for (int i = 0; i < CACHE_RENDU_TAILLE; i++) {
+            editor->cache_rendu->entrees[i].longueur = -1;
+        }
+    }
+    return editor->cache_rendu;
+}
 
-// Déclaration externe pour render_text
-extern void render_text(SDL_Renderer* renderer, TTF_Font* font,
-                        const char* text, int x, int y, Uint32 color);
+void liberer_cache_rendu(JsonEditor* editor) {
+    if (!editor || !editor->cache_rendu) return;
+    for (int i = 0; i < CACHE_RENDU_TAILLE; i++) {
+        if (editor->cache_rendu->entrees[i].texture) {
+            SDL_DestroyTexture(editor->cache_rendu->entrees[i].texture);
+        }
+    }
+    SAFE_FREE(editor->cache_rendu);
+    editor->cache_rendu = NULL;
+}
+
+// Largeur en pixels de len octets UTF-8 : somme des avances des glyphes
+// (table pour l'ASCII, métriques FreeType sinon), sans TTF_SizeUTF8
+static int largeur_texte(CacheRendu* cache, TTF_Font* font, const char* s, int len) {
+    if (cache->police_avances != font) {
+        for (int c = 0; c < 128; c++) {
+            int avance = 0;
+            if (c < 32 || TTF_GlyphMetrics(font, (Uint16)c, NULL, NULL, NULL, NULL, &avance) != 0) {
+                avance = 0;
+            }
+            cache->avances[c] = avance;
+        }
+        cache->police_avances = font;
+    }
+
+    int largeur = 0;
+    int i = 0;
+    while (i < len) {
+        unsigned char c = (unsigned char)s[i];
+        if (c < 0x80) {
+            largeur += cache->avances[c];
+            i++;
+            continue;
+        }
+
+        // Décodage UTF-8 (plan multilingue de base ; au-delà : avance de '?')
+        int nb = (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : (c >= 0xC0) ? 2 : 1;
+        Uint32 cp = (nb == 2) ? (c & 0x1F) : (nb == 3) ? (c & 0x0F) : (c & 0x07);
+        for (int k = 1; k < nb && i + k < len; k++) {
+            cp = (cp << 6) | ((unsigned char)s[i + k] & 0x3F);
+        }
+        int avance = 0;
+        if (nb == 1 || cp > 0xFFFF ||
+            TTF_GlyphMetrics(font, (Uint16)cp, NULL, NULL, NULL, NULL, &avance) != 0) {
+            avance = cache->avances['?'];
+        }
+        largeur += avance;
+        i += nb;
+    }
+    return largeur;
+}
+
+// FNV-1a sur le texte, la police et la couleur
+static Uint32 hash_texte(TTF_Font* font, Uint32 couleur, const char* s, int len) {
+    Uint32 h = 2166136261u ^ couleur ^ (Uint32)(uintptr_t)font;
+    for (int i = 0; i < len; i++) {
+        h = (h ^ (unsigned char)s[i]) * 16777619u;
+    }
+    return h;
+}
+
+static SDL_Color couleur_sdl(Uint32 couleur) {
+    return (SDL_Color){(couleur >> 16) & 0xFF, (couleur >> 8) & 0xFF, couleur & 0xFF, 255};
+}
+
+// Surface d'une ligne colorée : segments placés aux avances précalculées
+static SDL_Surface* rendre_surface_ligne(CacheRendu* cache, TTF_Font* font,
+                                         const char* ligne, int len) {
+    LigneColoree* ligne_coloree = parser_ligne_json(ligne);
+    int largeur = largeur_texte(cache, font, ligne, len);
+    if (largeur <= 0) return NULL;
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, largeur, TTF_FontHeight(font),
+                                                          32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) return NULL;
+
+    if (!ligne_coloree) {
+        // Fallback : si le parsing échoue, rendre en blanc
+        SDL_Surface* s = TTF_RenderUTF8_Solid(font, ligne, couleur_sdl(0xFFEEEEEE));
+        if (s) {
+            SDL_BlitSurface(s, NULL, surface, NULL);
+            SDL_FreeSurface(s);
+        }
+        return surface;
+    }
+
+    int x = 0;
+    int octet = 0;
+    for (int seg_idx = 0; seg_idx < ligne_coloree->nb_segments; seg_idx++) {
+        SegmentColore* seg = &ligne_coloree->segments[seg_idx];
+
+        // Position du segment : on avance depuis le segment précédent
+        x += largeur_texte(cache, font, ligne + octet, seg->debut - octet);
+        octet = seg->debut;
+
+        char segment_text[LIGNE_RENDU_MAX];
+        int seg_len = min_int(seg->longueur, len - seg->debut);
+        memcpy(segment_text, ligne + seg->debut, seg_len);
+        segment_text[seg_len] = '\0';
+
+        SDL_Surface* s = TTF_RenderUTF8_Solid(font, segment_text,
+                                              obtenir_couleur_token(seg->type));
+        if (s) {
+            SDL_Rect dest = {x, 0, s->w, s->h};
+            SDL_BlitSurface(s, NULL, surface, &dest);
+            SDL_FreeSurface(s);
+        }
+    }
+
+    liberer_ligne_coloree(ligne_coloree);
+    return surface;
+}
+
+// Texture d'un texte (couleur 0 : ligne JSON colorée), rendue seulement si
+// elle n'est pas déjà dans le cache
+static TexteEnCache* texte_en_cache(JsonEditor* editor, TTF_Font* font,
+                                    const char* texte, Uint32 couleur) {
+    CacheRendu* cache = obtenir_cache_rendu(editor);
+    if (!cache || !font) return NULL;
+
+    int len = min_int((int)strlen(texte), LIGNE_RENDU_MAX - 1);
+    Uint32 hash = hash_texte(font, couleur, texte, len);
+
+    // Recherche parmi les sondes ; sinon on remplace la moins récemment affichée
+    TexteEnCache* victime = NULL;
+    for (int k = 0; k < CACHE_RENDU_SONDES; k++) {
+        TexteEnCache* e = &cache->entrees[(hash + k) & (CACHE_RENDU_TAILLE - 1)];
+        if (e->longueur == len && e->hash == hash && e->police == font &&
+            e->couleur == couleur && memcmp(e->texte, texte, len) == 0) {
+            e->frame = cache->frame;
+            return e;
+        }
+        if (!victime || e->longueur < 0 ||
+            (victime->longueur >= 0 && e->frame < victime->frame)) {
+            victime = e;
+        }
+    }
+
+    SDL_Surface* surface = NULL;
+    if (couleur == 0) {
+        char ligne[LIGNE_RENDU_MAX];
+        memcpy(ligne, texte, len);
+        ligne[len] = '\0';
+        surface = rendre_surface_ligne(cache, font, ligne, len);
+    } else if (len > 0) {
+        surface = TTF_RenderUTF8_Solid(font, texte, couleur_sdl(couleur));
+    }
+
+    if (victime->texture) SDL_DestroyTexture(victime->texture);
+    victime->hash = hash;
+    victime->police = font;
+    victime->couleur = couleur;
+    victime->longueur = len;
+    memcpy(victime->texte, texte, len);
+    victime->texture = surface ? SDL_CreateTextureFromSurface(editor->renderer, surface) : NULL;
+    victime->largeur = surface ? surface->w : 0;
+    victime->hauteur = surface ? surface->h : 0;
+    victime->frame = cache->frame;
+    if (surface) SDL_FreeSurface(surface);
+    return victime;
+}
+
+static void dessiner_texte_cache(JsonEditor* editor, TTF_Font* font, const char* texte,
+                                 int x, int y, Uint32 couleur) {
+    TexteEnCache* entree = texte_en_cache(editor, font, texte, couleur);
+    if (!entree || !entree->texture) return;
+
+    SDL_Rect dest = {x, y, entree->largeur, entree->hauteur};
+    SDL_RenderCopy(editor->renderer, entree->texture, NULL, &dest);
+}
 
 //  RENDU DE L'ÉDITEUR
 void rendre_json_editor(JsonEditor* editor) {
     if (!editor || !editor->renderer) return;
 
+    CacheRendu* cache = obtenir_cache_rendu(editor);
+    if (!cache) return;
+    cache->frame++;
+
     // ─────────────────────────────────────────────────────────────────────────
     // FOND THÈME SOMBRE
     // ─────────────────────────────────────────────────────────────────────────
@@ -31,16 +219,14 @@ void rendre_json_editor(JsonEditor* editor) {
                  editor->filepath,
                  editor->modified ? " *" : "");
 
-        extern void render_text(SDL_Renderer* renderer, TTF_Font* font,
-                                const char* text, int x, int y, Uint32 color);
-        render_text(editor->renderer, editor->font_ui, titre, 10, 10, 0xFFCCCCCC);
+        dessiner_texte_cache(editor, editor->font_ui, titre, 10, 10, 0xFFCCCCCC);
     }
 
     // ─────────────────────────────────────────────────────────────────────────
     // ZONE DE TEXTE (ligne par ligne)
     // ─────────────────────────────────────────────────────────────────────────
     int y = 40;
-    char ligne[256];
+    char ligne[LIGNE_RENDU_MAX];
     // Calculer combien de lignes on peut afficher selon la hauteur actuelle
     int nb_lignes_visibles = obtenir_nb_lignes_visibles(editor);
 
@@ -53,54 +239,35 @@ void rendre_json_editor(JsonEditor* editor) {
     }
 
     for (int i = editor->scroll_offset; i < editor->scroll_offset + nb_lignes_visibles && i < editor->nb_lignes; i++) {
-        obtenir_ligne(editor->buffer, i, ligne, sizeof(ligne));
+        // Bornes de la ligne lues dans l'index (O(1))
+        int pos_debut_ligne = debut_ligne(&editor->texte, i);
+        int pos_fin_ligne = fin_ligne(&editor->texte, i);
+        int len_ligne = texte_copier(&editor->texte, pos_debut_ligne, pos_fin_ligne,
+                                     ligne, sizeof(ligne));
 
         if (!editor->font_mono) continue;
 
         // Numéro de ligne (gris moyen)
         char num_str[16];
         snprintf(num_str, sizeof(num_str), "%3d", i + 1);
-        render_text(editor->renderer, editor->font_mono, num_str, 5, y, 0xFF888888);
+        dessiner_texte_cache(editor, editor->font_mono, num_str, 5, y, 0xFF888888);
 
         // DESSINER LA SURBRILLANCE DE SÉLECTION (si elle touche cette ligne)
         if (editor->selection_active && sel_min != sel_max) {
-            // Calculer position de début de cette ligne dans le buffer
-            int pos_debut_ligne = 0;
-            int ligne_count = 0;
-            while (editor->buffer[pos_debut_ligne] && ligne_count < i) {
-                if (editor->buffer[pos_debut_ligne] == '\n') ligne_count++;
-                pos_debut_ligne++;
-            }
-
-            int pos_fin_ligne = pos_debut_ligne;
-            while (editor->buffer[pos_fin_ligne] && editor->buffer[pos_fin_ligne] != '\n') {
-                pos_fin_ligne++;
-            }
-
             // Cette ligne est-elle dans la sélection ?
             if (pos_fin_ligne >= sel_min && pos_debut_ligne <= sel_max) {
                 // Calculer quelle partie de la ligne est sélectionnée
                 int sel_debut_sur_ligne = (sel_min > pos_debut_ligne) ? sel_min - pos_debut_ligne : 0;
                 int sel_fin_sur_ligne = (sel_max < pos_fin_ligne) ? sel_max - pos_debut_ligne : pos_fin_ligne - pos_debut_ligne;
+                sel_debut_sur_ligne = min_int(sel_debut_sur_ligne, len_ligne);
+                sel_fin_sur_ligne = min_int(sel_fin_sur_ligne, len_ligne);
 
-                // Mesurer les largeurs
-                char avant_sel[256], dans_sel[256];
-                strncpy(avant_sel, ligne, sel_debut_sur_ligne);
-                avant_sel[sel_debut_sur_ligne] = '\0';
-
-                int largeur_avant = 0;
-                if (sel_debut_sur_ligne > 0 && editor->font_mono) {
-                    TTF_SizeUTF8(editor->font_mono, avant_sel, &largeur_avant, NULL);
-                }
-
-                int len_selection = sel_fin_sur_ligne - sel_debut_sur_ligne;
-                strncpy(dans_sel, ligne + sel_debut_sur_ligne, len_selection);
-                dans_sel[len_selection] = '\0';
-
-                int largeur_selection = 0;
-                if (len_selection > 0 && editor->font_mono) {
-                    TTF_SizeUTF8(editor->font_mono, dans_sel, &largeur_selection, NULL);
-                }
+                // Mesurer les largeurs (avances des glyphes)
+                int largeur_avant = largeur_texte(cache, editor->font_mono,
+                                                  ligne, sel_debut_sur_ligne);
+                int largeur_selection = largeur_texte(cache, editor->font_mono,
+                                                      ligne + sel_debut_sur_ligne,
+                                                      sel_fin_sur_ligne - sel_debut_sur_ligne);
 
                 // Dessiner le rectangle de surbrillance
                 SDL_Rect highlight_rect = {
@@ -117,49 +284,11 @@ void rendre_json_editor(JsonEditor* editor) {
         // ═════════════════════════════════════════════════════════════════════
         // RENDU DU TEXTE AVEC COLORATION SYNTAXIQUE
         // ═════════════════════════════════════════════════════════════════════
+        // Texture de la ligne depuis le cache : parsée et rendue seulement
+        // si son contenu a changé
         if (ligne[0] != '\0') {
-            // Parser la ligne pour obtenir les segments colorés
-            LigneColoree* ligne_coloree = parser_ligne_json(ligne);
-
-            if (ligne_coloree && ligne_coloree->nb_segments > 0) {
-                // Rendre chaque segment avec sa couleur
-                int x_offset = LEFT_MARGIN - editor->scroll_offset_x;
-
-                for (int seg_idx = 0; seg_idx < ligne_coloree->nb_segments; seg_idx++) {
-                    SegmentColore* seg = &ligne_coloree->segments[seg_idx];
-
-                    // Extraire le texte du segment
-                    char segment_text[256];
-                    int len = (seg->longueur < 255) ? seg->longueur : 255;
-                    strncpy(segment_text, ligne + seg->debut, len);
-                    segment_text[len] = '\0';
-
-                    // Mesurer la largeur du texte AVANT ce segment (pour le positionner)
-                    int x_avant = 0;
-                    if (seg->debut > 0) {
-                        char texte_avant[256];
-                        int len_avant = (seg->debut < 255) ? seg->debut : 255;
-                        strncpy(texte_avant, ligne, len_avant);
-                        texte_avant[len_avant] = '\0';
-                        TTF_SizeUTF8(editor->font_mono, texte_avant, &x_avant, NULL);
-                    }
-
-                    // Obtenir la couleur du segment
-                    SDL_Color couleur = obtenir_couleur_token(seg->type);
-                    Uint32 color_hex = (couleur.a << 24) | (couleur.r << 16) |
-                    (couleur.g << 8) | couleur.b;
-
-                    // Rendre le segment
-                    render_text(editor->renderer, editor->font_mono, segment_text,
-                                x_offset + x_avant, y, color_hex);
-                }
-
-                liberer_ligne_coloree(ligne_coloree);
-            } else {
-                // Fallback : si le parsing échoue, rendre en blanc
-                render_text(editor->renderer, editor->font_mono, ligne,
-                            LEFT_MARGIN - editor->scroll_offset_x, y, 0xFFEEEEEE);
-            }
+            dessiner_texte_cache(editor, editor->font_mono, ligne,
+                                 LEFT_MARGIN - editor->scroll_offset_x, y, 0);
         }
 
         y += LINE_HEIGHT;
@@ -170,14 +299,8 @@ void rendre_json_editor(JsonEditor* editor) {
     // ─────────────────────────────────────────────────────────────────────────
     int curseur_ligne = 0;
     int curseur_colonne = 0;
-    for (int i = 0; i < editor->curseur_position && editor->buffer[i]; i++) {
-        if (editor->buffer[i] == '\n') {
-            curseur_ligne++;
-            curseur_colonne = 0;
-        } else {
-            curseur_colonne++;
-        }
-    }
+    position_vers_ligne_colonne(&editor->texte, editor->curseur_position,
+                                &curseur_ligne, &curseur_colonne);
 
     // Clignotement (toutes les 500ms)
     static Uint32 last_blink = 0;
@@ -193,22 +316,20 @@ void rendre_json_editor(JsonEditor* editor) {
         curseur_ligne >= editor->scroll_offset &&
         curseur_ligne < editor->scroll_offset + nb_lignes_visibles) {
 
-        // ✅ CALCUL PRÉCIS : mesurer la largeur réelle du texte jusqu'au curseur
-        char ligne_actuelle[256];
-    obtenir_ligne(editor->buffer, curseur_ligne, ligne_actuelle, sizeof(ligne_actuelle));
-
-    // Extraire la partie de la ligne jusqu'au curseur
-    char texte_avant_curseur[256];
-    int len = (curseur_colonne < 255) ? curseur_colonne : 255;
-    utf8_strncpy(texte_avant_curseur, ligne_actuelle, len, sizeof(texte_avant_curseur));    texte_avant_curseur[len] = '\0';
+        // ✅ CALCUL PRÉCIS : largeur du texte jusqu'au curseur
+    // Extraire la partie de la ligne jusqu'au curseur (colonne en octets)
+    char texte_avant_curseur[LIGNE_RENDU_MAX];
+    int len = texte_copier(&editor->texte, editor->curseur_position - curseur_colonne,
+                           editor->curseur_position, texte_avant_curseur,
+                           sizeof(texte_avant_curseur));
 
-    // Mesurer la largeur réelle avec TTF_SizeUTF8
-    int largeur_texte = 0;
+    // Mesurer la largeur avec les avances des glyphes
+    int largeur_texte_curseur = 0;
     if (editor->font_mono && len > 0) {
-        TTF_SizeUTF8(editor->font_mono, texte_avant_curseur, &largeur_texte, NULL);
+        largeur_texte_curseur = largeur_texte(cache, editor->font_mono, texte_avant_curseur, len);
     }
 
-    int curseur_x = LEFT_MARGIN + largeur_texte - editor->scroll_offset_x;  // ✅ Avec scroll horizontal !
+    int curseur_x = LEFT_MARGIN + largeur_texte_curseur - editor->scroll_offset_x;  // ✅ Avec scroll horizontal !
     int curseur_y = 40 + ((curseur_ligne - editor->scroll_offset) * LINE_HEIGHT);
 
     SDL_SetRenderDrawColor(editor->renderer, 255, 255, 255, 255);
@@ -238,9 +359,6 @@ void rendre_json_editor(JsonEditor* editor) {
 void rendre_tous_boutons(JsonEditor* editor) {
     if (!editor || !editor->font_ui) return;
 
-    extern void render_text(SDL_Renderer* renderer, TTF_Font* font,
-                            const char* text, int x, int y, Uint32 color);
-
     // Dessiner chaque bouton
     for (int i = 0; i < editor->nb_boutons; i++) {
         EditorButton* btn = &editor->boutons[i];
@@ -255,14 +373,17 @@ void rendre_tous_boutons(JsonEditor* editor) {
                  btn->rect.y + btn->rect.h,
                  couleur);
 
-        // Centrer le texte
-        int texte_w, texte_h;
-        TTF_SizeUTF8(editor->font_ui, btn->label, &texte_w, &texte_h);
-        int centre_x = btn->rect.x + (btn->rect.w - texte_w) / 2;
-        int centre_y = btn->rect.y + (btn->rect.h - texte_h) / 2;
-
-        render_text(editor->renderer, editor->font_ui, btn->label,
-                    centre_x, centre_y, 0xFFFFFFFF);
+        // Centrer le texte (libellé rendu une seule fois, gardé dans le cache)
+        TexteEnCache* label = texte_en_cache(editor, editor->font_ui, btn->label, 0xFFFFFFFF);
+        if (label && label->texture) {
+            SDL_Rect dest = {
+                btn->rect.x + (btn->rect.w - label->largeur) / 2,
+                btn->rect.y + (btn->rect.h - label->hauteur) / 2,
+                label->largeur,
+                label->hauteur
+            };
+            SDL_RenderCopy(editor->renderer, label->texture, NULL, &dest);
+        }
     }
 }
 
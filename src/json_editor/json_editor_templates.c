@@ -227,33 +227,17 @@ void action_inserer_template_contextuel(JsonEditor* editor) {
     // INSERTION DU TEMPLATE À LA POSITION DU CURSEUR
     // ─────────────────────────────────────────────────────────────────────────
 
-    // Sauvegarder l'état pour undo
-    sauvegarder_etat_undo(editor);
+    // Une étape d'historique
+    commencer_etape_undo(editor, UNDO_ACTION);
 
-    // Calculer la longueur du template
+    // Insérer le template à la position du curseur
     int template_len = strlen(item->template_data);
-    int buffer_len = strlen(editor->buffer);
-
-    // Vérifier qu'on ne dépasse pas la taille du buffer
-    if (buffer_len + template_len >= JSON_BUFFER_SIZE - 1) {
-        debug_printf("⚠️ Buffer plein, impossible d'insérer le template\n");
+    if (!inserer_texte(editor, editor->curseur_position,
+                       item->template_data, template_len)) {
+        debug_printf("❌ Erreur allocation, impossible d'insérer le template\n");
         return;
     }
 
-    // Déplacer le texte après le curseur pour faire de la place
-    memmove(
-        editor->buffer + editor->curseur_position + template_len,
-        editor->buffer + editor->curseur_position,
-        buffer_len - editor->curseur_position + 1  // +1 pour le '\0'
-    );
-
-    // Insérer le template
-    memcpy(
-        editor->buffer + editor->curseur_position,
-        item->template_data,
-        template_len
-    );
-
     // Déplacer le curseur à la fin du template inséré
     editor->curseur_position += template_len;
 
@@ -264,7 +248,7 @@ void action_inserer_template_contextuel(JsonEditor* editor) {
     valider_json(editor);
 
     // Recalculer le nombre de lignes
-    editor->nb_lignes = compter_lignes(editor->buffer);
+    editor->nb_lignes = compter_lignes(&editor->texte);
 
     // Auto-scroll pour montrer le curseur
     auto_scroll_curseur(editor);
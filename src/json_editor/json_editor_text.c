@@ -0,0 +1,338 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "json_editor.h"
+#include "core/debug.h"
+#include "core/memory/memory.h"
+#include <limits.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TEXTE DE L'ÉDITEUR (GAP BUFFER)
+// ═══════════════════════════════════════════════════════════════════════════
+// Une frappe écrit directement dans le trou. Le trou ne se déplace (memmove
+// de la distance parcourue, pas de la taille du document) que quand on édite
+// ailleurs ; plein, la capacité double. Les lectures (rendu, navigation)
+// passent par texte_car / texte_copier sans toucher au trou.
+//
+// L'index des lignes suit le même principe : chaque édition amène son trou
+// juste après la ligne éditée (les entrées ne sont stables que pour les
+// éditions situées de l'autre côté du trou) puis y ajoute ou en retire les
+// débuts de ligne des '\n' insérés ou supprimés. Seul texte_remplacer le
+// reconstruit.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define TEXTE_CAPACITE_INITIALE 4096
+#define LIGNES_CAPACITE_INITIALE 256
+
+bool texte_init(GapBuffer* texte) {
+    memset(texte, 0, sizeof(*texte));
+    texte->data = SAFE_MALLOC(TEXTE_CAPACITE_INITIALE);
+    texte->lignes = SAFE_MALLOC(LIGNES_CAPACITE_INITIALE * sizeof(int));
+    if (!texte->data || !texte->lignes) {
+        texte_liberer(texte);
+        debug_printf("❌ TEXTE: Erreur allocation buffer\n");
+        return false;
+    }
+    texte->capacite = TEXTE_CAPACITE_INITIALE;
+    texte->gap_debut = 0;
+    texte->gap_fin = TEXTE_CAPACITE_INITIALE;
+
+    // Texte vide : une seule ligne, qui commence à 0
+    texte->lignes[0] = 0;
+    texte->lignes_capacite = LIGNES_CAPACITE_INITIALE;
+    texte->lignes_gap_debut = 1;
+    texte->lignes_gap_fin = LIGNES_CAPACITE_INITIALE;
+    return true;
+}
+
+void texte_liberer(GapBuffer* texte) {
+    if (!texte) return;
+    if (texte->data) SAFE_FREE(texte->data);
+    if (texte->lignes) SAFE_FREE(texte->lignes);
+    memset(texte, 0, sizeof(*texte));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INDEX DES LIGNES
+// ═══════════════════════════════════════════════════════════════════════════
+
+static int trou_lignes(const GapBuffer* texte) {
+    return texte->lignes_gap_fin - texte->lignes_gap_debut;
+}
+
+int compter_lignes(const GapBuffer* texte) {
+    if (!texte || !texte->lignes) return 1;
+    return texte->lignes_capacite - trou_lignes(texte);
+}
+
+int debut_ligne(const GapBuffer* texte, int index_ligne) {
+    if (index_ligne <= 0) return 0;
+    if (index_ligne >= compter_lignes(texte)) return texte_longueur(texte);
+    if (index_ligne < texte->lignes_gap_debut) return texte->lignes[index_ligne];
+    return texte_longueur(texte) - texte->lignes[index_ligne + trou_lignes(texte)];
+}
+
+int fin_ligne(const GapBuffer* texte, int index_ligne) {
+    if (index_ligne + 1 >= compter_lignes(texte)) return texte_longueur(texte);
+    return debut_ligne(texte, index_ligne + 1) - 1;
+}
+
+int ligne_a_position(const GapBuffer* texte, int position) {
+    // Dernière ligne dont le début est <= position
+    int lo = 0, hi = compter_lignes(texte) - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (debut_ligne(texte, mid) <= position) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+// Amène le trou de l'index juste avant la ligne index_ligne. À appeler
+// avant de modifier le texte : les entrées qui changent de côté sont
+// converties avec la longueur courante
+static void deplacer_trou_lignes(GapBuffer* texte, int index_ligne) {
+    int longueur = texte_longueur(texte);
+    while (texte->lignes_gap_debut > index_ligne) {
+        texte->lignes_gap_debut--;
+        texte->lignes_gap_fin--;
+        texte->lignes[texte->lignes_gap_fin] = longueur - texte->lignes[texte->lignes_gap_debut];
+    }
+    while (texte->lignes_gap_debut < index_ligne) {
+        texte->lignes[texte->lignes_gap_debut] = longueur - texte->lignes[texte->lignes_gap_fin];
+        texte->lignes_gap_debut++;
+        texte->lignes_gap_fin++;
+    }
+}
+
+// Garantit de la place pour `besoin` nouveaux débuts de ligne
+static bool reserver_lignes(GapBuffer* texte, int besoin) {
+    if (trou_lignes(texte) >= besoin) return true;
+
+    int nb_lignes = compter_lignes(texte);
+    int capacite = texte->lignes_capacite ? texte->lignes_capacite : LIGNES_CAPACITE_INITIALE;
+    while (capacite - nb_lignes < besoin) {
+        if (capacite > INT_MAX / 2 / (int)sizeof(int)) {
+            debug_printf("❌ TEXTE: Trop de lignes\n");
+            return false;
+        }
+        capacite *= 2;
+    }
+
+    int* lignes = SAFE_MALLOC((size_t)capacite * sizeof(int));
+    if (!lignes) {
+        debug_printf("❌ TEXTE: Erreur allocation index (%d lignes)\n", capacite);
+        return false;
+    }
+
+    int apres = texte->lignes_capacite - texte->lignes_gap_fin;
+    if (texte->lignes) {
+        memcpy(lignes, texte->lignes, texte->lignes_gap_debut * sizeof(int));
+        memcpy(lignes + capacite - apres, texte->lignes + texte->lignes_gap_fin,
+               apres * sizeof(int));
+        SAFE_FREE(texte->lignes);
+    }
+    texte->lignes = lignes;
+    texte->lignes_gap_fin = capacite - apres;
+    texte->lignes_capacite = capacite;
+    return true;
+}
+
+// Amène le trou à la position pos
+static void deplacer_trou(GapBuffer* texte, int pos) {
+    if (pos < texte->gap_debut) {
+        int n = texte->gap_debut - pos;
+        memmove(texte->data + texte->gap_fin - n, texte->data + pos, n);
+        texte->gap_debut -= n;
+        texte->gap_fin -= n;
+    } else if (pos > texte->gap_debut) {
+        int n = pos - texte->gap_debut;
+        memmove(texte->data + texte->gap_debut, texte->data + texte->gap_fin, n);
+        texte->gap_debut += n;
+        texte->gap_fin += n;
+    }
+}
+
+// Garantit un trou de plus de `besoin` octets : il reste toujours au moins
+// un octet pour le '\0' de texte_contigu
+static bool reserver(GapBuffer* texte, int besoin) {
+    if (texte->gap_fin - texte->gap_debut > besoin) return true;
+
+    int longueur = texte_longueur(texte);
+    int capacite = texte->capacite ? texte->capacite : TEXTE_CAPACITE_INITIALE;
+    while (capacite - longueur <= besoin) {
+        if (capacite > INT_MAX / 2) {
+            debug_printf("❌ TEXTE: Taille maximale atteinte\n");
+            return false;
+        }
+        capacite *= 2;
+    }
+
+    char* data = SAFE_MALLOC(capacite);
+    if (!data) {
+        debug_printf("❌ TEXTE: Erreur allocation (%d octets)\n", capacite);
+        return false;
+    }
+
+    int apres = texte->capacite - texte->gap_fin;
+    if (texte->data) {
+        memcpy(data, texte->data, texte->gap_debut);
+        memcpy(data + capacite - apres, texte->data + texte->gap_fin, apres);
+        SAFE_FREE(texte->data);
+    }
+    texte->data = data;
+    texte->gap_fin = capacite - apres;
+    texte->capacite = capacite;
+    return true;
+}
+
+// Compte les '\n' d'un morceau contigu
+static int compter_sauts(const char* p, int n) {
+    int count = 0;
+    const char* fin = p + n;
+    while (p < fin && (p = memchr(p, '\n', fin - p)) != NULL) {
+        count++;
+        p++;
+    }
+    return count;
+}
+
+bool texte_inserer(GapBuffer* texte, int pos, const char* src, int len) {
+    if (len <= 0) return true;
+
+    // Toutes les allocations avant la moindre modification
+    int sauts = compter_sauts(src, len);
+    if (!reserver(texte, len) || !reserver_lignes(texte, sauts)) return false;
+
+    int longueur = texte_longueur(texte);
+    if (pos < 0) pos = 0;
+    if (pos > longueur) pos = longueur;
+
+    // Trou de l'index après la ligne éditée : les lignes d'avant (absolues)
+    // et celles d'après (depuis la fin) ne changent pas
+    deplacer_trou_lignes(texte, ligne_a_position(texte, pos) + 1);
+
+    deplacer_trou(texte, pos);
+    memcpy(texte->data + texte->gap_debut, src, len);
+    texte->gap_debut += len;
+
+    for (int i = 0; i < len && sauts > 0; i++) {
+        if (src[i] == '\n') {
+            texte->lignes[texte->lignes_gap_debut++] = pos + i + 1;
+            sauts--;
+        }
+    }
+    return true;
+}
+
+void texte_supprimer(GapBuffer* texte, int debut, int fin) {
+    int longueur = texte_longueur(texte);
+    if (debut < 0) debut = 0;
+    if (fin > longueur) fin = longueur;
+    if (fin <= debut) return;
+
+    // Lignes qui commencent dans (debut, fin] : leur '\n' disparaît
+    int premiere = ligne_a_position(texte, debut);
+    int derniere = ligne_a_position(texte, fin);
+    deplacer_trou_lignes(texte, premiere + 1);
+    texte->lignes_gap_fin += derniere - premiere;
+
+    deplacer_trou(texte, debut);
+    texte->gap_fin += fin - debut;
+}
+
+bool texte_remplacer(GapBuffer* texte, const char* src, int len) {
+    if (len < 0) len = 0;
+
+    // Capacités pour le nouveau contenu (échec : texte intact), puis texte
+    // et index vidés : trou = toute la capacité
+    int nb_lignes = compter_sauts(src, len) + 1;
+    if (!reserver(texte, len - texte_longueur(texte)) ||
+        !reserver_lignes(texte, nb_lignes - compter_lignes(texte))) {
+        return false;
+    }
+    texte->gap_debut = 0;
+    texte->gap_fin = texte->capacite;
+    texte->lignes_gap_debut = 0;
+    texte->lignes_gap_fin = texte->lignes_capacite;
+
+    if (len > 0) memcpy(texte->data, src, len);
+    texte->gap_debut = len;
+
+    // Reconstruction de l'index, tout en positions absolues
+    texte->lignes[texte->lignes_gap_debut++] = 0;
+    for (int i = 0; i < len; i++) {
+        if (src[i] == '\n') texte->lignes[texte->lignes_gap_debut++] = i + 1;
+    }
+    return true;
+}
+
+int texte_copier(const GapBuffer* texte, int debut, int fin, char* dest, int max_len) {
+    if (!dest || max_len <= 0) return 0;
+
+    int longueur = texte_longueur(texte);
+    if (debut < 0) debut = 0;
+    if (fin > longueur) fin = longueur;
+    if (fin - debut > max_len - 1) fin = debut + max_len - 1;
+    if (fin <= debut) {
+        dest[0] = '\0';
+        return 0;
+    }
+
+    // Partie avant le trou, puis partie après
+    int n = 0;
+    if (debut < texte->gap_debut) {
+        int avant = min_int(fin, texte->gap_debut) - debut;
+        memcpy(dest, texte->data + debut, avant);
+        n = avant;
+    }
+    if (fin > texte->gap_debut) {
+        int depart = max_int(debut, texte->gap_debut);
+        int decalage = texte->gap_fin - texte->gap_debut;
+        memcpy(dest + n, texte->data + depart + decalage, fin - depart);
+        n += fin - depart;
+    }
+    dest[n] = '\0';
+    return n;
+}
+
+char* texte_extraire(const GapBuffer* texte, int debut, int fin) {
+    int longueur = texte_longueur(texte);
+    if (debut < 0) debut = 0;
+    if (fin > longueur) fin = longueur;
+    if (fin < debut) fin = debut;
+
+    char* copie = SAFE_MALLOC((size_t)(fin - debut) + 1);
+    if (!copie) return NULL;
+    texte_copier(texte, debut, fin, copie, fin - debut + 1);
+    return copie;
+}
+
+const char* texte_contigu(GapBuffer* texte) {
+    if (!texte->data) return "";
+    deplacer_trou(texte, texte_longueur(texte));
+    texte->data[texte->gap_debut] = '\0';
+    return texte->data;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LIGNES
+// ═══════════════════════════════════════════════════════════════════════════
+
+const char* obtenir_ligne(const GapBuffer* texte, int index_ligne, char* dest, int max_len) {
+    if (!dest || max_len <= 0) return dest;
+    if (!texte || index_ligne < 0) {
+        dest[0] = '\0';
+        return dest;
+    }
+
+    texte_copier(texte, debut_ligne(texte, index_ligne), fin_ligne(texte, index_ligne),
+                 dest, max_len);
+    return dest;
+}
+
+void position_vers_ligne_colonne(const GapBuffer* texte, int position, int* ligne, int* colonne) {
+    position = max_int(0, min_int(position, texte_longueur(texte)));
+    int l = ligne_a_position(texte, position);
+    if (ligne) *ligne = l;
+    if (colonne) *colonne = position - debut_ligne(texte, l);
+}
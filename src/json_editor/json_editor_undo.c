@@ -5,118 +5,317 @@
 #include <string.h>
 #include "core/memory/memory.h"
 
+// ═══════════════════════════════════════════════════════════════════════════
+// HISTORIQUE PAR OPÉRATIONS
+// ═══════════════════════════════════════════════════════════════════════════
+// Chaque modification du texte est enregistrée comme une opération (position,
+// texte supprimé, texte inséré) : une frappe coûte un octet, pas une copie
+// du document. Les frappes d'un même mot et les effacements qui se suivent
+// prolongent la dernière opération. L'historique est borné en octets : les
+// étapes les plus anciennes sont libérées au-delà de undo_max_octets.
+// ═══════════════════════════════════════════════════════════════════════════
 
+static ObjectPool undo_node_pool = OBJECT_POOL_INIT("UndoNode", UndoNode, 32);
 
-//  SAUVEGARDE UN SNAPSHOT DANS L'HISTORIQUE UNDO
-void sauvegarder_etat_undo(JsonEditor* editor) {
-    if (!editor) return;
+static void liberer_undo_node(JsonEditor* editor, UndoNode* node) {
+    editor->undo_octets -= sizeof(UndoNode) + node->supprime_capacite + node->insere_capacite;
+    editor->undo_count--;
+    if (node->supprime) SAFE_FREE(node->supprime);
+    if (node->insere) SAFE_FREE(node->insere);
+    POOL_FREE(undo_node_pool, node);
+}
 
-    // Créer un nouveau nœud
-    UndoNode* nouveau = SAFE_MALLOC(sizeof(UndoNode));
-    if (!nouveau) {
-        debug_printf("❌ UNDO: Erreur allocation mémoire\n");
-        return;
+// Historique devenu incohérent avec le texte (allocation impossible) : on
+// préfère tout oublier plutôt que d'annuler vers un état faux
+static void abandonner_historique(JsonEditor* editor) {
+    debug_printf("❌ UNDO: Erreur allocation, historique effacé\n");
+    liberer_historique_undo(editor);
+}
+
+// Réserve n octets à la fin (ou au début) d'un texte d'opération, capacité
+// doublée quand elle manque. Retourne l'emplacement à remplir
+static char* reserver_octets(JsonEditor* editor, char** texte, int* len, int* capacite,
+                             int n, bool au_debut) {
+    char* dest = *texte;
+    if (*len + n > *capacite) {
+        int nouvelle = max_int(16, (*len + n) * 2);
+        dest = SAFE_MALLOC(nouvelle);
+        if (!dest) return NULL;
+        if (*texte) {
+            memcpy(dest + (au_debut ? n : 0), *texte, *len);
+            SAFE_FREE(*texte);
+        }
+        editor->undo_octets += nouvelle - *capacite;
+        *capacite = nouvelle;
+        *texte = dest;
+    } else if (au_debut) {
+        memmove(dest + n, dest, *len);
     }
 
-    // Copier le buffer actuel
-    nouveau->buffer_snapshot = SAFE_MALLOC(strlen(editor->buffer) + 1);
-    if (!nouveau->buffer_snapshot) {
-        SAFE_FREE(nouveau);
-        debug_printf("❌ UNDO: Erreur allocation buffer\n");
-        return;
+    char* emplacement = dest + (au_debut ? 0 : *len);
+    *len += n;
+    return emplacement;
+}
+
+// Copie [debut, fin) du texte de l'éditeur dans l'emplacement réservé
+static void copier_depuis_texte(const GapBuffer* texte, int debut, int fin, char* dest) {
+    for (int i = debut; i < fin; i++) {
+        *dest++ = texte_car(texte, i);
     }
-    strcpy(nouveau->buffer_snapshot, editor->buffer);
+}
 
-    // Copier l'état
-    nouveau->curseur_position = editor->curseur_position;
-    nouveau->scroll_offset = editor->scroll_offset;
-    nouveau->scroll_offset_x = editor->scroll_offset_x;
+// Limite de mot pour la fusion : un mot commence entre gauche et droite
+static bool est_car_mot(char c) {
+    unsigned char u = (unsigned char)c;
+    return u >= 0x80 || (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') ||
+           (u >= '0' && u <= '9') || u == '_' || u == '-';
+}
 
-    // Insérer dans la liste chaînée
-    nouveau->prev = editor->current_undo;
-    nouveau->next = NULL;
+static bool debut_de_mot(char gauche, char droite) {
+    return !est_car_mot(gauche) && est_car_mot(droite);
+}
 
-    // Si on avait fait undo puis on modifie : on supprime tout le "futur"
-    if (editor->current_undo && editor->current_undo->next) {
-        UndoNode* temp = editor->current_undo->next;
-        while (temp) {
-            UndoNode* suivant = temp->next;
-            SAFE_FREE(temp->buffer_snapshot);
-            SAFE_FREE(temp);
-            temp = suivant;
-            editor->undo_count--;
+// Dernière opération, si la prochaine peut la prolonger
+static UndoNode* operation_fusionnable(JsonEditor* editor) {
+    if (editor->undo_nouvelle_etape || editor->undo_type == UNDO_ACTION) return NULL;
+    UndoNode* node = editor->current_undo;
+    return (node && !node->next) ? node : NULL;
+}
+
+// Libère les étapes les plus anciennes au-delà de la limite en octets
+// (jamais l'étape qui contient l'opération courante)
+static void limiter_historique(JsonEditor* editor) {
+    while (editor->undo_octets > editor->undo_max_octets && editor->undo_premier) {
+        UndoNode* fin = editor->undo_premier;
+        bool courante = (fin == editor->current_undo);
+        while (fin->next && fin->next->suite) {
+            fin = fin->next;
+            courante = courante || (fin == editor->current_undo);
         }
+        if (courante) break;
+
+        UndoNode* suivant = fin->next;
+        UndoNode* node = editor->undo_premier;
+        while (node != suivant) {
+            UndoNode* apres = node->next;
+            liberer_undo_node(editor, node);
+            node = apres;
+        }
+        editor->undo_premier = suivant;
+        if (suivant) suivant->prev = NULL;
+    }
+}
+
+// Ajoute une opération vide après l'opération courante
+static UndoNode* nouvelle_operation(JsonEditor* editor, int position) {
+    // Si on avait fait undo puis on modifie : on supprime tout le "futur"
+    UndoNode* futur = editor->current_undo ? editor->current_undo->next : editor->undo_premier;
+    if (futur == editor->undo_premier) editor->undo_premier = NULL;
+    while (futur) {
+        UndoNode* suivant = futur->next;
+        liberer_undo_node(editor, futur);
+        futur = suivant;
     }
+    if (editor->current_undo) editor->current_undo->next = NULL;
 
-    if (editor->current_undo) {
-        editor->current_undo->next = nouveau;
+    UndoNode* node = POOL_ALLOC(undo_node_pool);
+    if (!node) return NULL;
+
+    node->position = position;
+    node->curseur_avant = editor->curseur_position;
+    node->suite = !editor->undo_nouvelle_etape && editor->undo_type == UNDO_ACTION;
+    node->prev = editor->current_undo;
+    if (node->prev) {
+        node->prev->next = node;
+    } else {
+        editor->undo_premier = node;
     }
 
-    editor->current_undo = nouveau;
+    editor->current_undo = node;
     editor->undo_count++;
+    editor->undo_octets += sizeof(UndoNode);
+    editor->undo_nouvelle_etape = false;
+    return node;
+}
 
-    // Limiter l'historique (supprimer le plus ancien si on dépasse)
-    if (editor->undo_count > editor->max_undo_count) {
-        // Trouver le premier nœud
-        UndoNode* premier = editor->current_undo;
-        while (premier->prev) {
-            premier = premier->prev;
-        }
+//  DÉBUT D'UNE ÉTAPE
+void commencer_etape_undo(JsonEditor* editor, TypeEtapeUndo type) {
+    if (!editor) return;
+    if (type == UNDO_ACTION || type != editor->undo_type) {
+        editor->undo_nouvelle_etape = true;
+    }
+    editor->undo_type = type;
+}
 
-        // Supprimer le premier
-        if (premier->next) {
-            premier->next->prev = NULL;
-            SAFE_FREE(premier->buffer_snapshot);
-            SAFE_FREE(premier);
-            editor->undo_count--;
+//  MODIFICATIONS ENREGISTRÉES
+bool inserer_texte(JsonEditor* editor, int position, const char* src, int len) {
+    if (!editor || len <= 0) return true;
+    position = max_int(0, min_int(position, texte_longueur(&editor->texte)));
+
+    if (!texte_inserer(&editor->texte, position, src, len)) return false;
+
+    // Frappe dans le prolongement de l'opération précédente, même mot
+    UndoNode* node = operation_fusionnable(editor);
+    if (!node || editor->undo_type != UNDO_FRAPPE ||
+        position != node->position + node->insere_len ||
+        (node->insere_len > 0 && debut_de_mot(node->insere[node->insere_len - 1], src[0]))) {
+        node = nouvelle_operation(editor, position);
+    }
+
+    char* dest = node ? reserver_octets(editor, &node->insere, &node->insere_len,
+                                        &node->insere_capacite, len, false) : NULL;
+    if (!dest) {
+        abandonner_historique(editor);
+        return true;
+    }
+    memcpy(dest, src, len);
+    limiter_historique(editor);
+    return true;
+}
+
+void supprimer_texte(JsonEditor* editor, int debut, int fin) {
+    if (!editor) return;
+    debut = max_int(0, debut);
+    fin = min_int(fin, texte_longueur(&editor->texte));
+    if (fin <= debut) return;
+
+    // Effacement contigu à l'opération précédente (Backspace : devant,
+    // Suppr : derrière), sans franchir un début de mot
+    UndoNode* node = operation_fusionnable(editor);
+    bool au_debut = false;
+    if (node && editor->undo_type == UNDO_EFFACEMENT &&
+        node->insere_len == 0 && node->supprime_len > 0) {
+        if (fin == node->position &&
+            !debut_de_mot(texte_car(&editor->texte, fin - 1), node->supprime[0])) {
+            au_debut = true;
+        } else if (debut != node->position ||
+                   debut_de_mot(node->supprime[node->supprime_len - 1],
+                                texte_car(&editor->texte, debut))) {
+            node = NULL;
         }
+    } else {
+        node = NULL;
+    }
+    if (!node) node = nouvelle_operation(editor, debut);
+
+    char* dest = node ? reserver_octets(editor, &node->supprime, &node->supprime_len,
+                                        &node->supprime_capacite, fin - debut, au_debut) : NULL;
+    if (dest) {
+        copier_depuis_texte(&editor->texte, debut, fin, dest);
+        if (au_debut) node->position = debut;
     }
 
-    debug_printf("💾 UNDO: État sauvegardé (total: %d)\n", editor->undo_count);
+    texte_supprimer(&editor->texte, debut, fin);
+
+    if (!dest) {
+        abandonner_historique(editor);
+        return;
+    }
+    limiter_historique(editor);
 }
 
-//  UNDO : Revenir à l'état précédent
+bool remplacer_tout_le_texte(JsonEditor* editor, const char* src, int len) {
+    if (!editor) return false;
+    int longueur = texte_longueur(&editor->texte);
+
+    UndoNode* node = nouvelle_operation(editor, 0);
+    char* ancien = node ? reserver_octets(editor, &node->supprime, &node->supprime_len,
+                                          &node->supprime_capacite, longueur, false) : NULL;
+    char* nouveau = ancien ? reserver_octets(editor, &node->insere, &node->insere_len,
+                                             &node->insere_capacite, len, false) : NULL;
+    bool enregistre = (node && (longueur == 0 || ancien) && (len == 0 || nouveau));
+    if (enregistre) {
+        copier_depuis_texte(&editor->texte, 0, longueur, ancien);
+        memcpy(nouveau, src, len);
+    }
+
+    if (!texte_remplacer(&editor->texte, src, len)) {
+        abandonner_historique(editor);
+        return false;
+    }
+    if (!enregistre) {
+        abandonner_historique(editor);
+        return true;
+    }
+    limiter_historique(editor);
+    return true;
+}
+
+//  UNDO : Annuler la dernière étape
 void faire_undo(JsonEditor* editor) {
-    if (!editor || !editor->current_undo || !editor->current_undo->prev) {
+    if (!editor || !editor->current_undo) {
         debug_printf("⏪ UNDO: Pas d'état précédent\n");
         return;
     }
 
-    // Revenir à l'état précédent
-    editor->current_undo = editor->current_undo->prev;
-
-    // Restaurer l'état
-    strncpy(editor->buffer, editor->current_undo->buffer_snapshot, JSON_BUFFER_SIZE - 1);
-    editor->buffer[JSON_BUFFER_SIZE - 1] = '\0';
+    // Opérations de l'étape, de la dernière à la première
+    UndoNode* node;
+    do {
+        node = editor->current_undo;
+        texte_supprimer(&editor->texte, node->position, node->position + node->insere_len);
+        if (!texte_inserer(&editor->texte, node->position, node->supprime, node->supprime_len)) {
+            abandonner_historique(editor);
+            break;
+        }
+        editor->curseur_position = node->curseur_avant;
+        editor->current_undo = node->prev;
+    } while (node->suite && editor->current_undo);
 
-    editor->curseur_position = editor->current_undo->curseur_position;
-    editor->scroll_offset = editor->current_undo->scroll_offset;
-    editor->scroll_offset_x = editor->current_undo->scroll_offset_x;
-    editor->nb_lignes = compter_lignes(editor->buffer);
+    editor->undo_nouvelle_etape = true;
+    editor->nb_lignes = compter_lignes(&editor->texte);
     editor->modified = true;
+    deselectionner(editor);
+    auto_scroll_curseur(editor);
 
     debug_printf("⏪ UNDO: Retour à l'état précédent (curseur=%d)\n", editor->curseur_position);
 }
 
-//  REDO : Avancer vers l'état suivant
+//  REDO : Rejouer l'étape suivante
 void faire_redo(JsonEditor* editor) {
-    if (!editor || !editor->current_undo || !editor->current_undo->next) {
+    UndoNode* node = NULL;
+    if (editor) {
+        node = editor->current_undo ? editor->current_undo->next : editor->undo_premier;
+    }
+    if (!node) {
         debug_printf("⏩ REDO: Pas d'état suivant\n");
         return;
     }
 
-    // Avancer vers l'état suivant
-    editor->current_undo = editor->current_undo->next;
-
-    // Restaurer l'état
-    strncpy(editor->buffer, editor->current_undo->buffer_snapshot, JSON_BUFFER_SIZE - 1);
-    editor->buffer[JSON_BUFFER_SIZE - 1] = '\0';
+    // Opérations de l'étape, dans l'ordre
+    do {
+        texte_supprimer(&editor->texte, node->position, node->position + node->supprime_len);
+        if (!texte_inserer(&editor->texte, node->position, node->insere, node->insere_len)) {
+            abandonner_historique(editor);
+            break;
+        }
+        editor->curseur_position = node->position + node->insere_len;
+        editor->current_undo = node;
+        node = node->next;
+    } while (node && node->suite);
 
-    editor->curseur_position = editor->current_undo->curseur_position;
-    editor->scroll_offset = editor->current_undo->scroll_offset;
-    editor->scroll_offset_x = editor->current_undo->scroll_offset_x;
-    editor->nb_lignes = compter_lignes(editor->buffer);
+    editor->undo_nouvelle_etape = true;
+    editor->nb_lignes = compter_lignes(&editor->texte);
     editor->modified = true;
+    deselectionner(editor);
+    auto_scroll_curseur(editor);
 
     debug_printf("⏩ REDO: Avance à l'état suivant (curseur=%d)\n", editor->curseur_position);
 }
+
+//  LIBÉRATION DE L'HISTORIQUE
+void liberer_historique_undo(JsonEditor* editor) {
+    if (!editor) return;
+
+    UndoNode* node = editor->undo_premier;
+    while (node) {
+        UndoNode* suivant = node->next;
+        liberer_undo_node(editor, node);
+        node = suivant;
+    }
+
+    editor->current_undo = NULL;
+    editor->undo_premier = NULL;
+    editor->undo_count = 0;
+    editor->undo_octets = 0;
+    editor->undo_nouvelle_etape = true;
+}
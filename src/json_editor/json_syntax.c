@@ -55,7 +55,9 @@ static bool est_mot_cle(const char* str, int* longueur) {
 LigneColoree* parser_ligne_json(const char* ligne) {
     if (!ligne) return NULL;
 
-    LigneColoree* resultat = SAFE_MALLOC(sizeof(LigneColoree));
+    // Résultat temporaire : vit dans l'arène de frame (parsé seulement quand
+    // la ligne n'a pas de texture dans le cache de rendu)
+    LigneColoree* resultat = FRAME_ALLOC(sizeof(LigneColoree));
     if (!resultat) return NULL;
 
     resultat->nb_segments = 0;
@@ -201,8 +203,7 @@ LigneColoree* parser_ligne_json(const char* ligne) {
 }
 
 //  LIBÉRATION MÉMOIRE
+// La ligne est dans l'arène de frame : rendue au prochain frame_arena_reset()
 void liberer_ligne_coloree(LigneColoree* ligne) {
-    if (ligne) {
-        SAFE_FREE(ligne);
-    }
+    (void)ligne;
 }
@@ -34,12 +34,13 @@ typedef struct {
 //  PROTOTYPES
 
 // Parse une ligne de JSON et retourne les segments colorés
+// (alloué dans l'arène de frame : valide jusqu'à la fin de la frame)
 LigneColoree* parser_ligne_json(const char* ligne);
 
 // Retourne la couleur SDL associée à un type de token
 SDL_Color obtenir_couleur_token(TypeToken type);
 
-// Libère la mémoire d'une ligne colorée
+// Libère la mémoire d'une ligne colorée (no-op, conservé pour l'API)
 void liberer_ligne_coloree(LigneColoree* ligne);
 
 #endif
@@ -11,6 +11,10 @@
 #include "core/renderer.h"
 #include "core/config.h"
 #include "core/debug.h"
+#include "core/trace.h"
+#include "core/config_deps.h"
+#include "core/startup_timeline.h"
+#include "core/input_coalesce.h"
 #include "core/widget_base.h"
 #include "core/timer.h"
 #include "core/counter.h"
@@ -19,11 +23,14 @@
 #include "instances/technique_instance.h"
 #include "instances/whm/whm.h"
 #include "core/memory/memory.h"
+#include "core/stats_exchange.h"
 
 
 
 void init_debug_mode(int argc, char **argv) {
     int debug_enabled = 0;
+    const char* trace_path = NULL;
+    bool trace_requested = false;
 
     // Vérifier les arguments
     for (int i = 1; i < argc; i++) {
@@ -32,6 +39,24 @@ void init_debug_mode(int argc, char **argv) {
         }
         if (strcmp(argv[i], "--verbose") == 0 || strcmp(argv[i], "-v") == 0) {
             verbose_mode = 1;
+            debug_log_level = LOG_LEVEL_VERBOSE;
+        }
+        if (strncmp(argv[i], "--log-level=", 12) == 0) {
+            const char* level = argv[i] + 12;
+            if (strcmp(level, "error") == 0) debug_log_level = LOG_LEVEL_ERROR;
+            else if (strcmp(level, "warn") == 0) debug_log_level = LOG_LEVEL_WARN;
+            else if (strcmp(level, "info") == 0) debug_log_level = LOG_LEVEL_INFO;
+            else if (strcmp(level, "verbose") == 0) debug_log_level = LOG_LEVEL_VERBOSE;
+            verbose_mode = (debug_log_level >= LOG_LEVEL_VERBOSE);
+        }
+        if (strcmp(argv[i], "--track-memory") == 0) {
+            memory_enable_tracking(true);
+        }
+        if (strcmp(argv[i], "--trace") == 0) {
+            trace_requested = true;
+        } else if (strncmp(argv[i], "--trace=", 8) == 0) {
+            trace_requested = true;
+            trace_path = argv[i] + 8;
         }
     }
 
@@ -52,6 +77,9 @@ void init_debug_mode(int argc, char **argv) {
 
             setbuf(stdout, NULL);
 
+            // À partir d'ici, plus d'I/O dans les appels à debug_printf
+            debug_logger_start();
+
             time_t now = time(NULL);
             debug_printf("=== DÉBUT SESSION DEBUG - %s ===\n", ctime(&now));
             debug_printf("✅ Mode debug activé - logs dans debug.txt\n");
@@ -60,10 +88,19 @@ void init_debug_mode(int argc, char **argv) {
             }
         }
     }
+
+    // Après l'ouverture de debug.txt pour que le message d'activation y figure
+    if (trace_requested) {
+        trace_init(trace_path);
+    }
 }
 
 void cleanup_debug_mode() {
     if (debug_file) {
+        // Vider le buffer du logger puis écrire ses compteurs en synchrone
+        debug_logger_stop();
+        debug_logger_report();
+
         time_t now = time(NULL);
         fprintf(debug_file, "=== FIN SESSION DEBUG - %s ===\n", ctime(&now));
         fclose(debug_file);
@@ -74,9 +111,18 @@ void cleanup_debug_mode() {
 /*------------------------------------------- MAIN --------------------------------------------*/
 
 int main(int argc, char **argv) {
+    startup_mark("main");
 
     // Initialiser le mode debug si demandé
     init_debug_mode(argc, argv);
+    startup_mark("mode debug");
+
+    // --export-stats / --import-stats : traités sans ouvrir de fenêtre
+    int stats_exit = stats_exchange_cli(argc, argv);
+    if (stats_exit >= 0) {
+        cleanup_debug_mode();
+        return stats_exit;
+    }
 
 
     /*------------------------------------------------------------*/
@@ -86,6 +132,7 @@ int main(int argc, char **argv) {
     HexagoneList* hex_list = NULL;
     AppConfig config;
     SDL_Event event;
+    static SDL_Event frame_events[INPUT_BATCH_MAX];  // Lot d'événements de la frame
     int done = 1;
 
     // Charger la configuration
@@ -255,6 +302,8 @@ int main(int argc, char **argv) {
                      app.current_session, app.total_sessions);
     }
 
+    startup_mark("composants de session (hexagones, timers, compteur, carte)");
+
     /*------------------------------------------------------------*/
 
     // ═══════════════════════════════════════════════════════════════════════════
@@ -278,8 +327,14 @@ int main(int argc, char **argv) {
     while (done) {
         frame_start = SDL_GetTicks();
 
-        // Gestion événements
-        while (SDL_PollEvent(&event)) {
+        // Rendre la mémoire temporaire de la frame précédente
+        frame_arena_reset();
+
+        // Gestion événements (mouvements et molette regroupés)
+        int event_count = input_poll_coalesced(frame_events, INPUT_BATCH_MAX);
+        for (int e = 0; e < event_count; e++) {
+            event = frame_events[e];
+
             // Si une technique est active, déléguer les événements à l'instance
             if (app.active_technique) {
                 TechniqueInstance* instance = (TechniqueInstance*)app.active_technique;
@@ -363,9 +418,30 @@ int main(int argc, char **argv) {
             regulate_fps(frame_start);
 
             // Continuer la boucle (skip le code ancien ci-dessous)
+            app.precompute_idle_since = 0;
             continue;
         }
 
+        // ═════════════════════════════════════════════════════════════════════
+        // PRÉ-CALCULS INUTILISÉS (~100 MB)
+        // ═════════════════════════════════════════════════════════════════════
+        // Gardés après une session pour qu'un nouveau clic sur Wim les
+        // réutilise (config_deps), libérés après PRECOMPUTE_IDLE_MS sur l'écran d'accueil
+        if (!app.waiting_to_start) {
+            app.precompute_idle_since = 0;
+        } else if (app.hexagones && app.hexagones->first && app.hexagones->first->precomputed_vx) {
+            Uint32 now = SDL_GetTicks();
+            if (!app.precompute_idle_since) {
+                app.precompute_idle_since = now;
+            } else if (now - app.precompute_idle_since >= PRECOMPUTE_IDLE_MS) {
+                free_precomputed_data(app.hexagones);
+                derived_invalidate(DERIVED_HEXAGON_TABLES);
+                app.precompute_idle_since = 0;
+                debug_printf("🗑️  Pré-calculs libérés (inutilisés depuis %d s)\n",
+                             PRECOMPUTE_IDLE_MS / 1000);
+            }
+        }
+
         // ═════════════════════════════════════════════════════════════════════
         // MISE À JOUR DU PANNEAU STATS (s'il est ouvert)
         // ═════════════════════════════════════════════════════════════════════
@@ -1074,6 +1150,11 @@ int main(int argc, char **argv) {
     // === NETTOYAGE ===
     debug_printf("Nettoyage...\n");
 
+    size_t events_received, events_dispatched;
+    input_coalesce_stats(&events_received, &events_dispatched);
+    debug_printf("🖱️ INPUT: %zu événements reçus, %zu transmis après regroupement\n",
+                 events_received, events_dispatched);
+
     // Libérer le timer
     if (app.session_timer) {
         timer_destroy(app.session_timer);
@@ -1104,16 +1185,55 @@ int main(int argc, char **argv) {
         app.session_times = NULL;
     }
 
+    // Technique en cours + composants WHM conservés (polices TTF, textures)
+    if (app.active_technique) {
+        technique_destroy((TechniqueInstance*)app.active_technique);
+        app.active_technique = NULL;
+    }
+    whm_release_retained();
+
+    if (debug_file) {
+        derived_report();
+    }
+
     // Libérer les polices AVANT TTF_Quit
     cleanup_font_manager();
     TTF_Quit();
 
-    cleanup_debug_mode();
-
     free_hexagone_list(hex_list);
 
     cleanup_app(&app);
 
+    // Écrire la trace (--trace) avant les rapports : ses buffers sont trackés
+    trace_shutdown();
+
+    // Rapports mémoire : churn + pools avec --track-memory, pools seuls en --debug
+    if (memory_is_tracking_enabled()) {
+        memory_report_churn(20);
+    } else if (debug_file) {
+        memory_report_pools();
+    }
+
+    // Arène de frame et pools : libérés avant le rapport de fuites
+    // (leurs blocs sont trackés)
+    if (debug_file) {
+        frame_arena_report();
+    }
+    frame_arena_cleanup();
+    memory_pools_cleanup();
+
+    // Buffer du logger tracké lui aussi : arrêt avant le rapport de fuites
+    // (la suite s'écrit en synchrone)
+    debug_logger_stop();
+
+    if (memory_is_tracking_enabled()) {
+        memory_report_leaks();
+        memory_cleanup_tracking();
+    }
+
     debug_printf("Application terminée\n");
+
+    // En dernier : les rapports ci-dessus écrivent encore dans debug.txt
+    cleanup_debug_mode();
     return EXIT_SUCCESS;
 }  // <-- FIN DU main()
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// check.h
+// VÉRIFICATIONS AUTONOMES (make check)
+// Chaque tests/test_*.c est un petit exécutable qui vérifie de la logique
+// pure (sans fenêtre ni renderer) : CHECK compte les échecs et affiche
+// fichier:ligne de chacun, CHECK_DONE() donne le code de sortie de main.
+//
+// Les tests sont lancés depuis obj/tests/bin : les chemins ../config/...
+// de paths.h tombent dans obj/tests/config, jamais dans la vraie config.
+
+#ifndef __CHECK_H__
+#define __CHECK_H__
+
+#include <stdio.h>
+
+static int check_count = 0;
+static int check_failures = 0;
+
+#define CHECK(cond) do {                                                    \
+    check_count++;                                                          \
+    if (!(cond)) {                                                          \
+        check_failures++;                                                   \
+        fprintf(stderr, "❌ %s:%d: %s\n", __FILE__, __LINE__, #cond);       \
+    }                                                                       \
+} while (0)
+
+#define CHECK_EQ_INT(actual, expected) do {                                 \
+    long long check_a = (long long)(actual);                                \
+    long long check_e = (long long)(expected);                              \
+    check_count++;                                                          \
+    if (check_a != check_e) {                                               \
+        check_failures++;                                                   \
+        fprintf(stderr, "❌ %s:%d: %s = %lld, attendu %lld\n",               \
+                __FILE__, __LINE__, #actual, check_a, check_e);             \
+    }                                                                       \
+} while (0)
+
+#define CHECK_DONE() (                                                      \
+    printf("%s %s : %d vérification(s), %d échec(s)\n",                     \
+           check_failures ? "❌" : "✅", __FILE__, check_count, check_failures), \
+    check_failures ? 1 : 0)
+
+#endif
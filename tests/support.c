@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// support.c
+#include "support.h"
+#include <stdio.h>
+
+const char* const FICHIER = "echange.tmp";
+
+static unsigned int seed = 1;
+
+void aleatoire_graine(unsigned int graine) {
+    seed = graine;
+}
+
+int aleatoire(int n) {
+    seed = seed * 1103515245u + 12345u;
+    return (int)((seed >> 16) % (unsigned int)n);
+}
+
+void ecrire_fichier(const char* contenu) {
+    FILE* file = fopen(FICHIER, "w");
+    if (!file) return;
+    fputs(contenu, file);
+    fclose(file);
+}
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// support.h
+// OUTILS COMMUNS DES VÉRIFICATIONS (make check)
+// Générateur déterministe, exercice tiré et fichier d'échange temporaire,
+// partagés par les tests/test_*.c (support.c lié une fois à chacun).
+
+#ifndef __SUPPORT_H__
+#define __SUPPORT_H__
+
+#include <stdbool.h>
+#include <time.h>
+
+#define EXERCICE_SESSIONS_MAX 8
+
+// Exercice tiré par un test (mêmes champs qu'une entrée du journal)
+typedef struct {
+    time_t timestamp;
+    float times[EXERCICE_SESSIONS_MAX];
+    int count;
+} Exercice;
+
+// Fichier temporaire des tests d'import/export (dans obj/tests/bin)
+extern const char* const FICHIER;
+
+/**
+ * Choisir la graine du générateur (chaque test a la sienne : résultats
+ * identiques d'un lancement et d'une machine à l'autre)
+ */
+void aleatoire_graine(unsigned int graine);
+
+/**
+ * Entier tiré dans [0, n[ (générateur congruentiel linéaire)
+ */
+int aleatoire(int n);
+
+/**
+ * Remplacer le contenu de FICHIER
+ */
+void ecrire_fichier(const char* contenu);
+
+#endif
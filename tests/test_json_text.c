@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// test_json_text.c
+// TEXTE DE L'ÉDITEUR JSON (GAP BUFFER + INDEX DES LIGNES)
+// Éditions aléatoires appliquées en parallèle au gap buffer et à une chaîne
+// de référence : le texte, les copies et la version contiguë doivent rester
+// identiques quel que soit le déplacement du trou, et l'index des lignes
+// doit donner les mêmes débuts de ligne qu'un parcours de la référence.
+
+#include "check.h"
+#include "support.h"
+#include "json_editor/json_editor.h"
+#include <string.h>
+
+#define REFERENCE_MAX 65536
+#define ITERATIONS 20000
+
+static char reference[REFERENCE_MAX + 1];
+static int reference_len = 0;
+
+static bool meme_texte(const GapBuffer* texte) {
+    if (texte_longueur(texte) != reference_len) return false;
+    for (int i = 0; i < reference_len; i++) {
+        if (texte_car(texte, i) != reference[i]) return false;
+    }
+    return texte_car(texte, reference_len) == '\0' && texte_car(texte, -1) == '\0';
+}
+
+// Index des lignes comparé à un parcours de la référence
+static bool memes_lignes(const GapBuffer* texte) {
+    int ligne = 0;
+    int colonne = 0;
+    for (int pos = 0; pos <= reference_len; pos++) {
+        int l, c;
+        position_vers_ligne_colonne(texte, pos, &l, &c);
+        if (l != ligne || c != colonne || ligne_a_position(texte, pos) != ligne) return false;
+
+        if (pos < reference_len && reference[pos] == '\n') {
+            if (fin_ligne(texte, ligne) != pos) return false;
+            ligne++;
+            colonne = 0;
+            if (debut_ligne(texte, ligne) != pos + 1) return false;
+        } else {
+            colonne++;
+        }
+    }
+    return compter_lignes(texte) == ligne + 1 &&
+           fin_ligne(texte, ligne) == reference_len &&
+           debut_ligne(texte, 0) == 0;
+}
+
+static void reference_inserer(int pos, const char* src, int len) {
+    memmove(reference + pos + len, reference + pos, reference_len - pos);
+    memcpy(reference + pos, src, len);
+    reference_len += len;
+}
+
+static void reference_supprimer(int debut, int fin) {
+    memmove(reference + debut, reference + fin, reference_len - fin);
+    reference_len -= fin - debut;
+}
+
+static void cas_limites(void) {
+    GapBuffer texte;
+    CHECK(texte_init(&texte));
+    CHECK_EQ_INT(texte_longueur(&texte), 0);
+    CHECK(strcmp(texte_contigu(&texte), "") == 0);
+
+    CHECK(texte_inserer(&texte, 0, "abc", 3));
+    CHECK(texte_inserer(&texte, 3, "def", 3));      // En fin de texte
+    CHECK(texte_inserer(&texte, 0, "<", 1));        // En tête
+    CHECK(strcmp(texte_contigu(&texte), "<abcdef") == 0);
+
+    texte_supprimer(&texte, 5, 100);                // Fin au-delà du texte
+    CHECK(strcmp(texte_contigu(&texte), "<abcd") == 0);
+    CHECK_EQ_INT(compter_lignes(&texte), 1);
+    texte_supprimer(&texte, 2, 2);                  // Plage vide
+    CHECK_EQ_INT(texte_longueur(&texte), 5);
+
+    char copie[4];
+    CHECK_EQ_INT(texte_copier(&texte, 1, 5, copie, sizeof(copie)), 3);  // Tronqué à max_len - 1
+    CHECK(strcmp(copie, "abc") == 0);
+
+    CHECK(texte_remplacer(&texte, "x", 1));
+    CHECK(strcmp(texte_contigu(&texte), "x") == 0);
+    CHECK(texte_remplacer(&texte, "", 0));
+    CHECK_EQ_INT(texte_longueur(&texte), 0);
+    CHECK_EQ_INT(compter_lignes(&texte), 1);
+
+    // Lignes : texte remplacé, puis sauts ajoutés et retirés autour du trou
+    const char* objet = "{\n  \"a\": 1\n}";
+    const char* ajout = ",\n  \"b\": 2";
+    CHECK(texte_remplacer(&texte, objet, (int)strlen(objet)));
+    CHECK_EQ_INT(compter_lignes(&texte), 3);
+    CHECK_EQ_INT(debut_ligne(&texte, 1), 2);
+    CHECK_EQ_INT(fin_ligne(&texte, 1), 10);
+    char ligne[32];
+    CHECK(strcmp(obtenir_ligne(&texte, 1, ligne, sizeof(ligne)), "  \"a\": 1") == 0);
+    CHECK(strcmp(obtenir_ligne(&texte, 3, ligne, sizeof(ligne)), "") == 0);   // Au-delà : vide
+
+    CHECK(texte_inserer(&texte, 10, ajout, (int)strlen(ajout)));
+    CHECK_EQ_INT(compter_lignes(&texte), 4);
+    CHECK(strcmp(obtenir_ligne(&texte, 2, ligne, sizeof(ligne)), "  \"b\": 2") == 0);
+    CHECK_EQ_INT(debut_ligne(&texte, 3), 21);
+
+    texte_supprimer(&texte, 1, 21);                 // Supprime trois sauts d'un coup
+    CHECK(strcmp(texte_contigu(&texte), "{}") == 0);
+    CHECK_EQ_INT(compter_lignes(&texte), 1);
+    CHECK_EQ_INT(debut_ligne(&texte, 5), 2);        // Ligne absente : fin du texte
+
+    texte_liberer(&texte);
+}
+
+static void editions_aleatoires(void) {
+    GapBuffer texte;
+    CHECK(texte_init(&texte));
+    bool ok = true;
+
+    for (int it = 0; it < ITERATIONS && ok; it++) {
+        int pos = reference_len ? aleatoire(reference_len + 1) : 0;
+        int op = aleatoire(10);
+
+        if (op < 6) {
+            // Frappes courtes et quelques collages plus longs
+            char buffer[64];
+            int len = 1 + aleatoire(op == 0 ? 60 : 3);
+            if (reference_len + len >= REFERENCE_MAX) continue;  // Place du '{' final
+            for (int k = 0; k < len; k++) buffer[k] = "ab\nc{}"[aleatoire(6)];
+            ok = texte_inserer(&texte, pos, buffer, len);
+            reference_inserer(pos, buffer, len);
+        } else if (op < 9) {
+            int fin = pos + aleatoire(5);
+            if (fin > reference_len) fin = reference_len;
+            texte_supprimer(&texte, pos, fin);
+            reference_supprimer(pos, fin);
+        } else {
+            char copie[100];
+            int fin = pos + aleatoire(90);
+            int copies = texte_copier(&texte, pos, fin, copie, sizeof(copie));
+            if (fin > reference_len) fin = reference_len;
+            ok = copies == fin - pos && memcmp(copie, reference + pos, copies) == 0;
+        }
+
+        if (ok && it % 97 == 0) ok = meme_texte(&texte) && memes_lignes(&texte);
+    }
+    CHECK(ok);
+    CHECK(meme_texte(&texte));
+    CHECK(memes_lignes(&texte));
+
+    reference[reference_len] = '\0';
+    CHECK(strcmp(texte_contigu(&texte), reference) == 0);
+    // Après texte_contigu, le trou est en fin : les éditions continuent
+    CHECK(texte_inserer(&texte, 0, "{", 1));
+    reference_inserer(0, "{", 1);
+    CHECK(meme_texte(&texte));
+    CHECK(memes_lignes(&texte));
+
+    // Remplacement complet : index reconstruit
+    reference[reference_len] = '\0';
+    CHECK(texte_remplacer(&texte, reference + reference_len / 2, reference_len - reference_len / 2));
+    reference_supprimer(0, reference_len / 2);
+    CHECK(meme_texte(&texte));
+    CHECK(memes_lignes(&texte));
+
+    texte_liberer(&texte);
+}
+
+int main(void) {
+    aleatoire_graine(12345);
+    cas_limites();
+    editions_aleatoires();
+    return CHECK_DONE();
+}
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// test_json_undo.c
+// HISTORIQUE UNDO/REDO DE L'ÉDITEUR JSON
+// - Fusion : une étape par mot tapé, une par suite d'effacements
+// - Rejeu : une suite d'étapes aléatoires (plusieurs opérations chacune) est
+//   annulée jusqu'au début puis rejouée, le texte comparé à chaque étape
+// - Limite en octets : les étapes les plus anciennes sont oubliées
+
+#include "check.h"
+#include "support.h"
+#include "json_editor/json_editor.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ETAPES 300
+#define TEXTE_MAX 4096
+
+// Côté affichage de l'éditeur (json_editor_edit.c, json_editor_navigation.c) :
+// seul l'état de la sélection compte ici
+void deselectionner(JsonEditor* editor) {
+    editor->selection_active = false;
+    editor->selection_start = -1;
+    editor->selection_end = -1;
+}
+
+void auto_scroll_curseur(JsonEditor* editor) {
+    (void)editor;
+}
+
+static void editeur_init(JsonEditor* editor) {
+    memset(editor, 0, sizeof(*editor));
+    texte_init(&editor->texte);
+    editor->undo_max_octets = UNDO_MAX_OCTETS;
+    editor->undo_nouvelle_etape = true;
+}
+
+static void editeur_liberer(JsonEditor* editor) {
+    liberer_historique_undo(editor);
+    texte_liberer(&editor->texte);
+}
+
+static bool texte_egal(JsonEditor* editor, const char* attendu) {
+    return strcmp(texte_contigu(&editor->texte), attendu) == 0;
+}
+
+// Frappe d'un caractère au curseur, comme inserer_caractere
+static void taper(JsonEditor* editor, const char* texte) {
+    for (int i = 0; texte[i]; i++) {
+        commencer_etape_undo(editor, UNDO_FRAPPE);
+        inserer_texte(editor, editor->curseur_position, &texte[i], 1);
+        editor->curseur_position++;
+    }
+}
+
+static void backspace(JsonEditor* editor, int fois) {
+    for (int i = 0; i < fois; i++) {
+        commencer_etape_undo(editor, UNDO_EFFACEMENT);
+        supprimer_texte(editor, editor->curseur_position - 1, editor->curseur_position);
+        editor->curseur_position--;
+    }
+}
+
+static void fusion_des_etapes(void) {
+    JsonEditor editor;
+    editeur_init(&editor);
+
+    // Un mot par étape : l'espace reste avec le mot qui le précède
+    taper(&editor, "hello world");
+    CHECK(texte_egal(&editor, "hello world"));
+    faire_undo(&editor);
+    CHECK(texte_egal(&editor, "hello "));
+    CHECK_EQ_INT(editor.curseur_position, 6);
+    faire_undo(&editor);
+    CHECK(texte_egal(&editor, ""));
+    faire_undo(&editor);                            // Rien à annuler
+    CHECK(texte_egal(&editor, ""));
+    faire_redo(&editor);
+    faire_redo(&editor);
+    CHECK(texte_egal(&editor, "hello world"));
+    CHECK_EQ_INT(editor.curseur_position, 11);
+
+    // Effacements enchaînés dans le même mot : une seule étape
+    backspace(&editor, 3);
+    CHECK(texte_egal(&editor, "hello wo"));
+    faire_undo(&editor);
+    CHECK(texte_egal(&editor, "hello world"));
+
+    // Action isolée de plusieurs opérations : annulée et rejouée d'un bloc
+    commencer_etape_undo(&editor, UNDO_ACTION);
+    supprimer_texte(&editor, 0, 5);
+    inserer_texte(&editor, 0, "bonjour", 7);
+    CHECK(texte_egal(&editor, "bonjour world"));
+    faire_undo(&editor);
+    CHECK(texte_egal(&editor, "hello world"));
+    faire_redo(&editor);
+    CHECK(texte_egal(&editor, "bonjour world"));
+
+    // Modifier après un undo oublie le futur
+    faire_undo(&editor);
+    editor.curseur_position = 0;
+    taper(&editor, "!");
+    faire_redo(&editor);
+    CHECK(texte_egal(&editor, "!hello world"));
+
+    commencer_etape_undo(&editor, UNDO_ACTION);
+    remplacer_tout_le_texte(&editor, "{}", 2);
+    CHECK(texte_egal(&editor, "{}"));
+    faire_undo(&editor);
+    CHECK(texte_egal(&editor, "!hello world"));
+
+    editeur_liberer(&editor);
+    CHECK_EQ_INT(editor.undo_count, 0);
+    CHECK_EQ_INT(editor.undo_octets, 0);
+}
+
+static void rejeu_aleatoire(void) {
+    JsonEditor editor;
+    editeur_init(&editor);
+    char* etats[ETAPES + 1];
+    etats[0] = strdup("");
+
+    for (int e = 1; e <= ETAPES; e++) {
+        commencer_etape_undo(&editor, UNDO_ACTION);
+        int operations = 1 + aleatoire(3);
+        for (int op = 0; op < operations; op++) {
+            int longueur = texte_longueur(&editor.texte);
+            int pos = aleatoire(longueur + 1);
+            if (aleatoire(3) == 0 && longueur > 0) {
+                supprimer_texte(&editor, pos, pos + 1 + aleatoire(8));
+            } else if (longueur < TEXTE_MAX - 16) {
+                char morceau[16];
+                int n = 1 + aleatoire(15);
+                for (int k = 0; k < n; k++) morceau[k] = "{}\"a1 \n,:"[aleatoire(9)];
+                inserer_texte(&editor, pos, morceau, n);
+            }
+        }
+        etats[e] = strdup(texte_contigu(&editor.texte));
+    }
+
+    bool ok = true;
+    for (int e = ETAPES; e > 0 && ok; e--) {
+        faire_undo(&editor);
+        ok = texte_egal(&editor, etats[e - 1]);
+    }
+    CHECK(ok);
+    CHECK(editor.current_undo == NULL);
+
+    for (int e = 1; e <= ETAPES && ok; e++) {
+        faire_redo(&editor);
+        ok = texte_egal(&editor, etats[e]);
+    }
+    CHECK(ok);
+    CHECK_EQ_INT(editor.nb_lignes, compter_lignes(&editor.texte));
+
+    for (int e = 0; e <= ETAPES; e++) free(etats[e]);
+    editeur_liberer(&editor);
+}
+
+static void limite_en_octets(void) {
+    JsonEditor editor;
+    editeur_init(&editor);
+    editor.undo_max_octets = 4096;
+
+    char bloc[1000];
+    memset(bloc, 'a', sizeof(bloc));
+    for (int i = 0; i < 100; i++) {
+        commencer_etape_undo(&editor, UNDO_ACTION);
+        inserer_texte(&editor, 0, bloc, sizeof(bloc));
+    }
+    CHECK(editor.undo_octets <= editor.undo_max_octets);
+    CHECK(editor.undo_count > 0 && editor.undo_count < 100);
+
+    // Les étapes restantes s'annulent encore exactement
+    int restantes = editor.undo_count;
+    while (editor.current_undo) faire_undo(&editor);
+    CHECK_EQ_INT(texte_longueur(&editor.texte), (100 - restantes) * (int)sizeof(bloc));
+
+    editeur_liberer(&editor);
+}
+
+int main(void) {
+    aleatoire_graine(4242);
+    fusion_des_etapes();
+    rejeu_aleatoire();
+    limite_en_octets();
+    return CHECK_DONE();
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// test_stats_dedup.c
+// DOUBLONS À L'IMPORT DE L'HISTORIQUE
+// Vérifiés par l'extérieur (stats_export / stats_import) :
+// - Réimport d'un export : tout est doublon, même au-delà de la première
+//   capacité de l'ensemble des empreintes
+// - Temps à 0.5 seconde près de part et d'autre d'un arrondi (62.49 / 62.51) :
+//   doublon ; écart plus grand, autre nombre de sessions ou autre date : ajouté
+// - Même exercice deux fois dans le fichier : ajouté une fois
+
+#include "check.h"
+#include "support.h"
+#include "core/stats_exchange.h"
+#include "core/stats_store.h"
+#include <stdio.h>
+
+#define EXERCICES 3000              // Plus que la capacité initiale (1024 cases à moitié pleines)
+#define DATE_BASE 1600000000
+
+static int exercices_du_journal(void) {
+    ExerciseHistory history;
+    int count = stats_store_load(&history);
+    free_exercise_history(&history);
+    return count;
+}
+
+static void reimport_d_un_export(void) {
+    stats_store_reset();
+    bool ok = true;
+    for (int i = 0; i < EXERCICES && ok; i++) {
+        float times[3] = { 60.0f + (float)(i % 7), 30.25f, 90.5f };
+        ok = stats_store_append(DATE_BASE + (time_t)i * 600, times, 1 + i % 3);
+    }
+    CHECK(ok);
+
+    CHECK_EQ_INT(stats_export(FICHIER, STATS_FORMAT_CSV), EXERCICES);
+    StatsImportResult result;
+    CHECK(stats_import(FICHIER, &result));
+    CHECK_EQ_INT(result.imported, 0);
+    CHECK_EQ_INT(result.duplicates, EXERCICES);
+    CHECK_EQ_INT(result.invalid, 0);
+
+    CHECK_EQ_INT(stats_export(FICHIER, STATS_FORMAT_JSONL), EXERCICES);
+    CHECK(stats_import(FICHIER, &result));
+    CHECK_EQ_INT(result.duplicates, EXERCICES);
+    CHECK_EQ_INT(exercices_du_journal(), EXERCICES);
+    remove(FICHIER);
+}
+
+static void tolerance_des_temps(void) {
+    stats_store_reset();
+    float connus[2] = { 62.49f, 12.0f };
+    CHECK(stats_store_append(DATE_BASE, connus, 2));
+
+    StatsImportResult result;
+    ecrire_fichier("1600000000,,2,62.510;11.600\n");    // Arrondis différents, écart < 0.5
+    CHECK(stats_import(FICHIER, &result));
+    CHECK_EQ_INT(result.duplicates, 1);
+    CHECK_EQ_INT(result.imported, 0);
+
+    ecrire_fichier("1600000000,,2,63.100;12.000\n"      // Écart de 0.61
+                   "1600000000,,1,62.490\n"             // Autre nombre de sessions
+                   "1600000001,,2,62.490;12.000\n");    // Autre date
+    CHECK(stats_import(FICHIER, &result));
+    CHECK_EQ_INT(result.duplicates, 0);
+    CHECK_EQ_INT(result.imported, 3);
+    CHECK_EQ_INT(exercices_du_journal(), 4);
+    remove(FICHIER);
+}
+
+static void doublon_dans_le_fichier(void) {
+    stats_store_reset();
+    StatsImportResult result;
+    ecrire_fichier("{\"timestamp\":1600000000,\"sessions\":[45.000]}\n"
+                   "1600000000,,1,45.200\n");
+    CHECK(stats_import(FICHIER, &result));
+    CHECK_EQ_INT(result.imported, 1);
+    CHECK_EQ_INT(result.duplicates, 1);
+    CHECK_EQ_INT(exercices_du_journal(), 1);
+
+    remove(FICHIER);
+    stats_store_reset();
+}
+
+int main(void) {
+    reimport_d_un_export();
+    tolerance_des_temps();
+    doublon_dans_le_fichier();
+    return CHECK_DONE();
+}
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// test_stats_exchange.c
+// EXPORT / IMPORT DE L'HISTORIQUE (CSV, JSON LINES)
+// - Aller-retour : export, journal vidé, import ; même historique (temps à
+//   la milliseconde près), dans chaque format
+// - Fichier dans le désordre : exercices ajoutés au journal triés par date,
+//   à date égale dans l'ordre du fichier
+// - Lignes ignorées (vides, commentaires, en-tête) et lignes rejetées
+
+#include "check.h"
+#include "support.h"
+#include "core/stats_exchange.h"
+#include "core/stats_store.h"
+#include <math.h>
+#include <stdio.h>
+
+#define EXERCICES 500
+#define DATE_BASE 1650000000
+
+static Exercice exercices[EXERCICES];
+
+static bool meme_historique(const Exercice* attendus, int count) {
+    ExerciseHistory history;
+    bool ok = stats_store_load(&history) == count && history.count == count;
+    for (int i = 0; ok && i < count; i++) {
+        const ExerciseEntry* entry = &history.entries[i];
+        ok = entry->timestamp == attendus[i].timestamp && entry->session_count == attendus[i].count;
+        for (int s = 0; ok && s < entry->session_count; s++) {
+            ok = fabsf(entry->session_times[s] - attendus[i].times[s]) <= 0.001f;
+        }
+    }
+    free_exercise_history(&history);
+    return ok;
+}
+
+// Dates visitées dans l'ordre du journal
+typedef struct {
+    time_t dates[16];
+    float premiers[16];
+    int count;
+} Visites;
+
+static bool noter_visite(time_t timestamp, const float* times, int count, void* user) {
+    (void)count;
+    Visites* visites = user;
+    if (visites->count < 16) {
+        visites->dates[visites->count] = timestamp;
+        visites->premiers[visites->count] = times[0];
+    }
+    visites->count++;
+    return true;
+}
+
+static void aller_retour(StatsExchangeFormat format) {
+    stats_store_reset();
+    bool ok = true;
+    for (int i = 0; i < EXERCICES && ok; i++) {
+        ok = stats_store_append(exercices[i].timestamp, exercices[i].times, exercices[i].count);
+    }
+    CHECK(ok);
+
+    CHECK_EQ_INT(stats_export(FICHIER, format), EXERCICES);
+    stats_store_reset();
+
+    StatsImportResult result;
+    CHECK(stats_import(FICHIER, &result));
+    CHECK_EQ_INT(result.imported, EXERCICES);
+    CHECK_EQ_INT(result.duplicates, 0);
+    CHECK_EQ_INT(result.invalid, 0);
+    CHECK(meme_historique(exercices, EXERCICES));
+    remove(FICHIER);
+}
+
+static void import_dans_le_desordre(void) {
+    stats_store_reset();
+    float connu = 30.0f;
+    CHECK(stats_store_append(1650000300, &connu, 1));
+
+    StatsImportResult result;
+    ecrire_fichier("1650000500,,1,50.000\n"
+                   "{\"timestamp\":1650000100,\"sessions\":[10.000]}\n"
+                   "1650000400,,2,40.000;41.000\n"
+                   "1650000100,,1,11.000\n");
+    CHECK(stats_import(FICHIER, &result));
+    CHECK_EQ_INT(result.imported, 4);
+
+    // Journal : l'exercice connu, puis l'import trié (même date : ordre du fichier)
+    Visites visites = {0};
+    CHECK_EQ_INT(stats_store_foreach(noter_visite, &visites), 5);
+    CHECK(visites.dates[0] == 1650000300 && visites.dates[1] == 1650000100 &&
+          visites.dates[2] == 1650000100 && visites.dates[3] == 1650000400 &&
+          visites.dates[4] == 1650000500);
+    CHECK(visites.premiers[1] == 10.0f && visites.premiers[2] == 11.0f);
+
+    // Historique chargé : trié par date
+    const Exercice attendus[] = {
+        { 1650000100, { 10.0f }, 1 },
+        { 1650000100, { 11.0f }, 1 },
+        { 1650000300, { 30.0f }, 1 },
+        { 1650000400, { 40.0f, 41.0f }, 2 },
+        { 1650000500, { 50.0f }, 1 },
+    };
+    CHECK(meme_historique(attendus, 5));
+    remove(FICHIER);
+}
+
+static void lignes_ignorees_et_rejetees(void) {
+    stats_store_reset();
+    StatsImportResult result;
+    ecrire_fichier("timestamp,date,session_count,sessions\n"
+                   "\n"
+                   "# commentaire\n"
+                   "  {\"sessions\": [ 20.5 , 21 ], \"extra\": {\"a\": [1, \"]\"]}, \"timestamp\": 1650000000 }\n"
+                   "1650000001,2022-04-15T05:20:01Z,1,2.5e1\n"
+                   "pas un exercice\n"
+                   "1650000002,,2,10.000\n"                 // Nombre de sessions faux
+                   "1650000003,,1,-4.000\n"                 // Temps négatif
+                   "4000000000,,1,10.000\n"                 // Date future
+                   "{\"timestamp\":1650000004,\"sessions\":[]}\n"
+                   "{\"timestamp\":1650000005,\"sessions\":[1.0]} reste\n");
+    CHECK(stats_import(FICHIER, &result));
+    CHECK_EQ_INT(result.imported, 2);
+    CHECK_EQ_INT(result.invalid, 6);
+
+    const Exercice attendus[] = {
+        { 1650000000, { 20.5f, 21.0f }, 2 },
+        { 1650000001, { 25.0f }, 1 },
+    };
+    CHECK(meme_historique(attendus, 2));
+
+    CHECK(!stats_import("absent.tmp", &result));
+    CHECK(stats_exchange_format("stats.jsonl") == STATS_FORMAT_JSONL);
+    CHECK(stats_exchange_format("stats.json") == STATS_FORMAT_JSONL);
+    CHECK(stats_exchange_format("stats.csv") == STATS_FORMAT_CSV);
+    CHECK(stats_exchange_format(NULL) == STATS_FORMAT_CSV);
+
+    remove(FICHIER);
+    stats_store_reset();
+}
+
+int main(void) {
+    aleatoire_graine(99);
+    // Temps au millième (3 décimales à l'export), dates croissantes
+    time_t date = DATE_BASE;
+    for (int i = 0; i < EXERCICES; i++) {
+        date += 60 + aleatoire(86400);
+        exercices[i].timestamp = date;
+        exercices[i].count = 1 + aleatoire(8);
+        for (int s = 0; s < exercices[i].count; s++) {
+            exercices[i].times[s] = (float)aleatoire(600000) / 1000.0f;
+        }
+    }
+
+    aller_retour(STATS_FORMAT_CSV);
+    aller_retour(STATS_FORMAT_JSONL);
+    import_dans_le_desordre();
+    lignes_ignorees_et_rejetees();
+    return CHECK_DONE();
+}
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// test_stats_history.c
+// HISTORIQUE EN MÉMOIRE : DOUBLONS ET AJOUTS SANS RECHARGEMENT
+// - Doublons par empreinte : première session de part et d'autre d'un
+//   arrondi (x.49 / x.51, 0.5 s ± ε), autre nombre de sessions ; mêmes
+//   réponses sans ensemble d'empreintes (parcours complet)
+// - Ajouts un à un (dont un exercice plus ancien) : historique trié, chaque
+//   exercice retrouvé, chronologie à jour
+// - Chargement puis ajout : même historique qu'un rechargement du journal
+
+#include "check.h"
+#include "core/stats_history.h"
+#include "core/stats_store.h"
+#include "core/memory/memory.h"
+#include <string.h>
+
+#define AJOUTS 2000
+#define DATE_BASE 1700000000
+
+static ExerciseHistory historique_vide(void) {
+    ExerciseHistory history;
+    memset(&history, 0, sizeof(history));
+    return history;
+}
+
+static bool present(const ExerciseHistory* history, float premier, float second, int count) {
+    float times[2] = { premier, second };
+    return is_exercise_in_history(history, times, count);
+}
+
+// Réponses attendues autour des arrondis, avec ou sans empreintes
+static bool doublons_attendus(const ExerciseHistory* history) {
+    return present(history, 12.51f, 30.0f, 2) &&       // 12.49 enregistré : arrondis 12 / 13
+           present(history, 12.0f, 30.0f, 2) &&
+           !present(history, 13.0f, 30.0f, 2) &&       // Écart 0.51
+           !present(history, 12.49f, 30.0f, 1) &&      // Autre nombre de sessions
+           present(history, 0.51f, 5.0f, 2) &&         // 0.49 enregistré : arrondis 0 / 1
+           present(history, 0.001f, 5.0f, 2) &&
+           !present(history, 1.0f, 5.0f, 2) &&
+           present(history, 10.499f, 7.0f, 2) &&       // 10.0 enregistré : 0.5 s - ε
+           !present(history, 10.501f, 7.0f, 2) &&      // 0.5 s + ε
+           present(history, 9.501f, 7.0f, 2) &&
+           !present(history, 9.499f, 7.0f, 2);
+}
+
+static void doublons(void) {
+    ExerciseHistory history = historique_vide();
+    const float a[2] = { 12.49f, 30.0f };
+    const float b[2] = { 0.49f, 5.0f };
+    const float c[2] = { 10.0f, 7.0f };
+    CHECK(append_exercise_to_history(&history, DATE_BASE, a, 2));
+    CHECK(append_exercise_to_history(&history, DATE_BASE + 60, b, 2));
+    CHECK(append_exercise_to_history(&history, DATE_BASE + 120, c, 2));
+    CHECK(history.fingerprints != NULL);
+    CHECK(doublons_attendus(&history));
+
+    // Sans empreintes (allocation impossible) : parcours complet
+    SAFE_FREE(history.fingerprints);
+    history.fingerprint_capacity = 0;
+    CHECK(doublons_attendus(&history));
+
+    CHECK(!is_exercise_in_history(&history, a, 0));
+    free_exercise_history(&history);
+    CHECK(!present(&history, 12.49f, 30.0f, 2));        // Historique vide
+}
+
+static void ajouts_un_a_un(void) {
+    ExerciseHistory history = historique_vide();
+    bool ok = true;
+    for (int i = 0; i < AJOUTS && ok; i++) {
+        float times[2] = { 20.0f + (float)i * 1.5f, 60.0f };
+        ok = !is_exercise_in_history(&history, times, 2) &&
+             append_exercise_to_history(&history, DATE_BASE + (time_t)i * 3600, times, 2) &&
+             is_exercise_in_history(&history, times, 2);
+    }
+    CHECK(ok);
+    CHECK_EQ_INT(history.count, AJOUTS);
+    CHECK(history.fingerprint_capacity >= history.count * 2);
+
+    // Horloge reculée : rangé à sa date
+    float ancien[1] = { 42.0f };
+    CHECK(append_exercise_to_history(&history, DATE_BASE - 10, ancien, 1));
+    CHECK(history.entries[0].timestamp == DATE_BASE - 10);
+    CHECK(history.entries[0].session_times[0] == 42.0f);
+    CHECK(is_exercise_in_history(&history, ancien, 1));
+
+    ok = true;
+    for (int i = 1; i < history.count && ok; i++) {
+        ok = history.entries[i - 1].timestamp <= history.entries[i].timestamp &&
+             history.entries[i].session_times[0] == 20.0f + (float)(i - 1) * 1.5f;
+    }
+    CHECK(ok);
+
+    int64_t premier, dernier;
+    CHECK_EQ_INT(history.timeline.count, AJOUTS + 1);
+    CHECK(stats_timeline_range(&history.timeline, &premier, &dernier));
+    CHECK(premier == DATE_BASE - 10 && dernier == DATE_BASE + (int64_t)(AJOUTS - 1) * 3600);
+    free_exercise_history(&history);
+}
+
+static bool memes_entrees(const ExerciseHistory* a, const ExerciseHistory* b) {
+    if (a->count != b->count) return false;
+    for (int i = 0; i < a->count; i++) {
+        const ExerciseEntry* ea = &a->entries[i];
+        const ExerciseEntry* eb = &b->entries[i];
+        if (ea->timestamp != eb->timestamp || ea->session_count != eb->session_count ||
+            memcmp(ea->session_times, eb->session_times, (size_t)ea->session_count * sizeof(float)) != 0) {
+            return false;
+        }
+    }
+    return a->timeline.count == b->timeline.count;
+}
+
+static void chargement_puis_ajouts(void) {
+    stats_store_reset();
+    for (int i = 0; i < 100; i++) {
+        float times[3] = { 30.0f + (float)i, 45.0f, 50.0f };
+        stats_store_append(DATE_BASE + (time_t)i * 600, times, 3);
+    }
+
+    ExerciseHistory tenu;
+    CHECK_EQ_INT(load_exercise_history(&tenu), 100);
+    float* pool = tenu.session_pool;
+
+    // Plus que la place réservée : les temps sont déplacés en cours de route
+    bool ok = true;
+    for (int i = 0; i < STATS_HISTORY_RESERVE * 2 && ok; i++) {
+        float times[2] = { 500.0f + (float)i, 1.0f };
+        time_t date = DATE_BASE + 100000 + (time_t)i * 60;
+        ok = stats_store_append(date, times, 2) && append_exercise_to_history(&tenu, date, times, 2);
+        if (i == STATS_HISTORY_RESERVE - 2) ok = ok && tenu.session_pool == pool;
+    }
+    CHECK(ok);
+
+    ExerciseHistory relu;
+    load_exercise_history(&relu);
+    CHECK(memes_entrees(&tenu, &relu));
+    free_exercise_history(&tenu);
+    free_exercise_history(&relu);
+    stats_store_reset();
+}
+
+int main(void) {
+    doublons();
+    ajouts_un_a_un();
+    chargement_puis_ajouts();
+    return CHECK_DONE();
+}
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// test_stats_rollup.c
+// CUMULS DE L'HISTORIQUE
+// Les mêmes exercices ajoutés dans l'ordre chronologique et mélangés doivent
+// donner les mêmes cumuls, égaux à un calcul direct : exercices par jour et
+// par semaine dans la fenêtre, séries, records, moyennes par rang. Puis
+// fichier des cumuls (aller-retour, fichier tronqué) et rattrapage depuis le
+// journal.
+
+#include "check.h"
+#include "support.h"
+#include "core/stats_store.h"
+#include "core/paths.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PLAGE_JOURS 1500            // Jours tirés (plus que ROLLUP_DAYS)
+#define EXERCICES 1200
+#define JOUR_BASE 19000             // 2022-01-08
+
+static Exercice exercices[EXERCICES];
+
+// Midi UTC (TZ=UTC) : un exercice par jour tiré
+static time_t midi(int jour) {
+    return (time_t)(JOUR_BASE + jour) * 86400 + 12 * 3600;
+}
+
+static void tirer_exercices(int plage) {
+    for (int i = 0; i < EXERCICES; i++) {
+        exercices[i].timestamp = midi(aleatoire(plage));
+        exercices[i].count = 1 + aleatoire(3);
+        for (int s = 0; s < exercices[i].count; s++) {
+            exercices[i].times[s] = (float)(5 + aleatoire(300));
+        }
+    }
+}
+
+static void cumuler(StatsRollup* rollup, const int* ordre) {
+    stats_rollup_reset(rollup);
+    for (int i = 0; i < EXERCICES; i++) {
+        const Exercice* e = &exercices[ordre[i]];
+        stats_rollup_add(rollup, e->timestamp, e->times, e->count);
+    }
+}
+
+// Cumuls comparés au calcul direct sur les exercices tirés
+static bool cumuls_exacts(const StatsRollup* rollup, int plage) {
+    static int par_jour[PLAGE_JOURS];
+    memset(par_jour, 0, sizeof(par_jour));
+    uint32_t sessions = 0;
+    double somme_rang0 = 0.0;
+    float record = 0.0f;
+    for (int i = 0; i < EXERCICES; i++) {
+        par_jour[(exercices[i].timestamp / 86400) - JOUR_BASE]++;
+        sessions += (uint32_t)exercices[i].count;
+        somme_rang0 += exercices[i].times[0];
+        for (int s = 0; s < exercices[i].count; s++) {
+            if (exercices[i].times[s] > record) record = exercices[i].times[s];
+        }
+    }
+
+    // Séries : parcours des jours actifs (serie = plage finissant à dernier)
+    int dernier = -1, serie = 0, meilleure = 0;
+    for (int j = 0; j < plage; j++) {
+        if (!par_jour[j]) continue;
+        serie = (dernier == j - 1) ? serie + 1 : 1;
+        dernier = j;
+        if (serie > meilleure) meilleure = serie;
+    }
+
+    if (rollup->exercises != EXERCICES || rollup->sessions != sessions) return false;
+    if (rollup->best_session != record || rollup->best_streak != (uint32_t)meilleure) return false;
+    if (rollup->streak != (uint32_t)serie) return false;
+    if (rollup->last_day != stats_rollup_day(midi(dernier))) return false;
+    if (rollup->by_rank[0].count != EXERCICES) return false;
+    if (stats_rollup_mean(rollup, 0) < (float)(somme_rang0 / EXERCICES) - 0.01f ||
+        stats_rollup_mean(rollup, 0) > (float)(somme_rang0 / EXERCICES) + 0.01f) {
+        return false;
+    }
+
+    // Jours et semaines : exacts dans la fenêtre, 0 au-delà
+    int32_t semaine_recente = stats_rollup_week(rollup->last_day);
+    for (int j = 0; j < plage; j++) {
+        int32_t jour = stats_rollup_day(midi(j));
+        uint32_t attendu = (dernier - j < ROLLUP_DAYS) ? (uint32_t)par_jour[j] : 0;
+        if (stats_rollup_day_exercises(rollup, jour) != attendu) return false;
+
+        int32_t semaine = stats_rollup_week(jour);
+        if (j > 0 && semaine == stats_rollup_week(stats_rollup_day(midi(j - 1)))) continue;
+        uint32_t par_semaine = 0;
+        for (int k = j; k < plage && stats_rollup_week(stats_rollup_day(midi(k))) == semaine; k++) {
+            par_semaine += (uint32_t)par_jour[k];
+        }
+        attendu = (semaine > semaine_recente - ROLLUP_WEEKS) ? par_semaine : 0;
+        if (stats_rollup_week_exercises(rollup, semaine) != attendu) return false;
+    }
+    return true;
+}
+
+static void independant_de_l_ordre(void) {
+    static StatsRollup chronologique, melange;
+    static int ordre[EXERCICES];
+
+    // Plage courte (séries longues) puis plage large (fenêtres dépassées)
+    const int plages[] = { 200, PLAGE_JOURS };
+    for (int p = 0; p < 2; p++) {
+        tirer_exercices(plages[p]);
+
+        // Ordre chronologique
+        for (int i = 0; i < EXERCICES; i++) ordre[i] = i;
+        for (int i = 1; i < EXERCICES; i++) {
+            int o = ordre[i], k = i - 1;
+            while (k >= 0 && exercices[ordre[k]].timestamp > exercices[o].timestamp) {
+                ordre[k + 1] = ordre[k];
+                k--;
+            }
+            ordre[k + 1] = o;
+        }
+        cumuler(&chronologique, ordre);
+        CHECK(cumuls_exacts(&chronologique, plages[p]));
+
+        // Mélange (Fisher-Yates)
+        for (int i = EXERCICES - 1; i > 0; i--) {
+            int k = aleatoire(i + 1);
+            int o = ordre[i];
+            ordre[i] = ordre[k];
+            ordre[k] = o;
+        }
+        cumuler(&melange, ordre);
+        CHECK(cumuls_exacts(&melange, plages[p]));
+    }
+}
+
+static void series(void) {
+    static StatsRollup rollup;
+    stats_rollup_reset(&rollup);
+    float t = 60.0f;
+    int32_t jour0 = stats_rollup_day(midi(0));
+
+    stats_rollup_add(&rollup, midi(0), &t, 1);
+    stats_rollup_add(&rollup, midi(1), &t, 1);
+    stats_rollup_add(&rollup, midi(3), &t, 1);
+    stats_rollup_add(&rollup, midi(4), &t, 1);
+    CHECK_EQ_INT(rollup.run_count, 2);
+    CHECK_EQ_INT(rollup.streak, 2);
+    CHECK_EQ_INT(rollup.best_streak, 2);
+
+    stats_rollup_add(&rollup, midi(2), &t, 1);     // Comble le trou après coup
+    CHECK_EQ_INT(rollup.run_count, 1);
+    CHECK_EQ_INT(rollup.streak, 5);
+    CHECK_EQ_INT(rollup.best_streak, 5);
+
+    stats_rollup_add(&rollup, midi(1), &t, 1);     // Jour déjà actif
+    CHECK_EQ_INT(rollup.streak, 5);
+    CHECK_EQ_INT(stats_rollup_day_exercises(&rollup, jour0 + 1), 2);
+
+    CHECK_EQ_INT(stats_rollup_current_streak(&rollup, jour0 + 4), 5);
+    CHECK_EQ_INT(stats_rollup_current_streak(&rollup, jour0 + 5), 5);   // Pas encore fait aujourd'hui
+    CHECK_EQ_INT(stats_rollup_current_streak(&rollup, jour0 + 6), 0);   // Interrompue
+}
+
+static void mediane(void) {
+    static StatsRollup rollup;
+    stats_rollup_reset(&rollup);
+    const float temps[] = { 10.0f, 20.0f, 62.0f, 90.0f, 900.0f };
+    for (int i = 0; i < 5; i++) stats_rollup_add(&rollup, midi(i), &temps[i], 1);
+
+    float m = stats_rollup_median(&rollup, 0);
+    CHECK(m >= 62.0f - ROLLUP_HIST_STEP / 2.0f - 0.01f && m <= 62.0f + ROLLUP_HIST_STEP / 2.0f + 0.01f);
+    CHECK(rollup.by_rank[0].max == 900.0f);        // Au-delà de l'histogramme
+    CHECK(stats_rollup_mean(&rollup, 1) == 0.0f);  // Rang sans données
+}
+
+static void fichier_des_cumuls(void) {
+    static StatsRollup ecrit, lu;
+    stats_rollup_reset(&ecrit);
+    float t[2] = { 75.0f, 120.0f };
+    stats_rollup_add(&ecrit, midi(10), t, 2);
+
+    const char* path = "cumuls.tmp";
+    uint64_t fin = 0;
+    uint32_t records = 0;
+    CHECK(stats_rollup_save(path, &ecrit, 4096, 7));
+    CHECK(stats_rollup_load(path, &lu, &fin, &records));
+    CHECK_EQ_INT(fin, 4096);
+    CHECK_EQ_INT(records, 7);
+    CHECK(memcmp(&ecrit, &lu, sizeof(StatsRollup)) == 0);
+
+    // Fichier tronqué : refusé
+    FILE* file = fopen(path, "r+b");
+    if (file) {
+        CHECK(ftruncate(fileno(file), 100) == 0);
+        fclose(file);
+    }
+    CHECK(!stats_rollup_load(path, &lu, &fin, &records));
+    remove(path);
+}
+
+// Cumuls du journal : tenus à chaque ajout (dans le désordre), puis
+// recalculés quand le fichier des cumuls disparaît
+static void rattrapage_depuis_le_journal(void) {
+    static StatsRollup direct, tenu, recalcule;
+    stats_store_reset();
+    stats_rollup_reset(&direct);
+
+    tirer_exercices(60);
+    for (int i = 0; i < 40; i++) {
+        CHECK(stats_store_append(exercices[i].timestamp, exercices[i].times, exercices[i].count));
+        stats_rollup_add(&direct, exercices[i].timestamp, exercices[i].times, exercices[i].count);
+    }
+
+    CHECK(stats_store_load_rollup(&tenu));
+    CHECK(memcmp(&tenu, &direct, sizeof(StatsRollup)) == 0);
+
+    remove(CONFIG_STATS_ROLLUP);
+    CHECK(stats_store_load_rollup(&recalcule));
+    CHECK(memcmp(&recalcule, &direct, sizeof(StatsRollup)) == 0);
+
+    stats_store_reset();
+}
+
+int main(void) {
+    aleatoire_graine(777);
+    setenv("TZ", "UTC", 1);
+    tzset();
+
+    independant_de_l_ordre();
+    series();
+    mediane();
+    fichier_des_cumuls();
+    rattrapage_depuis_le_journal();
+    return CHECK_DONE();
+}
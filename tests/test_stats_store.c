@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// test_stats_store.c
+// JOURNAL DES EXERCICES : CRC ET REPRISE APRÈS INCIDENT
+// - Ajouts dans le désordre : historique chargé trié par date
+// - Fin incomplète (coupure pendant une écriture) : ignorée, puis tronquée
+//   par l'ajout suivant
+// - Octet abîmé au milieu : l'enregistrement est écarté par son CRC, avec ou
+//   sans index, les autres sont gardés
+// - Ajout : l'index est complété sur place (pas réécrit), y compris s'il
+//   était en retard sur le journal ; un index d'un autre journal est refait
+// - Journal d'un autre format : jamais réécrit
+// - Anciens fichiers .bin : importés une fois puis supprimés
+
+#include "check.h"
+#include "core/stats_store.h"
+#include "core/paths.h"
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Format du journal (stats_store.c) : en-tête de 16 octets, puis par
+// exercice un en-tête de 24 octets et les temps, alignés sur 8 octets
+#define LOG_HEADER_SIZE 16
+#define RECORD_HEADER_SIZE 24
+#define INDEX_HEADER_SIZE 24
+
+static long record_size(int session_count) {
+    return (RECORD_HEADER_SIZE + session_count * 4 + 7) & ~7L;
+}
+
+static long taille_fichier(const char* path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? (long)st.st_size : -1;
+}
+
+static ino_t inode(const char* path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? st.st_ino : 0;
+}
+
+static bool fichier_existe(const char* path) {
+    return access(path, F_OK) == 0;
+}
+
+static void ecrire_a(const char* path, long offset, const void* data, size_t size) {
+    FILE* file = fopen(path, offset < 0 ? "ab" : "r+b");
+    if (!file) return;
+    if (offset >= 0) fseek(file, offset, SEEK_SET);
+    fwrite(data, 1, size, file);
+    fclose(file);
+}
+
+// Charge l'historique et vérifie les dates attendues, dans l'ordre
+static bool historique_egal(const time_t* dates, int count) {
+    ExerciseHistory history;
+    bool ok = stats_store_load(&history) == count && history.count == count;
+    for (int i = 0; ok && i < count; i++) {
+        const ExerciseEntry* entry = &history.entries[i];
+        ok = entry->timestamp == dates[i] && entry->session_count > 0 &&
+             entry->session_times[0] == (float)(dates[i] % 1000);
+    }
+    free_exercise_history(&history);
+    return ok;
+}
+
+// Premier temps = date % 1000 (repère pour historique_egal)
+static bool ajouter(time_t date, int session_count) {
+    float times[4] = { (float)(date % 1000), 30.0f, 60.0f, 90.0f };
+    return stats_store_append(date, times, session_count);
+}
+
+static bool compter_visites(time_t timestamp, const float* times, int count, void* user) {
+    (void)timestamp;
+    (void)times;
+    (void)count;
+    (*(int*)user)++;
+    return true;
+}
+
+static void ajouts_et_ordre(void) {
+    stats_store_reset();
+    ExerciseHistory vide;
+    CHECK_EQ_INT(stats_store_load(&vide), 0);       // Pas de journal : historique vide
+    free_exercise_history(&vide);
+
+    CHECK(ajouter(1700000300, 3));
+    CHECK(ajouter(1700000100, 2));
+    CHECK(ajouter(1700000200, 1));
+    CHECK_EQ_INT(taille_fichier(CONFIG_STATS_LOG),
+                 LOG_HEADER_SIZE + record_size(3) + record_size(2) + record_size(1));
+
+    const time_t dates[] = { 1700000100, 1700000200, 1700000300 };
+    CHECK(historique_egal(dates, 3));
+
+    int visites = 0;
+    CHECK_EQ_INT(stats_store_foreach(compter_visites, &visites), 3);
+    CHECK_EQ_INT(visites, 3);
+
+    float trop[1] = { 1.0f };
+    CHECK(!stats_store_append(1700000400, trop, 0));
+    CHECK(!stats_store_append(1700000400, trop, STATS_MAX_SESSIONS + 1));
+}
+
+static void fin_incomplete(void) {
+    long avant = taille_fichier(CONFIG_STATS_LOG);
+
+    // Début d'enregistrement puis coupure
+    unsigned char morceau[RECORD_HEADER_SIZE + 6];
+    memset(morceau, 0xAB, sizeof(morceau));
+    ecrire_a(CONFIG_STATS_LOG, -1, morceau, sizeof(morceau));
+
+    const time_t dates[] = { 1700000100, 1700000200, 1700000300 };
+    CHECK(historique_egal(dates, 3));
+
+    // L'ajout suivant repart de la fin du dernier enregistrement valide
+    CHECK(ajouter(1700000400, 4));
+    CHECK_EQ_INT(taille_fichier(CONFIG_STATS_LOG), avant + record_size(4));
+
+    const time_t apres[] = { 1700000100, 1700000200, 1700000300, 1700000400 };
+    CHECK(historique_egal(apres, 4));
+}
+
+static void octet_abime(void) {
+    // Deuxième enregistrement du journal (1700000100, 2 sessions) : un temps abîmé
+    long offset = LOG_HEADER_SIZE + record_size(3) + RECORD_HEADER_SIZE + 4;
+    ecrire_a(CONFIG_STATS_LOG, offset, "X", 1);
+
+    const time_t dates[] = { 1700000200, 1700000300, 1700000400 };
+    CHECK(fichier_existe(CONFIG_STATS_INDEX));
+    CHECK(historique_egal(dates, 3));              // Index présent : CRC vérifié à la copie
+
+    remove(CONFIG_STATS_INDEX);
+    CHECK(historique_egal(dates, 3));              // Journal reparcouru
+    CHECK(fichier_existe(CONFIG_STATS_INDEX));     // Index réécrit
+
+    int visites = 0;
+    CHECK_EQ_INT(stats_store_foreach(compter_visites, &visites), 3);
+
+    // Index corrompu : ignoré
+    ecrire_a(CONFIG_STATS_INDEX, 0, "XXXX", 4);
+    CHECK(historique_egal(dates, 3));
+}
+
+static bool copier_fichier(const char* source, const char* destination) {
+    FILE* in = fopen(source, "rb");
+    FILE* out = fopen(destination, "wb");
+    char buffer[4096];
+    size_t n;
+    bool ok = in && out;
+    while (ok && (n = fread(buffer, 1, sizeof(buffer), in)) > 0) ok = fwrite(buffer, 1, n, out) == n;
+    if (in) fclose(in);
+    if (out) fclose(out);
+    return ok;
+}
+
+static void index_complete_a_l_ajout(void) {
+    stats_store_reset();
+    CHECK(ajouter(1700001100, 1));
+    CHECK(ajouter(1700001200, 2));
+
+    // Index complété sur place : même fichier, un offset de plus
+    ino_t avant = inode(CONFIG_STATS_INDEX);
+    CHECK(ajouter(1700001300, 3));
+    CHECK(avant != 0 && inode(CONFIG_STATS_INDEX) == avant);
+    CHECK_EQ_INT(taille_fichier(CONFIG_STATS_INDEX), INDEX_HEADER_SIZE + 3 * 8);
+
+    // Index en retard (ancienne copie) : la fin du journal est reprise
+    const char* ancien = CONFIG_STATS_DIR "/ancien.idx";
+    CHECK(copier_fichier(CONFIG_STATS_INDEX, ancien));
+    CHECK(ajouter(1700001400, 1));
+    CHECK(rename(ancien, CONFIG_STATS_INDEX) == 0);
+    CHECK(ajouter(1700001500, 2));
+    CHECK_EQ_INT(taille_fichier(CONFIG_STATS_INDEX), INDEX_HEADER_SIZE + 5 * 8);
+    const time_t dates[] = { 1700001100, 1700001200, 1700001300, 1700001400, 1700001500 };
+    CHECK(historique_egal(dates, 5));
+
+    // Dernier offset de l'index incohérent avec le journal : index refait
+    uint64_t faux = LOG_HEADER_SIZE;
+    ecrire_a(CONFIG_STATS_INDEX, INDEX_HEADER_SIZE + 4 * 8, &faux, sizeof(faux));
+    CHECK(ajouter(1700001600, 1));
+    CHECK_EQ_INT(taille_fichier(CONFIG_STATS_INDEX), INDEX_HEADER_SIZE + 6 * 8);
+    const time_t toutes[] = { 1700001100, 1700001200, 1700001300, 1700001400, 1700001500, 1700001600 };
+    CHECK(historique_egal(toutes, 6));
+
+    StatsRollup rollup;
+    CHECK(stats_store_load_rollup(&rollup));
+    CHECK_EQ_INT(rollup.exercises, 6);
+}
+
+static void autre_format(void) {
+    stats_store_reset();
+    unsigned char inconnu[64];
+    memset(inconnu, 0x5A, sizeof(inconnu));
+    ecrire_a(CONFIG_STATS_LOG, -1, inconnu, sizeof(inconnu));
+
+    ExerciseHistory history;
+    CHECK_EQ_INT(stats_store_load(&history), 0);
+    free_exercise_history(&history);
+    CHECK(!ajouter(1700000500, 1));
+    CHECK_EQ_INT(taille_fichier(CONFIG_STATS_LOG), (long)sizeof(inconnu));
+}
+
+static void anciens_fichiers(void) {
+    stats_store_reset();
+
+    // [time_t][int session_count][float × session_count]
+    const time_t dates[] = { 1600000100, 1600000200 };
+    for (int i = 1; i >= 0; i--) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/stats_%d.bin", CONFIG_STATS_DIR, i);
+        FILE* file = fopen(path, "wb");
+        if (!file) continue;
+        int count = 1;
+        float time = (float)(dates[i] % 1000);
+        fwrite(&dates[i], sizeof(time_t), 1, file);
+        fwrite(&count, sizeof(int), 1, file);
+        fwrite(&time, sizeof(float), 1, file);
+        fclose(file);
+    }
+
+    CHECK(historique_egal(dates, 2));
+    CHECK(!fichier_existe(CONFIG_STATS_DIR "/stats_0.bin"));
+    CHECK(!fichier_existe(CONFIG_STATS_DIR "/stats_1.bin"));
+    CHECK(historique_egal(dates, 2));              // Pas importés deux fois
+
+    stats_store_reset();
+    CHECK(!fichier_existe(CONFIG_STATS_LOG));
+}
+
+int main(void) {
+    ajouts_et_ordre();
+    fin_incomplete();
+    octet_abime();
+    index_complete_a_l_ajout();
+    autre_format();
+    anciens_fichiers();
+    return CHECK_DONE();
+}
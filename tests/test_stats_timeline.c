@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// test_stats_timeline.c
+// CHRONOLOGIE DE L'HISTORIQUE (PYRAMIDE + LTTB)
+// - Au plus budget + 2 points, dates croissantes, low ≤ valeur ≤ high
+// - Historique entier : premier et dernier points dans les tranches des
+//   bords, enveloppe des points égale au min/max de toutes les sessions
+// - Petite fenêtre : exercices rendus tels quels, plus un voisin de chaque côté
+// - Exercices ajoutés dans le désordre : mêmes points
+// - Exercices ajoutés après construction (place réservée) : mêmes points
+//   qu'une construction complète
+
+#include "check.h"
+#include "support.h"
+#include "core/stats_timeline.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define EXERCICES 100000
+#define BUDGET 300
+#define DATE_BASE 1500000000
+
+static Exercice exercices[EXERCICES];
+static TimelinePoint points[BUDGET + 2];
+static TimelinePoint points_melange[BUDGET + 2];
+
+// Dates distinctes et croissantes (écart de 1 à 6 heures)
+static void tirer_exercices(void) {
+    time_t date = DATE_BASE;
+    for (int i = 0; i < EXERCICES; i++) {
+        date += 3600 * (1 + aleatoire(6));
+        exercices[i].timestamp = date;
+        exercices[i].count = 1 + aleatoire(3);
+        for (int s = 0; s < exercices[i].count; s++) {
+            exercices[i].times[s] = (float)(10 + aleatoire(200)) + (float)aleatoire(100) / 100.0f;
+        }
+    }
+
+    // Session la plus courte, unique, dans un exercice ordinaire : seule
+    // l'enveloppe de sa tranche peut la garder
+    Exercice* e = &exercices[EXERCICES / 3];
+    e->count = 3;
+    e->times[0] = 60.0f;
+    e->times[1] = 1.5f;
+    e->times[2] = 90.0f;
+}
+
+static bool construire(StatsTimeline* timeline, const int* ordre, int count) {
+    if (!stats_timeline_begin(timeline, count)) return false;
+    for (int i = 0; i < count; i++) {
+        const Exercice* e = &exercices[ordre ? ordre[i] : i];
+        stats_timeline_add(timeline, e->timestamp, e->times, e->count);
+    }
+    stats_timeline_finish(timeline);
+    return true;
+}
+
+static bool points_coherents(const TimelinePoint* out, int count) {
+    for (int i = 0; i < count; i++) {
+        if (out[i].low > out[i].value || out[i].value > out[i].high) return false;
+        if (i > 0 && out[i].time <= out[i - 1].time) return false;
+    }
+    return true;
+}
+
+static void historique_entier(void) {
+    StatsTimeline timeline;
+    CHECK(construire(&timeline, NULL, EXERCICES));
+    CHECK_EQ_INT(timeline.count, EXERCICES);
+
+    int64_t premier, dernier;
+    CHECK(stats_timeline_range(&timeline, &premier, &dernier));
+    CHECK(premier == exercices[0].timestamp && dernier == exercices[EXERCICES - 1].timestamp);
+
+    int n = stats_timeline_sample(&timeline, premier, dernier, BUDGET, points);
+    CHECK(n >= 3 && n <= BUDGET + 2);
+    CHECK(points_coherents(points, n));
+    // Bords : nœuds moyennés au-delà du niveau 0, mais dans la première
+    // (dernière) tranche de l'historique
+    CHECK(points[0].time >= (double)premier &&
+          points[0].time < (double)exercices[EXERCICES / BUDGET].timestamp);
+    CHECK(points[n - 1].time <= (double)dernier &&
+          points[n - 1].time > (double)exercices[EXERCICES - 1 - EXERCICES / BUDGET].timestamp);
+
+    // Enveloppe : chaque exercice est dans une tranche
+    float bas = exercices[0].times[0], haut = bas;
+    for (int i = 0; i < EXERCICES; i++) {
+        for (int s = 0; s < exercices[i].count; s++) {
+            if (exercices[i].times[s] < bas) bas = exercices[i].times[s];
+            if (exercices[i].times[s] > haut) haut = exercices[i].times[s];
+        }
+    }
+    float points_bas = points[0].low, points_haut = points[0].high;
+    for (int i = 1; i < n; i++) {
+        if (points[i].low < points_bas) points_bas = points[i].low;
+        if (points[i].high > points_haut) points_haut = points[i].high;
+    }
+    CHECK(points_bas == bas);
+    CHECK(points_haut == haut);
+
+    // Fenêtres décalées : la session la plus courte tombe à différentes
+    // places de sa tranche
+    bool ok = true;
+    for (int d = 1; d <= 16 && ok; d++) {
+        int64_t debut = exercices[d * 97].timestamp;
+        int m = stats_timeline_sample(&timeline, debut, dernier, BUDGET, points);
+        float plus_bas = points[0].low;
+        for (int i = 1; i < m; i++) if (points[i].low < plus_bas) plus_bas = points[i].low;
+        ok = plus_bas == 1.5f;
+    }
+    CHECK(ok);
+
+    // Budget minimal : 3 points, plus les bords
+    n = stats_timeline_sample(&timeline, premier, dernier, 1, points);
+    CHECK(n >= 3 && n <= 5);
+    CHECK(points_coherents(points, n));
+
+    stats_timeline_free(&timeline);
+    CHECK(timeline.nodes == NULL);
+}
+
+static void petite_fenetre(void) {
+    StatsTimeline timeline;
+    CHECK(construire(&timeline, NULL, EXERCICES));
+
+    // 50 exercices au milieu : rendus tels quels, avec un voisin de chaque côté
+    int debut = EXERCICES / 2;
+    int64_t t0 = exercices[debut].timestamp;
+    int64_t t1 = exercices[debut + 49].timestamp;
+    int n = stats_timeline_sample(&timeline, t0, t1, BUDGET, points);
+    CHECK_EQ_INT(n, 52);
+    bool ok = n == 52;
+    for (int i = 0; ok && i < n; i++) {
+        const Exercice* e = &exercices[debut - 1 + i];
+        float haut = e->times[0];
+        for (int s = 1; s < e->count; s++) if (e->times[s] > haut) haut = e->times[s];
+        ok = points[i].time == (double)e->timestamp && points[i].value == haut;
+    }
+    CHECK(ok);
+
+    // Fenêtre vide ou inversée
+    CHECK_EQ_INT(stats_timeline_sample(&timeline, t1, t0, BUDGET, points), 0);
+    n = stats_timeline_sample(&timeline, t0 + 1, t0 + 2, BUDGET, points);
+    CHECK_EQ_INT(n, 2);                             // Les deux voisins
+
+    stats_timeline_free(&timeline);
+
+    StatsTimeline vide;
+    CHECK(construire(&vide, NULL, 0));
+    CHECK_EQ_INT(stats_timeline_sample(&vide, 0, DATE_BASE, BUDGET, points), 0);
+    CHECK(!stats_timeline_range(&vide, &t0, &t1));
+}
+
+static void independante_de_l_ordre(void) {
+    static int ordre[EXERCICES];
+    for (int i = 0; i < EXERCICES; i++) ordre[i] = i;
+    for (int i = EXERCICES - 1; i > 0; i--) {
+        int k = aleatoire(i + 1);
+        int o = ordre[i];
+        ordre[i] = ordre[k];
+        ordre[k] = o;
+    }
+
+    StatsTimeline chronologique, melange;
+    CHECK(construire(&chronologique, NULL, EXERCICES));
+    CHECK(construire(&melange, ordre, EXERCICES));
+
+    // Plusieurs fenêtres : différents niveaux de la pyramide
+    const int64_t t0 = exercices[0].timestamp;
+    const int64_t duree = exercices[EXERCICES - 1].timestamp - t0;
+    bool ok = true;
+    for (int f = 1; f <= 64 && ok; f *= 2) {
+        int64_t debut = t0 + duree / 3 - duree / (3 * f);
+        int64_t fin = t0 + duree / 3 + duree / (3 * f);
+        int a = stats_timeline_sample(&chronologique, debut, fin, BUDGET, points);
+        int b = stats_timeline_sample(&melange, debut, fin, BUDGET, points_melange);
+        ok = a == b && a > 0 && memcmp(points, points_melange, (size_t)a * sizeof(TimelinePoint)) == 0;
+    }
+    CHECK(ok);
+
+    stats_timeline_free(&chronologique);
+    stats_timeline_free(&melange);
+}
+
+static void ajouts_apres_construction(void) {
+    // Moitié construite (place pour tout), l'autre moitié ajoutée une à une
+    StatsTimeline complete, ajoutee;
+    CHECK(construire(&complete, NULL, EXERCICES));
+    CHECK(stats_timeline_begin(&ajoutee, EXERCICES));
+    for (int i = 0; i < EXERCICES / 2 + 1; i++) {
+        stats_timeline_add(&ajoutee, exercices[i].timestamp, exercices[i].times, exercices[i].count);
+    }
+    stats_timeline_finish(&ajoutee);
+
+    bool ok = true;
+    for (int i = EXERCICES / 2 + 1; i < EXERCICES && ok; i++) {
+        ok = stats_timeline_append(&ajoutee, exercices[i].timestamp, exercices[i].times, exercices[i].count);
+    }
+    CHECK(ok);
+    CHECK_EQ_INT(ajoutee.count, EXERCICES);
+    CHECK_EQ_INT(ajoutee.levels, complete.levels);
+
+    const int64_t t0 = exercices[0].timestamp;
+    const int64_t duree = exercices[EXERCICES - 1].timestamp - t0;
+    for (int f = 1; f <= 256 && ok; f *= 2) {
+        int64_t debut = t0 + duree - duree / f;
+        int a = stats_timeline_sample(&complete, debut, t0 + duree, BUDGET, points);
+        int b = stats_timeline_sample(&ajoutee, debut, t0 + duree, BUDGET, points_melange);
+        ok = a == b && a > 0 && memcmp(points, points_melange, (size_t)a * sizeof(TimelinePoint)) == 0;
+    }
+    CHECK(ok);
+
+    // Place pleine, exercice plus ancien : à reconstruire
+    float t = 10.0f;
+    CHECK(!stats_timeline_append(&ajoutee, exercices[EXERCICES - 1].timestamp + 60, &t, 1));
+    stats_timeline_free(&complete);
+    stats_timeline_free(&ajoutee);
+
+    CHECK(stats_timeline_begin(&ajoutee, 4));
+    stats_timeline_add(&ajoutee, DATE_BASE, &t, 1);
+    stats_timeline_finish(&ajoutee);
+    CHECK(!stats_timeline_append(&ajoutee, DATE_BASE - 1, &t, 1));
+    CHECK(stats_timeline_append(&ajoutee, DATE_BASE, &t, 1));    // Même date : acceptée
+    CHECK_EQ_INT(ajoutee.levels, 2);
+    stats_timeline_free(&ajoutee);
+}
+
+int main(void) {
+    aleatoire_graine(2024);
+    tirer_exercices();
+    historique_entier();
+    petite_fenetre();
+    independante_de_l_ordre();
+    ajouts_apres_construction();
+    return CHECK_DONE();
+}